@@ -0,0 +1,161 @@
+/*
+ * Boost Software License - Version 1.0 - August 17th, 2003
+ *
+ * Permission is hereby granted, free of charge, to any person or organization
+ * obtaining a copy of the software and accompanying documentation covered by
+ * this license (the "Software") to use, reproduce, display, distribute,
+ * execute, and transmit the Software, and to prepare derivative works of the
+ * Software, and to permit third-parties to whom the Software is furnished to
+ * do so, all subject to the following:
+ *
+ * The copyright notices in the Software and this entire statement, including
+ * the above license grant, this restriction and the following disclaimer,
+ * must be included in all copies of the Software, in whole or in part, and
+ * all derivative works of the Software, unless such copies or derivative
+ * works are solely in the form of machine-executable object code generated by
+ * a source language processor.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+ * SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+ * FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+// Bandwidth of a bulk unit conversion over arrays of pressures, with
+// regular and huge pages.
+//
+// Usage: huge_pages_benchmark [MiB per array] [threads]
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <engineering_units/si/pressure.hpp>
+#include <engineering_units/memory/large_array.hpp>
+
+namespace si = engunits::si;
+
+using engunits::huge_pages;
+using engunits::large_array;
+
+using pascal_t = engunits::quantity<double, si::pascal>;
+using bar_t = engunits::quantity<double, si::bar>;
+
+// Each thread converts the slice it touched first
+template<class In, class Out>
+double convert( const In & in, Out & out, unsigned threads )
+{
+    const std::size_t n = in.size();
+    const auto start = std::chrono::steady_clock::now();
+    
+    auto slice = [&]( unsigned k )
+    {
+        const pascal_t * src = in.data();
+        bar_t * dst = out.data();
+        
+        for ( std::size_t i = n * k / threads; i < n * ( k + 1 ) / threads; ++i )
+            dst[i] = bar_t( src[i] );
+    };
+    
+    std::vector< std::thread > workers;
+    
+    for ( unsigned k = 1; k < threads; ++k )
+        workers.emplace_back( slice, k );
+    
+    slice( 0 );
+    
+    for ( auto & w : workers )
+        w.join();
+    
+    return std::chrono::duration<double>( std::chrono::steady_clock::now() - start ).count();
+}
+
+// Converts one value per 4 KiB page, in a random order of the pages: every
+// access needs a new TLB entry with regular pages
+template<class In, class Out>
+double convert_sparse( const In & in, Out & out, const std::vector<std::size_t> & pages )
+{
+    const std::size_t stride = 4096 / sizeof(pascal_t);
+    const auto start = std::chrono::steady_clock::now();
+    
+    for ( int round = 0; round < 8; ++round )
+        for ( std::size_t p : pages )
+            out[ p * stride + round ] = bar_t( in[ p * stride + round ] );
+    
+    return std::chrono::duration<double>( std::chrono::steady_clock::now() - start ).count();
+}
+
+template<class In, class Out>
+void run( const std::string & name, const In & in, Out & out, unsigned threads, const std::vector<std::size_t> & pages )
+{
+    double best = 1e9, sparse = 1e9;
+    
+    for ( int i = 0; i < 5; ++i )
+    {
+        best = std::min( best, convert( in, out, threads ) );
+        sparse = std::min( sparse, convert_sparse( in, out, pages ) );
+    }
+    
+    const double bytes = 2.0 * double( in.size() ) * sizeof(double);
+    const double accesses = 8.0 * double( pages.size() );
+    
+    std::cout << std::setw( 36 ) << std::left << name
+              << std::setw( 8 ) << std::right << std::fixed << std::setprecision( 2 ) 
+              << bytes / best / 1e9 << " GB/s"
+              << std::setw( 10 ) << sparse / accesses * 1e9 << " ns/page" << std::endl;
+}
+
+const char * describe( huge_pages p )
+{
+    switch ( p )
+    {
+    case huge_pages::none: return "regular pages";
+    case huge_pages::transparent: return "transparent huge pages";
+    case huge_pages::reserved: return "reserved huge pages";
+    }
+    
+    return "";
+}
+
+int main( int argc, char ** argv )
+{
+    const std::size_t mib = argc > 1 ? std::strtoul( argv[1], nullptr, 10 ) : 1024;
+    const unsigned threads = argc > 2 ? unsigned( std::strtoul( argv[2], nullptr, 10 ) ) 
+                                      : std::max( 1u, std::thread::hardware_concurrency() );
+    
+    const std::size_t n = mib * 1024 * 1024 / sizeof(double);
+    
+    std::vector<std::size_t> pages( n * sizeof(double) / 4096 );
+    
+    for ( std::size_t i = 0; i < pages.size(); ++i )
+        pages[i] = i;
+    
+    std::shuffle( pages.begin(), pages.end(), std::mt19937( 42 ) );
+    
+    std::cout << "Converting " << mib << " MiB of pascal to bar, " << threads << " threads" << std::endl;
+    
+    {
+        std::vector<pascal_t> in( n, pascal_t( 101325.0 ) );
+        std::vector<bar_t> out( n );
+        
+        run( "std::vector", in, out, threads, pages );
+    }
+    
+    for ( huge_pages p : { huge_pages::none, huge_pages::transparent, huge_pages::reserved } )
+    {
+        large_array<pascal_t> in( n, pascal_t( 101325.0 ), p, threads );
+        large_array<bar_t> out( n, p, threads );
+        
+        run( std::string( "large_array, " ) + describe( in.pages() ), in, out, threads, pages );
+    }
+}
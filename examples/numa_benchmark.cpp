@@ -0,0 +1,113 @@
+/*
+ * Boost Software License - Version 1.0 - August 17th, 2003
+ *
+ * Permission is hereby granted, free of charge, to any person or organization
+ * obtaining a copy of the software and accompanying documentation covered by
+ * this license (the "Software") to use, reproduce, display, distribute,
+ * execute, and transmit the Software, and to prepare derivative works of the
+ * Software, and to permit third-parties to whom the Software is furnished to
+ * do so, all subject to the following:
+ *
+ * The copyright notices in the Software and this entire statement, including
+ * the above license grant, this restriction and the following disclaimer,
+ * must be included in all copies of the Software, in whole or in part, and
+ * all derivative works of the Software, unless such copies or derivative
+ * works are solely in the form of machine-executable object code generated by
+ * a source language processor.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+ * SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+ * FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+// Scaling of a bulk unit conversion with the number of NUMA nodes, with
+// each node working on local memory, and on the memory of the next node.
+//
+// Usage: numa_benchmark [MiB per array]
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+#include <engineering_units/si/pressure.hpp>
+#include <engineering_units/memory/numa.hpp>
+
+namespace si = engunits::si;
+
+using engunits::numa_topology;
+using engunits::numa_executor;
+using engunits::partitioned_array;
+
+using pascal_t = engunits::quantity<double, si::pascal>;
+using hpa_t = engunits::quantity<double, si::hectopascal>;
+
+// The first nodes of the machine, rotated by shift
+numa_topology first_nodes( unsigned count, unsigned shift )
+{
+    const numa_topology & system = numa_topology::system();
+    std::vector<numa_topology::node_info> nodes;
+    
+    for ( unsigned i = 0; i < count; ++i )
+        nodes.push_back( system.node( ( i + shift ) % count ) );
+    
+    return numa_topology( std::move( nodes ) );
+}
+
+// GB/s of the conversion; the arrays are placed by the workers of placement
+double bandwidth( numa_executor & executor, numa_executor & placement, std::size_t n )
+{
+    partitioned_array<pascal_t> in( placement, n, pascal_t( 101325.0 ) );
+    partitioned_array<hpa_t> out( placement, n );
+    
+    double best = 1e9;
+    
+    for ( int i = 0; i < 5; ++i )
+    {
+        const auto start = std::chrono::steady_clock::now();
+        engunits::transform( executor, in, out, []( pascal_t x ) { return hpa_t( x ); } );
+        best = std::min( best, std::chrono::duration<double>( std::chrono::steady_clock::now() - start ).count() );
+    }
+    
+    return 2.0 * double( n ) * sizeof(double) / best / 1e9;
+}
+
+int main( int argc, char ** argv )
+{
+    const std::size_t mib = argc > 1 ? std::strtoul( argv[1], nullptr, 10 ) : 1024;
+    const std::size_t n = mib * 1024 * 1024 / sizeof(double);
+    
+    const numa_topology & system = numa_topology::system();
+    
+    std::cout << "Converting " << mib << " MiB of pascal to hectopascal, " 
+              << system.nodes() << " NUMA nodes" << std::endl;
+    
+    std::cout << std::setw( 6 ) << "nodes" << std::setw( 9 ) << "threads"
+              << std::setw( 14 ) << "local GB/s" << std::setw( 14 ) << "remote GB/s" << std::endl;
+    
+    for ( unsigned nodes = 1; nodes <= system.nodes(); ++nodes )
+    {
+        const unsigned cpus = unsigned( system.node( 0 ).cpus.size() );
+        
+        for ( unsigned threads : { 1u, cpus } )
+        {
+            numa_executor executor( threads, first_nodes( nodes, 0 ) );
+            numa_executor shifted( threads, first_nodes( nodes, 1 ) );
+            
+            std::cout << std::setw( 6 ) << nodes << std::setw( 9 ) << threads * nodes
+                      << std::fixed << std::setprecision( 2 )
+                      << std::setw( 14 ) << bandwidth( executor, executor, n )
+                      << std::setw( 14 ) << bandwidth( executor, shifted, n ) << std::endl;
+            
+            if ( cpus == 1 )
+                break;
+        }
+    }
+}
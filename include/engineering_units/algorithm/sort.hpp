@@ -0,0 +1,624 @@
+/*
+ * Boost Software License - Version 1.0 - August 17th, 2003
+ *
+ * Permission is hereby granted, free of charge, to any person or organization
+ * obtaining a copy of the software and accompanying documentation covered by
+ * this license (the "Software") to use, reproduce, display, distribute,
+ * execute, and transmit the Software, and to prepare derivative works of the
+ * Software, and to permit third-parties to whom the Software is furnished to
+ * do so, all subject to the following:
+ *
+ * The copyright notices in the Software and this entire statement, including
+ * the above license grant, this restriction and the following disclaimer,
+ * must be included in all copies of the Software, in whole or in part, and
+ * all derivative works of the Software, unless such copies or derivative
+ * works are solely in the form of machine-executable object code generated by
+ * a source language processor.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+ * SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+ * FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef ENGINEERING_UNITS_ALGORITHM_SORT_HPP
+#define ENGINEERING_UNITS_ALGORITHM_SORT_HPP
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <engineering_units/quantity.hpp>
+
+#include <engineering_units/detail/allocator.hpp>
+#include <engineering_units/detail/doxygen.hpp>
+#include <engineering_units/detail/scale.hpp>
+
+namespace engunits
+{
+
+namespace detail
+{
+
+template<std::size_t Size>
+struct radix_uint;
+
+template<> struct radix_uint<1> { typedef std::uint8_t type; };
+template<> struct radix_uint<2> { typedef std::uint16_t type; };
+template<> struct radix_uint<4> { typedef std::uint32_t type; };
+template<> struct radix_uint<8> { typedef std::uint64_t type; };
+
+template<class T, class = void>
+struct radix_key
+{
+    static constexpr bool value = false;
+};
+
+// Integers: flipping the sign bit maps the signed order to the unsigned order
+template<class T>
+struct radix_key< T, std::enable_if_t< std::is_integral<T>::value > >
+{
+    static constexpr bool value = true;
+
+    typedef typename radix_uint< sizeof(T) >::type type;
+
+    static constexpr type sign = std::is_signed<T>::value ? type( type(1) << ( 8 * sizeof(T) - 1 ) ) : type(0);
+
+    static type encode( T x ) noexcept
+    {
+        return type( type(x) ^ sign );
+    }
+
+    static T decode( type u ) noexcept
+    {
+        return T( type( u ^ sign ) );
+    }
+};
+
+// IEEE floats: flip all the bits of the negatives, and the sign of the positives.
+// -0 sorts before +0, and NaNs go to either end depending on their sign.
+template<class T>
+struct radix_key< T, std::enable_if_t< std::is_floating_point<T>::value &&
+                                       std::numeric_limits<T>::is_iec559 &&
+                                       ( sizeof(T) == 4 || sizeof(T) == 8 ) > >
+{
+    static constexpr bool value = true;
+
+    typedef typename radix_uint< sizeof(T) >::type type;
+
+    static constexpr type sign = type(1) << ( 8 * sizeof(T) - 1 );
+
+    static type encode( T x ) noexcept
+    {
+        type u;
+        std::memcpy( &u, &x, sizeof(T) );
+        return ( u & sign ) ? type( ~u ) : type( u | sign );
+    }
+
+    static T decode( type u ) noexcept
+    {
+        u = ( u & sign ) ? type( u ^ sign ) : type( ~u );
+
+        T x;
+        std::memcpy( &x, &u, sizeof(T) );
+        return x;
+    }
+};
+
+struct radix_no_payload {};
+
+template<class V>
+void radix_move_payload( V * from, V * to, std::size_t i, std::size_t j )
+{
+    to[j] = std::move( from[i] );
+}
+
+inline void radix_move_payload( radix_no_payload *, radix_no_payload *, std::size_t, std::size_t ) noexcept
+{}
+
+template<class F>
+void radix_parallel( std::size_t n, F f )
+{
+    std::vector< std::thread > threads;
+
+    for ( std::size_t k = 1; k < n; ++k )
+        threads.emplace_back( f, k );
+
+    f( 0 );
+
+    for ( auto & t : threads )
+        t.join();
+}
+
+inline std::size_t radix_threads( std::size_t n, unsigned threads )
+{
+    if ( threads == 0 )
+        threads = std::max( 1u, std::thread::hardware_concurrency() );
+
+    // Not worth a thread for less than 256k elements
+    const std::size_t min_chunk = std::size_t( 1 ) << 18;
+
+    return std::max<std::size_t>( 1, std::min<std::size_t>( threads, n / min_chunk ) );
+}
+
+/**
+ * @internal
+ * @brief LSD radix sort of @p keys, one byte per pass, moving @p values along.
+ *
+ * @p tmp_keys and @p tmp_values are scratch buffers of the same size. The
+ * result is in @p keys and @p values. Passes where all the keys have the
+ * same byte are skipped. With more than one chunk, each thread counts and
+ * scatters its own slice of the array; the offsets of the slices are
+ * interleaved by digit, so the sort stays stable.
+ */
+template<class U, class V, class Allocator>
+void radix_sort( U * keys, U * tmp_keys, V * values, V * tmp_values,
+                 std::size_t n, std::size_t chunks, const Allocator & alloc )
+{
+    typedef std::vector< std::size_t, rebind_alloc_t<Allocator, std::size_t> > size_vector;
+
+    constexpr std::size_t passes = sizeof(U);
+    constexpr std::size_t radix = 256;
+
+    auto begin = [n, chunks]( std::size_t k ) { return n * k / chunks; };
+
+    // Histogram of every byte, to find the passes that can be skipped
+    size_vector global( chunks * passes * radix, 0, alloc );
+
+    radix_parallel( chunks, [&]( std::size_t k )
+    {
+        std::size_t * local = &global[ k * passes * radix ];
+
+        const std::size_t end = begin( k + 1 );
+        for ( std::size_t i = begin( k ); i < end; ++i )
+        {
+            const U u = keys[i];
+
+            for ( std::size_t p = 0; p < passes; ++p )
+                ++local[ p * radix + ( ( u >> ( 8 * p ) ) & 0xff ) ];
+        }
+    } );
+
+    for ( std::size_t k = 1; k < chunks; ++k )
+        for ( std::size_t d = 0; d < passes * radix; ++d )
+            global[d] += global[ k * passes * radix + d ];
+
+    size_vector offsets( chunks * radix, alloc );
+    std::size_t done = 0;
+
+    for ( std::size_t p = 0; p < passes; ++p )
+    {
+        const std::size_t * count = &global[ p * radix ];
+        const unsigned shift = unsigned( 8 * p );
+
+        if ( std::find( count, count + radix, n ) != count + radix )
+            continue;
+
+        if ( chunks == 1 )
+        {
+            std::size_t sum = 0;
+
+            for ( std::size_t d = 0; d < radix; ++d )
+            {
+                offsets[d] = sum;
+                sum += count[d];
+            }
+        }
+        else
+        {
+            radix_parallel( chunks, [&]( std::size_t k )
+            {
+                std::size_t * local = &offsets[ k * radix ];
+                std::fill( local, local + radix, 0 );
+
+                const std::size_t end = begin( k + 1 );
+                for ( std::size_t i = begin( k ); i < end; ++i )
+                    ++local[ ( keys[i] >> shift ) & 0xff ];
+            } );
+
+            std::size_t sum = 0;
+
+            for ( std::size_t d = 0; d < radix; ++d )
+            {
+                for ( std::size_t k = 0; k < chunks; ++k )
+                {
+                    const std::size_t c = offsets[ k * radix + d ];
+                    offsets[ k * radix + d ] = sum;
+                    sum += c;
+                }
+            }
+        }
+
+        radix_parallel( chunks, [&]( std::size_t k )
+        {
+            std::size_t * local = &offsets[ k * radix ];
+
+            const std::size_t end = begin( k + 1 );
+            for ( std::size_t i = begin( k ); i < end; ++i )
+            {
+                const std::size_t j = local[ ( keys[i] >> shift ) & 0xff ]++;
+
+                tmp_keys[j] = keys[i];
+                radix_move_payload( values, tmp_values, i, j );
+            }
+        } );
+
+        std::swap( keys, tmp_keys );
+        std::swap( values, tmp_values );
+        ++done;
+    }
+
+    // An odd number of passes leaves the result in the scratch buffers
+    if ( done % 2 == 1 )
+    {
+        std::copy( keys, keys + n, tmp_keys );
+
+        for ( std::size_t i = 0; i < n; ++i )
+            radix_move_payload( values, tmp_values, i, i );
+    }
+}
+
+template<class It>
+using iterator_value_t = typename std::iterator_traits<It>::value_type;
+
+template<class Q>
+struct less_value
+{
+    bool operator()( const Q & lhs, const Q & rhs ) const
+    {
+        return lhs.value() < rhs.value();
+    }
+};
+
+// Compares the values of a range of Q with a probe P of another unit or
+// value type, without rounding either to the other's type: e is below x
+// when e * num < x * den, where num / den is the factor from the unit of
+// Q to the unit of P.
+template<class Q, class P>
+struct less_across_units
+{
+    bool operator()( const Q & e, const P & x ) const
+    {
+        return e.value() * ratio.numerator() < x.value() * ratio.denominator();
+    }
+    
+    bool operator()( const P & x, const Q & e ) const
+    {
+        return x.value() * ratio.denominator() < e.value() * ratio.numerator();
+    }
+    
+    scale_ratio ratio;
+};
+
+template<class Q, class P>
+less_across_units<Q, P> make_less_across_units( const P & x )
+{
+    return less_across_units<Q, P>{ scale_ratio( conversion_factor( typename Q::unit_type{}, x.unit() ) ) };
+}
+
+template<class ForwardIt, class P>
+ForwardIt lower_bound( ForwardIt first, ForwardIt last, const P & x, std::true_type )
+{
+    return std::lower_bound( first, last, x, less_value<P>{} );
+}
+
+template<class ForwardIt, class P>
+ForwardIt lower_bound( ForwardIt first, ForwardIt last, const P & x, std::false_type )
+{
+    return std::lower_bound( first, last, x, make_less_across_units< iterator_value_t<ForwardIt> >( x ) );
+}
+
+template<class ForwardIt, class P>
+ForwardIt upper_bound( ForwardIt first, ForwardIt last, const P & x, std::true_type )
+{
+    return std::upper_bound( first, last, x, less_value<P>{} );
+}
+
+template<class ForwardIt, class P>
+ForwardIt upper_bound( ForwardIt first, ForwardIt last, const P & x, std::false_type )
+{
+    return std::upper_bound( first, last, x, make_less_across_units< iterator_value_t<ForwardIt> >( x ) );
+}
+
+template<class T, class ... Units, class Allocator>
+void sort_quantities( quantity<T, Units...> * first, quantity<T, Units...> * last,
+                      unsigned threads, const Allocator & alloc, std::true_type )
+{
+    typedef radix_key<T> key;
+    typedef typename key::type U;
+    typedef std::vector< U, rebind_alloc_t<Allocator, U> > key_vector;
+
+    const std::size_t n = std::size_t( last - first );
+
+    if ( n < 2 )
+        return;
+
+    key_vector keys( n, alloc );
+
+    for ( std::size_t i = 0; i < n; ++i )
+        keys[i] = key::encode( first[i].value() );
+
+    // Radix sort does not pay off the counting for small arrays
+    if ( n < 256 )
+    {
+        std::sort( keys.begin(), keys.end() );
+    }
+    else
+    {
+        key_vector tmp( n, alloc );
+        radix_sort( keys.data(), tmp.data(),
+                    static_cast<radix_no_payload*>( nullptr ),
+                    static_cast<radix_no_payload*>( nullptr ),
+                    n, radix_threads( n, threads ), alloc );
+    }
+
+    for ( std::size_t i = 0; i < n; ++i )
+        first[i].value() = key::decode( keys[i] );
+}
+
+template<class T, class ... Units, class Allocator>
+void sort_quantities( quantity<T, Units...> * first, quantity<T, Units...> * last,
+                      unsigned, const Allocator &, std::false_type )
+{
+    std::stable_sort( first, last, less_value< quantity<T, Units...> >{} );
+}
+
+template<class T, class ... Units, class RandomIt, class Allocator>
+void sort_quantities_by_key( quantity<T, Units...> * first, quantity<T, Units...> * last,
+                             RandomIt values, unsigned threads, const Allocator & alloc, std::true_type )
+{
+    typedef radix_key<T> key;
+    typedef typename key::type U;
+    typedef iterator_value_t<RandomIt> V;
+    typedef std::vector< U, rebind_alloc_t<Allocator, U> > key_vector;
+    typedef std::vector< V, rebind_alloc_t<Allocator, V> > value_vector;
+
+    const std::size_t n = std::size_t( last - first );
+
+    if ( n < 2 )
+        return;
+
+    key_vector keys( n, alloc ), tmp_keys( n, alloc );
+
+    for ( std::size_t i = 0; i < n; ++i )
+        keys[i] = key::encode( first[i].value() );
+
+    value_vector vals( std::make_move_iterator( values ), std::make_move_iterator( values + n ), alloc );
+    value_vector tmp_vals( n, alloc );
+
+    radix_sort( keys.data(), tmp_keys.data(), vals.data(), tmp_vals.data(),
+                n, radix_threads( n, threads ), alloc );
+
+    for ( std::size_t i = 0; i < n; ++i )
+        first[i].value() = key::decode( keys[i] );
+
+    std::move( vals.begin(), vals.end(), values );
+}
+
+template<class T, class ... Units, class RandomIt, class Allocator>
+void sort_quantities_by_key( quantity<T, Units...> * first, quantity<T, Units...> * last,
+                             RandomIt values, unsigned, const Allocator & alloc, std::false_type )
+{
+    typedef quantity<T, Units...> Q;
+    typedef iterator_value_t<RandomIt> V;
+
+    const std::size_t n = std::size_t( last - first );
+
+    std::vector< std::size_t, rebind_alloc_t<Allocator, std::size_t> > order( n, alloc );
+
+    for ( std::size_t i = 0; i < n; ++i )
+        order[i] = i;
+
+    std::stable_sort( order.begin(), order.end(), [first]( std::size_t i, std::size_t j )
+    {
+        return first[i].value() < first[j].value();
+    } );
+
+    std::vector< Q, rebind_alloc_t<Allocator, Q> > keys( std::make_move_iterator( first ), std::make_move_iterator( last ), alloc );
+    std::vector< V, rebind_alloc_t<Allocator, V> > vals( std::make_move_iterator( values ), std::make_move_iterator( values + n ), alloc );
+
+    for ( std::size_t i = 0; i < n; ++i )
+    {
+        first[i] = std::move( keys[ order[i] ] );
+        values[i] = std::move( vals[ order[i] ] );
+    }
+}
+
+}
+
+/**
+ * @addtogroup algorithms
+ * @{
+ */
+
+/**
+ * @brief Sort a contiguous array of quantities in ascending order.
+ * @param threads Number of threads for large arrays, all the hardware threads if 0.
+ *
+ * Quantities of integers and IEEE floats are sorted with an LSD radix sort
+ * on their bit pattern, one byte per pass, skipping the bytes that are the
+ * same in all the elements. Floats are sorted by their total order: -0
+ * comes before +0, negative NaNs first and positive NaNs last. Other value
+ * types fall back to `std::stable_sort`.
+ *
+ * The sort is always stable.
+ *
+ * @note The arguments are pointers, not iterators, so that an unqualified call
+ *  with the iterators of a `std::vector` of quantities does not clash with
+ *  `std::sort` found by ADL. Use the range overload for containers.
+ */
+template<class T, class ... Units>
+void sort( quantity<T, Units...> * first, quantity<T, Units...> * last, unsigned threads = 0 )
+{
+    detail::sort_quantities( first, last, threads, std::allocator<char>(),
+                             std::integral_constant< bool, detail::radix_key<T>::value >{} );
+}
+
+/**
+ * @brief Sort a contiguous array of quantities, taking the scratch memory from @p alloc.
+ * @param alloc Any allocator, rebound to the types of the scratch buffers,
+ *  e.g. an @c arena_allocator or a `std::pmr::polymorphic_allocator`.
+ *
+ * The scratch memory of the radix sort, twice the size of the array plus
+ * the digit counts, comes from @p alloc. With more than one thread the
+ * threads themselves still allocate; the fallback to `std::stable_sort`
+ * for other value types allocates from the heap.
+ */
+template<class T, class ... Units, class Allocator,
+         ENGUNITS_ENABLE_IF( detail::is_allocator_v<Allocator> )>
+void sort( quantity<T, Units...> * first, quantity<T, Units...> * last,
+           const Allocator & alloc, unsigned threads = 0 )
+{
+    detail::sort_quantities( first, last, threads, alloc,
+                             std::integral_constant< bool, detail::radix_key<T>::value >{} );
+}
+
+/**
+ * @brief Sort a contiguous range of quantities, such as a `std::vector` or `std::array`
+ */
+template<class Range,
+         ENGUNITS_ENABLE_IF(( detail::is_quantity_v< std::decay_t< decltype( *std::declval<Range &>().data() ) > > ))>
+void sort( Range & range, unsigned threads = 0 )
+{
+    engunits::sort( range.data(), range.data() + range.size(), threads );
+}
+
+template<class Range, class Allocator,
+         ENGUNITS_ENABLE_IF(( detail::is_quantity_v< std::decay_t< decltype( *std::declval<Range &>().data() ) > > &&
+                              detail::is_allocator_v<Allocator> ))>
+void sort( Range & range, const Allocator & alloc, unsigned threads = 0 )
+{
+    engunits::sort( range.data(), range.data() + range.size(), alloc, threads );
+}
+
+/**
+ * @brief Same as @c sort, which is already stable
+ */
+template<class T, class ... Units>
+void stable_sort( quantity<T, Units...> * first, quantity<T, Units...> * last, unsigned threads = 0 )
+{
+    engunits::sort( first, last, threads );
+}
+
+template<class T, class ... Units, class Allocator,
+         ENGUNITS_ENABLE_IF( detail::is_allocator_v<Allocator> )>
+void stable_sort( quantity<T, Units...> * first, quantity<T, Units...> * last,
+                  const Allocator & alloc, unsigned threads = 0 )
+{
+    engunits::sort( first, last, alloc, threads );
+}
+
+template<class Range,
+         ENGUNITS_ENABLE_IF(( detail::is_quantity_v< std::decay_t< decltype( *std::declval<Range &>().data() ) > > ))>
+void stable_sort( Range & range, unsigned threads = 0 )
+{
+    engunits::sort( range.data(), range.data() + range.size(), threads );
+}
+
+template<class Range, class Allocator,
+         ENGUNITS_ENABLE_IF(( detail::is_quantity_v< std::decay_t< decltype( *std::declval<Range &>().data() ) > > &&
+                              detail::is_allocator_v<Allocator> ))>
+void stable_sort( Range & range, const Allocator & alloc, unsigned threads = 0 )
+{
+    engunits::sort( range.data(), range.data() + range.size(), alloc, threads );
+}
+
+/**
+ * @brief Sort a contiguous array of quantities, and reorder another array along.
+ * @param first,last The keys
+ * @param values The first of `last - first` values, moved to the position of
+ *  their key. @c V must be default constructible and move assignable.
+ * @param threads Number of threads for large arrays, all the hardware threads if 0.
+ *
+ * The order of the keys is the same of @c sort, and equal keys keep the
+ * relative order of their values.
+ */
+template<class T, class ... Units, class RandomIt>
+void sort_by_key( quantity<T, Units...> * first, quantity<T, Units...> * last,
+                  RandomIt values, unsigned threads = 0 )
+{
+    detail::sort_quantities_by_key( first, last, values, threads, std::allocator<char>(),
+                                    std::integral_constant< bool, detail::radix_key<T>::value >{} );
+}
+
+/**
+ * @brief Same as @c sort_by_key, taking the scratch memory from @p alloc
+ * @sa sort
+ */
+template<class T, class ... Units, class RandomIt, class Allocator,
+         ENGUNITS_ENABLE_IF( detail::is_allocator_v<Allocator> )>
+void sort_by_key( quantity<T, Units...> * first, quantity<T, Units...> * last,
+                  RandomIt values, const Allocator & alloc, unsigned threads = 0 )
+{
+    detail::sort_quantities_by_key( first, last, values, threads, alloc,
+                                    std::integral_constant< bool, detail::radix_key<T>::value >{} );
+}
+
+/**
+ * @brief Sort two contiguous ranges of the same size, the first holding the keys
+ */
+template<class KeyRange, class ValueRange,
+         ENGUNITS_ENABLE_IF(( detail::is_quantity_v< std::decay_t< decltype( *std::declval<KeyRange &>().data() ) > > ))>
+void sort_by_key( KeyRange & keys, ValueRange & values, unsigned threads = 0 )
+{
+    assert( keys.size() == values.size() );
+    engunits::sort_by_key( keys.data(), keys.data() + keys.size(), values.begin(), threads );
+}
+
+template<class KeyRange, class ValueRange, class Allocator,
+         ENGUNITS_ENABLE_IF(( detail::is_quantity_v< std::decay_t< decltype( *std::declval<KeyRange &>().data() ) > > &&
+                              detail::is_allocator_v<Allocator> ))>
+void sort_by_key( KeyRange & keys, ValueRange & values, const Allocator & alloc, unsigned threads = 0 )
+{
+    assert( keys.size() == values.size() );
+    engunits::sort_by_key( keys.data(), keys.data() + keys.size(), values.begin(), alloc, threads );
+}
+
+/**
+ * @brief First element of the sorted range [ @p first, @p last ) not less than @p x
+ *
+ * @p x can have any unit convertible to the unit of the range, and any
+ * value type. If both match the range, the search compares the underlying
+ * values; otherwise each element is compared with @p x in @c long double,
+ * scaled by the conversion factor, so that neither side is truncated or
+ * rounded to the other's type: 1500 mm is above 1 m even in a range of 
+ * `quantity<int, si::meter>`.
+ */
+template<class ForwardIt, class U, class ... Units>
+ForwardIt lower_bound( ForwardIt first, ForwardIt last, const quantity<U, Units...> & x )
+{
+    typedef detail::iterator_value_t<ForwardIt> Q;
+
+    return detail::lower_bound( first, last, x, std::is_same< Q, quantity<U, Units...> >{} );
+}
+
+/**
+ * @brief First element of the sorted range [ @p first, @p last ) greater than @p x
+ *
+ * @sa lower_bound
+ */
+template<class ForwardIt, class U, class ... Units>
+ForwardIt upper_bound( ForwardIt first, ForwardIt last, const quantity<U, Units...> & x )
+{
+    typedef detail::iterator_value_t<ForwardIt> Q;
+
+    return detail::upper_bound( first, last, x, std::is_same< Q, quantity<U, Units...> >{} );
+}
+
+/** @} */
+
+}
+
+#endif //ENGINEERING_UNITS_ALGORITHM_SORT_HPP
@@ -0,0 +1,238 @@
+/*
+ * Boost Software License - Version 1.0 - August 17th, 2003
+ *
+ * Permission is hereby granted, free of charge, to any person or organization
+ * obtaining a copy of the software and accompanying documentation covered by
+ * this license (the "Software") to use, reproduce, display, distribute,
+ * execute, and transmit the Software, and to prepare derivative works of the
+ * Software, and to permit third-parties to whom the Software is furnished to
+ * do so, all subject to the following:
+ *
+ * The copyright notices in the Software and this entire statement, including
+ * the above license grant, this restriction and the following disclaimer,
+ * must be included in all copies of the Software, in whole or in part, and
+ * all derivative works of the Software, unless such copies or derivative
+ * works are solely in the form of machine-executable object code generated by
+ * a source language processor.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+ * SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+ * FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef ENGINEERING_UNITS_CHRONO_HPP
+#define ENGINEERING_UNITS_CHRONO_HPP
+
+#include <chrono>
+#include <ratio>
+#include <type_traits>
+#include <utility>
+
+#include <engineering_units/quantity.hpp>
+#include <engineering_units/time.hpp>
+
+#include <engineering_units/detail/doxygen.hpp>
+#include <engineering_units/detail/void_t.hpp>
+
+/**
+ * @file chrono.hpp
+ * @brief Conversions between time quantities and `std::chrono::duration`
+ * 
+ * A quantity of a time unit with an exact period (@c second, @c millisecond,
+ * @c microsecond, @c nanosecond, @c decisecond, @c centisecond, @c minute, 
+ * @c hour) converts to and from any `std::chrono::duration`. The conversion
+ * follows the rules of `std::chrono`: it is implicit if it does not lose 
+ * precision, explicit otherwise, and it is computed with `std::ratio` 
+ * arithmetic, so durations of integers are converted with integer 
+ * operations only.
+ * 
+ * @code{.cpp}
+ *   quantity<std::int64_t, millisecond> timeout = std::chrono::seconds( 2 );  // 2000 ms
+ *   std::chrono::microseconds us = timeout;                                   // 2000000 us
+ * 
+ *   // Truncates, explicit
+ *   std::chrono::seconds s( quantity<std::int64_t, millisecond>( 1500 ) );   // 1 s
+ * @endcode
+ */
+
+namespace engunits
+{
+
+namespace detail
+{
+
+/**
+ * @internal
+ * @brief The `std::ratio` of seconds of a time unit, if it is exact
+ */
+template<class Unit>
+struct chrono_period {};
+
+template<> struct chrono_period< second >      { typedef std::ratio<1> type; };
+template<> struct chrono_period< decisecond >  { typedef std::deci type; };
+template<> struct chrono_period< centisecond > { typedef std::centi type; };
+template<> struct chrono_period< millisecond > { typedef std::milli type; };
+template<> struct chrono_period< microsecond > { typedef std::micro type; };
+template<> struct chrono_period< nanosecond >  { typedef std::nano type; };
+template<> struct chrono_period< minute >      { typedef std::ratio<60> type; };
+template<> struct chrono_period< hour >        { typedef std::ratio<3600> type; };
+
+/**
+ * @internal
+ * @brief The time unit of a `std::ratio` of seconds
+ */
+template<class Period>
+struct chrono_unit {};
+
+template<> struct chrono_unit< std::ratio<1> >    { typedef second type; };
+template<> struct chrono_unit< std::deci >        { typedef decisecond type; };
+template<> struct chrono_unit< std::centi >       { typedef centisecond type; };
+template<> struct chrono_unit< std::milli >       { typedef millisecond type; };
+template<> struct chrono_unit< std::micro >       { typedef microsecond type; };
+template<> struct chrono_unit< std::nano >        { typedef nanosecond type; };
+template<> struct chrono_unit< std::ratio<60> >   { typedef minute type; };
+template<> struct chrono_unit< std::ratio<3600> > { typedef hour type; };
+
+template<class T, class ... Units, class Rep, class Period>
+struct quantity_interop< quantity<T, Units...>, 
+                         std::chrono::duration<Rep, Period>,
+                         void_t< typename chrono_period< unit_type_t<Units...> >::type > >
+{
+    typedef quantity<T, Units...> quantity_type;
+    typedef std::chrono::duration<Rep, Period> duration_type;
+    
+    // The duration with the same representation of the quantity
+    typedef std::chrono::duration<T, typename chrono_period< unit_type_t<Units...> >::type> native_type;
+    
+    static constexpr bool value = true;
+    static constexpr bool implicit_from = std::is_convertible<duration_type, native_type>::value;
+    static constexpr bool implicit_to = std::is_convertible<native_type, duration_type>::value;
+    
+    static constexpr quantity_type from( const duration_type & d )
+    {
+        return quantity_type( std::chrono::duration_cast<native_type>( d ).count() );
+    }
+    
+    static constexpr duration_type to( const quantity_type & q )
+    {
+        return std::chrono::duration_cast<duration_type>( native_type( q.value() ) );
+    }
+};
+
+}
+
+/**
+ * @addtogroup operators
+ * @{
+ */
+
+/**
+ * @brief The quantity with the same representation and period of a duration
+ * 
+ * @code{.cpp}
+ *   auto q = to_quantity( std::chrono::milliseconds( 5 ) ); // quantity<std::int64_t, millisecond>
+ * @endcode
+ */
+template<class Rep, class Period>
+constexpr auto to_quantity( const std::chrono::duration<Rep, Period> & d )
+{
+    return quantity< Rep, typename detail::chrono_unit< typename Period::type >::type >( d.count() );
+}
+
+/**
+ * @brief The duration with the same representation and period of a time quantity
+ */
+template<class T, class Unit>
+constexpr auto to_duration( const quantity<T, Unit> & q )
+{
+    return std::chrono::duration< T, typename detail::chrono_period<Unit>::type >( q.value() );
+}
+
+/** @} */
+
+/**
+ * @brief Measure elapsed times with a @p Clock, as quantities
+ * @tparam Clock A clock with a period that has a time unit, such as `std::chrono::steady_clock`
+ * 
+ * @code{.cpp}
+ *   stopwatch w;
+ *   
+ *   process( batch );
+ *   
+ *   quantity<double, microsecond> latency( w.lap() );
+ * @endcode
+ * 
+ * @sa measure_latency
+ */
+template<class Clock = std::chrono::steady_clock>
+class basic_stopwatch
+{
+public:
+    typedef Clock clock;
+    
+    /**
+     * @brief The quantity of the representation and period of @p Clock
+     */
+    typedef quantity< typename Clock::rep, 
+                      typename detail::chrono_unit< typename Clock::period::type >::type > duration;
+    
+    /**
+     * @brief Start measuring
+     */
+    basic_stopwatch() :
+        start_( Clock::now() )
+    {}
+    
+    /**
+     * @brief Time since construction or the last @c reset or @c lap
+     */
+    duration elapsed() const
+    {
+        return Clock::now() - start_;
+    }
+    
+    /**
+     * @brief Restart measuring from now
+     */
+    void reset()
+    {
+        start_ = Clock::now();
+    }
+    
+    /**
+     * @brief Same as @c elapsed followed by @c reset, with a single reading of the clock
+     */
+    duration lap()
+    {
+        const typename Clock::time_point now = Clock::now();
+        const duration result = now - start_;
+        
+        start_ = now;
+        return result;
+    }
+    
+private:
+    typename Clock::time_point start_;
+};
+
+typedef basic_stopwatch<> stopwatch;
+
+/**
+ * @brief Call @p f and measure how long it takes
+ * @return The elapsed time, a @c quantity in the period of `std::chrono::steady_clock`.
+ */
+template<class F, class ... Args>
+stopwatch::duration measure_latency( F && f, Args && ... args )
+{
+    stopwatch w;
+    std::forward<F>(f)( std::forward<Args>(args)... );
+    return w.elapsed();
+}
+
+}
+
+#endif //ENGINEERING_UNITS_CHRONO_HPP
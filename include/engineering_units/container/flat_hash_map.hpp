@@ -0,0 +1,549 @@
+/*
+ * Boost Software License - Version 1.0 - August 17th, 2003
+ *
+ * Permission is hereby granted, free of charge, to any person or organization
+ * obtaining a copy of the software and accompanying documentation covered by
+ * this license (the "Software") to use, reproduce, display, distribute,
+ * execute, and transmit the Software, and to prepare derivative works of the
+ * Software, and to permit third-parties to whom the Software is furnished to
+ * do so, all subject to the following:
+ *
+ * The copyright notices in the Software and this entire statement, including
+ * the above license grant, this restriction and the following disclaimer,
+ * must be included in all copies of the Software, in whole or in part, and
+ * all derivative works of the Software, unless such copies or derivative
+ * works are solely in the form of machine-executable object code generated by
+ * a source language processor.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+ * SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+ * FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef ENGINEERING_UNITS_CONTAINER_FLAT_HASH_MAP_HPP
+#define ENGINEERING_UNITS_CONTAINER_FLAT_HASH_MAP_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <engineering_units/hash.hpp>
+
+#include <engineering_units/detail/allocator.hpp>
+#include <engineering_units/detail/doxygen.hpp>
+
+namespace engunits
+{
+
+/**
+ * @addtogroup containers
+ * @{
+ */
+
+/**
+ * @brief Hash map with open addressing, for small keys such as quantities.
+ * @tparam Key The type of the keys, usually a quantity of an integral type
+ * @tparam T The type of the mapped values
+ * @tparam Hash A hash function for @p Key
+ * @tparam KeyEqual An equality predicate for @p Key
+ * @tparam Allocator The allocator of the slots, e.g. an @c arena_allocator or a
+ *  `std::pmr::polymorphic_allocator`; it is rebound for the array of flags.
+ *
+ * The elements are stored in a single array, and collisions are resolved
+ * by linear probing, so that a lookup touches one or two cache lines and
+ * no node is allocated per element. A separate array of flags marks the
+ * occupied slots.
+ *
+ * The result of @p Hash is scrambled with a multiplicative hash, so that
+ * `std::hash` of integers, which is the identity, spreads the keys of a
+ * regular grid over the whole table.
+ *
+ * Unlike `std::unordered_map`:
+ *  - @p Key and @p T must be default constructible;
+ *  - any insertion or erasure invalidates iterators and references;
+ *  - the key of an element must not be modified through an iterator.
+ *
+ * @code{.cpp}
+ *   using mm = quantity<std::int64_t, si::millimeter>;
+ *
+ *   flat_hash_map< mm, std::size_t > cells;
+ *
+ *   for ( auto x : positions )
+ *       ++cells[ quantize<mm>( x, mm(10) ) ];
+ * @endcode
+ */
+template<class Key,
+         class T,
+         class Hash = std::hash<Key>,
+         class KeyEqual = std::equal_to<Key>,
+         class Allocator = std::allocator< std::pair<Key, T> > >
+class flat_hash_map
+{
+    template<bool Const>
+    class basic_iterator;
+
+public:
+    typedef Key key_type;
+    typedef T mapped_type;
+    typedef std::pair<Key, T> value_type;
+    typedef std::size_t size_type;
+    typedef Hash hasher;
+    typedef KeyEqual key_equal;
+    typedef Allocator allocator_type;
+    typedef basic_iterator<false> iterator;
+    typedef basic_iterator<true> const_iterator;
+
+    /**
+     * @brief Construct an empty map
+     * @param capacity Number of elements that can be inserted without a rehash
+     */
+    explicit flat_hash_map( size_type capacity = 0,
+                            const Hash & hash = Hash(),
+                            const KeyEqual & equal = KeyEqual(),
+                            const Allocator & alloc = Allocator() ) :
+        slots_( alloc ),
+        used_( alloc ),
+        hash_( hash ),
+        equal_( equal )
+    {
+        reserve( capacity );
+    }
+
+    /**
+     * @brief Construct an empty map that allocates from @p alloc
+     */
+    explicit flat_hash_map( const Allocator & alloc ) :
+        flat_hash_map( 0, Hash(), KeyEqual(), alloc )
+    {}
+
+    allocator_type get_allocator() const
+    {
+        return slots_.get_allocator();
+    }
+
+    iterator begin() noexcept { return iterator( this, first_used() ); }
+    iterator end() noexcept { return iterator( this, slots_.size() ); }
+    const_iterator begin() const noexcept { return const_iterator( this, first_used() ); }
+    const_iterator end() const noexcept { return const_iterator( this, slots_.size() ); }
+    const_iterator cbegin() const noexcept { return begin(); }
+    const_iterator cend() const noexcept { return end(); }
+
+    size_type size() const noexcept
+    {
+        return size_;
+    }
+
+    bool empty() const noexcept
+    {
+        return size_ == 0;
+    }
+
+    /**
+     * @brief Number of slots, a power of two
+     */
+    size_type bucket_count() const noexcept
+    {
+        return slots_.size();
+    }
+
+    /**
+     * @brief Fraction of the slots in use, kept below 3/4
+     */
+    double load_factor() const noexcept
+    {
+        return slots_.empty() ? 0.0 : double( size_ ) / double( slots_.size() );
+    }
+
+    /**
+     * @brief Make room for @p n elements without further rehash
+     */
+    void reserve( size_type n )
+    {
+        const size_type capacity = capacity_for( n );
+
+        if ( capacity > slots_.size() )
+            resize( capacity );
+    }
+
+    /**
+     * @brief Remove all the elements, keeping the memory
+     */
+    void clear()
+    {
+        for ( size_type i = 0; i < slots_.size(); ++i )
+        {
+            if ( used_[i] )
+            {
+                slots_[i] = value_type();
+                used_[i] = 0;
+            }
+        }
+
+        size_ = 0;
+    }
+
+    /**
+     * @brief Insert a value constructed from @p args, if @p key is not in the map
+     * @return An iterator to the element with key @p key, and true if it was inserted.
+     */
+    template<class ... Args>
+    std::pair<iterator, bool> try_emplace( const Key & key, Args && ... args )
+    {
+        grow_if_full();
+
+        const std::pair<size_type, bool> slot = probe( key );
+
+        if ( !slot.second )
+        {
+            slots_[slot.first].first = key;
+            slots_[slot.first].second = T( std::forward<Args>(args)... );
+            used_[slot.first] = 1;
+            ++size_;
+        }
+
+        return { iterator( this, slot.first ), !slot.second };
+    }
+
+    /**
+     * @brief Insert @p value, if its key is not in the map
+     */
+    std::pair<iterator, bool> insert( const value_type & value )
+    {
+        return try_emplace( value.first, value.second );
+    }
+
+    std::pair<iterator, bool> insert( value_type && value )
+    {
+        return try_emplace( value.first, std::move( value.second ) );
+    }
+
+    /**
+     * @brief The value mapped to @p key, inserted with its default value if not found
+     */
+    T & operator[]( const Key & key )
+    {
+        return try_emplace( key ).first->second;
+    }
+
+    /**
+     * @brief The value mapped to @p key
+     * @throw std::out_of_range if @p key is not in the map
+     */
+    T & at( const Key & key )
+    {
+        const iterator it = find( key );
+
+        if ( it == end() )
+            throw std::out_of_range( "flat_hash_map: key not found" );
+
+        return it->second;
+    }
+
+    const T & at( const Key & key ) const
+    {
+        const const_iterator it = find( key );
+
+        if ( it == end() )
+            throw std::out_of_range( "flat_hash_map: key not found" );
+
+        return it->second;
+    }
+
+    iterator find( const Key & key )
+    {
+        const std::pair<size_type, bool> slot = lookup( key );
+        return iterator( this, slot.second ? slot.first : slots_.size() );
+    }
+
+    const_iterator find( const Key & key ) const
+    {
+        const std::pair<size_type, bool> slot = lookup( key );
+        return const_iterator( this, slot.second ? slot.first : slots_.size() );
+    }
+
+    size_type count( const Key & key ) const
+    {
+        return lookup( key ).second ? 1 : 0;
+    }
+
+    bool contains( const Key & key ) const
+    {
+        return lookup( key ).second;
+    }
+
+    /**
+     * @brief Remove the element with key @p key
+     * @return The number of removed elements, 0 or 1.
+     *
+     * The elements that follow in the same run of occupied slots are shifted
+     * back, so that no tombstone is left and lookups stay short.
+     */
+    size_type erase( const Key & key )
+    {
+        const std::pair<size_type, bool> slot = lookup( key );
+
+        if ( !slot.second )
+            return 0;
+
+        size_type hole = slot.first;
+        size_type j = hole;
+
+        for ( ;; )
+        {
+            j = ( j + 1 ) & mask();
+
+            if ( !used_[j] )
+                break;
+
+            const size_type home = bucket( slots_[j].first );
+
+            // The element in j can fill the hole if the hole is not before its home slot
+            if ( ( ( j - home ) & mask() ) >= ( ( j - hole ) & mask() ) )
+            {
+                slots_[hole] = std::move( slots_[j] );
+                hole = j;
+            }
+        }
+
+        slots_[hole] = value_type();
+        used_[hole] = 0;
+        --size_;
+
+        return 1;
+    }
+
+    /**
+     * @brief Change the number of slots to at least @p n
+     * 
+     * The number of slots is rounded up to a power of two, and to the 
+     * minimum that @c reserve would choose for @c size() elements, so the 
+     * map can also shrink.
+     */
+    void rehash( size_type n )
+    {
+        size_type capacity = capacity_for( size_ );
+
+        while ( capacity < n )
+            capacity *= 2;
+
+        resize( capacity );
+    }
+
+private:
+    typedef std::vector<value_type, Allocator> slot_vector;
+    typedef std::vector<std::uint8_t, detail::rebind_alloc_t<Allocator, std::uint8_t> > flag_vector;
+
+    static constexpr size_type min_capacity = 16;
+
+    // Smallest power of two number of slots that holds n elements below the maximum load
+    static size_type capacity_for( size_type n ) noexcept
+    {
+        size_type capacity = min_capacity;
+
+        while ( capacity - capacity / 4 < n )
+            capacity *= 2;
+
+        return capacity;
+    }
+
+    // Move the elements to capacity slots, a power of two not less than size()
+    void resize( size_type capacity )
+    {
+        slot_vector slots( capacity, slots_.get_allocator() );
+        flag_vector used( capacity, 0, used_.get_allocator() );
+
+        slots.swap( slots_ );
+        used.swap( used_ );
+
+        shift_ = 64;
+
+        for ( size_type c = capacity; c > 1; c /= 2 )
+            --shift_;
+
+        for ( size_type i = 0; i < slots.size(); ++i )
+        {
+            if ( used[i] )
+            {
+                size_type k = bucket( slots[i].first );
+
+                while ( used_[k] )
+                    k = ( k + 1 ) & mask();
+
+                slots_[k] = std::move( slots[i] );
+                used_[k] = 1;
+            }
+        }
+    }
+
+    size_type mask() const noexcept
+    {
+        return slots_.size() - 1;
+    }
+
+    // Fibonacci hashing: the top bits of the product depend on all the bits of the hash
+    size_type bucket( const Key & key ) const
+    {
+        const std::uint64_t h = static_cast<std::uint64_t>( hash_( key ) );
+        return size_type( ( h * 0x9e3779b97f4a7c15ull ) >> shift_ );
+    }
+
+    // Slot of key, and whether it was found
+    std::pair<size_type, bool> lookup( const Key & key ) const
+    {
+        if ( size_ == 0 )
+            return { 0, false };
+
+        return probe( key );
+    }
+
+    // Slot of key if found, or the free slot where it belongs
+    std::pair<size_type, bool> probe( const Key & key ) const
+    {
+        size_type i = bucket( key );
+
+        while ( used_[i] )
+        {
+            if ( equal_( slots_[i].first, key ) )
+                return { i, true };
+
+            i = ( i + 1 ) & mask();
+        }
+
+        return { i, false };
+    }
+
+    void grow_if_full()
+    {
+        if ( slots_.empty() )
+            resize( min_capacity );
+        else if ( size_ + 1 > slots_.size() - slots_.size() / 4 )
+            resize( slots_.size() * 2 );
+    }
+
+    size_type first_used() const noexcept
+    {
+        size_type i = 0;
+
+        while ( i < slots_.size() && !used_[i] )
+            ++i;
+
+        return i;
+    }
+
+    slot_vector slots_;
+    flag_vector used_;
+    size_type size_ = 0;
+    unsigned shift_ = 64;
+
+    Hash hash_;
+    KeyEqual equal_;
+};
+
+template<class Key, class T, class Hash, class KeyEqual, class Allocator>
+template<bool Const>
+class flat_hash_map<Key, T, Hash, KeyEqual, Allocator>::basic_iterator
+{
+    typedef std::conditional_t<Const, const flat_hash_map, flat_hash_map> map_type;
+
+public:
+    typedef std::forward_iterator_tag iterator_category;
+    typedef typename flat_hash_map::value_type value_type;
+    typedef std::ptrdiff_t difference_type;
+    typedef std::conditional_t<Const, const value_type, value_type> & reference;
+    typedef std::conditional_t<Const, const value_type, value_type> * pointer;
+
+    basic_iterator() = default;
+
+    /**
+     * @brief Conversion from iterator to const_iterator
+     */
+    template<bool OtherConst, ENGUNITS_ENABLE_IF( Const && !OtherConst )>
+    basic_iterator( const basic_iterator<OtherConst> & other ) noexcept :
+        map_( other.map_ ),
+        i_( other.i_ )
+    {}
+
+    reference operator*() const
+    {
+        return map_->slots_[i_];
+    }
+
+    pointer operator->() const
+    {
+        return &map_->slots_[i_];
+    }
+
+    basic_iterator & operator++()
+    {
+        do
+        {
+            ++i_;
+        }
+        while ( i_ < map_->slots_.size() && !map_->used_[i_] );
+
+        return *this;
+    }
+
+    basic_iterator operator++(int)
+    {
+        basic_iterator result = *this;
+        ++*this;
+        return result;
+    }
+
+    friend bool operator==( const basic_iterator & lhs, const basic_iterator & rhs ) noexcept
+    {
+        return lhs.i_ == rhs.i_;
+    }
+
+    friend bool operator!=( const basic_iterator & lhs, const basic_iterator & rhs ) noexcept
+    {
+        return lhs.i_ != rhs.i_;
+    }
+
+private:
+    friend class flat_hash_map;
+    friend class basic_iterator<!Const>;
+
+    basic_iterator( map_type * map, std::size_t i ) noexcept :
+        map_( map ),
+        i_( i )
+    {}
+
+    map_type * map_ = nullptr;
+    std::size_t i_ = 0;
+};
+
+#if defined(ENGUNITS_HAS_MEMORY_RESOURCE)
+
+namespace pmr
+{
+
+/**
+ * @brief A @c flat_hash_map that allocates from a `std::pmr::memory_resource`
+ */
+template<class Key,
+         class T,
+         class Hash = std::hash<Key>,
+         class KeyEqual = std::equal_to<Key> >
+using flat_hash_map = engunits::flat_hash_map< Key, T, Hash, KeyEqual,
+                                               std::pmr::polymorphic_allocator< std::pair<Key, T> > >;
+
+}
+
+#endif
+
+/** @} */
+
+}
+
+#endif //ENGINEERING_UNITS_CONTAINER_FLAT_HASH_MAP_HPP
@@ -0,0 +1,608 @@
+/*
+ * Boost Software License - Version 1.0 - August 17th, 2003
+ *
+ * Permission is hereby granted, free of charge, to any person or organization
+ * obtaining a copy of the software and accompanying documentation covered by
+ * this license (the "Software") to use, reproduce, display, distribute,
+ * execute, and transmit the Software, and to prepare derivative works of the
+ * Software, and to permit third-parties to whom the Software is furnished to
+ * do so, all subject to the following:
+ *
+ * The copyright notices in the Software and this entire statement, including
+ * the above license grant, this restriction and the following disclaimer,
+ * must be included in all copies of the Software, in whole or in part, and
+ * all derivative works of the Software, unless such copies or derivative
+ * works are solely in the form of machine-executable object code generated by
+ * a source language processor.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+ * SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+ * FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef ENGINEERING_UNITS_CONTAINER_RING_BUFFER_HPP
+#define ENGINEERING_UNITS_CONTAINER_RING_BUFFER_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define ENGUNITS_HAS_SHARED_MEMORY 1
+#endif
+
+#include <engineering_units/quantity.hpp>
+#include <engineering_units/unit/symbol.hpp>
+
+#include <engineering_units/detail/cache_line.hpp>
+#include <engineering_units/detail/doxygen.hpp>
+
+namespace engunits
+{
+
+namespace detail
+{
+
+/**
+ * @internal
+ * @brief Control block at the beginning of a ring buffer.
+ * 
+ * The layout is fixed, so that it can be placed in shared memory and 
+ * inspected by another process. Each index lives on its own cache line.
+ */
+struct ring_buffer_header
+{
+    static constexpr std::uint64_t magic_number = 0x474e495255474e45ull; // "ENGURING"
+    static constexpr std::uint32_t current_version = 2;
+    static constexpr std::size_t symbol_capacity = 128;
+    
+    std::uint64_t magic;
+    std::uint32_t version;
+    std::uint32_t value_size;
+    std::uint64_t capacity;
+    std::uint64_t multi_producer;
+    char symbol[symbol_capacity];
+    
+    // Next slot to be read, written by the consumer
+    alignas(cache_line_size) std::atomic<std::uint64_t> read;
+    
+    // Next slot to be published. With multiple producers, end of the
+    // published slots that the consumer has found so far.
+    alignas(cache_line_size) std::atomic<std::uint64_t> write;
+    
+    // Next slot to be claimed, only used with multiple producers
+    alignas(cache_line_size) std::atomic<std::uint64_t> reserve;
+};
+
+static_assert( sizeof(ring_buffer_header) % cache_line_size == 0, "" );
+
+constexpr bool is_power_of_two( std::uint64_t x )
+{
+    return x != 0 && ( x & ( x - 1 ) ) == 0;
+}
+
+}
+
+/**
+ * @addtogroup containers
+ * @{
+ */
+
+/**
+ * @brief Tag for a ring buffer written by a single thread.
+ */
+struct single_producer {};
+
+/**
+ * @brief Tag for a ring buffer written by many threads at once.
+ * 
+ * Producers claim a range of slots with a compare-and-swap, and publish
+ * it by storing its end in a marker for its first slot, so they never 
+ * wait for each other. The consumer follows the markers in the order in
+ * which the ranges were claimed: values pushed after a range that is
+ * claimed but not yet published become visible together with it.
+ */
+struct multi_producer {};
+
+/**
+ * @brief Lock-free bounded queue of quantities, read by a single consumer.
+ * @tparam Q A @c quantity
+ * @tparam Producer Either @c single_producer or @c multi_producer
+ * 
+ * Only the underlying values are stored, contiguously, while the unit is
+ * carried by the type. The queue can live in the heap, or in a named
+ * shared memory segment, so that a consumer can attach from another process.
+ * 
+ * The shared memory segment starts with a header that records the size of
+ * @c value_type and the symbol of the unit, taken from @c unit_symbol_v.
+ * @c open_shared checks it in place against the expected unit before any 
+ * value is read.
+ * 
+ * @code{.cpp}
+ *   // Producer process
+ *   auto q = spsc_ring_buffer< quantity<float, si::pascal> >::create_shared( "/pressure", 1 << 16 );
+ *   q.push( samples.begin(), samples.end() );
+ * 
+ *   // Consumer process, fails if the producer did not write pascals
+ *   auto q = spsc_ring_buffer< quantity<float, si::pascal> >::open_shared( "/pressure" );
+ *   std::size_t n = q.pop( buffer.begin(), buffer.size() );
+ * @endcode
+ * 
+ * @sa spsc_ring_buffer
+ * @sa mpsc_ring_buffer
+ */
+template<class Q, class Producer = single_producer>
+class ring_buffer
+{
+    static_assert( detail::is_quantity_v<Q>, "ring_buffer holds quantities" );
+    static_assert( std::is_trivially_copyable< typename Q::value_type >::value,
+                   "ring_buffer requires a trivially copyable value_type" );
+    static_assert( std::is_same<Producer, single_producer>::value ||
+                   std::is_same<Producer, multi_producer>::value,
+                   "Producer must be single_producer or multi_producer" );
+
+public:
+    typedef Q quantity_type;
+    typedef typename Q::value_type value_type;
+    typedef typename Q::unit_type unit_type;
+    
+    /**
+     * @brief Create a queue in the heap
+     * @param capacity Number of slots, must be a power of two.
+     */
+    explicit ring_buffer( std::size_t capacity )
+    {
+        check_capacity( capacity );
+        
+        const std::size_t bytes = size_in_bytes( capacity ) + detail::cache_line_size;
+        
+        heap_.reset( new unsigned char[ bytes ] );
+        
+        void * p = heap_.get();
+        std::size_t space = bytes;
+        std::align( detail::cache_line_size, size_in_bytes( capacity ), p, space );
+        
+        init( p, capacity );
+    }
+    
+    ring_buffer( ring_buffer && other ) noexcept :
+        heap_( std::move( other.heap_ ) ),
+        mapped_( std::exchange( other.mapped_, 0 ) ),
+        header_( std::exchange( other.header_, nullptr ) ),
+        data_( std::exchange( other.data_, nullptr ) ),
+        markers_( std::exchange( other.markers_, nullptr ) ),
+        mask_( other.mask_ ),
+        cached_read_( other.cached_read_ ),
+        cached_write_( other.cached_write_ )
+    {}
+    
+    ring_buffer & operator=( ring_buffer && other ) noexcept
+    {
+        ring_buffer tmp( std::move( other ) );
+        swap( tmp );
+        return *this;
+    }
+    
+    ~ring_buffer()
+    {
+#ifdef ENGUNITS_HAS_SHARED_MEMORY
+        if ( mapped_ != 0 )
+            ::munmap( static_cast<void*>( header_ ), mapped_ );
+#endif
+    }
+    
+    void swap( ring_buffer & other ) noexcept
+    {
+        using std::swap;
+        swap( heap_, other.heap_ );
+        swap( mapped_, other.mapped_ );
+        swap( header_, other.header_ );
+        swap( data_, other.data_ );
+        swap( markers_, other.markers_ );
+        swap( mask_, other.mask_ );
+        swap( cached_read_, other.cached_read_ );
+        swap( cached_write_, other.cached_write_ );
+    }
+    
+#if defined(ENGUNITS_HAS_SHARED_MEMORY) || defined(ENGUNITS_DOXYGEN)
+    /**
+     * @brief Create a queue in a new named shared memory segment.
+     * @param name Name of the segment, as in `shm_open`
+     * @param capacity Number of slots, must be a power of two.
+     * @throw std::system_error if the segment can not be created.
+     * 
+     * The segment is not removed when the queue is destroyed, call
+     * @c unlink_shared once every process has attached.
+     */
+    static ring_buffer create_shared( const char * name, std::size_t capacity )
+    {
+        check_capacity( capacity );
+        
+        const std::size_t bytes = size_in_bytes( capacity );
+        
+        const int fd = ::shm_open( name, O_CREAT | O_EXCL | O_RDWR, 0600 );
+        
+        if ( fd < 0 )
+            throw std::system_error( errno, std::generic_category(), "shm_open" );
+        
+        if ( ::ftruncate( fd, off_t( bytes ) ) != 0 )
+        {
+            const int e = errno;
+            ::close( fd );
+            ::shm_unlink( name );
+            throw std::system_error( e, std::generic_category(), "ftruncate" );
+        }
+        
+        ring_buffer result( map( fd, bytes ), bytes );
+        result.init( result.header_, capacity );
+        
+        return result;
+    }
+    
+    /**
+     * @brief Attach to a queue created by @c create_shared
+     * @param name Name of the segment, as in `shm_open`
+     * @throw std::system_error if the segment can not be opened.
+     * @throw std::runtime_error if the segment was not created with the
+     *  same unit and value size.
+     */
+    static ring_buffer open_shared( const char * name )
+    {
+        const int fd = ::shm_open( name, O_RDWR, 0 );
+        
+        if ( fd < 0 )
+            throw std::system_error( errno, std::generic_category(), "shm_open" );
+        
+        struct stat st;
+        
+        if ( ::fstat( fd, &st ) != 0 )
+        {
+            const int e = errno;
+            ::close( fd );
+            throw std::system_error( e, std::generic_category(), "fstat" );
+        }
+        
+        const std::size_t bytes = std::size_t( st.st_size );
+        
+        if ( bytes < sizeof( detail::ring_buffer_header ) )
+        {
+            ::close( fd );
+            throw std::runtime_error( "ring_buffer: not a ring buffer" );
+        }
+        
+        ring_buffer result( map( fd, bytes ), bytes );
+        const detail::ring_buffer_header & h = *result.header_;
+        
+        if ( h.magic != detail::ring_buffer_header::magic_number ||
+             h.version != detail::ring_buffer_header::current_version ||
+             !detail::is_power_of_two( h.capacity ) ||
+             size_in_bytes( h.capacity ) > bytes )
+        {
+            throw std::runtime_error( "ring_buffer: not a ring buffer" );
+        }
+        
+        if ( h.value_size != sizeof( value_type ) ||
+             std::strcmp( h.symbol, symbol().c_str() ) != 0 )
+        {
+            throw std::runtime_error( "ring_buffer: unit mismatch" );
+        }
+        
+        if ( h.multi_producer != is_multi_producer )
+            throw std::runtime_error( "ring_buffer: producer mismatch" );
+        
+        result.attach( h.capacity );
+        result.cached_read_ = h.read.load( std::memory_order_acquire );
+        result.cached_write_ = h.write.load( std::memory_order_acquire );
+        
+        return result;
+    }
+    
+    /**
+     * @brief Remove a named shared memory segment
+     * 
+     * Processes that are already attached keep working.
+     */
+    static void unlink_shared( const char * name ) noexcept
+    {
+        ::shm_unlink( name );
+    }
+#endif
+    
+    /**
+     * @brief Symbol of the unit stored in the header.
+     */
+    static constexpr const auto & symbol()
+    {
+        return unit_symbol_v< unit_type >;
+    }
+    
+    /**
+     * @brief Number of slots
+     */
+    std::size_t capacity() const noexcept
+    {
+        return std::size_t( mask_ + 1 );
+    }
+    
+    /**
+     * @brief Number of values ready to be read.
+     * @note This is only a snapshot when other threads are using the queue.
+     */
+    std::size_t size() const noexcept
+    {
+        const std::uint64_t r = header_->read.load( std::memory_order_acquire );
+        return std::size_t( published( header_->write.load( std::memory_order_acquire ), Producer{} ) - r );
+    }
+    
+    /**
+     * @brief Append a single value
+     * @return false if the queue is full.
+     */
+    bool push( const Q & x )
+    {
+        return push( &x, &x + 1 ) == 1;
+    }
+
+    /**
+     * @brief Append the values in [ @p first, @p last ), a @c ForwardIterator range
+     * @return The number of values appended, less than the size of the range
+     *   if the queue is full.
+     * 
+     * The values are published to the consumer all together.
+     */
+    template<class ForwardIt>
+    std::size_t push( ForwardIt first, ForwardIt last )
+    {
+        const std::uint64_t n = std::uint64_t( std::distance( first, last ) );
+        
+        if ( n == 0 )
+            return 0;
+        
+        return do_push( first, n, Producer{} );
+    }
+    
+    /**
+     * @brief Remove a single value
+     * @return false if the queue is empty.
+     */
+    bool pop( Q & x )
+    {
+        return pop( &x, 1 ) == 1;
+    }
+    
+    /**
+     * @brief Remove up to @p max_count values, and write them to @p d_first
+     * @return The number of values removed.
+     * @note Only one thread can consume.
+     */
+    template<class OutputIt>
+    std::size_t pop( OutputIt d_first, std::size_t max_count )
+    {
+        const std::uint64_t r = header_->read.load( std::memory_order_relaxed );
+        
+        if ( cached_write_ - r < max_count )
+            cached_write_ = found( published( cached_write_, Producer{} ), Producer{} );
+        
+        const std::uint64_t n = std::min<std::uint64_t>( cached_write_ - r, max_count );
+        
+        for ( std::uint64_t i = 0; i < n; ++i, ++d_first )
+            *d_first = Q( data_[ ( r + i ) & mask_ ] );
+        
+        header_->read.store( r + n, std::memory_order_release );
+        
+        return std::size_t( n );
+    }
+
+private:
+    static constexpr std::uint64_t is_multi_producer = std::is_same<Producer, multi_producer>::value;
+    
+    ring_buffer( void * p, std::size_t bytes ) noexcept :
+        mapped_( bytes ),
+        header_( static_cast<detail::ring_buffer_header*>( p ) )
+    {}
+    
+    static void check_capacity( std::size_t capacity )
+    {
+        if ( !detail::is_power_of_two( capacity ) )
+            throw std::invalid_argument( "ring_buffer: capacity must be a power of two" );
+    }
+    
+    static std::size_t values_in_bytes( std::uint64_t capacity ) noexcept
+    {
+        const std::size_t bytes = std::size_t( capacity ) * sizeof( value_type );
+        return ( bytes + detail::cache_line_size - 1 ) / detail::cache_line_size * detail::cache_line_size;
+    }
+    
+    // With multiple producers, the values are followed by one marker per slot
+    static std::size_t size_in_bytes( std::uint64_t capacity ) noexcept
+    {
+        return sizeof( detail::ring_buffer_header ) + values_in_bytes( capacity ) +
+               ( is_multi_producer ? std::size_t( capacity ) * sizeof( std::atomic<std::uint64_t> ) : 0 );
+    }
+    
+    void attach( std::uint64_t capacity ) noexcept
+    {
+        unsigned char * values = reinterpret_cast<unsigned char*>( header_ + 1 );
+        
+        data_ = reinterpret_cast<value_type*>( values );
+        mask_ = capacity - 1;
+        
+        if ( is_multi_producer )
+            markers_ = reinterpret_cast<std::atomic<std::uint64_t>*>( values + values_in_bytes( capacity ) );
+    }
+    
+#ifdef ENGUNITS_HAS_SHARED_MEMORY
+    static void * map( int fd, std::size_t bytes )
+    {
+        void * p = ::mmap( nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0 );
+        const int e = errno;
+        ::close( fd );
+        
+        if ( p == MAP_FAILED )
+            throw std::system_error( e, std::generic_category(), "mmap" );
+        
+        return p;
+    }
+#endif
+    
+    void init( void * p, std::uint64_t capacity ) noexcept
+    {
+        static_assert( std::decay_t< decltype( symbol() ) >::size() < detail::ring_buffer_header::symbol_capacity,
+                       "unit symbol too long for the ring_buffer header" );
+        
+        header_ = ::new ( p ) detail::ring_buffer_header {};
+        
+        header_->version = detail::ring_buffer_header::current_version;
+        header_->value_size = sizeof( value_type );
+        header_->capacity = capacity;
+        header_->multi_producer = is_multi_producer;
+        std::memcpy( header_->symbol, symbol().c_str(), std::decay_t< decltype( symbol() ) >::size() + 1 );
+        header_->read.store( 0, std::memory_order_relaxed );
+        header_->write.store( 0, std::memory_order_relaxed );
+        header_->reserve.store( 0, std::memory_order_relaxed );
+        
+        attach( capacity );
+        
+        if ( is_multi_producer )
+        {
+            for ( std::uint64_t i = 0; i < capacity; ++i )
+                ::new ( static_cast<void*>( markers_ + i ) ) std::atomic<std::uint64_t>( 0 );
+        }
+        
+        // Publish the header last, so that a reader never sees half of it
+        std::atomic_thread_fence( std::memory_order_release );
+        header_->magic = detail::ring_buffer_header::magic_number;
+    }
+    
+    std::uint64_t published( std::uint64_t, single_producer ) const noexcept
+    {
+        return header_->write.load( std::memory_order_acquire );
+    }
+    
+    // Follow the ranges published from w on. The marker of the first slot
+    // of a range holds its end; a marker left from an older lap is at
+    // most w, since a range is never longer than the capacity.
+    std::uint64_t published( std::uint64_t w, multi_producer ) const noexcept
+    {
+        for ( ;; )
+        {
+            const std::uint64_t end = markers_[ w & mask_ ].load( std::memory_order_acquire );
+            
+            if ( end <= w )
+                return w;
+            
+            w = end;
+        }
+    }
+    
+    std::uint64_t found( std::uint64_t w, single_producer ) noexcept
+    {
+        return w;
+    }
+    
+    // Share the end of the published ranges, for size() and for a 
+    // consumer that attaches later
+    std::uint64_t found( std::uint64_t w, multi_producer ) noexcept
+    {
+        header_->write.store( w, std::memory_order_release );
+        return w;
+    }
+    
+    template<class ForwardIt>
+    void copy_in( ForwardIt first, std::uint64_t start, std::uint64_t n ) noexcept
+    {
+        for ( std::uint64_t i = 0; i < n; ++i, ++first )
+            data_[ ( start + i ) & mask_ ] = Q( *first ).value();
+    }
+    
+    template<class ForwardIt>
+    std::size_t do_push( ForwardIt first, std::uint64_t n, single_producer )
+    {
+        const std::uint64_t w = header_->write.load( std::memory_order_relaxed );
+        
+        if ( capacity() - ( w - cached_read_ ) < n )
+            cached_read_ = header_->read.load( std::memory_order_acquire );
+        
+        n = std::min<std::uint64_t>( n, capacity() - ( w - cached_read_ ) );
+        
+        copy_in( first, w, n );
+        
+        header_->write.store( w + n, std::memory_order_release );
+        
+        return std::size_t( n );
+    }
+    
+    template<class ForwardIt>
+    std::size_t do_push( ForwardIt first, std::uint64_t n, multi_producer )
+    {
+        std::uint64_t start = header_->reserve.load( std::memory_order_relaxed );
+        std::uint64_t count;
+        
+        do
+        {
+            const std::uint64_t r = header_->read.load( std::memory_order_acquire );
+            count = std::min<std::uint64_t>( n, capacity() - ( start - r ) );
+            
+            if ( count == 0 )
+                return 0;
+        }
+        while ( !header_->reserve.compare_exchange_weak( start,
+                                                         start + count,
+                                                         std::memory_order_relaxed ) );
+        
+        copy_in( first, start, count );
+        
+        markers_[ start & mask_ ].store( start + count, std::memory_order_release );
+        
+        return std::size_t( count );
+    }
+    
+    std::unique_ptr<unsigned char[]> heap_;
+    std::size_t mapped_ = 0;
+    detail::ring_buffer_header * header_ = nullptr;
+    value_type * data_ = nullptr;
+    std::atomic<std::uint64_t> * markers_ = nullptr;
+    std::uint64_t mask_ = 0;
+    
+    // Each side keeps a private copy of the other side's index, 
+    // and only reloads it when it seems to be out of space.
+    alignas(detail::cache_line_size) std::uint64_t cached_read_ = 0;
+    alignas(detail::cache_line_size) std::uint64_t cached_write_ = 0;
+};
+
+/**
+ * @brief Ring buffer with one producer and one consumer
+ * @relates ring_buffer
+ */
+template<class Q>
+using spsc_ring_buffer = ring_buffer< Q, single_producer >;
+
+/**
+ * @brief Ring buffer with many producers and one consumer
+ * @relates ring_buffer
+ */
+template<class Q>
+using mpsc_ring_buffer = ring_buffer< Q, multi_producer >;
+
+/** @} */
+
+}
+
+#endif //ENGINEERING_UNITS_CONTAINER_RING_BUFFER_HPP
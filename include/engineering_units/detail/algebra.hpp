@@ -0,0 +1,203 @@
+/*
+ * Boost Software License - Version 1.0 - August 17th, 2003
+ *
+ * Permission is hereby granted, free of charge, to any person or organization
+ * obtaining a copy of the software and accompanying documentation covered by
+ * this license (the "Software") to use, reproduce, display, distribute,
+ * execute, and transmit the Software, and to prepare derivative works of the
+ * Software, and to permit third-parties to whom the Software is furnished to
+ * do so, all subject to the following:
+ *
+ * The copyright notices in the Software and this entire statement, including
+ * the above license grant, this restriction and the following disclaimer,
+ * must be included in all copies of the Software, in whole or in part, and
+ * all derivative works of the Software, unless such copies or derivative
+ * works are solely in the form of machine-executable object code generated by
+ * a source language processor.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+ * SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+ * FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef ENGINEERING_UNITS_DETAIL_ALGEBRA_HPP
+#define ENGINEERING_UNITS_DETAIL_ALGEBRA_HPP
+
+#include <cstddef>
+#include <initializer_list>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+namespace engunits
+{
+
+namespace detail
+{
+
+template<std::size_t I, class Op, class ... Tuples>
+void for_each_component_at( Op & op, Tuples & ... ts )
+{
+    op( std::get<I>( ts ) ... );
+}
+
+/**
+ * @internal
+ * @brief Call @p op on the I-th element of every tuple in @p ts, for each I.
+ */
+template<class Op, std::size_t ... Is, class ... Tuples>
+void for_each_component( Op & op, std::index_sequence<Is...>, Tuples & ... ts )
+{
+    (void) std::initializer_list<int>{
+        ( for_each_component_at<Is>( op, ts ... ), 0 ) ...
+    };
+}
+
+/**
+ * @internal
+ * @brief Element access that broadcasts anything that is not a @c std::vector
+ */
+template<class T, class Alloc>
+T & element( std::vector<T, Alloc> & v, std::size_t i )
+{
+    return v[i];
+}
+
+template<class T, class Alloc>
+const T & element( const std::vector<T, Alloc> & v, std::size_t i )
+{
+    return v[i];
+}
+
+template<class T>
+T & element( T & t, std::size_t )
+{
+    return t;
+}
+
+/**
+ * @internal
+ * @brief Operations on a state made of a tuple of quantities.
+ *
+ * Each element of the state tuple holds one value.
+ */
+struct tuple_algebra
+{
+    template<class Q>
+    using container = Q;
+
+    template<class ... Ts>
+    static void resize( std::tuple<Ts...> &, std::size_t )
+    {}
+
+    template<class ... Ts, class ... Us>
+    static bool same_size( const std::tuple<Ts...> &, const std::tuple<Us...> & )
+    {
+        return true;
+    }
+
+    template<class Op, class Head, class ... Tail>
+    static void for_each( Op op, Head & head, Tail & ... tail )
+    {
+        for_each_component( op,
+                            std::make_index_sequence<
+                                std::tuple_size<std::remove_const_t<Head> >::value
+                            >{},
+                            head,
+                            tail ... );
+    }
+};
+
+/**
+ * @internal
+ * @brief Operations on a structure-of-arrays state.
+ *
+ * Each element of the state tuple is a @c std::vector, which holds the value
+ * of that component for every trajectory in the batch. Operations are applied
+ * on one component at a time, over contiguous memory, which lets the
+ * compiler vectorize the inner loop.
+ *
+ * Arguments that are not vectors are broadcast to every trajectory.
+ */
+struct batch_algebra
+{
+    template<class Q>
+    using container = std::vector<Q>;
+
+    template<class Op>
+    struct elementwise
+    {
+        template<class V, class ... Vs>
+        void operator()( V & v, Vs & ... vs ) const
+        {
+            const std::size_t n = v.size();
+
+            for ( std::size_t i = 0; i < n; ++i )
+                op( v[i], element( vs, i ) ... );
+        }
+
+        Op & op;
+    };
+
+    struct resize_op
+    {
+        template<class V>
+        void operator()( V & v ) const
+        {
+            v.resize( n );
+        }
+
+        std::size_t n;
+    };
+
+    struct same_size_op
+    {
+        template<class V, class W>
+        void operator()( const V & v, const W & w )
+        {
+            result = result && v.size() == w.size();
+        }
+
+        bool result;
+    };
+
+    template<class ... Ts>
+    static void resize( std::tuple<Ts...> & t, std::size_t n )
+    {
+        resize_op op{ n };
+        for_each_component( op, std::index_sequence_for<Ts...>{}, t );
+    }
+
+    /**
+     * @brief Whether every component of @p a holds as many trajectories
+     *  as the same component of @p b
+     */
+    template<class ... Ts, class ... Us>
+    static bool same_size( const std::tuple<Ts...> & a, const std::tuple<Us...> & b )
+    {
+        same_size_op op{ true };
+        for_each_component( op, std::index_sequence_for<Ts...>{}, a, b );
+        return op.result;
+    }
+
+    template<class Op, class Head, class ... Tail>
+    static void for_each( Op op, Head & head, Tail & ... tail )
+    {
+        elementwise<Op> e{ op };
+        for_each_component( e,
+                            std::make_index_sequence<
+                                std::tuple_size<std::remove_const_t<Head> >::value
+                            >{},
+                            head,
+                            tail ... );
+    }
+};
+
+}
+}
+
+#endif //ENGINEERING_UNITS_DETAIL_ALGEBRA_HPP
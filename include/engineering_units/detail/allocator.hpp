@@ -0,0 +1,69 @@
+/*
+ * Boost Software License - Version 1.0 - August 17th, 2003
+ *
+ * Permission is hereby granted, free of charge, to any person or organization
+ * obtaining a copy of the software and accompanying documentation covered by
+ * this license (the "Software") to use, reproduce, display, distribute,
+ * execute, and transmit the Software, and to prepare derivative works of the
+ * Software, and to permit third-parties to whom the Software is furnished to
+ * do so, all subject to the following:
+ *
+ * The copyright notices in the Software and this entire statement, including
+ * the above license grant, this restriction and the following disclaimer,
+ * must be included in all copies of the Software, in whole or in part, and
+ * all derivative works of the Software, unless such copies or derivative
+ * works are solely in the form of machine-executable object code generated by
+ * a source language processor.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+ * SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+ * FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef ENGINEERING_UNITS_DETAIL_ALLOCATOR_HPP
+#define ENGINEERING_UNITS_DETAIL_ALLOCATOR_HPP
+
+#include <cstddef>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+#if __cplusplus >= 201703L && defined(__has_include)
+#if __has_include(<memory_resource>)
+#include <memory_resource>
+#endif
+#endif
+
+// std::pmr is optional: libc++ shipped it late, and the library is C++14
+#if defined(__cpp_lib_memory_resource) && !defined(ENGUNITS_HAS_MEMORY_RESOURCE)
+#define ENGUNITS_HAS_MEMORY_RESOURCE 1
+#endif
+
+#include <engineering_units/detail/void_t.hpp>
+
+namespace engunits
+{
+
+namespace detail
+{
+
+template<class A, class = void>
+struct is_allocator : std::false_type {};
+
+template<class A>
+struct is_allocator<A, void_t< decltype( std::declval<A &>().allocate( std::size_t( 1 ) ) ) > > : std::true_type {};
+
+template<class A>
+constexpr bool is_allocator_v = is_allocator<A>::value;
+
+template<class A, class T>
+using rebind_alloc_t = typename std::allocator_traits<A>::template rebind_alloc<T>;
+
+}
+}
+
+#endif //ENGINEERING_UNITS_DETAIL_ALLOCATOR_HPP
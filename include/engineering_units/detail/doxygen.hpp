@@ -31,6 +31,12 @@
  * @defgroup metafunctions Metafunctions
  * @defgroup operators Operators and functions
  * @defgroup predef_units Predefined units
+ * @defgroup numeric Numerical algorithms
+ * @defgroup algorithms Sorting and searching
+ * @defgroup containers Containers
+ * @defgroup memory Memory resources and allocators
+ * @defgroup io Input and output
+ * @defgroup concurrency Pipelines and threads
  */
 
 // Hide all the sfinae magic from doxygen.
@@ -59,6 +65,11 @@
 
 #endif //ENGUNITS_DOXYGEN
 
+// C++20 constraints replace the enable_if above where available. 
+// Define ENGUNITS_NO_CONCEPTS to keep the C++14 overload set.
+#if defined(__cpp_concepts) && __cpp_concepts >= 201907L && !defined(ENGUNITS_NO_CONCEPTS)
+#define ENGUNITS_HAS_CONCEPTS 1
+#endif
 
 #endif //ENGINEERING_UNITS_DETAIL_DOXYGEN_HPP
 
@@ -42,12 +42,15 @@ namespace detail
  * @brief Checks if the arguments are not duplicated
  */
 template<class Head, class ... Tail>
-constexpr bool is_unique_v =    
+struct is_unique : std::integral_constant<bool,
     none_of( std::is_same<Head, Tail>::value ... ) &&
-    is_unique_v<Tail...>;
+    is_unique<Tail...>::value > {};
     
 template<class Head>
-constexpr bool is_unique_v<Head> = true;
+struct is_unique<Head> : std::true_type {};
+
+template<class ... Ts>
+constexpr bool is_unique_v = is_unique<Ts...>::value;
 
 }
 }
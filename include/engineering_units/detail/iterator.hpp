@@ -0,0 +1,63 @@
+/*
+ * Boost Software License - Version 1.0 - August 17th, 2003
+ *
+ * Permission is hereby granted, free of charge, to any person or organization
+ * obtaining a copy of the software and accompanying documentation covered by
+ * this license (the "Software") to use, reproduce, display, distribute,
+ * execute, and transmit the Software, and to prepare derivative works of the
+ * Software, and to permit third-parties to whom the Software is furnished to
+ * do so, all subject to the following:
+ *
+ * The copyright notices in the Software and this entire statement, including
+ * the above license grant, this restriction and the following disclaimer,
+ * must be included in all copies of the Software, in whole or in part, and
+ * all derivative works of the Software, unless such copies or derivative
+ * works are solely in the form of machine-executable object code generated by
+ * a source language processor.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+ * SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+ * FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef ENGINEERING_UNITS_DETAIL_ITERATOR_HPP
+#define ENGINEERING_UNITS_DETAIL_ITERATOR_HPP
+
+#include <iterator>
+#include <type_traits>
+
+#include <engineering_units/detail/void_t.hpp>
+
+namespace engunits
+{
+
+namespace detail
+{
+
+template<class Iterator>
+using iterator_value_t = typename std::iterator_traits<Iterator>::value_type;
+
+template<class T, class = void>
+struct is_iterator : std::false_type {};
+
+template<class T>
+struct is_iterator<
+    T,
+    void_t< typename std::iterator_traits<T>::iterator_category >
+> : std::true_type {};
+
+/**
+ * @internal
+ * @brief Checks if @p T is an iterator, used to tell apart a range from a step.
+ */
+template<class T>
+constexpr bool is_iterator_v = is_iterator<T>::value;
+
+}
+}
+
+#endif //ENGINEERING_UNITS_DETAIL_ITERATOR_HPP
@@ -0,0 +1,157 @@
+/*
+ * Boost Software License - Version 1.0 - August 17th, 2003
+ *
+ * Permission is hereby granted, free of charge, to any person or organization
+ * obtaining a copy of the software and accompanying documentation covered by
+ * this license (the "Software") to use, reproduce, display, distribute,
+ * execute, and transmit the Software, and to prepare derivative works of the
+ * Software, and to permit third-parties to whom the Software is furnished to
+ * do so, all subject to the following:
+ *
+ * The copyright notices in the Software and this entire statement, including
+ * the above license grant, this restriction and the following disclaimer,
+ * must be included in all copies of the Software, in whole or in part, and
+ * all derivative works of the Software, unless such copies or derivative
+ * works are solely in the form of machine-executable object code generated by
+ * a source language processor.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+ * SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+ * FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef ENGINEERING_UNITS_DETAIL_MAPPED_FILE_HPP
+#define ENGINEERING_UNITS_DETAIL_MAPPED_FILE_HPP
+
+#include <cstddef>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <system_error>
+#include <utility>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define ENGUNITS_HAS_MMAP 1
+#endif
+
+namespace engunits
+{
+
+namespace detail
+{
+
+/**
+ * @internal
+ * @brief Read-only view of a whole file.
+ * 
+ * The file is mapped in memory where @c mmap is available, and read into
+ * a buffer otherwise.
+ */
+class mapped_file
+{
+public:
+    mapped_file() = default;
+    
+    explicit mapped_file( const std::string & path )
+    {
+#ifdef ENGUNITS_HAS_MMAP
+        const int fd = ::open( path.c_str(), O_RDONLY );
+        
+        if ( fd < 0 )
+            throw std::system_error( errno, std::generic_category(), path );
+        
+        struct stat st;
+        
+        if ( ::fstat( fd, &st ) != 0 )
+        {
+            const int e = errno;
+            ::close( fd );
+            throw std::system_error( e, std::generic_category(), path );
+        }
+        
+        size_ = std::size_t( st.st_size );
+        
+        if ( size_ != 0 )
+        {
+            void * p = ::mmap( nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0 );
+            
+            if ( p == MAP_FAILED )
+            {
+                const int e = errno;
+                ::close( fd );
+                throw std::system_error( e, std::generic_category(), path );
+            }
+            
+            data_ = static_cast<const char*>( p );
+        }
+        
+        ::close( fd );
+#else
+        std::ifstream in( path, std::ios::binary | std::ios::ate );
+        
+        if ( !in )
+            throw std::system_error( std::make_error_code( std::errc::no_such_file_or_directory ), path );
+        
+        size_ = std::size_t( in.tellg() );
+        buffer_.reset( new char[ size_ ] );
+        in.seekg( 0 );
+        in.read( buffer_.get(), std::streamsize( size_ ) );
+        data_ = buffer_.get();
+#endif
+    }
+    
+    mapped_file( mapped_file && other ) noexcept :
+        data_( std::exchange( other.data_, nullptr ) ),
+        size_( std::exchange( other.size_, 0 ) ),
+        buffer_( std::move( other.buffer_ ) )
+    {}
+    
+    mapped_file & operator=( mapped_file && other ) noexcept
+    {
+        mapped_file tmp( std::move( other ) );
+        std::swap( data_, tmp.data_ );
+        std::swap( size_, tmp.size_ );
+        std::swap( buffer_, tmp.buffer_ );
+        return *this;
+    }
+    
+    ~mapped_file()
+    {
+#ifdef ENGUNITS_HAS_MMAP
+        if ( data_ != nullptr )
+            ::munmap( const_cast<char*>( data_ ), size_ );
+#endif
+    }
+    
+    /**
+     * @brief Hint that the file will be read from start to end
+     */
+    void advise_sequential() const noexcept
+    {
+#if defined(ENGUNITS_HAS_MMAP) && defined(MADV_SEQUENTIAL)
+        if ( data_ != nullptr )
+            ::madvise( const_cast<char*>( data_ ), size_, MADV_SEQUENTIAL );
+#endif
+    }
+    
+    const char * data() const noexcept { return data_; }
+    std::size_t size() const noexcept { return size_; }
+    
+private:
+    const char * data_ = nullptr;
+    std::size_t size_ = 0;
+    std::unique_ptr<char[]> buffer_;
+};
+
+}
+}
+
+#endif //ENGINEERING_UNITS_DETAIL_MAPPED_FILE_HPP
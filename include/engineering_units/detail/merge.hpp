@@ -29,6 +29,8 @@
 
 #include <type_traits>
 
+#include <engineering_units/detail/inline_variable.hpp>
+
 namespace engunits
 {
 
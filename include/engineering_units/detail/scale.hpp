@@ -0,0 +1,130 @@
+/*
+ * Boost Software License - Version 1.0 - August 17th, 2003
+ *
+ * Permission is hereby granted, free of charge, to any person or organization
+ * obtaining a copy of the software and accompanying documentation covered by
+ * this license (the "Software") to use, reproduce, display, distribute,
+ * execute, and transmit the Software, and to prepare derivative works of the
+ * Software, and to permit third-parties to whom the Software is furnished to
+ * do so, all subject to the following:
+ *
+ * The copyright notices in the Software and this entire statement, including
+ * the above license grant, this restriction and the following disclaimer,
+ * must be included in all copies of the Software, in whole or in part, and
+ * all derivative works of the Software, unless such copies or derivative
+ * works are solely in the form of machine-executable object code generated by
+ * a source language processor.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+ * SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+ * FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef ENGINEERING_UNITS_DETAIL_SCALE_HPP
+#define ENGINEERING_UNITS_DETAIL_SCALE_HPP
+
+#include <cmath>
+#include <type_traits>
+
+#include <engineering_units/detail/doxygen.hpp>
+
+namespace engunits
+{
+
+namespace detail
+{
+
+/**
+ * @internal
+ * @brief A unit conversion factor, as a ratio with an exact integer on
+ *  one side
+ * 
+ * Decimal prefixes are not exact in binary: 1500 mm times 0.001 is just
+ * below 1.5, and 1 m times 1000 is not always 1000 mm. A factor whose
+ * inverse is an integer up to rounding is stored as 1 over that integer,
+ * a factor that is an integer up to rounding as that integer over 1, 
+ * and any other factor as itself.
+ */
+class scale_ratio
+{
+public:
+    scale_ratio( long double factor = 1 ) noexcept :
+        numerator_( factor < 1 && near_integer( 1 / factor ) ? 1 :
+                    near_integer( factor ) ? std::round( factor ) : factor ),
+        denominator_( factor < 1 && near_integer( 1 / factor ) ? std::round( 1 / factor ) : 1 )
+    {}
+    
+    long double numerator() const noexcept { return numerator_; }
+    long double denominator() const noexcept { return denominator_; }
+    
+    long double value() const noexcept
+    {
+        return numerator_ / denominator_;
+    }
+    
+    /**
+     * @brief @p x times the factor, in @c long double
+     */
+    template<class T>
+    long double apply( T x ) const noexcept
+    {
+        return static_cast<long double>( x ) * numerator_ / denominator_;
+    }
+    
+    friend bool operator==( const scale_ratio & lhs, const scale_ratio & rhs ) noexcept
+    {
+        return lhs.numerator_ == rhs.numerator_ && lhs.denominator_ == rhs.denominator_;
+    }
+    
+    friend bool operator!=( const scale_ratio & lhs, const scale_ratio & rhs ) noexcept
+    {
+        return !( lhs == rhs );
+    }
+    
+private:
+    static bool near_integer( long double x ) noexcept
+    {
+        return std::fabs( x - std::round( x ) ) <= 1e-12L * x;
+    }
+    
+    long double numerator_;
+    long double denominator_;
+};
+
+/**
+ * @internal
+ * @brief Type of a unit conversion factor applied to values of type @p T
+ * 
+ * Floating point values are scaled in their own type. Integers are 
+ * scaled in @c long double by a @c scale_ratio and rounded to the nearest
+ * value, so that a factor below one does not truncate to zero, and the
+ * halfway cases round as written.
+ */
+template<class T>
+using scale_factor_t = std::conditional_t< std::is_floating_point<T>::value, T, scale_ratio >;
+
+/**
+ * @internal
+ * @brief Multiply @p x by the conversion factor @p f, rounding to the
+ *  nearest integer if @p T is integral.
+ */
+template<class T, ENGUNITS_ENABLE_IF( std::is_floating_point<T>::value )>
+T scale_value( T x, scale_factor_t<T> f ) noexcept
+{
+    return x * f;
+}
+
+template<class T, ENGUNITS_ENABLE_IF( std::is_integral<T>::value )>
+T scale_value( T x, const scale_factor_t<T> & f ) noexcept
+{
+    return static_cast<T>( std::round( f.apply( x ) ) );
+}
+
+}
+}
+
+#endif //ENGINEERING_UNITS_DETAIL_SCALE_HPP
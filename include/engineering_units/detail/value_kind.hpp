@@ -0,0 +1,63 @@
+/*
+ * Boost Software License - Version 1.0 - August 17th, 2003
+ *
+ * Permission is hereby granted, free of charge, to any person or organization
+ * obtaining a copy of the software and accompanying documentation covered by
+ * this license (the "Software") to use, reproduce, display, distribute,
+ * execute, and transmit the Software, and to prepare derivative works of the
+ * Software, and to permit third-parties to whom the Software is furnished to
+ * do so, all subject to the following:
+ *
+ * The copyright notices in the Software and this entire statement, including
+ * the above license grant, this restriction and the following disclaimer,
+ * must be included in all copies of the Software, in whole or in part, and
+ * all derivative works of the Software, unless such copies or derivative
+ * works are solely in the form of machine-executable object code generated by
+ * a source language processor.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+ * SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+ * FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef ENGINEERING_UNITS_DETAIL_VALUE_KIND_HPP
+#define ENGINEERING_UNITS_DETAIL_VALUE_KIND_HPP
+
+#include <cstdint>
+#include <type_traits>
+
+namespace engunits
+{
+
+namespace detail
+{
+
+/**
+ * @internal
+ * @brief Character that identifies an arithmetic type in binary formats
+ * 
+ * 'f' for floating point, 'i' for signed and 'u' for unsigned integers.
+ * Together with the size, it identifies the type.
+ */
+template<class T>
+struct value_kind
+{
+    static_assert( std::is_arithmetic<T>::value, 
+                   "Only arithmetic value types can be stored" );
+    
+    static constexpr char value = std::is_floating_point<T>::value ? 'f' :
+                                  std::is_signed<T>::value ? 'i' : 'u';
+};
+
+// Kind and size packed together
+template<class T>
+constexpr std::uint64_t value_tag_v = ( std::uint64_t( value_kind<T>::value ) << 8 ) | sizeof( T );
+
+}
+}
+
+#endif //ENGINEERING_UNITS_DETAIL_VALUE_KIND_HPP
@@ -0,0 +1,58 @@
+/*
+ * Boost Software License - Version 1.0 - August 17th, 2003
+ *
+ * Permission is hereby granted, free of charge, to any person or organization
+ * obtaining a copy of the software and accompanying documentation covered by
+ * this license (the "Software") to use, reproduce, display, distribute,
+ * execute, and transmit the Software, and to prepare derivative works of the
+ * Software, and to permit third-parties to whom the Software is furnished to
+ * do so, all subject to the following:
+ *
+ * The copyright notices in the Software and this entire statement, including
+ * the above license grant, this restriction and the following disclaimer,
+ * must be included in all copies of the Software, in whole or in part, and
+ * all derivative works of the Software, unless such copies or derivative
+ * works are solely in the form of machine-executable object code generated by
+ * a source language processor.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+ * SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+ * FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef ENGINEERING_UNITS_HASH_HPP
+#define ENGINEERING_UNITS_HASH_HPP
+
+#include <cstddef>
+#include <functional>
+
+#include <engineering_units/quantity.hpp>
+
+namespace std
+{
+
+/**
+ * @brief Hash of a quantity, the hash of its value.
+ *
+ * The unit is not part of the hash, since quantities of different units
+ * are different types and never share a table. Quantities of floating
+ * point values hash -0 and +0 alike, as they compare equal; prefer
+ * @c engunits::quantize to build keys out of measured values.
+ */
+template<class T, class ... Units>
+struct hash< engunits::quantity<T, Units...> >
+{
+    std::size_t operator()( const engunits::quantity<T, Units...> & q ) const
+        noexcept( noexcept( std::hash<T>{}( q.value() ) ) )
+    {
+        return std::hash<T>{}( q.value() );
+    }
+};
+
+}
+
+#endif //ENGINEERING_UNITS_HASH_HPP
@@ -0,0 +1,82 @@
+/*
+ * Boost Software License - Version 1.0 - August 17th, 2003
+ *
+ * Permission is hereby granted, free of charge, to any person or organization
+ * obtaining a copy of the software and accompanying documentation covered by
+ * this license (the "Software") to use, reproduce, display, distribute,
+ * execute, and transmit the Software, and to prepare derivative works of the
+ * Software, and to permit third-parties to whom the Software is furnished to
+ * do so, all subject to the following:
+ *
+ * The copyright notices in the Software and this entire statement, including
+ * the above license grant, this restriction and the following disclaimer,
+ * must be included in all copies of the Software, in whole or in part, and
+ * all derivative works of the Software, unless such copies or derivative
+ * works are solely in the form of machine-executable object code generated by
+ * a source language processor.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+ * SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+ * FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef ENGINEERING_UNITS_IMPERIAL_TEMPERATURE_HPP
+#define ENGINEERING_UNITS_IMPERIAL_TEMPERATURE_HPP
+
+#include <engineering_units/unit/helper_macros.hpp>
+#include <engineering_units/point.hpp>
+#include <engineering_units/si/temperature.hpp>
+
+
+namespace engunits
+{
+namespace imperial
+{
+
+/**
+ * @addtogroup predef_units
+ * @{
+ */
+
+ENGUNITS_DEFINE_BASE_UNIT( rankine, R, si::kelvin, ( 5.0L / 9.0L ) );
+ENGUNITS_IMPORT_OPERATORS
+
+namespace literals
+{
+
+ENGUNITS_DEFINE_UDL( rankine, R )
+
+}
+
+/**
+ * @brief Origin of the Fahrenheit scale, 459.67 R above absolute zero
+ * 
+ * Differences of Fahrenheit temperatures are in rankine.
+ */
+struct fahrenheit_origin
+{
+    typedef rankine unit_type;
+    typedef si::kelvin_origin reference_type;
+    
+    static constexpr long double offset()
+    {
+        return 459.67L;
+    }
+};
+
+/**
+ * @brief Temperature on the Fahrenheit scale
+ * @sa quantity_point
+ */
+template<class T>
+using fahrenheit_point = quantity_point<T, fahrenheit_origin>;
+
+/** @} */
+}
+}
+
+#endif //ENGINEERING_UNITS_IMPERIAL_TEMPERATURE_HPP
@@ -0,0 +1,69 @@
+/*
+ * Boost Software License - Version 1.0 - August 17th, 2003
+ *
+ * Permission is hereby granted, free of charge, to any person or organization
+ * obtaining a copy of the software and accompanying documentation covered by
+ * this license (the "Software") to use, reproduce, display, distribute,
+ * execute, and transmit the Software, and to prepare derivative works of the
+ * Software, and to permit third-parties to whom the Software is furnished to
+ * do so, all subject to the following:
+ *
+ * The copyright notices in the Software and this entire statement, including
+ * the above license grant, this restriction and the following disclaimer,
+ * must be included in all copies of the Software, in whole or in part, and
+ * all derivative works of the Software, unless such copies or derivative
+ * works are solely in the form of machine-executable object code generated by
+ * a source language processor.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+ * SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+ * FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef ENGINEERING_UNITS_INFORMATION_HPP
+#define ENGINEERING_UNITS_INFORMATION_HPP
+
+#include <engineering_units/quantity.hpp>
+
+#include <engineering_units/unit/helper_macros.hpp>
+
+namespace engunits
+{
+
+/**
+ * @addtogroup predef_units
+ * @{
+ */
+
+/**
+ * @brief Number of events, items or samples.
+ * 
+ * Counts have their own dimension, so that a rate of samples per second
+ * can not be added to a frequency of bytes per second.
+ */
+ENGUNITS_DEFINE_ROOT_UNIT( count, ct, cardinality );
+
+ENGUNITS_DEFINE_ROOT_UNIT( byte, B, information );
+ENGUNITS_DEFINE_BASE_UNIT( kibibyte, KiB, byte, 1024.0L );
+ENGUNITS_DEFINE_BASE_UNIT( mebibyte, MiB, kibibyte, 1024.0L );
+ENGUNITS_DEFINE_BASE_UNIT( gibibyte, GiB, mebibyte, 1024.0L );
+
+namespace literals
+{
+
+ENGUNITS_DEFINE_UDL( count, ct )
+ENGUNITS_DEFINE_UDL( byte, B )
+
+}
+
+ENGUNITS_IMPORT_OPERATORS
+
+/** @} */
+
+}
+
+#endif //ENGINEERING_UNITS_INFORMATION_HPP
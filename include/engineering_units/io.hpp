@@ -31,6 +31,7 @@
 #include <sstream>
 
 #include <engineering_units/quantity.hpp>
+#include <engineering_units/unit/symbol.hpp>
 #include <engineering_units/unit/traits.hpp>
 #include <engineering_units/detail/doxygen.hpp>
 
@@ -46,16 +47,16 @@ ENGUNITS_ENABLE_IF_T(
     is_unit_v<U>,
     std::ostream&) operator<<( std::ostream & os, const U & )
 {
-    return os << unit_traits<U>::symbol();
+    return os << unit_symbol_v<U>.c_str();
 }
 
 template<class T, class ... Units>
 std::ostream& operator<<(std::ostream & os, quantity<T, Units...> const & x)
 {
     const auto w = os.width();
-    const auto symbol = unit_traits< 
+    const auto & symbol = unit_symbol_v< 
         typename quantity<T, Units...>::unit_type
-    >::symbol();
+    >;
     
     if ( w != 0 && (os.flags() | std::ios::left) )
     {
@@ -0,0 +1,635 @@
+/*
+ * Boost Software License - Version 1.0 - August 17th, 2003
+ *
+ * Permission is hereby granted, free of charge, to any person or organization
+ * obtaining a copy of the software and accompanying documentation covered by
+ * this license (the "Software") to use, reproduce, display, distribute,
+ * execute, and transmit the Software, and to prepare derivative works of the
+ * Software, and to permit third-parties to whom the Software is furnished to
+ * do so, all subject to the following:
+ *
+ * The copyright notices in the Software and this entire statement, including
+ * the above license grant, this restriction and the following disclaimer,
+ * must be included in all copies of the Software, in whole or in part, and
+ * all derivative works of the Software, unless such copies or derivative
+ * works are solely in the form of machine-executable object code generated by
+ * a source language processor.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+ * SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+ * FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef ENGINEERING_UNITS_IO_COLUMNAR_HPP
+#define ENGINEERING_UNITS_IO_COLUMNAR_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include <engineering_units/quantity.hpp>
+#include <engineering_units/unit/descriptor.hpp>
+
+#include <engineering_units/detail/doxygen.hpp>
+#include <engineering_units/detail/mapped_file.hpp>
+#include <engineering_units/detail/scale.hpp>
+#include <engineering_units/detail/value_kind.hpp>
+
+namespace engunits
+{
+
+namespace detail
+{
+
+/**
+ * @internal
+ * @brief Layout of the columnar format
+ * 
+ *  - 64 bytes of file header: magic, version, byte order marker.
+ *  - The values of each column, starting at a 64 bytes boundary.
+ *  - The column directory.
+ *  - A trailer with the directory offset, the number of columns and the magic.
+ */
+struct columnar_format
+{
+    static constexpr std::size_t magic_size = 8;
+    static constexpr std::uint32_t version = 1;
+    static constexpr std::uint32_t byte_order = 0x01020304;
+    static constexpr std::size_t header_size = 64;
+    static constexpr std::size_t trailer_size = 24;
+    static constexpr std::size_t alignment = 64;
+    
+    static const char * magic() noexcept { return "ENGUCOL"; }
+};
+
+template<class T>
+void put_raw( std::string & out, const T & x )
+{
+    out.append( reinterpret_cast<const char*>( &x ), sizeof( x ) );
+}
+
+inline void put_string( std::string & out, const std::string & s )
+{
+    put_raw( out, std::uint32_t( s.size() ) );
+    out.append( s );
+}
+
+/**
+ * @internal
+ * @brief Bounds checked reader of the column directory
+ */
+struct columnar_parser
+{
+    const char * first;
+    const char * last;
+    
+    template<class T>
+    T get()
+    {
+        T x;
+        check( sizeof( T ) );
+        std::memcpy( &x, first, sizeof( T ) );
+        first += sizeof( T );
+        return x;
+    }
+    
+    std::string get_string()
+    {
+        const std::uint32_t n = get<std::uint32_t>();
+        check( n );
+        std::string s( first, n );
+        first += n;
+        return s;
+    }
+    
+    void check( std::size_t n ) const
+    {
+        if ( std::size_t( last - first ) < n )
+            throw std::runtime_error( "columnar: corrupt column directory" );
+    }
+};
+
+}
+
+/**
+ * @addtogroup io
+ * @{
+ */
+
+/**
+ * @brief Description of a column stored in a columnar file.
+ */
+struct column_info
+{
+    /**
+     * @brief Name of the column
+     */
+    std::string name;
+    
+    /**
+     * @brief 'f' for floating point, 'i' for signed and 'u' for unsigned integers
+     */
+    char value_kind;
+    
+    /**
+     * @brief Size of each value, in bytes
+     */
+    std::uint8_t value_size;
+    
+    /**
+     * @brief Unit of the stored values
+     */
+    unit_descriptor unit;
+    
+    /**
+     * @brief Offset of the first value from the beginning of the file
+     */
+    std::uint64_t offset;
+    
+    /**
+     * @brief Number of values
+     */
+    std::uint64_t count;
+};
+
+/**
+ * @brief Write arrays of quantities to a self-describing binary file.
+ * 
+ * Each column is written as a contiguous array of values, together with
+ * the value type and the description of its unit (see @c unit_descriptor).
+ * The directory of the columns is written by @c close, or by the destructor.
+ * 
+ * Values are stored in the byte order of the machine that writes them.
+ * 
+ * @code{.cpp}
+ *   column_writer w( "flight.engu" );
+ *   w.write( "altitude", altitude.begin(), altitude.end() );   // quantity<float, imperial::foot>
+ *   w.write( "pressure", pressure.begin(), pressure.end() );   // quantity<double, si::pascal>
+ *   w.close();
+ * @endcode
+ * 
+ * @sa column_reader
+ */
+class column_writer
+{
+public:
+    /**
+     * @brief Create the file @p path, or truncate it.
+     * @throw std::ios_base::failure on I/O errors.
+     */
+    explicit column_writer( const std::string & path ) :
+        out_( path, std::ios::binary | std::ios::trunc )
+    {
+        out_.exceptions( std::ios::failbit | std::ios::badbit );
+        
+        char header[ detail::columnar_format::header_size ] = {};
+        const std::uint32_t version = detail::columnar_format::version;
+        const std::uint32_t byte_order = detail::columnar_format::byte_order;
+        
+        std::memcpy( header, detail::columnar_format::magic(), detail::columnar_format::magic_size );
+        std::memcpy( header + 8, &version, 4 );
+        std::memcpy( header + 12, &byte_order, 4 );
+        
+        out_.write( header, sizeof( header ) );
+        position_ = sizeof( header );
+    }
+    
+    column_writer( const column_writer & ) = delete;
+    column_writer & operator=( const column_writer & ) = delete;
+    
+    ~column_writer()
+    {
+        try
+        {
+            close();
+        }
+        catch ( ... ) {}
+    }
+    
+    /**
+     * @brief Append a column
+     * @param name Name of the column, must be unique in the file
+     * @param first,last Range of quantities, the unit is taken from the 
+     *   iterator @c value_type.
+     * @throw std::invalid_argument if a column called @p name already exists.
+     */
+    template<class InputIt>
+    void write( const std::string & name, InputIt first, InputIt last )
+    {
+        typedef std::decay_t< typename std::iterator_traits<InputIt>::value_type > quantity_type;
+        typedef typename quantity_type::value_type value_type;
+        
+        static_assert( detail::is_quantity_v<quantity_type>, "Can only write quantities" );
+        
+        if ( std::any_of( columns_.begin(), columns_.end(), 
+                          [&]( const column_info & c ) { return c.name == name; } ) )
+        {
+            throw std::invalid_argument( "columnar: duplicate column " + name );
+        }
+        
+        pad_to( detail::columnar_format::alignment );
+        
+        column_info info;
+        info.name = name;
+        info.value_kind = detail::value_kind<value_type>::value;
+        info.value_size = sizeof( value_type );
+        info.unit = describe_unit( typename quantity_type::unit_type {} );
+        info.offset = position_;
+        info.count = 0;
+        
+        value_type buffer[ 1024 ];
+        std::size_t n = 0;
+        
+        for ( ; first != last; ++first )
+        {
+            buffer[ n++ ] = first->value();
+            
+            if ( n == 1024 )
+            {
+                flush( buffer, n );
+                info.count += n;
+                n = 0;
+            }
+        }
+        
+        flush( buffer, n );
+        info.count += n;
+        
+        columns_.push_back( std::move( info ) );
+    }
+    
+    /**
+     * @brief Write the column directory and close the file
+     */
+    void close()
+    {
+        if ( !out_.is_open() )
+            return;
+        
+        const std::uint64_t directory = position_;
+        
+        std::string buffer;
+        
+        for ( const column_info & c : columns_ )
+        {
+            detail::put_string( buffer, c.name );
+            detail::put_raw( buffer, c.value_kind );
+            detail::put_raw( buffer, c.value_size );
+            detail::put_raw( buffer, double( c.unit.scale ) );
+            detail::put_string( buffer, c.unit.symbol );
+            detail::put_raw( buffer, std::uint32_t( c.unit.dimensions.size() ) );
+            
+            for ( const unit_dimension & d : c.unit.dimensions )
+            {
+                detail::put_string( buffer, d.symbol );
+                detail::put_raw( buffer, std::int64_t( d.num ) );
+                detail::put_raw( buffer, std::int64_t( d.den ) );
+            }
+            
+            detail::put_raw( buffer, c.offset );
+            detail::put_raw( buffer, c.count );
+        }
+        
+        detail::put_raw( buffer, directory );
+        detail::put_raw( buffer, std::uint64_t( columns_.size() ) );
+        buffer.append( detail::columnar_format::magic(), detail::columnar_format::magic_size );
+        
+        out_.write( buffer.data(), std::streamsize( buffer.size() ) );
+        out_.close();
+    }
+    
+private:
+    template<class T>
+    void flush( const T * p, std::size_t n )
+    {
+        out_.write( reinterpret_cast<const char*>( p ), std::streamsize( n * sizeof( T ) ) );
+        position_ += n * sizeof( T );
+    }
+    
+    void pad_to( std::size_t alignment )
+    {
+        const char zeros[ detail::columnar_format::alignment ] = {};
+        
+        const std::size_t pad = ( alignment - position_ % alignment ) % alignment;
+        out_.write( zeros, std::streamsize( pad ) );
+        position_ += pad;
+    }
+    
+    std::ofstream out_;
+    std::uint64_t position_ = 0;
+    std::vector< column_info > columns_;
+};
+
+/**
+ * @brief Typed view of a column, in the unit of @p Q
+ * 
+ * The values are not copied out of the file. If the stored unit differs 
+ * from the unit of @p Q, the conversion factor is applied when each value 
+ * is accessed, or all at once by @c convert.
+ * 
+ * @warning The view is only valid while the @c column_reader is alive.
+ * @sa column_reader::column
+ */
+template<class Q>
+class column_view
+{
+    static_assert( detail::is_quantity_v<Q>, "column_view of a non-quantity" );
+    
+public:
+    typedef Q quantity_type;
+    typedef typename Q::value_type value_type;
+    typedef detail::scale_factor_t<value_type> factor_type;
+    
+    /**
+     * @brief Random access iterator that yields @p Q by value.
+     */
+    class const_iterator
+    {
+    public:
+        typedef std::random_access_iterator_tag iterator_category;
+        typedef Q value_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef const Q * pointer;
+        typedef Q reference;
+        
+        const_iterator() = default;
+        
+        Q operator*() const { return Q( detail::scale_value( *p_, factor_ ) ); }
+        Q operator[]( difference_type n ) const { return Q( detail::scale_value( p_[n], factor_ ) ); }
+        
+        const_iterator & operator++() { ++p_; return *this; }
+        const_iterator & operator--() { --p_; return *this; }
+        const_iterator operator++(int) { const_iterator t = *this; ++p_; return t; }
+        const_iterator operator--(int) { const_iterator t = *this; --p_; return t; }
+        const_iterator & operator+=( difference_type n ) { p_ += n; return *this; }
+        const_iterator & operator-=( difference_type n ) { p_ -= n; return *this; }
+        
+        friend const_iterator operator+( const_iterator i, difference_type n ) { return i += n; }
+        friend const_iterator operator+( difference_type n, const_iterator i ) { return i += n; }
+        friend const_iterator operator-( const_iterator i, difference_type n ) { return i -= n; }
+        friend difference_type operator-( const const_iterator & l, const const_iterator & r ) { return l.p_ - r.p_; }
+        
+        friend bool operator==( const const_iterator & l, const const_iterator & r ) { return l.p_ == r.p_; }
+        friend bool operator!=( const const_iterator & l, const const_iterator & r ) { return l.p_ != r.p_; }
+        friend bool operator<( const const_iterator & l, const const_iterator & r ) { return l.p_ < r.p_; }
+        friend bool operator>( const const_iterator & l, const const_iterator & r ) { return l.p_ > r.p_; }
+        friend bool operator<=( const const_iterator & l, const const_iterator & r ) { return l.p_ <= r.p_; }
+        friend bool operator>=( const const_iterator & l, const const_iterator & r ) { return l.p_ >= r.p_; }
+        
+    private:
+        friend class column_view;
+        
+        const_iterator( const typename Q::value_type * p, factor_type factor ) :
+            p_( p ),
+            factor_( factor )
+        {}
+        
+        const typename Q::value_type * p_ = nullptr;
+        factor_type factor_ = 1;
+    };
+    
+    column_view() = default;
+    
+    column_view( const value_type * data, std::size_t size, factor_type factor ) :
+        data_( data ),
+        size_( size ),
+        factor_( factor )
+    {}
+    
+    std::size_t size() const noexcept { return size_; }
+    bool empty() const noexcept { return size_ == 0; }
+    
+    Q operator[]( std::size_t i ) const { return Q( detail::scale_value( data_[i], factor_ ) ); }
+    
+    const_iterator begin() const { return const_iterator( data_, factor_ ); }
+    const_iterator end() const { return const_iterator( data_ + size_, factor_ ); }
+    
+    /**
+     * @brief The values as stored in the file, in the stored unit.
+     */
+    const value_type * raw() const noexcept { return data_; }
+    
+    /**
+     * @brief Factor from the stored unit to the unit of @p Q
+     * 
+     * Integral values are scaled in @c long double and rounded to the 
+     * nearest integer.
+     */
+    factor_type factor() const noexcept { return factor_; }
+    
+    /**
+     * @brief True if the stored unit is not the unit of @p Q
+     */
+    bool needs_conversion() const noexcept { return factor_ != factor_type( 1 ); }
+    
+    /**
+     * @brief Convert all the values, and write them to @p d_first
+     * @return Output iterator to the element past the last written.
+     */
+    template<class OutputIt>
+    OutputIt convert( OutputIt d_first ) const
+    {
+        const value_type * first = data_;
+        const factor_type f = factor_;
+        
+        if ( !needs_conversion() )
+        {
+            for ( std::size_t i = 0; i < size_; ++i, ++d_first )
+                *d_first = Q( first[i] );
+        }
+        else
+        {
+            for ( std::size_t i = 0; i < size_; ++i, ++d_first )
+                *d_first = Q( detail::scale_value( first[i], f ) );
+        }
+        
+        return d_first;
+    }
+    
+private:
+    const value_type * data_ = nullptr;
+    std::size_t size_ = 0;
+    factor_type factor_ = 1;
+};
+
+/**
+ * @brief Read a file written by @c column_writer
+ * 
+ * The file is memory mapped, and the columns are returned as views
+ * over the mapped memory.
+ * 
+ * @code{.cpp}
+ *   column_reader r( "flight.engu" );
+ * 
+ *   // Stored in feet, read in meters.
+ *   column_view< quantity<float, si::meter> > altitude = r.column< quantity<float, si::meter> >( "altitude" );
+ * 
+ *   std::vector< quantity<float, si::meter> > meters( altitude.size() );
+ *   altitude.convert( meters.begin() );
+ * @endcode
+ * 
+ * @sa column_writer
+ */
+class column_reader
+{
+public:
+    /**
+     * @brief Open and validate the file @p path
+     * @throw std::system_error if the file can not be opened.
+     * @throw std::runtime_error if the file is not valid.
+     */
+    explicit column_reader( const std::string & path ) :
+        file_( path )
+    {
+        typedef detail::columnar_format format;
+        
+        const char * data = file_.data();
+        const std::size_t size = file_.size();
+        
+        if ( size < format::header_size + format::trailer_size ||
+             std::memcmp( data, format::magic(), format::magic_size ) != 0 ||
+             std::memcmp( data + size - format::magic_size, format::magic(), format::magic_size ) != 0 )
+        {
+            throw std::runtime_error( "columnar: not a columnar file" );
+        }
+        
+        detail::columnar_parser header { data + 8, data + format::header_size };
+        
+        if ( header.get<std::uint32_t>() != format::version )
+            throw std::runtime_error( "columnar: unsupported version" );
+        
+        if ( header.get<std::uint32_t>() != format::byte_order )
+            throw std::runtime_error( "columnar: file written with a different byte order" );
+        
+        detail::columnar_parser trailer { data + size - format::trailer_size, data + size };
+        
+        const std::uint64_t directory = trailer.get<std::uint64_t>();
+        const std::uint64_t count = trailer.get<std::uint64_t>();
+        
+        if ( directory > size - format::trailer_size )
+            throw std::runtime_error( "columnar: corrupt column directory" );
+        
+        detail::columnar_parser p { data + directory, data + size - format::trailer_size };
+        
+        for ( std::uint64_t i = 0; i < count; ++i )
+        {
+            column_info c;
+            
+            c.name = p.get_string();
+            c.value_kind = p.get<char>();
+            c.value_size = p.get<std::uint8_t>();
+            c.unit.scale = p.get<double>();
+            c.unit.symbol = p.get_string();
+            
+            const std::uint32_t dimensions = p.get<std::uint32_t>();
+            
+            for ( std::uint32_t j = 0; j < dimensions; ++j )
+            {
+                unit_dimension d;
+                d.symbol = p.get_string();
+                d.num = p.get<std::int64_t>();
+                d.den = p.get<std::int64_t>();
+                c.unit.dimensions.push_back( std::move( d ) );
+            }
+            
+            c.offset = p.get<std::uint64_t>();
+            c.count = p.get<std::uint64_t>();
+            
+            if ( c.value_size == 0 ||
+                 c.offset % c.value_size != 0 ||
+                 c.offset > directory ||
+                 c.count > ( directory - c.offset ) / c.value_size )
+            {
+                throw std::runtime_error( "columnar: corrupt column " + c.name );
+            }
+            
+            columns_.push_back( std::move( c ) );
+        }
+    }
+    
+    /**
+     * @brief Number of columns in the file
+     */
+    std::size_t size() const noexcept
+    {
+        return columns_.size();
+    }
+    
+    /**
+     * @brief Description of the @p i -th column
+     */
+    const column_info & info( std::size_t i ) const
+    {
+        return columns_.at( i );
+    }
+    
+    /**
+     * @brief Find a column by name
+     * @return nullptr if there is no such column.
+     */
+    const column_info * find( const std::string & name ) const noexcept
+    {
+        auto it = std::find_if( columns_.begin(), columns_.end(),
+                                [&]( const column_info & c ) { return c.name == name; } );
+        
+        return it == columns_.end() ? nullptr : &*it;
+    }
+    
+    /**
+     * @brief Get a typed view of the column @p name
+     * @tparam Q The quantity to read, its unit must have the same dimensions
+     *  as the stored unit, and its @c value_type must be the stored one.
+     * @throw std::out_of_range if there is no such column.
+     * @throw std::runtime_error if the type or the dimensions do not match.
+     */
+    template<class Q>
+    column_view<Q> column( const std::string & name ) const
+    {
+        typedef typename Q::value_type value_type;
+        
+        const column_info * c = find( name );
+        
+        if ( c == nullptr )
+            throw std::out_of_range( "columnar: no column " + name );
+        
+        if ( c->value_kind != detail::value_kind<value_type>::value ||
+             c->value_size != sizeof( value_type ) )
+        {
+            throw std::runtime_error( "columnar: value type mismatch in column " + name );
+        }
+        
+        const unit_descriptor target = describe_unit( typename Q::unit_type {} );
+        
+        if ( !c->unit.same_dimensions( target ) )
+            throw std::runtime_error( "columnar: can not convert " + c->unit.symbol + 
+                                      " to " + target.symbol + " in column " + name );
+        
+        // Both scales go through double, so that identical units give exactly 1
+        const auto factor = typename column_view<Q>::factor_type( double( c->unit.scale ) / double( target.scale ) );
+        
+        return column_view<Q>( reinterpret_cast<const value_type*>( file_.data() + c->offset ), 
+                               std::size_t( c->count ), 
+                               factor );
+    }
+    
+private:
+    detail::mapped_file file_;
+    std::vector< column_info > columns_;
+};
+
+/** @} */
+
+}
+
+#endif //ENGINEERING_UNITS_IO_COLUMNAR_HPP
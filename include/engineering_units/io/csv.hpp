@@ -0,0 +1,551 @@
+/*
+ * Boost Software License - Version 1.0 - August 17th, 2003
+ *
+ * Permission is hereby granted, free of charge, to any person or organization
+ * obtaining a copy of the software and accompanying documentation covered by
+ * this license (the "Software") to use, reproduce, display, distribute,
+ * execute, and transmit the Software, and to prepare derivative works of the
+ * Software, and to permit third-parties to whom the Software is furnished to
+ * do so, all subject to the following:
+ *
+ * The copyright notices in the Software and this entire statement, including
+ * the above license grant, this restriction and the following disclaimer,
+ * must be included in all copies of the Software, in whole or in part, and
+ * all derivative works of the Software, unless such copies or derivative
+ * works are solely in the form of machine-executable object code generated by
+ * a source language processor.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+ * SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+ * FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef ENGINEERING_UNITS_IO_CSV_HPP
+#define ENGINEERING_UNITS_IO_CSV_HPP
+
+#include <algorithm>
+#include <cerrno>
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
+#include <exception>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#if __cplusplus >= 201703L && defined(__has_include)
+#if __has_include(<charconv>)
+#include <charconv>
+#if defined(__cpp_lib_to_chars) && __cpp_lib_to_chars >= 201611L
+#define ENGUNITS_HAS_FROM_CHARS 1
+#endif
+#endif
+#endif
+
+#include <engineering_units/quantity.hpp>
+#include <engineering_units/predefined_units.hpp>
+#include <engineering_units/unit/descriptor.hpp>
+#include <engineering_units/unit/registry.hpp>
+
+#include <engineering_units/detail/doxygen.hpp>
+#include <engineering_units/detail/mapped_file.hpp>
+#include <engineering_units/detail/scale.hpp>
+
+namespace engunits
+{
+
+namespace detail
+{
+
+#ifdef ENGUNITS_HAS_FROM_CHARS
+
+template<class T>
+bool parse_number( const char * first, const char * last, T & x )
+{
+    if ( first != last && *first == '+' )
+        ++first;
+    
+    const std::from_chars_result r = std::from_chars( first, last, x );
+    return r.ec == std::errc() && r.ptr == last;
+}
+
+#else
+
+inline void strto( const char * s, char ** end, float & x ) { x = std::strtof( s, end ); }
+inline void strto( const char * s, char ** end, double & x ) { x = std::strtod( s, end ); }
+inline void strto( const char * s, char ** end, long double & x ) { x = std::strtold( s, end ); }
+
+template<class T>
+std::enable_if_t< std::is_signed<T>::value > strto( const char * s, char ** end, T & x )
+{
+    x = T( std::strtoll( s, end, 10 ) );
+}
+
+template<class T>
+std::enable_if_t< std::is_unsigned<T>::value > strto( const char * s, char ** end, T & x )
+{
+    x = T( std::strtoull( s, end, 10 ) );
+}
+
+// The mapped fields are not null terminated, they are copied to the stack first
+template<class T>
+bool parse_number( const char * first, const char * last, T & x )
+{
+    char buffer[ 64 ];
+    const std::size_t n = std::size_t( last - first );
+    
+    if ( n == 0 || n >= sizeof( buffer ) )
+        return false;
+    
+    std::memcpy( buffer, first, n );
+    buffer[n] = '\0';
+    
+    char * end;
+    errno = 0;
+    strto( buffer, &end, x );
+    
+    return errno == 0 && end == buffer + n;
+}
+
+#endif
+
+inline bool is_csv_space( char c )
+{
+    return c == ' ' || c == '\t' || c == '\r';
+}
+
+inline void trim( const char * & first, const char * & last )
+{
+    while ( first != last && is_csv_space( *first ) )
+        ++first;
+    
+    while ( last != first && is_csv_space( *( last - 1 ) ) )
+        --last;
+}
+
+inline const char * end_of_line( const char * first, const char * last )
+{
+    const void * p = std::memchr( first, '\n', std::size_t( last - first ) );
+    return p == nullptr ? last : static_cast<const char*>( p );
+}
+
+inline bool is_blank( const char * first, const char * last )
+{
+    trim( first, last );
+    return first == last;
+}
+
+/**
+ * @internal
+ * @brief Destination of the values of a column
+ */
+struct csv_sink
+{
+    virtual ~csv_sink() = default;
+    virtual void resize( std::size_t rows ) = 0;
+    virtual bool store( std::size_t row, const char * first, const char * last ) = 0;
+};
+
+template<class T, class Allocator>
+class csv_vector_sink : public csv_sink
+{
+public:
+    typedef value_type_t<T> value_type;
+    typedef scale_factor_t<value_type> factor_type;
+    
+    csv_vector_sink( std::vector<T, Allocator> & out, factor_type factor ) :
+        out_( out ),
+        factor_( factor )
+    {}
+    
+    void resize( std::size_t rows ) override
+    {
+        out_.resize( rows );
+        data_ = out_.data();
+    }
+    
+    bool store( std::size_t row, const char * first, const char * last ) override
+    {
+        value_type x;
+        
+        if ( !parse_number( first, last, x ) )
+            return false;
+        
+        data_[row] = T( scale_value( x, factor_ ) );
+        return true;
+    }
+    
+private:
+    std::vector<T, Allocator> & out_;
+    T * data_ = nullptr;
+    factor_type factor_;
+};
+
+}
+
+/**
+ * @addtogroup io
+ * @{
+ */
+
+/**
+ * @brief Reader of numeric CSV files with units in the header
+ * 
+ * The first line of the file names the columns, each optionally followed by
+ * its unit in square brackets:
+ * 
+ * @code{.unparsed}
+ *   time, altitude [ft], pressure [hPa]
+ *   0.0, 1500, 1013.2
+ *   0.1, 1502, 1013.1
+ * @endcode
+ * 
+ * The units are parsed with a @c unit_registry, by default 
+ * @c predefined_units(). Columns are bound to vectors of quantities, and 
+ * each value is converted to the unit of the vector with a single 
+ * multiplication by a factor computed once per column.
+ * 
+ * @code{.cpp}
+ *   csv_reader csv( "flight.csv" );
+ * 
+ *   std::vector< quantity<float, si::meter> > altitude;
+ *   std::vector< quantity<float, si::pascal> > pressure;
+ * 
+ *   csv.bind( "altitude", altitude );
+ *   csv.bind( "pressure", pressure );
+ *   csv.read();
+ * @endcode
+ * 
+ * The file is memory mapped and split in chunks at line boundaries, which
+ * are decoded in parallel directly into the bound vectors. Fields are plain
+ * numbers: quotes and escapes are not supported.
+ */
+class csv_reader
+{
+public:
+    /**
+     * @brief Open @p path and parse its header
+     * @throw std::system_error if the file can not be opened.
+     * 
+     * A header unit that is not in @p units only makes the reader
+     * throw if that column is bound to a quantity.
+     */
+    explicit csv_reader( const std::string & path, 
+                         const unit_registry & units = predefined_units() ) :
+        file_( path )
+    {
+        const char * first = file_.data();
+        const char * last = first + file_.size();
+        
+        if ( first == last )
+        {
+            body_ = last;
+            return;
+        }
+        
+        const char * eol = detail::end_of_line( first, last );
+        body_ = eol == last ? last : eol + 1;
+        
+        while ( first != eol )
+        {
+            const void * p = std::memchr( first, ',', std::size_t( eol - first ) );
+            const char * field_end = p == nullptr ? eol : static_cast<const char*>( p );
+            
+            columns_.push_back( parse_header( first, field_end, units ) );
+            
+            first = field_end == eol ? eol : field_end + 1;
+        }
+        
+        sinks_.resize( columns_.size() );
+    }
+    
+    /**
+     * @brief Number of columns
+     */
+    std::size_t columns() const noexcept
+    {
+        return columns_.size();
+    }
+    
+    /**
+     * @brief Name of the @p i -th column, without the unit
+     */
+    const std::string & name( std::size_t i ) const
+    {
+        return columns_.at( i ).name;
+    }
+    
+    /**
+     * @brief Unit of the @p i -th column, dimensionless if there was none.
+     * @throw std::invalid_argument if the unit was not in the registry.
+     */
+    const unit_descriptor & unit( std::size_t i ) const
+    {
+        const column & c = columns_.at( i );
+        
+        if ( !c.error.empty() )
+            throw std::invalid_argument( c.error );
+        
+        return c.unit;
+    }
+    
+    /**
+     * @brief Decode the column @p name into @p out, when @c read is called.
+     * @param name Name of the column
+     * @param out Either a vector of quantities, whose unit must have the same
+     *  dimensions as the column, or a vector of plain numbers, which receive 
+     *  the values as written.
+     * @throw std::out_of_range if there is no such column.
+     * @throw std::invalid_argument if the header unit could not be parsed.
+     * @throw std::runtime_error if the units do not have the same dimensions.
+     * 
+     * @p out must be alive when @c read is called. It can have any 
+     * allocator, such as an @c arena_allocator, so that the columns of each
+     * file go to memory that is recycled.
+     */
+    template<class T, class Allocator>
+    void bind( const std::string & name, std::vector<T, Allocator> & out )
+    {
+        const std::size_t i = index( name );
+        
+        sinks_[i].reset( new detail::csv_vector_sink<T, Allocator>( out, factor<T>( i, std::integral_constant<bool, detail::is_quantity_v<T>>{} ) ) );
+    }
+    
+    /**
+     * @brief Decode all the bound columns
+     * @param threads Number of threads, all the hardware threads if 0.
+     * @return The number of rows, blank lines excluded.
+     * @throw std::runtime_error if a field is not a number, or a line does 
+     *  not have as many fields as the header.
+     */
+    std::size_t read( unsigned threads = 0 )
+    {
+        const char * first = body_;
+        const char * last = file_.data() + file_.size();
+        
+        if ( first == last )
+            return 0;
+        
+        file_.advise_sequential();
+        
+        if ( threads == 0 )
+            threads = std::max( 1u, std::thread::hardware_concurrency() );
+        
+        // Not worth a thread for less than 1MiB
+        const std::size_t min_chunk = std::size_t( 1 ) << 20;
+        const std::size_t n = std::max<std::size_t>( 1, 
+            std::min<std::size_t>( threads, std::size_t( last - first ) / min_chunk ) );
+        
+        std::vector<const char*> bounds( 1, first );
+        
+        for ( std::size_t k = 1; k < n; ++k )
+        {
+            const char * p = detail::end_of_line( std::max( bounds.back(), first + ( last - first ) * k / n ), last );
+            bounds.push_back( p == last ? last : p + 1 );
+        }
+        
+        bounds.push_back( last );
+        
+        std::vector<std::size_t> rows( n + 1, 0 );
+        
+        parallel( n, [&]( std::size_t k ) 
+        { 
+            rows[k + 1] = count_rows( bounds[k], bounds[k + 1] ); 
+        } );
+        
+        for ( std::size_t k = 0; k < n; ++k )
+            rows[k + 1] += rows[k];
+        
+        for ( auto & s : sinks_ )
+            if ( s )
+                s->resize( rows[n] );
+        
+        parallel( n, [&]( std::size_t k ) 
+        { 
+            parse_rows( bounds[k], bounds[k + 1], rows[k] ); 
+        } );
+        
+        return rows[n];
+    }
+    
+private:
+    struct column
+    {
+        std::string name;
+        unit_descriptor unit;
+        std::string error;
+    };
+    
+    static column parse_header( const char * first, const char * last, const unit_registry & units )
+    {
+        column result;
+        
+        detail::trim( first, last );
+        
+        const char * open = std::find( first, last, '[' );
+        const char * name_end = open;
+        
+        detail::trim( first, name_end );
+        result.name.assign( first, name_end );
+        
+        if ( open == last )
+            return result;
+        
+        const char * close = std::find( open, last, ']' );
+        
+        try
+        {
+            if ( close == last )
+                throw std::invalid_argument( "csv_reader: missing ] in " + std::string( first, last ) );
+            
+            ++open;
+            detail::trim( open, close );
+            result.unit = units.parse( std::string( open, close ) );
+        }
+        catch ( const std::invalid_argument & e )
+        {
+            result.error = e.what();
+        }
+        
+        return result;
+    }
+    
+    std::size_t index( const std::string & name ) const
+    {
+        for ( std::size_t i = 0; i < columns_.size(); ++i )
+            if ( columns_[i].name == name )
+                return i;
+        
+        throw std::out_of_range( "csv_reader: no column " + name );
+    }
+    
+    template<class Q>
+    detail::scale_factor_t< typename Q::value_type > factor( std::size_t i, std::true_type ) const
+    {
+        const unit_descriptor & from = unit( i );
+        const unit_descriptor to = describe_unit( typename Q::unit_type {} );
+        
+        if ( !from.same_dimensions( to ) )
+            throw std::runtime_error( "csv_reader: can not convert " + from.symbol + 
+                                      " to " + to.symbol + " in column " + columns_[i].name );
+        
+        return detail::scale_factor_t< typename Q::value_type >( conversion_factor( from, to ) );
+    }
+    
+    template<class T>
+    detail::scale_factor_t<T> factor( std::size_t, std::false_type ) const
+    {
+        static_assert( std::is_arithmetic<T>::value, "csv_reader can only decode numbers" );
+        return detail::scale_factor_t<T>( 1 );
+    }
+    
+    template<class F>
+    static void parallel( std::size_t n, F f )
+    {
+        std::vector< std::exception_ptr > errors( n );
+        std::vector< std::thread > threads;
+        
+        auto task = [&]( std::size_t k )
+        {
+            try
+            {
+                f( k );
+            }
+            catch ( ... )
+            {
+                errors[k] = std::current_exception();
+            }
+        };
+        
+        for ( std::size_t k = 1; k < n; ++k )
+            threads.emplace_back( task, k );
+        
+        task( 0 );
+        
+        for ( auto & t : threads )
+            t.join();
+        
+        for ( auto & e : errors )
+            if ( e )
+                std::rethrow_exception( e );
+    }
+    
+    static std::size_t count_rows( const char * first, const char * last )
+    {
+        std::size_t n = 0;
+        
+        while ( first != last )
+        {
+            const char * eol = detail::end_of_line( first, last );
+            
+            if ( !detail::is_blank( first, eol ) )
+                ++n;
+            
+            first = eol == last ? last : eol + 1;
+        }
+        
+        return n;
+    }
+    
+    void parse_rows( const char * first, const char * last, std::size_t row ) const
+    {
+        const std::size_t n = columns_.size();
+        
+        while ( first != last )
+        {
+            const char * eol = detail::end_of_line( first, last );
+            
+            if ( !detail::is_blank( first, eol ) )
+            {
+                const char * field = first;
+                
+                for ( std::size_t c = 0; c < n; ++c )
+                {
+                    const void * p = std::memchr( field, ',', std::size_t( eol - field ) );
+                    const char * field_end = p == nullptr ? eol : static_cast<const char*>( p );
+                    
+                    if ( field_end == eol && c + 1 != n )
+                        throw std::runtime_error( "csv_reader: too few fields in row " + std::to_string( row + 1 ) );
+                    
+                    if ( sinks_[c] )
+                    {
+                        const char * b = field;
+                        const char * e = field_end;
+                        detail::trim( b, e );
+                        
+                        if ( !sinks_[c]->store( row, b, e ) )
+                            throw std::runtime_error( "csv_reader: bad number in row " + std::to_string( row + 1 ) +
+                                                      ", column " + columns_[c].name );
+                    }
+                    
+                    field = field_end + 1;
+                }
+                
+                if ( field <= eol )
+                    throw std::runtime_error( "csv_reader: too many fields in row " + std::to_string( row + 1 ) );
+                
+                ++row;
+            }
+            
+            first = eol == last ? last : eol + 1;
+        }
+    }
+    
+    detail::mapped_file file_;
+    const char * body_ = nullptr;
+    std::vector< column > columns_;
+    std::vector< std::unique_ptr< detail::csv_sink > > sinks_;
+};
+
+/** @} */
+
+}
+
+#endif //ENGINEERING_UNITS_IO_CSV_HPP
@@ -0,0 +1,352 @@
+/*
+ * Boost Software License - Version 1.0 - August 17th, 2003
+ *
+ * Permission is hereby granted, free of charge, to any person or organization
+ * obtaining a copy of the software and accompanying documentation covered by
+ * this license (the "Software") to use, reproduce, display, distribute,
+ * execute, and transmit the Software, and to prepare derivative works of the
+ * Software, and to permit third-parties to whom the Software is furnished to
+ * do so, all subject to the following:
+ *
+ * The copyright notices in the Software and this entire statement, including
+ * the above license grant, this restriction and the following disclaimer,
+ * must be included in all copies of the Software, in whole or in part, and
+ * all derivative works of the Software, unless such copies or derivative
+ * works are solely in the form of machine-executable object code generated by
+ * a source language processor.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+ * SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+ * FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef ENGINEERING_UNITS_IO_SERIALIZE_HPP
+#define ENGINEERING_UNITS_IO_SERIALIZE_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <initializer_list>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <engineering_units/quantity.hpp>
+#include <engineering_units/unit/dimension_hash.hpp>
+
+#include <engineering_units/detail/doxygen.hpp>
+#include <engineering_units/detail/scale.hpp>
+#include <engineering_units/detail/value_kind.hpp>
+
+namespace engunits
+{
+
+/**
+ * @addtogroup io
+ * @{
+ */
+
+/**
+ * @brief Hash of the dimensions and of the value type of the quantity @p Q
+ * 
+ * This is what @c serialize writes in front of every quantity or array of 
+ * quantities. Two quantities with the same schema hash can be converted 
+ * into each other with a single multiplication.
+ * 
+ * @sa dimension_hash_v
+ */
+template<class Q>
+constexpr std::uint64_t schema_hash_v = detail::mix64( 
+    dimension_hash_v< typename Q::unit_type > ^ 
+    detail::mix64( detail::value_tag_v< typename Q::value_type > ) );
+
+/** @} */
+
+namespace detail
+{
+
+class binary_source
+{
+public:
+    binary_source( const char * first, const char * last ) : first_( first ), last_( last ) {}
+    
+    void read( void * dst, std::size_t n )
+    {
+        if ( std::size_t( last_ - first_ ) < n )
+            throw std::runtime_error( "deserialize: truncated input" );
+        
+        std::memcpy( dst, first_, n );
+        first_ += n;
+    }
+    
+    template<class T>
+    T get()
+    {
+        T x;
+        read( &x, sizeof( x ) );
+        return x;
+    }
+    
+    const char * position() const noexcept { return first_; }
+    std::size_t remaining() const noexcept { return std::size_t( last_ - first_ ); }
+    
+private:
+    const char * first_;
+    const char * last_;
+};
+
+template<class T>
+void put( std::vector<char> & out, const T & x )
+{
+    const char * p = reinterpret_cast<const char*>( &x );
+    out.insert( out.end(), p, p + sizeof( T ) );
+}
+
+// Wire format of a field:
+//   u64 schema hash
+//   f64 scale to the root units
+//   u64 number of values, only for arrays
+//   the values
+template<class Q>
+void write_header( std::vector<char> & out )
+{
+    put( out, schema_hash_v<Q> );
+    put( out, double( unit_root_scale_v< typename Q::unit_type > ) );
+}
+
+// Factor from the sender's unit to the unit of Q
+template<class Q>
+scale_factor_t< typename Q::value_type > read_header( binary_source & in )
+{
+    if ( in.get<std::uint64_t>() != schema_hash_v<Q> )
+        throw std::runtime_error( "deserialize: incompatible dimensions or value type" );
+    
+    // Both scales go through double, so that identical units give exactly 1
+    return scale_factor_t< typename Q::value_type >( in.get<double>() / double( unit_root_scale_v< typename Q::unit_type > ) );
+}
+
+template<class Q>
+void write_values( std::vector<char> & out, const Q * first, std::size_t n )
+{
+    static_assert( std::is_trivially_copyable<Q>::value && sizeof( Q ) == sizeof( typename Q::value_type ),
+                   "Can not copy the representation of this quantity" );
+    
+    const char * p = reinterpret_cast<const char*>( first );
+    out.insert( out.end(), p, p + n * sizeof( Q ) );
+}
+
+template<class Q>
+void read_values( binary_source & in, Q * first, std::size_t n, const scale_factor_t< typename Q::value_type > & factor )
+{
+    static_assert( std::is_trivially_copyable<Q>::value && sizeof( Q ) == sizeof( typename Q::value_type ),
+                   "Can not copy the representation of this quantity" );
+    
+    in.read( first, n * sizeof( Q ) );
+    
+    if ( factor != scale_factor_t< typename Q::value_type >( 1 ) )
+        for ( std::size_t i = 0; i < n; ++i )
+            first[i] = Q( scale_value( first[i].value(), factor ) );
+}
+
+template<class T, class ... Units>
+void write( std::vector<char> & out, const quantity<T, Units...> & x );
+
+template<class T, class ... Units, class A>
+void write( std::vector<char> & out, const std::vector< quantity<T, Units...>, A > & x );
+
+template<class T, class ... Units, std::size_t N>
+void write( std::vector<char> & out, const std::array< quantity<T, Units...>, N > & x );
+
+template<class ... Ts>
+void write( std::vector<char> & out, const std::tuple<Ts...> & x );
+
+template<class A, class B>
+void write( std::vector<char> & out, const std::pair<A, B> & x );
+
+template<class T, class ... Units>
+void read( binary_source & in, quantity<T, Units...> & x );
+
+template<class T, class ... Units, class A>
+void read( binary_source & in, std::vector< quantity<T, Units...>, A > & x );
+
+template<class T, class ... Units, std::size_t N>
+void read( binary_source & in, std::array< quantity<T, Units...>, N > & x );
+
+template<class ... Ts>
+void read( binary_source & in, std::tuple<Ts...> & x );
+
+template<class A, class B>
+void read( binary_source & in, std::pair<A, B> & x );
+
+template<class T, class ... Units>
+void write( std::vector<char> & out, const quantity<T, Units...> & x )
+{
+    write_header< quantity<T, Units...> >( out );
+    write_values( out, &x, 1 );
+}
+
+template<class T, class ... Units, class A>
+void write( std::vector<char> & out, const std::vector< quantity<T, Units...>, A > & x )
+{
+    write_header< quantity<T, Units...> >( out );
+    put( out, std::uint64_t( x.size() ) );
+    write_values( out, x.data(), x.size() );
+}
+
+template<class T, class ... Units, std::size_t N>
+void write( std::vector<char> & out, const std::array< quantity<T, Units...>, N > & x )
+{
+    write_header< quantity<T, Units...> >( out );
+    put( out, std::uint64_t( N ) );
+    write_values( out, x.data(), N );
+}
+
+template<class Tuple, std::size_t ... Is>
+void write_tuple( std::vector<char> & out, const Tuple & x, std::index_sequence<Is...> )
+{
+    (void) std::initializer_list<int> { ( write( out, std::get<Is>( x ) ), 0 ) ... };
+}
+
+template<class ... Ts>
+void write( std::vector<char> & out, const std::tuple<Ts...> & x )
+{
+    write_tuple( out, x, std::index_sequence_for<Ts...>{} );
+}
+
+template<class A, class B>
+void write( std::vector<char> & out, const std::pair<A, B> & x )
+{
+    write( out, x.first );
+    write( out, x.second );
+}
+
+template<class T, class ... Units>
+void read( binary_source & in, quantity<T, Units...> & x )
+{
+    const auto factor = read_header< quantity<T, Units...> >( in );
+    read_values( in, &x, 1, factor );
+}
+
+template<class T, class ... Units, class A>
+void read( binary_source & in, std::vector< quantity<T, Units...>, A > & x )
+{
+    const auto factor = read_header< quantity<T, Units...> >( in );
+    const std::uint64_t n = in.get<std::uint64_t>();
+    
+    // Do not trust n before checking that the data is there
+    if ( n > std::uint64_t( in.remaining() ) / sizeof( T ) )
+        throw std::runtime_error( "deserialize: truncated input" );
+    
+    x.resize( std::size_t( n ) );
+    read_values( in, x.data(), x.size(), factor );
+}
+
+template<class T, class ... Units, std::size_t N>
+void read( binary_source & in, std::array< quantity<T, Units...>, N > & x )
+{
+    const auto factor = read_header< quantity<T, Units...> >( in );
+    
+    if ( in.get<std::uint64_t>() != N )
+        throw std::runtime_error( "deserialize: array size mismatch" );
+    
+    read_values( in, x.data(), N, factor );
+}
+
+template<class Tuple, std::size_t ... Is>
+void read_tuple( binary_source & in, Tuple & x, std::index_sequence<Is...> )
+{
+    (void) std::initializer_list<int> { ( read( in, std::get<Is>( x ) ), 0 ) ... };
+}
+
+template<class ... Ts>
+void read( binary_source & in, std::tuple<Ts...> & x )
+{
+    read_tuple( in, x, std::index_sequence_for<Ts...>{} );
+}
+
+template<class A, class B>
+void read( binary_source & in, std::pair<A, B> & x )
+{
+    read( in, x.first );
+    read( in, x.second );
+}
+
+}
+
+/**
+ * @addtogroup io
+ * @{
+ */
+
+/**
+ * @brief Append the binary representation of @p x to @p out
+ * @tparam T A @c quantity, a `std::vector` or `std::array` of quantities,
+ *  or a `std::tuple` or `std::pair` of any of these.
+ * 
+ * Each quantity, or array of quantities, is preceded by its 
+ * @c schema_hash_v and by the scale of its unit. Arrays are copied 
+ * with a single @c memcpy.
+ * 
+ * Values are written in the byte order of the machine, this format is meant
+ * for communication on the same host.
+ * 
+ * @code{.cpp}
+ *   std::vector<char> buffer;
+ *   serialize( std::make_tuple( 3.0_m, pressures ), buffer );
+ *   
+ *   // On the other side, maybe in feet
+ *   std::tuple< quantity<double, imperial::foot>, std::vector< quantity<double, si::pascal> > > msg;
+ *   deserialize( buffer.data(), buffer.data() + buffer.size(), msg );
+ * @endcode
+ * 
+ * @sa deserialize
+ */
+template<class T>
+void serialize( const T & x, std::vector<char> & out )
+{
+    detail::write( out, x );
+}
+
+/**
+ * @brief Return the binary representation of @p x
+ * @sa serialize
+ */
+template<class T>
+std::vector<char> serialize( const T & x )
+{
+    std::vector<char> out;
+    detail::write( out, x );
+    return out;
+}
+
+/**
+ * @brief Read @p x from the range [ @p first, @p last )
+ * @return Pointer past the last byte read
+ * @throw std::runtime_error if the schema hash of a field does not match
+ *  the one of @p T, or if the input is too short.
+ * 
+ * A quantity that was written in another unit, with the same dimensions 
+ * and value type, is converted to the unit of the destination.
+ * 
+ * @sa serialize
+ */
+template<class T>
+const char * deserialize( const char * first, const char * last, T & x )
+{
+    detail::binary_source in( first, last );
+    detail::read( in, x );
+    return in.position();
+}
+
+/** @} */
+
+}
+
+#endif //ENGINEERING_UNITS_IO_SERIALIZE_HPP
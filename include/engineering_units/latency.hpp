@@ -0,0 +1,599 @@
+/*
+ * Boost Software License - Version 1.0 - August 17th, 2003
+ *
+ * Permission is hereby granted, free of charge, to any person or organization
+ * obtaining a copy of the software and accompanying documentation covered by
+ * this license (the "Software") to use, reproduce, display, distribute,
+ * execute, and transmit the Software, and to prepare derivative works of the
+ * Software, and to permit third-parties to whom the Software is furnished to
+ * do so, all subject to the following:
+ *
+ * The copyright notices in the Software and this entire statement, including
+ * the above license grant, this restriction and the following disclaimer,
+ * must be included in all copies of the Software, in whole or in part, and
+ * all derivative works of the Software, unless such copies or derivative
+ * works are solely in the form of machine-executable object code generated by
+ * a source language processor.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+ * SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+ * FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef ENGINEERING_UNITS_LATENCY_HPP
+#define ENGINEERING_UNITS_LATENCY_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#if !defined(ENGUNITS_NO_RDTSC) && ( defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86) )
+#define ENGUNITS_HAS_RDTSC 1
+#if defined(_MSC_VER)
+#include <intrin.h>
+#else
+#include <x86intrin.h>
+#endif
+#endif
+
+#include <engineering_units/quantity.hpp>
+#include <engineering_units/chrono.hpp>
+#include <engineering_units/io.hpp>
+#include <engineering_units/time.hpp>
+
+#include <engineering_units/detail/doxygen.hpp>
+
+/**
+ * @def ENGUNITS_MAX_LATENCY_SITES
+ * @brief Maximum number of @c latency_site objects in a program
+ */
+#ifndef ENGUNITS_MAX_LATENCY_SITES
+#define ENGUNITS_MAX_LATENCY_SITES 256
+#endif
+
+namespace engunits
+{
+
+/**
+ * @brief The fastest clock of the platform, for latency measurements.
+ * 
+ * Reads the time stamp counter on x86, unless `ENGUNITS_NO_RDTSC` is
+ * defined, and `std::chrono::steady_clock` elsewhere. The length of a 
+ * tick of the time stamp counter is calibrated against `steady_clock`,
+ * the first time @c period is called; call it at startup to pay the 
+ * 10 ms of the calibration there.
+ * 
+ * @note The time stamp counter is assumed to be invariant, that is to tick at
+ *  a constant rate on all the cores, as it does on x86 processors of the last
+ *  fifteen years.
+ */
+struct tick_clock
+{
+    /**
+     * @brief Current time, in ticks
+     */
+    static std::uint64_t now() noexcept
+    {
+#if defined(ENGUNITS_HAS_RDTSC)
+        return __rdtsc();
+#else
+        return std::uint64_t( std::chrono::steady_clock::now().time_since_epoch().count() );
+#endif
+    }
+    
+    /**
+     * @brief The length of a tick
+     */
+    static quantity<double, second> period()
+    {
+        static const quantity<double, second> result = calibrate();
+        return result;
+    }
+    
+private:
+    static quantity<double, second> calibrate()
+    {
+#if defined(ENGUNITS_HAS_RDTSC)
+        const auto t0 = std::chrono::steady_clock::now();
+        const std::uint64_t c0 = now();
+        
+        std::this_thread::sleep_for( std::chrono::milliseconds( 10 ) );
+        
+        const auto t1 = std::chrono::steady_clock::now();
+        const std::uint64_t c1 = now();
+        
+        const quantity<double, second> elapsed = std::chrono::duration<double>( t1 - t0 );
+        return elapsed / double( c1 - c0 );
+#else
+        return std::chrono::duration<double>( std::chrono::steady_clock::duration( 1 ) );
+#endif
+    }
+};
+
+namespace detail
+{
+
+// Index of the most significant bit, x must not be 0
+inline unsigned msb64( std::uint64_t x ) noexcept
+{
+#if defined(__GNUC__)
+    return 63u - unsigned( __builtin_clzll( x ) );
+#else
+    unsigned r = 0;
+    
+    while ( x >>= 1 )
+        ++r;
+    
+    return r;
+#endif
+}
+
+}
+
+/**
+ * @addtogroup numeric
+ * @{
+ */
+
+/**
+ * @brief Histogram of durations in ticks, with logarithmic buckets.
+ * 
+ * The buckets follow the layout of HDR histograms: each power of two is
+ * split in @c sub_buckets linear buckets, so that the relative error of 
+ * any value is below 1 / @c sub_buckets, from one tick to 2^64 ticks, 
+ * with a fixed number of counters and no floating point operation.
+ * 
+ * A histogram has a single writer, and any number of readers: the 
+ * counters are atomic, but incremented with a relaxed load and store 
+ * instead of a read-modify-write instruction. Readers can see a partial
+ * update, never a torn counter.
+ * 
+ * @sa latency_site
+ */
+class latency_histogram
+{
+public:
+    static constexpr unsigned sub_bits = 5;
+    static constexpr std::size_t sub_buckets = std::size_t( 1 ) << sub_bits;
+    static constexpr std::size_t buckets = ( 64 - sub_bits + 1 ) * sub_buckets;
+    
+    latency_histogram() noexcept
+    {
+        for ( auto & c : counts_ )
+            c.store( 0, std::memory_order_relaxed );
+    }
+    
+    latency_histogram( const latency_histogram & ) = delete;
+    latency_histogram & operator=( const latency_histogram & ) = delete;
+    
+    /**
+     * @brief The bucket of a duration of @p ticks
+     */
+    static std::size_t index( std::uint64_t ticks ) noexcept
+    {
+        if ( ticks < sub_buckets )
+            return std::size_t( ticks );
+        
+        const unsigned shift = detail::msb64( ticks ) - sub_bits;
+        
+        return ( shift + 1 ) * sub_buckets + std::size_t( ( ticks >> shift ) & ( sub_buckets - 1 ) );
+    }
+    
+    /**
+     * @brief The smallest duration, in ticks, that goes in the bucket @p i
+     */
+    static std::uint64_t lower( std::size_t i ) noexcept
+    {
+        if ( i < 2 * sub_buckets )
+            return i;
+        
+        const unsigned shift = unsigned( i / sub_buckets - 1 );
+        
+        return std::uint64_t( sub_buckets + i % sub_buckets ) << shift;
+    }
+    
+    /**
+     * @brief The number of durations that go in the bucket @p i
+     */
+    static std::uint64_t width( std::size_t i ) noexcept
+    {
+        return i < 2 * sub_buckets ? 1 : std::uint64_t( 1 ) << ( i / sub_buckets - 1 );
+    }
+    
+    /**
+     * @brief Add a duration, only from the thread that owns the histogram
+     */
+    void record( std::uint64_t ticks ) noexcept
+    {
+        increment( counts_[ index( ticks ) ], 1 );
+        increment( sum_, ticks );
+        
+        if ( ticks > max_.load( std::memory_order_relaxed ) )
+            max_.store( ticks, std::memory_order_relaxed );
+    }
+    
+    /**
+     * @brief Number of durations in the bucket @p i
+     */
+    std::uint64_t count( std::size_t i ) const noexcept
+    {
+        return counts_[i].load( std::memory_order_relaxed );
+    }
+    
+    /**
+     * @brief Sum of all the durations
+     */
+    std::uint64_t sum() const noexcept
+    {
+        return sum_.load( std::memory_order_relaxed );
+    }
+    
+    /**
+     * @brief Longest duration
+     */
+    std::uint64_t max() const noexcept
+    {
+        return max_.load( std::memory_order_relaxed );
+    }
+    
+private:
+    static void increment( std::atomic<std::uint64_t> & c, std::uint64_t n ) noexcept
+    {
+        c.store( c.load( std::memory_order_relaxed ) + n, std::memory_order_relaxed );
+    }
+    
+    std::atomic<std::uint64_t> counts_[buckets];
+    std::atomic<std::uint64_t> sum_ { 0 };
+    std::atomic<std::uint64_t> max_ { 0 };
+};
+
+/**
+ * @brief Latency statistics of a call site, merged over all the threads.
+ * 
+ * The durations are quantities, and are printed by @c operator<< in
+ * microseconds.
+ * 
+ * @sa latency_site::snapshot
+ */
+class latency_snapshot
+{
+public:
+    typedef quantity<double, second> duration;
+    
+    latency_snapshot( std::string name, quantity<double, second> period ) :
+        name_( std::move( name ) ),
+        period_( period ),
+        counts_( latency_histogram::buckets, 0 )
+    {}
+    
+    /**
+     * @brief Add the counts of a histogram
+     */
+    void merge( const latency_histogram & h )
+    {
+        for ( std::size_t i = 0; i < counts_.size(); ++i )
+        {
+            const std::uint64_t c = h.count( i );
+            counts_[i] += c;
+            count_ += c;
+        }
+        
+        sum_ += h.sum();
+        max_ = std::max( max_, h.max() );
+    }
+    
+    const std::string & name() const noexcept
+    {
+        return name_;
+    }
+    
+    /**
+     * @brief Number of durations
+     */
+    std::uint64_t count() const noexcept
+    {
+        return count_;
+    }
+    
+    /**
+     * @brief Mean duration
+     * @pre `count() > 0`
+     */
+    duration mean() const
+    {
+        return period_ * ( double( sum_ ) / double( count_ ) );
+    }
+    
+    /**
+     * @brief Longest duration
+     */
+    duration max() const
+    {
+        return period_ * double( max_ );
+    }
+    
+    /**
+     * @brief Duration not exceeded by the fraction @p p of the calls
+     * @pre `count() > 0` and `0 <= p <= 1`
+     * 
+     * Returns the middle of the bucket of the percentile, so that the error
+     * is within half the relative width of a bucket.
+     */
+    duration percentile( double p ) const
+    {
+        const std::uint64_t rank = std::max<std::uint64_t>( 1, std::uint64_t( std::ceil( p * double( count_ ) ) ) );
+        std::uint64_t below = 0;
+        
+        for ( std::size_t i = 0; i < counts_.size(); ++i )
+        {
+            below += counts_[i];
+            
+            if ( below >= rank )
+            {
+                const double middle = double( latency_histogram::lower( i ) ) + 
+                                      double( latency_histogram::width( i ) - 1 ) / 2.0;
+                
+                return period_ * std::min( middle, double( max_ ) );
+            }
+        }
+        
+        return max();
+    }
+    
+    /**
+     * @brief Print count, mean, median, 99th percentile and maximum, in microseconds
+     */
+    friend std::ostream & operator<<( std::ostream & os, const latency_snapshot & s )
+    {
+        typedef quantity<double, microsecond> us;
+        
+        os << s.name() << ": count=" << s.count();
+        
+        if ( s.count() > 0 )
+        {
+            os << " mean=" << us( s.mean() )
+               << " p50=" << us( s.percentile( 0.5 ) )
+               << " p99=" << us( s.percentile( 0.99 ) )
+               << " max=" << us( s.max() );
+        }
+        
+        return os;
+    }
+    
+private:
+    std::string name_;
+    quantity<double, second> period_;
+    std::vector<std::uint64_t> counts_;
+    std::uint64_t count_ = 0;
+    std::uint64_t sum_ = 0;
+    std::uint64_t max_ = 0;
+};
+
+/** @} */
+
+namespace detail
+{
+
+/**
+ * @internal
+ * @brief Histograms of one thread, one per call site, created on first use.
+ */
+struct latency_thread_slots
+{
+    std::atomic<latency_histogram*> histograms[ENGUNITS_MAX_LATENCY_SITES];
+    
+    latency_thread_slots() noexcept
+    {
+        for ( auto & h : histograms )
+            h.store( nullptr, std::memory_order_relaxed );
+    }
+    
+    ~latency_thread_slots()
+    {
+        for ( auto & h : histograms )
+            delete h.load( std::memory_order_relaxed );
+    }
+    
+    latency_histogram & create( std::size_t site )
+    {
+        latency_histogram * h = new latency_histogram;
+        histograms[site].store( h, std::memory_order_release );
+        return *h;
+    }
+};
+
+/**
+ * @internal
+ * @brief Names of the call sites, and histograms of all the threads.
+ * 
+ * The histograms of a thread outlive it, so that its measures are still
+ * part of the snapshots.
+ */
+struct latency_registry
+{
+    std::mutex mutex;
+    std::vector<std::string> sites;
+    std::vector< std::unique_ptr<latency_thread_slots> > threads;
+    
+    static latency_registry & instance()
+    {
+        static latency_registry registry;
+        return registry;
+    }
+    
+    std::size_t add_site( std::string name )
+    {
+        std::lock_guard<std::mutex> lock( mutex );
+        
+        if ( sites.size() == ENGUNITS_MAX_LATENCY_SITES )
+            throw std::length_error( "latency_site: more than ENGUNITS_MAX_LATENCY_SITES sites" );
+        
+        sites.push_back( std::move( name ) );
+        return sites.size() - 1;
+    }
+    
+    latency_thread_slots * add_thread()
+    {
+        std::unique_ptr<latency_thread_slots> slots( new latency_thread_slots );
+        
+        std::lock_guard<std::mutex> lock( mutex );
+        threads.push_back( std::move( slots ) );
+        return threads.back().get();
+    }
+    
+    latency_snapshot snapshot( std::size_t site )
+    {
+        const quantity<double, second> period = tick_clock::period();
+        
+        std::lock_guard<std::mutex> lock( mutex );
+        latency_snapshot result( sites[site], period );
+        
+        for ( const auto & t : threads )
+            if ( const latency_histogram * h = t->histograms[site].load( std::memory_order_acquire ) )
+                result.merge( *h );
+        
+        return result;
+    }
+};
+
+}
+
+/**
+ * @brief A named place in the code whose latency is measured.
+ * 
+ * Each thread records in its own histogram, so that recording takes no lock
+ * and shares no cache line with other threads; @c snapshot merges the 
+ * histograms of all the threads. Sites are usually static objects, 
+ * declared by @c ENGUNITS_SCOPED_LATENCY.
+ * 
+ * @code{.cpp}
+ *   void kernel()
+ *   {
+ *       ENGUNITS_SCOPED_LATENCY( "kernel" );
+ *       ...
+ *   }
+ * 
+ *   for ( const auto & s : latency_snapshots() )
+ *       std::cout << s << std::endl;
+ *   // kernel: count=1000 mean=1.2us p50=1.1us p99=3.4us max=12.5us
+ * @endcode
+ * 
+ * @throw std::length_error from the constructor if there are more than
+ *  @c ENGUNITS_MAX_LATENCY_SITES sites.
+ */
+class latency_site
+{
+public:
+    explicit latency_site( std::string name ) :
+        id_( detail::latency_registry::instance().add_site( std::move( name ) ) )
+    {}
+    
+    latency_site( const latency_site & ) = delete;
+    latency_site & operator=( const latency_site & ) = delete;
+    
+    /**
+     * @brief Record a duration, in ticks of @c tick_clock
+     */
+    void record( std::uint64_t ticks )
+    {
+        static thread_local detail::latency_thread_slots * slots = nullptr;
+        
+        if ( !slots )
+            slots = detail::latency_registry::instance().add_thread();
+        
+        latency_histogram * h = slots->histograms[id_].load( std::memory_order_relaxed );
+        
+        ( h ? *h : slots->create( id_ ) ).record( ticks );
+    }
+    
+    /**
+     * @brief Statistics of all the durations recorded so far
+     */
+    latency_snapshot snapshot() const
+    {
+        return detail::latency_registry::instance().snapshot( id_ );
+    }
+    
+private:
+    std::size_t id_;
+};
+
+/**
+ * @brief Statistics of all the call sites
+ */
+inline std::vector<latency_snapshot> latency_snapshots()
+{
+    detail::latency_registry & registry = detail::latency_registry::instance();
+    
+    std::size_t n;
+    
+    {
+        std::lock_guard<std::mutex> lock( registry.mutex );
+        n = registry.sites.size();
+    }
+    
+    std::vector<latency_snapshot> result;
+    
+    for ( std::size_t i = 0; i < n; ++i )
+        result.push_back( registry.snapshot( i ) );
+    
+    return result;
+}
+
+/**
+ * @brief Record the lifetime of the object into a @c latency_site
+ */
+class scoped_timer
+{
+public:
+    explicit scoped_timer( latency_site & site ) noexcept :
+        site_( site ),
+        start_( tick_clock::now() )
+    {}
+    
+    scoped_timer( const scoped_timer & ) = delete;
+    scoped_timer & operator=( const scoped_timer & ) = delete;
+    
+    ~scoped_timer()
+    {
+        site_.record( tick_clock::now() - start_ );
+    }
+    
+private:
+    latency_site & site_;
+    std::uint64_t start_;
+};
+
+}
+
+#define ENGUNITS_LATENCY_CAT_IMPL(a, b) a##b
+#define ENGUNITS_LATENCY_CAT(a, b) ENGUNITS_LATENCY_CAT_IMPL(a, b)
+
+/**
+ * @def ENGUNITS_SCOPED_LATENCY(name)
+ * @brief Measure the time from this line to the end of the enclosing scope
+ * 
+ * Declares a static @c latency_site called @p name, and a @c scoped_timer
+ * that records into it.
+ */
+#define ENGUNITS_SCOPED_LATENCY(name)                                                       \
+    static ::engunits::latency_site ENGUNITS_LATENCY_CAT( engunits_latency_site_, __LINE__ ) \
+        ( name );                                                                           \
+    ::engunits::scoped_timer ENGUNITS_LATENCY_CAT( engunits_latency_timer_, __LINE__ )       \
+        ( ENGUNITS_LATENCY_CAT( engunits_latency_site_, __LINE__ ) )
+
+#endif //ENGINEERING_UNITS_LATENCY_HPP
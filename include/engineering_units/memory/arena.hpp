@@ -0,0 +1,268 @@
+/*
+ * Boost Software License - Version 1.0 - August 17th, 2003
+ *
+ * Permission is hereby granted, free of charge, to any person or organization
+ * obtaining a copy of the software and accompanying documentation covered by
+ * this license (the "Software") to use, reproduce, display, distribute,
+ * execute, and transmit the Software, and to prepare derivative works of the
+ * Software, and to permit third-parties to whom the Software is furnished to
+ * do so, all subject to the following:
+ *
+ * The copyright notices in the Software and this entire statement, including
+ * the above license grant, this restriction and the following disclaimer,
+ * must be included in all copies of the Software, in whole or in part, and
+ * all derivative works of the Software, unless such copies or derivative
+ * works are solely in the form of machine-executable object code generated by
+ * a source language processor.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+ * SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+ * FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef ENGINEERING_UNITS_MEMORY_ARENA_HPP
+#define ENGINEERING_UNITS_MEMORY_ARENA_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <vector>
+
+#include <engineering_units/detail/allocator.hpp>
+#include <engineering_units/detail/doxygen.hpp>
+
+namespace engunits
+{
+
+/**
+ * @addtogroup memory
+ * @{
+ */
+
+/**
+ * @brief Bump pointer allocator for short lived arrays, released all at once.
+ * 
+ * Memory is handed out from large blocks by advancing a pointer;
+ * @c deallocate does nothing, and @c reset makes all the memory available
+ * again. When the current block is exhausted a new one, twice as large, is
+ * allocated; @c reset then merges the blocks into one of the total size,
+ * so that after the first frames the arena reaches a steady state where it
+ * never calls `operator new`.
+ * 
+ * With C++17 the arena is also a `std::pmr::memory_resource`, usable by 
+ * `std::pmr` containers and by `std::pmr::monotonic_buffer_resource` or 
+ * `std::pmr::unsynchronized_pool_resource` as upstream resource.
+ * 
+ * @code{.cpp}
+ *   bump_arena frame( 1 << 20 );
+ *   
+ *   for ( ;; )
+ *   {
+ *       frame.reset();
+ *       
+ *       arena_vector< quantity<float, si::meter> > x( n, frame );
+ *       ...
+ *       sort( x, arena_allocator<char>( frame ) );
+ *   }
+ * @endcode
+ * 
+ * @note Not thread safe: use one arena per thread.
+ * @warning Objects allocated from the arena must be destroyed before 
+ *  @c reset is called.
+ */
+class bump_arena
+#if defined(ENGUNITS_HAS_MEMORY_RESOURCE)
+    : public std::pmr::memory_resource
+#endif
+{
+public:
+    /**
+     * @param capacity Size of the first block, in bytes
+     */
+    explicit bump_arena( std::size_t capacity = 64 * 1024 )
+    {
+        add_block( std::max<std::size_t>( capacity, 64 ) );
+    }
+    
+    bump_arena( const bump_arena & ) = delete;
+    bump_arena & operator=( const bump_arena & ) = delete;
+    
+    /**
+     * @brief Allocate @p bytes aligned to @p alignment, a power of two
+     * @throw std::bad_alloc if a new block can not be allocated
+     */
+    void * allocate( std::size_t bytes, std::size_t alignment = alignof(std::max_align_t) )
+    {
+        const std::uintptr_t p = ( current_ + alignment - 1 ) & ~std::uintptr_t( alignment - 1 );
+        
+        if ( p <= end_ && bytes <= end_ - p )
+        {
+            current_ = p + bytes;
+            return reinterpret_cast<void*>( p );
+        }
+        
+        return allocate_block( bytes, alignment );
+    }
+    
+    /**
+     * @brief Does nothing, the memory is reclaimed by @c reset
+     */
+    void deallocate( void *, std::size_t, std::size_t = alignof(std::max_align_t) ) noexcept
+    {}
+    
+    /**
+     * @brief Make all the memory available again
+     * 
+     * If more than one block was used since the last reset, they are 
+     * replaced with a single block of their total size.
+     */
+    void reset()
+    {
+        if ( blocks_.size() > 1 )
+        {
+            const std::size_t total = capacity();
+            
+            blocks_.clear();
+            capacity_ = 0;
+            add_block( total );
+        }
+        
+        current_ = begin_;
+        retired_ = 0;
+    }
+    
+    /**
+     * @brief Bytes allocated since the last reset, padding included
+     */
+    std::size_t used() const noexcept
+    {
+        return retired_ + std::size_t( current_ - begin_ );
+    }
+    
+    /**
+     * @brief Total size of the blocks
+     */
+    std::size_t capacity() const noexcept
+    {
+        return capacity_;
+    }
+    
+private:
+#if defined(ENGUNITS_HAS_MEMORY_RESOURCE)
+    void * do_allocate( std::size_t bytes, std::size_t alignment ) override
+    {
+        return allocate( bytes, alignment );
+    }
+    
+    void do_deallocate( void *, std::size_t, std::size_t ) override
+    {}
+    
+    bool do_is_equal( const std::pmr::memory_resource & other ) const noexcept override
+    {
+        return this == &other;
+    }
+#endif
+    
+    void add_block( std::size_t size )
+    {
+        blocks_.emplace_back( new unsigned char[ size ] );
+        capacity_ += size;
+        
+        begin_ = reinterpret_cast<std::uintptr_t>( blocks_.back().get() );
+        current_ = begin_;
+        end_ = begin_ + size;
+    }
+    
+    void * allocate_block( std::size_t bytes, std::size_t alignment )
+    {
+        if ( bytes > std::size_t( -1 ) / 4 )
+            throw std::bad_alloc();
+        
+        const std::size_t used_here = std::size_t( current_ - begin_ );
+        
+        blocks_.reserve( blocks_.size() + 1 );
+        add_block( std::max( 2 * std::size_t( end_ - begin_ ), bytes + alignment ) );
+        retired_ += used_here;
+        
+        return allocate( bytes, alignment );
+    }
+    
+    std::vector< std::unique_ptr<unsigned char[]> > blocks_;
+    std::size_t capacity_ = 0;
+    std::size_t retired_ = 0;
+    
+    std::uintptr_t begin_ = 0;
+    std::uintptr_t current_ = 0;
+    std::uintptr_t end_ = 0;
+};
+
+/**
+ * @brief Standard allocator that takes the memory from a @c bump_arena
+ * 
+ * The containers and the algorithms of this library that accept an 
+ * allocator work with it, as with any other allocator.
+ */
+template<class T>
+class arena_allocator
+{
+public:
+    typedef T value_type;
+    
+    arena_allocator( bump_arena & arena ) noexcept :
+        arena_( &arena )
+    {}
+    
+    template<class U>
+    arena_allocator( const arena_allocator<U> & other ) noexcept :
+        arena_( &other.arena() )
+    {}
+    
+    T * allocate( std::size_t n )
+    {
+        if ( n > std::size_t( -1 ) / sizeof(T) )
+            throw std::bad_alloc();
+        
+        return static_cast<T*>( arena_->allocate( n * sizeof(T), alignof(T) ) );
+    }
+    
+    void deallocate( T *, std::size_t ) noexcept
+    {}
+    
+    bump_arena & arena() const noexcept
+    {
+        return *arena_;
+    }
+    
+    template<class U>
+    friend bool operator==( const arena_allocator & lhs, const arena_allocator<U> & rhs ) noexcept
+    {
+        return &lhs.arena() == &rhs.arena();
+    }
+    
+    template<class U>
+    friend bool operator!=( const arena_allocator & lhs, const arena_allocator<U> & rhs ) noexcept
+    {
+        return !( lhs == rhs );
+    }
+    
+private:
+    bump_arena * arena_;
+};
+
+/**
+ * @brief A vector whose memory comes from a @c bump_arena
+ */
+template<class T>
+using arena_vector = std::vector< T, arena_allocator<T> >;
+
+/** @} */
+
+}
+
+#endif //ENGINEERING_UNITS_MEMORY_ARENA_HPP
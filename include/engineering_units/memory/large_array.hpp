@@ -0,0 +1,379 @@
+/*
+ * Boost Software License - Version 1.0 - August 17th, 2003
+ *
+ * Permission is hereby granted, free of charge, to any person or organization
+ * obtaining a copy of the software and accompanying documentation covered by
+ * this license (the "Software") to use, reproduce, display, distribute,
+ * execute, and transmit the Software, and to prepare derivative works of the
+ * Software, and to permit third-parties to whom the Software is furnished to
+ * do so, all subject to the following:
+ *
+ * The copyright notices in the Software and this entire statement, including
+ * the above license grant, this restriction and the following disclaimer,
+ * must be included in all copies of the Software, in whole or in part, and
+ * all derivative works of the Software, unless such copies or derivative
+ * works are solely in the form of machine-executable object code generated by
+ * a source language processor.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+ * SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+ * FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef ENGINEERING_UNITS_MEMORY_LARGE_ARRAY_HPP
+#define ENGINEERING_UNITS_MEMORY_LARGE_ARRAY_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/mman.h>
+#define ENGUNITS_HAS_MMAP 1
+#endif
+
+#include <engineering_units/detail/cache_line.hpp>
+#include <engineering_units/detail/doxygen.hpp>
+
+namespace engunits
+{
+
+/**
+ * @addtogroup memory
+ * @{
+ */
+
+/**
+ * @brief How the memory of a large array is backed
+ */
+enum class huge_pages
+{
+    none,        ///< Regular pages
+    transparent, ///< Transparent huge pages where the kernel can, with `madvise(MADV_HUGEPAGE)`
+    reserved     ///< Pages of the reserved pool, with `MAP_HUGETLB`; transparent if the pool is empty
+};
+
+/** @} */
+
+namespace detail
+{
+
+// Default size of huge pages on x86-64 and aarch64
+constexpr std::size_t huge_page_size = std::size_t( 2 ) << 20;
+
+/**
+ * @internal
+ * @brief A range of pages, aligned to @c huge_page_size when mapped.
+ * 
+ * Without @c mmap the memory comes from `operator new`, aligned to a cache
+ * line, and the policy is always @c huge_pages::none.
+ */
+class page_block
+{
+public:
+    page_block() = default;
+    
+    page_block( std::size_t bytes, huge_pages policy )
+    {
+        if ( bytes == 0 )
+            return;
+        
+#ifdef ENGUNITS_HAS_MMAP
+        // Whole huge pages, so that the same size can be unmapped in all cases
+        length_ = ( bytes + huge_page_size - 1 ) / huge_page_size * huge_page_size;
+        
+#ifdef MAP_HUGETLB
+        if ( policy == huge_pages::reserved )
+        {
+            void * p = ::mmap( nullptr, length_, PROT_READ | PROT_WRITE,
+                               MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0 );
+            
+            if ( p != MAP_FAILED )
+            {
+                base_ = data_ = p;
+                mapped_ = length_;
+                policy_ = huge_pages::reserved;
+                return;
+            }
+        }
+#endif
+        
+        // Map one huge page more, to align the start to a huge page
+        mapped_ = length_ + huge_page_size;
+        
+        void * p = ::mmap( nullptr, mapped_, PROT_READ | PROT_WRITE,
+                           MAP_PRIVATE | MAP_ANONYMOUS, -1, 0 );
+        
+        if ( p == MAP_FAILED )
+            throw std::bad_alloc();
+        
+        base_ = p;
+        
+        const std::uintptr_t a = reinterpret_cast<std::uintptr_t>( p );
+        data_ = reinterpret_cast<void*>( ( a + huge_page_size - 1 ) & ~std::uintptr_t( huge_page_size - 1 ) );
+        policy_ = huge_pages::none;
+        
+#ifdef MADV_HUGEPAGE
+        if ( policy != huge_pages::none && ::madvise( data_, length_, MADV_HUGEPAGE ) == 0 )
+            policy_ = huge_pages::transparent;
+#endif
+#else
+        (void) policy;
+        
+        length_ = bytes;
+        buffer_.reset( new unsigned char[ bytes + cache_line_size ] );
+        
+        void * p = buffer_.get();
+        std::size_t space = bytes + cache_line_size;
+        data_ = std::align( cache_line_size, bytes, p, space );
+#endif
+    }
+    
+    page_block( page_block && other ) noexcept :
+        base_( std::exchange( other.base_, nullptr ) ),
+        data_( std::exchange( other.data_, nullptr ) ),
+        length_( std::exchange( other.length_, 0 ) ),
+        mapped_( std::exchange( other.mapped_, 0 ) ),
+        policy_( other.policy_ ),
+        buffer_( std::move( other.buffer_ ) )
+    {}
+    
+    page_block & operator=( page_block && other ) noexcept
+    {
+        page_block tmp( std::move( other ) );
+        std::swap( base_, tmp.base_ );
+        std::swap( data_, tmp.data_ );
+        std::swap( length_, tmp.length_ );
+        std::swap( mapped_, tmp.mapped_ );
+        std::swap( policy_, tmp.policy_ );
+        std::swap( buffer_, tmp.buffer_ );
+        return *this;
+    }
+    
+    ~page_block()
+    {
+#ifdef ENGUNITS_HAS_MMAP
+        if ( base_ != nullptr )
+            ::munmap( base_, mapped_ );
+#endif
+    }
+    
+    void * data() const noexcept { return data_; }
+    std::size_t length() const noexcept { return length_; }
+    huge_pages policy() const noexcept { return policy_; }
+    
+private:
+    void * base_ = nullptr;
+    void * data_ = nullptr;
+    std::size_t length_ = 0;
+    std::size_t mapped_ = 0;
+    huge_pages policy_ = huge_pages::none;
+    std::unique_ptr<unsigned char[]> buffer_;
+};
+
+}
+
+/**
+ * @addtogroup memory
+ * @{
+ */
+
+/**
+ * @brief Allocator of memory aligned to @p Alignment bytes, a cache line by default
+ * 
+ * Makes the vectors of quantities start on a cache line, so that the 
+ * vectorized loops over them do not split loads across lines.
+ */
+template<class T, std::size_t Alignment = detail::cache_line_size>
+class aligned_allocator
+{
+    static_assert( Alignment >= alignof(T) && ( Alignment & ( Alignment - 1 ) ) == 0,
+                   "Alignment must be a power of two, not less than the alignment of T" );
+    
+    static constexpr std::size_t align = Alignment > alignof(std::max_align_t) ? Alignment : alignof(std::max_align_t);
+    
+public:
+    typedef T value_type;
+    
+    template<class U>
+    struct rebind
+    {
+        typedef aligned_allocator<U, Alignment> other;
+    };
+    
+    aligned_allocator() = default;
+    
+    template<class U>
+    aligned_allocator( const aligned_allocator<U, Alignment> & ) noexcept
+    {}
+    
+    T * allocate( std::size_t n )
+    {
+        if ( n > ( std::size_t( -1 ) - align ) / sizeof(T) )
+            throw std::bad_alloc();
+        
+        // At least align bytes of padding, enough to store the offset to the block
+        unsigned char * base = static_cast<unsigned char*>( ::operator new( n * sizeof(T) + align ) );
+        const std::uintptr_t a = reinterpret_cast<std::uintptr_t>( base ) + align;
+        unsigned char * p = reinterpret_cast<unsigned char*>( a & ~std::uintptr_t( align - 1 ) );
+        
+        reinterpret_cast<std::size_t*>( p )[-1] = std::size_t( p - base );
+        
+        return reinterpret_cast<T*>( p );
+    }
+    
+    void deallocate( T * p, std::size_t ) noexcept
+    {
+        unsigned char * q = reinterpret_cast<unsigned char*>( p );
+        ::operator delete( q - reinterpret_cast<std::size_t*>( q )[-1] );
+    }
+    
+    template<class U>
+    bool operator==( const aligned_allocator<U, Alignment> & ) const noexcept
+    {
+        return true;
+    }
+    
+    template<class U>
+    bool operator!=( const aligned_allocator<U, Alignment> & ) const noexcept
+    {
+        return false;
+    }
+};
+
+/**
+ * @brief Fixed size array for bulk data, backed by huge pages and touched in parallel.
+ * 
+ * The elements start on a huge page boundary. With @c huge_pages::transparent
+ * or @c huge_pages::reserved each 2 MiB page needs a single TLB entry,
+ * instead of 512, which matters when passes over the array miss the TLB.
+ * 
+ * The elements are initialized by @p threads threads, each one writing a
+ * contiguous slice `[ size() * k / threads, size() * (k + 1) / threads )`.
+ * On NUMA machines the first write places a page on the node of the 
+ * writer, so that the threads that later process the same slices find 
+ * their data in local memory.
+ * 
+ * @code{.cpp}
+ *   large_array< quantity<double, si::pascal> > p( n, huge_pages::transparent );
+ * @endcode
+ * 
+ * @tparam T A trivially destructible type, such as a quantity of a built-in type
+ * @note The memory is not reclaimed until the array is destroyed, and the
+ *  size can not change.
+ */
+template<class T>
+class large_array
+{
+    static_assert( std::is_trivially_destructible<T>::value, "large_array needs a trivially destructible type" );
+    
+public:
+    typedef T value_type;
+    typedef std::size_t size_type;
+    typedef T * iterator;
+    typedef const T * const_iterator;
+    
+    large_array() = default;
+    
+    /**
+     * @brief Allocate @p n elements, and value-initialize them in parallel
+     * @param pages How the memory is backed
+     * @param threads Number of threads touching the memory, all the hardware threads if 0.
+     * @throw std::bad_alloc if the memory could not be mapped
+     */
+    explicit large_array( size_type n, huge_pages pages = huge_pages::transparent, unsigned threads = 0 ) :
+        large_array( n, T(), pages, threads )
+    {}
+    
+    /**
+     * @brief Allocate @p n copies of @p value, written in parallel
+     */
+    large_array( size_type n, const T & value, huge_pages pages = huge_pages::transparent, unsigned threads = 0 ) :
+        block_( n * sizeof(T), pages ),
+        data_( static_cast<T*>( block_.data() ) ),
+        size_( n )
+    {
+        if ( threads == 0 )
+            threads = std::max( 1u, std::thread::hardware_concurrency() );
+        
+        // Not worth a thread for less than a few huge pages
+        const size_type min_slice = 4 * detail::huge_page_size / sizeof(T) + 1;
+        threads = unsigned( std::max<size_type>( 1, std::min<size_type>( threads, n / min_slice ) ) );
+        
+        auto fill = [this, n, threads, &value]( unsigned k )
+        {
+            std::uninitialized_fill( data_ + n * k / threads, data_ + n * ( k + 1 ) / threads, value );
+        };
+        
+        std::vector< std::thread > workers;
+        
+        for ( unsigned k = 1; k < threads; ++k )
+            workers.emplace_back( fill, k );
+        
+        fill( 0 );
+        
+        for ( auto & w : workers )
+            w.join();
+    }
+    
+    large_array( large_array && other ) noexcept :
+        block_( std::move( other.block_ ) ),
+        data_( std::exchange( other.data_, nullptr ) ),
+        size_( std::exchange( other.size_, 0 ) )
+    {}
+    
+    large_array & operator=( large_array && other ) noexcept
+    {
+        block_ = std::move( other.block_ );
+        data_ = std::exchange( other.data_, nullptr );
+        size_ = std::exchange( other.size_, 0 );
+        return *this;
+    }
+    
+    T * data() noexcept { return data_; }
+    const T * data() const noexcept { return data_; }
+    
+    size_type size() const noexcept { return size_; }
+    bool empty() const noexcept { return size_ == 0; }
+    
+    iterator begin() noexcept { return data_; }
+    iterator end() noexcept { return data_ + size_; }
+    const_iterator begin() const noexcept { return data_; }
+    const_iterator end() const noexcept { return data_ + size_; }
+    
+    T & operator[]( size_type i ) noexcept { return data_[i]; }
+    const T & operator[]( size_type i ) const noexcept { return data_[i]; }
+    
+    /**
+     * @brief How the memory is actually backed
+     * 
+     * @c huge_pages::transparent means that the kernel accepted the hint;
+     * it may still back part of the array with regular pages, when it can
+     * not find free huge pages.
+     */
+    huge_pages pages() const noexcept
+    {
+        return block_.policy();
+    }
+    
+private:
+    detail::page_block block_;
+    T * data_ = nullptr;
+    size_type size_ = 0;
+};
+
+/** @} */
+
+}
+
+#endif //ENGINEERING_UNITS_MEMORY_LARGE_ARRAY_HPP
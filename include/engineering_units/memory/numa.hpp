@@ -0,0 +1,577 @@
+/*
+ * Boost Software License - Version 1.0 - August 17th, 2003
+ *
+ * Permission is hereby granted, free of charge, to any person or organization
+ * obtaining a copy of the software and accompanying documentation covered by
+ * this license (the "Software") to use, reproduce, display, distribute,
+ * execute, and transmit the Software, and to prepare derivative works of the
+ * Software, and to permit third-parties to whom the Software is furnished to
+ * do so, all subject to the following:
+ *
+ * The copyright notices in the Software and this entire statement, including
+ * the above license grant, this restriction and the following disclaimer,
+ * must be included in all copies of the Software, in whole or in part, and
+ * all derivative works of the Software, unless such copies or derivative
+ * works are solely in the form of machine-executable object code generated by
+ * a source language processor.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+ * SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+ * FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef ENGINEERING_UNITS_MEMORY_NUMA_HPP
+#define ENGINEERING_UNITS_MEMORY_NUMA_HPP
+
+#include <algorithm>
+#include <cassert>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <fstream>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#if defined(__linux__)
+#include <sched.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#define ENGUNITS_HAS_NUMA 1
+#endif
+
+#include <engineering_units/memory/large_array.hpp>
+
+#include <engineering_units/detail/doxygen.hpp>
+
+namespace engunits
+{
+
+namespace detail
+{
+
+// Parse a list such as "0-3,8-11" of /sys/devices/system
+inline std::vector<unsigned> parse_cpu_list( const std::string & list )
+{
+    std::vector<unsigned> result;
+    std::istringstream in( list );
+    std::string range;
+    
+    while ( std::getline( in, range, ',' ) )
+    {
+        unsigned first = 0, last = 0;
+        char dash = 0;
+        std::istringstream r( range );
+        
+        if ( !( r >> first ) )
+            continue;
+        
+        last = ( r >> dash >> last && dash == '-' ) ? last : first;
+        
+        for ( unsigned i = first; i <= last; ++i )
+            result.push_back( i );
+    }
+    
+    return result;
+}
+
+inline std::string read_line( const std::string & path )
+{
+    std::ifstream in( path );
+    std::string line;
+    std::getline( in, line );
+    return line;
+}
+
+// Restrict the calling thread to cpus; false if not supported
+inline bool pin_current_thread( const std::vector<unsigned> & cpus ) noexcept
+{
+#ifdef ENGUNITS_HAS_NUMA
+    cpu_set_t set;
+    CPU_ZERO( &set );
+    
+    for ( unsigned c : cpus )
+        if ( c < CPU_SETSIZE )
+            CPU_SET( c, &set );
+    
+    return ::sched_setaffinity( 0, sizeof(set), &set ) == 0;
+#else
+    (void) cpus;
+    return false;
+#endif
+}
+
+// Ask for the pages of [p, p + bytes) to be placed on node when first touched
+inline bool bind_to_node( void * p, std::size_t bytes, unsigned node ) noexcept
+{
+#if defined(ENGUNITS_HAS_NUMA) && defined(SYS_mbind)
+    if ( p == nullptr || bytes == 0 )
+        return false;
+    
+    constexpr unsigned bits = 8 * sizeof(unsigned long);
+    constexpr int mpol_preferred = 1;
+    
+    std::vector<unsigned long> mask( node / bits + 1, 0 );
+    mask[ node / bits ] = 1ul << ( node % bits );
+    
+    return ::syscall( SYS_mbind, p, bytes, mpol_preferred, mask.data(), mask.size() * bits + 1, 0 ) == 0;
+#else
+    (void) p;
+    (void) bytes;
+    (void) node;
+    return false;
+#endif
+}
+
+}
+
+/**
+ * @addtogroup memory
+ * @{
+ */
+
+/**
+ * @brief The NUMA nodes of the machine, and the CPUs of each one.
+ * 
+ * @c system reads the topology from `/sys/devices/system/node` on Linux;
+ * elsewhere, or if it can not be read, the machine is a single node with
+ * all the hardware threads. Nodes without CPUs are left out.
+ */
+class numa_topology
+{
+public:
+    struct node_info
+    {
+        unsigned id;                 ///< Number of the node for the kernel
+        std::vector<unsigned> cpus;  ///< CPUs of the node
+    };
+    
+    /**
+     * @brief A topology given explicitly, e.g. a subset of the nodes
+     * @pre @p nodes is not empty, and no node is without CPUs.
+     */
+    explicit numa_topology( std::vector<node_info> nodes ) :
+        nodes_( std::move( nodes ) )
+    {
+        assert( !nodes_.empty() );
+    }
+    
+    /**
+     * @brief The topology of this machine, read once
+     */
+    static const numa_topology & system()
+    {
+        static const numa_topology topology = detect();
+        return topology;
+    }
+    
+    unsigned nodes() const noexcept
+    {
+        return unsigned( nodes_.size() );
+    }
+    
+    const node_info & node( unsigned i ) const noexcept
+    {
+        return nodes_[i];
+    }
+    
+private:
+    static numa_topology detect()
+    {
+        std::vector<node_info> nodes;
+        
+#ifdef ENGUNITS_HAS_NUMA
+        const std::string root = "/sys/devices/system/node/";
+        
+        for ( unsigned id : detail::parse_cpu_list( detail::read_line( root + "online" ) ) )
+        {
+            std::vector<unsigned> cpus = detail::parse_cpu_list( 
+                detail::read_line( root + "node" + std::to_string( id ) + "/cpulist" ) );
+            
+            if ( !cpus.empty() )
+                nodes.push_back( { id, std::move( cpus ) } );
+        }
+#endif
+        
+        if ( nodes.empty() )
+        {
+            node_info all { 0, {} };
+            
+            for ( unsigned c = 0; c < std::max( 1u, std::thread::hardware_concurrency() ); ++c )
+                all.cpus.push_back( c );
+            
+            nodes.push_back( std::move( all ) );
+        }
+        
+        return numa_topology( std::move( nodes ) );
+    }
+    
+    std::vector<node_info> nodes_;
+};
+
+/**
+ * @brief Pool of threads, each one pinned to the CPUs of a NUMA node
+ * 
+ * @c run calls a function on every worker, with the index of its node, 
+ * its index among the workers of the node, and their number. Together
+ * with @c partitioned_array, whose partition @c i lives on node @c i, 
+ * this lets each thread work on memory local to its node.
+ * 
+ * Pinning is best effort: if the operating system refuses it, the 
+ * workers run unpinned, and are still correct.
+ * 
+ * @sa transform, transform_reduce
+ */
+class numa_executor
+{
+public:
+    /**
+     * @param threads_per_node Workers on each node, as many as its CPUs if 0.
+     * @param topology The nodes to use
+     */
+    explicit numa_executor( unsigned threads_per_node = 0,
+                            const numa_topology & topology = numa_topology::system() ) :
+        topology_( topology )
+    {
+        for ( unsigned n = 0; n < topology_.nodes(); ++n )
+        {
+            first_.push_back( total_ );
+            count_.push_back( threads_per_node ? threads_per_node : unsigned( topology_.node( n ).cpus.size() ) );
+            total_ += count_.back();
+        }
+        
+        for ( unsigned n = 0; n < topology_.nodes(); ++n )
+            for ( unsigned w = 0; w < count_[n]; ++w )
+                threads_.emplace_back( &numa_executor::work, this, n, w );
+    }
+    
+    numa_executor( const numa_executor & ) = delete;
+    numa_executor & operator=( const numa_executor & ) = delete;
+    
+    ~numa_executor()
+    {
+        {
+            std::lock_guard<std::mutex> lock( mutex_ );
+            stop_ = true;
+        }
+        
+        start_.notify_all();
+        
+        for ( auto & t : threads_ )
+            t.join();
+    }
+    
+    const numa_topology & topology() const noexcept
+    {
+        return topology_;
+    }
+    
+    /**
+     * @brief Number of workers on @p node
+     */
+    unsigned workers( unsigned node ) const noexcept
+    {
+        return count_[node];
+    }
+    
+    /**
+     * @brief Total number of workers
+     */
+    unsigned workers() const noexcept
+    {
+        return total_;
+    }
+    
+    /**
+     * @brief Index of the first worker of @p node, among all the workers
+     */
+    unsigned first_worker( unsigned node ) const noexcept
+    {
+        return first_[node];
+    }
+    
+    /**
+     * @brief Call `f( node, worker, workers( node ) )` on every worker, and wait
+     * @throw Any exception thrown by @p f, the first one if more than one
+     */
+    template<class F>
+    void run( F && f )
+    {
+        std::unique_lock<std::mutex> lock( mutex_ );
+        
+        job_ = &f;
+        call_ = []( void * job, unsigned node, unsigned worker, unsigned workers )
+        {
+            ( *static_cast< std::remove_reference_t<F> * >( job ) )( node, worker, workers );
+        };
+        
+        pending_ = unsigned( threads_.size() );
+        ++generation_;
+        start_.notify_all();
+        
+        done_.wait( lock, [this] { return pending_ == 0; } );
+        
+        job_ = nullptr;
+        
+        if ( error_ )
+            std::rethrow_exception( std::exchange( error_, nullptr ) );
+    }
+    
+private:
+    void work( unsigned node, unsigned worker )
+    {
+        detail::pin_current_thread( topology_.node( node ).cpus );
+        
+        std::uint64_t seen = 0;
+        
+        for ( ;; )
+        {
+            void * job;
+            void ( *call )( void *, unsigned, unsigned, unsigned );
+            
+            {
+                std::unique_lock<std::mutex> lock( mutex_ );
+                start_.wait( lock, [&] { return stop_ || generation_ != seen; } );
+                
+                if ( stop_ )
+                    return;
+                
+                seen = generation_;
+                job = job_;
+                call = call_;
+            }
+            
+            try
+            {
+                call( job, node, worker, count_[node] );
+            }
+            catch ( ... )
+            {
+                std::lock_guard<std::mutex> lock( mutex_ );
+                
+                if ( !error_ )
+                    error_ = std::current_exception();
+            }
+            
+            {
+                std::lock_guard<std::mutex> lock( mutex_ );
+                
+                if ( --pending_ == 0 )
+                    done_.notify_one();
+            }
+        }
+    }
+    
+    numa_topology topology_;
+    std::vector<unsigned> first_;
+    std::vector<unsigned> count_;
+    unsigned total_ = 0;
+    std::vector<std::thread> threads_;
+    
+    std::mutex mutex_;
+    std::condition_variable start_;
+    std::condition_variable done_;
+    
+    void * job_ = nullptr;
+    void ( *call_ )( void *, unsigned, unsigned, unsigned ) = nullptr;
+    std::uint64_t generation_ = 0;
+    unsigned pending_ = 0;
+    bool stop_ = false;
+    std::exception_ptr error_;
+};
+
+/**
+ * @brief Large array split in one partition per NUMA node of an executor
+ * 
+ * Partition @c i holds a contiguous range of the elements, and its pages 
+ * are placed on node @c i, with `mbind` where available; the workers of 
+ * the node initialize it, each its own slice, so that the placement also
+ * holds where `mbind` is not available, by first touch.
+ * 
+ * @code{.cpp}
+ *   numa_executor executor;
+ *   partitioned_array< quantity<double, si::pascal> > p( executor, n );
+ *   partitioned_array< quantity<double, si::bar> > b( executor, n );
+ *   
+ *   transform( executor, p, b, []( auto x ) { return quantity<double, si::bar>( x ); } );
+ * @endcode
+ * 
+ * @tparam T A trivially destructible type, such as a quantity of a built-in type
+ */
+template<class T>
+class partitioned_array
+{
+    static_assert( std::is_trivially_destructible<T>::value, "partitioned_array needs a trivially destructible type" );
+    
+public:
+    typedef T value_type;
+    typedef std::size_t size_type;
+    
+    /**
+     * @brief Allocate @p n copies of @p value, spread over the nodes of @p executor
+     */
+    partitioned_array( numa_executor & executor, size_type n, const T & value = T(),
+                       huge_pages pages = huge_pages::transparent ) :
+        size_( n ),
+        chunk_( ( n + executor.topology().nodes() - 1 ) / executor.topology().nodes() )
+    {
+        const unsigned parts = executor.topology().nodes();
+        
+        bound_ = true;
+        
+        for ( unsigned p = 0; p < parts; ++p )
+        {
+            const size_type count = std::min( chunk_, n - std::min( n, p * chunk_ ) );
+            
+            blocks_.emplace_back( count * sizeof(T), pages );
+            data_.push_back( static_cast<T*>( blocks_.back().data() ) );
+            sizes_.push_back( count );
+            
+            if ( count != 0 )
+                bound_ = detail::bind_to_node( blocks_.back().data(), blocks_.back().length(), 
+                                               executor.topology().node( p ).id ) && bound_;
+        }
+        
+        executor.run( [this, &value]( unsigned node, unsigned worker, unsigned workers )
+        {
+            const size_type m = sizes_[node];
+            std::uninitialized_fill( data_[node] + m * worker / workers, data_[node] + m * ( worker + 1 ) / workers, value );
+        } );
+    }
+    
+    size_type size() const noexcept
+    {
+        return size_;
+    }
+    
+    /**
+     * @brief Number of partitions, the nodes of the executor
+     */
+    unsigned partitions() const noexcept
+    {
+        return unsigned( data_.size() );
+    }
+    
+    T * data( unsigned partition ) noexcept { return data_[partition]; }
+    const T * data( unsigned partition ) const noexcept { return data_[partition]; }
+    
+    /**
+     * @brief Number of elements of @p partition
+     */
+    size_type size( unsigned partition ) const noexcept
+    {
+        return sizes_[partition];
+    }
+    
+    /**
+     * @brief Index of the first element of @p partition
+     */
+    size_type offset( unsigned partition ) const noexcept
+    {
+        return std::min( size_, partition * chunk_ );
+    }
+    
+    T & operator[]( size_type i ) noexcept
+    {
+        return data_[ i / chunk_ ][ i % chunk_ ];
+    }
+    
+    const T & operator[]( size_type i ) const noexcept
+    {
+        return data_[ i / chunk_ ][ i % chunk_ ];
+    }
+    
+    /**
+     * @brief Whether all the partitions were explicitly bound to their node
+     */
+    bool bound() const noexcept
+    {
+        return bound_;
+    }
+    
+private:
+    std::vector<detail::page_block> blocks_;
+    std::vector<T*> data_;
+    std::vector<size_type> sizes_;
+    size_type size_;
+    size_type chunk_;
+    bool bound_ = false;
+};
+
+/**
+ * @brief `out[i] = f( in[i] )` for all the elements, each node on its own partition
+ * @pre @p in and @p out were created with the same size and @p executor
+ */
+template<class T, class U, class F>
+void transform( numa_executor & executor, const partitioned_array<T> & in, partitioned_array<U> & out, F f )
+{
+    assert( in.size() == out.size() && in.partitions() == out.partitions() );
+    
+    executor.run( [&]( unsigned node, unsigned worker, unsigned workers )
+    {
+        const std::size_t m = in.size( node );
+        const T * src = in.data( node );
+        U * dst = out.data( node );
+        
+        const std::size_t last = m * ( worker + 1 ) / workers;
+        
+        for ( std::size_t i = m * worker / workers; i < last; ++i )
+            dst[i] = f( src[i] );
+    } );
+}
+
+/**
+ * @brief `reduce( ... reduce( init, transform( in[0] ) ) ..., transform( in[n - 1] ) )`
+ * 
+ * Each worker reduces its own slice, and the partial results are reduced
+ * in order; @p reduce must be associative.
+ */
+template<class T, class R, class Reduce, class Transform>
+R transform_reduce( numa_executor & executor, const partitioned_array<T> & in, R init,
+                    Reduce reduce, Transform transform )
+{
+    std::vector<R> partial( executor.workers(), init );
+    std::vector<char> used( executor.workers(), 0 );
+    
+    executor.run( [&]( unsigned node, unsigned worker, unsigned workers )
+    {
+        const std::size_t m = in.size( node );
+        const T * src = in.data( node );
+        
+        std::size_t i = m * worker / workers;
+        const std::size_t last = m * ( worker + 1 ) / workers;
+        
+        if ( i == last )
+            return;
+        
+        R acc = transform( src[i] );
+        
+        for ( ++i; i < last; ++i )
+            acc = reduce( acc, transform( src[i] ) );
+        
+        const unsigned k = executor.first_worker( node ) + worker;
+        partial[k] = acc;
+        used[k] = 1;
+    } );
+    
+    for ( std::size_t k = 0; k < partial.size(); ++k )
+        if ( used[k] )
+            init = reduce( init, partial[k] );
+    
+    return init;
+}
+
+/** @} */
+
+}
+
+#endif //ENGINEERING_UNITS_MEMORY_NUMA_HPP
@@ -0,0 +1,260 @@
+/*
+ * Boost Software License - Version 1.0 - August 17th, 2003
+ *
+ * Permission is hereby granted, free of charge, to any person or organization
+ * obtaining a copy of the software and accompanying documentation covered by
+ * this license (the "Software") to use, reproduce, display, distribute,
+ * execute, and transmit the Software, and to prepare derivative works of the
+ * Software, and to permit third-parties to whom the Software is furnished to
+ * do so, all subject to the following:
+ *
+ * The copyright notices in the Software and this entire statement, including
+ * the above license grant, this restriction and the following disclaimer,
+ * must be included in all copies of the Software, in whole or in part, and
+ * all derivative works of the Software, unless such copies or derivative
+ * works are solely in the form of machine-executable object code generated by
+ * a source language processor.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+ * SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+ * FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef ENGINEERING_UNITS_NUMERIC_COUNTER_HPP
+#define ENGINEERING_UNITS_NUMERIC_COUNTER_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <thread>
+#include <type_traits>
+#include <utility>
+
+#include <engineering_units/quantity.hpp>
+#include <engineering_units/chrono.hpp>
+#include <engineering_units/time.hpp>
+
+#include <engineering_units/detail/cache_line.hpp>
+#include <engineering_units/detail/doxygen.hpp>
+
+namespace engunits
+{
+
+namespace detail
+{
+
+// A small number, different for each thread, assigned on first use
+inline std::size_t thread_shard() noexcept
+{
+    static std::atomic<std::size_t> next { 0 };
+    static thread_local std::size_t id = 0;
+    
+    if ( id == 0 )
+        id = next.fetch_add( 1, std::memory_order_relaxed ) + 1;
+    
+    return id - 1;
+}
+
+template<class T, ENGUNITS_ENABLE_IF( std::is_integral<T>::value )>
+void atomic_add( std::atomic<T> & a, T x ) noexcept
+{
+    a.fetch_add( x, std::memory_order_relaxed );
+}
+
+template<class T, ENGUNITS_ENABLE_IF( !std::is_integral<T>::value )>
+void atomic_add( std::atomic<T> & a, T x ) noexcept
+{
+    T old = a.load( std::memory_order_relaxed );
+    
+    while ( !a.compare_exchange_weak( old, old + x, std::memory_order_relaxed ) )
+        ;
+}
+
+}
+
+/**
+ * @addtogroup numeric
+ * @{
+ */
+
+/**
+ * @brief The total of a counter at a point in time
+ * @sa rate
+ */
+template<class Q>
+struct counter_snapshot
+{
+    Q value;
+    std::chrono::steady_clock::time_point time;
+};
+
+/**
+ * @brief Rate of a counter between two snapshots
+ * @pre @p from was taken before @p to
+ * 
+ * The result is per @c second, and converts to any unit of the same
+ * dimension, e.g. `quantity<double, count, minute_<-1> >`.
+ */
+template<class Q>
+auto rate( const counter_snapshot<Q> & from, const counter_snapshot<Q> & to )
+{
+    const quantity<double, second> elapsed = std::chrono::duration<double>( to.time - from.time );
+    
+    return ( to.value - from.value ) * 1.0 / elapsed;
+}
+
+/**
+ * @brief A counter that many threads can increment without contention.
+ * 
+ * The total is split in shards, each one on its own cache line; a thread
+ * always adds to the same shard, so that threads do not bounce cache lines
+ * between cores as they would with a single atomic. Reading the total 
+ * sums the shards.
+ * 
+ * @tparam Q A quantity, e.g. `quantity<std::uint64_t, byte>`
+ * 
+ * @code{.cpp}
+ *   sharded_counter< quantity<std::uint64_t, byte> > received;
+ *   
+ *   // On the I/O threads
+ *   received += quantity<std::uint64_t, byte>( n );
+ *   
+ *   // On the reporting thread
+ *   auto before = received.snapshot();
+ *   std::this_thread::sleep_for( std::chrono::seconds( 1 ) );
+ *   quantity<double, mebibyte, second_<-1> > r( rate( before, received.snapshot() ) );
+ * @endcode
+ * 
+ * @note Floating point counters add with a compare and swap loop, 
+ *  integral counters with a single atomic instruction.
+ */
+template<class Q>
+class sharded_counter
+{
+    static_assert( detail::is_quantity_v<Q>, "sharded_counter needs a quantity" );
+    
+    struct shard
+    {
+        alignas(detail::cache_line_size) std::atomic<typename Q::value_type> value;
+    };
+    
+    static_assert( sizeof(shard) == detail::cache_line_size, "" );
+    
+public:
+    typedef Q quantity_type;
+    typedef typename Q::value_type value_type;
+    
+    /**
+     * @brief Type of the rates, e.g. `quantity<double, byte, second_<-1> >`
+     */
+    typedef decltype( std::declval<Q>() * 1.0 / std::declval< quantity<double, second> >() ) rate_type;
+    
+    typedef counter_snapshot<Q> snapshot_type;
+    
+    /**
+     * @brief Create a counter at zero
+     * @param shards Number of shards, rounded up to a power of two; the
+     *  default is the number of hardware threads.
+     */
+    explicit sharded_counter( std::size_t shards = 0 )
+    {
+        if ( shards == 0 )
+            shards = std::max( 1u, std::thread::hardware_concurrency() );
+        
+        std::size_t n = 1;
+        
+        while ( n < shards )
+            n *= 2;
+        
+        // Over-allocate, new does not honour the alignment of shard before C++17
+        const std::size_t bytes = n * sizeof(shard) + detail::cache_line_size;
+        storage_.reset( new unsigned char[ bytes ] );
+        
+        void * p = storage_.get();
+        std::size_t space = bytes;
+        std::align( detail::cache_line_size, n * sizeof(shard), p, space );
+        
+        shards_ = static_cast<shard*>( p );
+        mask_ = n - 1;
+        
+        for ( std::size_t i = 0; i < n; ++i )
+            ::new ( &shards_[i] ) shard { { value_type( 0 ) } };
+    }
+    
+    sharded_counter( sharded_counter && ) noexcept = default;
+    sharded_counter & operator=( sharded_counter && ) noexcept = default;
+    
+    /**
+     * @brief Add @p q, in any unit of the same dimension as @p Q
+     */
+    template<class T, class ... Units>
+    void add( const quantity<T, Units...> & q ) noexcept
+    {
+        detail::atomic_add( shards_[ detail::thread_shard() & mask_ ].value, Q( q ).value() );
+    }
+    
+    template<class T, class ... Units>
+    sharded_counter & operator+=( const quantity<T, Units...> & q ) noexcept
+    {
+        add( q );
+        return *this;
+    }
+    
+    /**
+     * @brief Add one unit of @p Q
+     */
+    sharded_counter & operator++() noexcept
+    {
+        detail::atomic_add( shards_[ detail::thread_shard() & mask_ ].value, value_type( 1 ) );
+        return *this;
+    }
+    
+    /**
+     * @brief The total
+     * 
+     * Concurrent additions may or may not be included.
+     */
+    Q load() const noexcept
+    {
+        value_type sum = 0;
+        
+        for ( std::size_t i = 0; i <= mask_; ++i )
+            sum += shards_[i].value.load( std::memory_order_relaxed );
+        
+        return Q( sum );
+    }
+    
+    /**
+     * @brief The total, and the time it was read
+     */
+    snapshot_type snapshot() const noexcept
+    {
+        return { load(), std::chrono::steady_clock::now() };
+    }
+    
+    /**
+     * @brief Number of shards
+     */
+    std::size_t shards() const noexcept
+    {
+        return mask_ + 1;
+    }
+    
+private:
+    std::unique_ptr<unsigned char[]> storage_;
+    shard * shards_;
+    std::size_t mask_;
+};
+
+/** @} */
+
+}
+
+#endif //ENGINEERING_UNITS_NUMERIC_COUNTER_HPP
@@ -0,0 +1,174 @@
+/*
+ * Boost Software License - Version 1.0 - August 17th, 2003
+ *
+ * Permission is hereby granted, free of charge, to any person or organization
+ * obtaining a copy of the software and accompanying documentation covered by
+ * this license (the "Software") to use, reproduce, display, distribute,
+ * execute, and transmit the Software, and to prepare derivative works of the
+ * Software, and to permit third-parties to whom the Software is furnished to
+ * do so, all subject to the following:
+ *
+ * The copyright notices in the Software and this entire statement, including
+ * the above license grant, this restriction and the following disclaimer,
+ * must be included in all copies of the Software, in whole or in part, and
+ * all derivative works of the Software, unless such copies or derivative
+ * works are solely in the form of machine-executable object code generated by
+ * a source language processor.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+ * SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+ * FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef ENGINEERING_UNITS_NUMERIC_DIFFERENTIATION_HPP
+#define ENGINEERING_UNITS_NUMERIC_DIFFERENTIATION_HPP
+
+#include <type_traits>
+
+#include <engineering_units/quantity.hpp>
+
+#include <engineering_units/detail/doxygen.hpp>
+#include <engineering_units/detail/iterator.hpp>
+
+namespace engunits
+{
+
+/**
+ * @addtogroup numeric
+ * @{
+ */
+
+/**
+ * @brief Finite difference derivative of uniformly spaced samples.
+ * @param first,last Samples of the function, an @c InputIterator range
+ * @param dx Spacing of the abscissa
+ * @param d_first Beginning of the destination range,
+ *  receives one derivative for each sample.
+ * @return Output iterator to the element past the last element written.
+ * 
+ * Interior points use second order central differences, the two end
+ * points use first order one-sided differences. The unit of the result
+ * is the unit of the samples divided by the unit of @p dx.
+ * 
+ * The input is read in a single pass, keeping only the last three samples,
+ * so this can be used on streams. Nothing is written if there are less
+ * than two samples.
+ * 
+ * @code{.cpp}
+ *   std::vector< quantity<double, si::meter> > position = ...;
+ *   std::vector< quantity<double, si::meter, second_<-1> > > velocity( position.size() );
+ * 
+ *   gradient( position.begin(), position.end(), 0.01_s, velocity.begin() );
+ * @endcode
+ */
+template<class InputIt, class X, class OutputIt>
+OutputIt gradient( InputIt first, InputIt last, const X & dx, OutputIt d_first,
+                   ENGUNITS_ENABLE_IF( !detail::is_iterator_v<X> ) )
+{
+    using y_type = detail::iterator_value_t<InputIt>;
+    
+    if ( first == last )
+        return d_first;
+    
+    y_type y0 = *first;
+    
+    if ( ++first == last )
+        return d_first;
+    
+    y_type y1 = *first;
+    
+    *d_first = ( y1 - y0 ) / dx;
+    ++d_first;
+    
+    const auto two_dx = 2 * dx;
+    
+    while ( ++first != last )
+    {
+        const y_type y2 = *first;
+        
+        *d_first = ( y2 - y0 ) / two_dx;
+        ++d_first;
+        
+        y0 = y1;
+        y1 = y2;
+    }
+    
+    *d_first = ( y1 - y0 ) / dx;
+    ++d_first;
+    
+    return d_first;
+}
+
+/**
+ * @brief Finite difference derivative of samples at arbitrary abscissae.
+ * @param x_first,x_last Abscissae, an @c InputIterator range
+ * @param y_first Samples of the function, one for each abscissa
+ * @param d_first Beginning of the destination range,
+ *  receives one derivative for each sample.
+ * @return Output iterator to the element past the last element written.
+ * 
+ * Interior points use the second order three point formula for 
+ * non-uniform grids, the two end points use first order one-sided 
+ * differences. The unit of the result is the unit of the samples
+ * divided by the unit of the abscissae.
+ * 
+ * The input is read in a single pass, keeping only the last three samples.
+ */
+template<class InputIt1, class InputIt2, class OutputIt>
+OutputIt gradient( InputIt1 x_first, InputIt1 x_last, 
+                   InputIt2 y_first, OutputIt d_first,
+                   ENGUNITS_ENABLE_IF( detail::is_iterator_v<InputIt2> ) )
+{
+    using x_type = detail::iterator_value_t<InputIt1>;
+    using y_type = detail::iterator_value_t<InputIt2>;
+    
+    if ( x_first == x_last )
+        return d_first;
+    
+    x_type x0 = *x_first;
+    y_type y0 = *y_first;
+    
+    if ( ++x_first == x_last )
+        return d_first;
+    
+    x_type x1 = *x_first;
+    y_type y1 = *++y_first;
+    
+    *d_first = ( y1 - y0 ) / ( x1 - x0 );
+    ++d_first;
+    
+    while ( ++x_first != x_last )
+    {
+        const x_type x2 = *x_first;
+        const y_type y2 = *++y_first;
+        
+        const auto hs = x1 - x0;
+        const auto hd = x2 - x1;
+        
+        // Weights of the three samples, expressed as ratios of the steps
+        const auto r = hs / hd;
+        
+        *d_first = ( r * ( y2 - y1 ) + ( y1 - y0 ) / r ) / ( hs + hd );
+        ++d_first;
+        
+        x0 = x1;
+        x1 = x2;
+        y0 = y1;
+        y1 = y2;
+    }
+    
+    *d_first = ( y1 - y0 ) / ( x1 - x0 );
+    ++d_first;
+    
+    return d_first;
+}
+
+/** @} */
+
+}
+
+#endif //ENGINEERING_UNITS_NUMERIC_DIFFERENTIATION_HPP
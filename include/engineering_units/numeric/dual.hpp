@@ -0,0 +1,603 @@
+/*
+ * Boost Software License - Version 1.0 - August 17th, 2003
+ *
+ * Permission is hereby granted, free of charge, to any person or organization
+ * obtaining a copy of the software and accompanying documentation covered by
+ * this license (the "Software") to use, reproduce, display, distribute,
+ * execute, and transmit the Software, and to prepare derivative works of the
+ * Software, and to permit third-parties to whom the Software is furnished to
+ * do so, all subject to the following:
+ *
+ * The copyright notices in the Software and this entire statement, including
+ * the above license grant, this restriction and the following disclaimer,
+ * must be included in all copies of the Software, in whole or in part, and
+ * all derivative works of the Software, unless such copies or derivative
+ * works are solely in the form of machine-executable object code generated by
+ * a source language processor.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+ * SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+ * FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef ENGINEERING_UNITS_NUMERIC_DUAL_HPP
+#define ENGINEERING_UNITS_NUMERIC_DUAL_HPP
+
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <ostream>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include <engineering_units/quantity.hpp>
+
+#include <engineering_units/detail/doxygen.hpp>
+
+namespace engunits
+{
+
+/**
+ * @addtogroup numeric
+ * @{
+ */
+
+/**
+ * @brief A value and @p N of its partial derivatives
+ * 
+ * Arithmetic and the math functions apply the chain rule, so that a 
+ * formula evaluated on dual numbers computes its derivatives exactly, 
+ * together with its value (forward mode automatic differentiation).
+ * The type works as the value of a @c quantity.
+ * 
+ * With @p N greater than one, every operation updates @p N derivatives,
+ * stored contiguously, in a loop that vectorizes: one evaluation gives
+ * the derivatives with respect to @p N inputs, or along @p N directions.
+ * 
+ * @tparam N Number of derivatives
+ * 
+ * @code{.cpp}
+ *   // d/dx x^2 sin(x) at 1.5
+ *   dual<double> x = dual<double>::variable( 1.5 );
+ *   dual<double> y = x * x * sin( x );
+ *   
+ *   y.value();       // 2.24...
+ *   y.derivative();  // 3.15...
+ * @endcode
+ * 
+ * @note The comparison operators compare the values.
+ * 
+ * @sa derivative, jacobian
+ */
+template<class T, std::size_t N = 1>
+class dual
+{
+    static_assert( std::is_floating_point<T>::value, "dual needs a floating point type" );
+    static_assert( N > 0, "dual needs at least one derivative" );
+    
+public:
+    typedef T value_type;
+    
+    /**
+     * @brief A constant, all derivatives are zero
+     */
+    constexpr dual( T value = T( 0 ) ) noexcept :
+        value_( value ),
+        derivatives_()
+    {}
+    
+    /**
+     * @brief A constant from another arithmetic type, e.g. the 
+     *  @c long double conversion factors of @c quantity
+     */
+    template<class U, ENGUNITS_ENABLE_IF(( std::is_arithmetic<U>::value && !std::is_same<U, T>::value ))>
+    constexpr dual( U value ) noexcept :
+        dual( static_cast<T>( value ) )
+    {}
+    
+    /**
+     * @brief The independent variable number @p i, with value @p value
+     * @pre `i < N`
+     */
+    static dual variable( T value, std::size_t i = 0 ) noexcept
+    {
+        assert( i < N );
+        
+        dual r( value );
+        r.derivatives_[i] = T( 1 );
+        return r;
+    }
+    
+    static constexpr std::size_t size() noexcept { return N; }
+    
+    constexpr T value() const noexcept { return value_; }
+    
+    /**
+     * @pre `i < N`
+     */
+    T derivative( std::size_t i = 0 ) const noexcept
+    {
+        assert( i < N );
+        return derivatives_[i];
+    }
+    
+    T & derivative( std::size_t i = 0 ) noexcept
+    {
+        assert( i < N );
+        return derivatives_[i];
+    }
+    
+    /**
+     * @brief The function of one variable with value @p value and 
+     *  derivative @p d at this point
+     */
+    dual chain( T value, T d ) const noexcept
+    {
+        dual r( value );
+        
+        for ( std::size_t i = 0; i < N; ++i )
+            r.derivatives_[i] = d * derivatives_[i];
+        
+        return r;
+    }
+    
+    /**
+     * @brief The function of two variables with value @p value and 
+     *  partial derivatives @p dx and @p dy at @p x, @p y
+     */
+    static dual chain( T value, T dx, const dual & x, T dy, const dual & y ) noexcept
+    {
+        dual r( value );
+        
+        for ( std::size_t i = 0; i < N; ++i )
+            r.derivatives_[i] = dx * x.derivatives_[i] + dy * y.derivatives_[i];
+        
+        return r;
+    }
+    
+    dual operator+() const noexcept { return *this; }
+    dual operator-() const noexcept { return chain( -value_, T( -1 ) ); }
+    
+    dual & operator+=( const dual & rhs ) noexcept { return *this = *this + rhs; }
+    dual & operator-=( const dual & rhs ) noexcept { return *this = *this - rhs; }
+    dual & operator*=( const dual & rhs ) noexcept { return *this = *this * rhs; }
+    dual & operator/=( const dual & rhs ) noexcept { return *this = *this / rhs; }
+    
+    friend dual operator+( const dual & lhs, const dual & rhs ) noexcept
+    {
+        return chain( lhs.value_ + rhs.value_, T( 1 ), lhs, T( 1 ), rhs );
+    }
+    
+    friend dual operator-( const dual & lhs, const dual & rhs ) noexcept
+    {
+        return chain( lhs.value_ - rhs.value_, T( 1 ), lhs, T( -1 ), rhs );
+    }
+    
+    friend dual operator*( const dual & lhs, const dual & rhs ) noexcept
+    {
+        return chain( lhs.value_ * rhs.value_, rhs.value_, lhs, lhs.value_, rhs );
+    }
+    
+    friend dual operator/( const dual & lhs, const dual & rhs ) noexcept
+    {
+        const T q = lhs.value_ / rhs.value_;
+        return chain( q, T( 1 ) / rhs.value_, lhs, -q / rhs.value_, rhs );
+    }
+    
+    // Constants do not need a derivative of their own
+    template<class U, ENGUNITS_ENABLE_IF( std::is_arithmetic<U>::value )>
+    friend dual operator+( const dual & lhs, U rhs ) noexcept { return lhs.chain( lhs.value_ + T( rhs ), T( 1 ) ); }
+    
+    template<class U, ENGUNITS_ENABLE_IF( std::is_arithmetic<U>::value )>
+    friend dual operator+( U lhs, const dual & rhs ) noexcept { return rhs + lhs; }
+    
+    template<class U, ENGUNITS_ENABLE_IF( std::is_arithmetic<U>::value )>
+    friend dual operator-( const dual & lhs, U rhs ) noexcept { return lhs.chain( lhs.value_ - T( rhs ), T( 1 ) ); }
+    
+    template<class U, ENGUNITS_ENABLE_IF( std::is_arithmetic<U>::value )>
+    friend dual operator-( U lhs, const dual & rhs ) noexcept { return rhs.chain( T( lhs ) - rhs.value_, T( -1 ) ); }
+    
+    template<class U, ENGUNITS_ENABLE_IF( std::is_arithmetic<U>::value )>
+    friend dual operator*( const dual & lhs, U rhs ) noexcept { return lhs.chain( lhs.value_ * T( rhs ), T( rhs ) ); }
+    
+    template<class U, ENGUNITS_ENABLE_IF( std::is_arithmetic<U>::value )>
+    friend dual operator*( U lhs, const dual & rhs ) noexcept { return rhs * lhs; }
+    
+    template<class U, ENGUNITS_ENABLE_IF( std::is_arithmetic<U>::value )>
+    friend dual operator/( const dual & lhs, U rhs ) noexcept { return lhs.chain( lhs.value_ / T( rhs ), T( 1 ) / T( rhs ) ); }
+    
+    template<class U, ENGUNITS_ENABLE_IF( std::is_arithmetic<U>::value )>
+    friend dual operator/( U lhs, const dual & rhs ) noexcept
+    {
+        const T q = T( lhs ) / rhs.value_;
+        return rhs.chain( q, -q / rhs.value_ );
+    }
+    
+    friend constexpr bool operator==( const dual & lhs, const dual & rhs ) noexcept { return lhs.value_ == rhs.value_; }
+    friend constexpr bool operator!=( const dual & lhs, const dual & rhs ) noexcept { return lhs.value_ != rhs.value_; }
+    friend constexpr bool operator<( const dual & lhs, const dual & rhs ) noexcept { return lhs.value_ < rhs.value_; }
+    friend constexpr bool operator<=( const dual & lhs, const dual & rhs ) noexcept { return lhs.value_ <= rhs.value_; }
+    friend constexpr bool operator>( const dual & lhs, const dual & rhs ) noexcept { return lhs.value_ > rhs.value_; }
+    friend constexpr bool operator>=( const dual & lhs, const dual & rhs ) noexcept { return lhs.value_ >= rhs.value_; }
+    
+    /**
+     * @brief Print as `(value; d0, d1, ...)`
+     */
+    friend std::ostream & operator<<( std::ostream & os, const dual & x )
+    {
+        os << "(" << x.value_ << ";";
+        
+        for ( std::size_t i = 0; i < N; ++i )
+            os << ( i ? ", " : " " ) << x.derivatives_[i];
+        
+        return os << ")";
+    }
+    
+private:
+    T value_;
+    T derivatives_[N];
+};
+
+/**
+ * @name Math functions of dual numbers
+ * @relates dual
+ * @{
+ */
+
+template<class T, std::size_t N>
+dual<T, N> abs( const dual<T, N> & x ) noexcept
+{
+    return x.value() < T( 0 ) ? -x : x;
+}
+
+template<class T, std::size_t N>
+dual<T, N> fabs( const dual<T, N> & x ) noexcept
+{
+    return abs( x );
+}
+
+template<class T, std::size_t N>
+dual<T, N> fma( const dual<T, N> & x, const dual<T, N> & y, const dual<T, N> & z ) noexcept
+{
+    return x * y + z;
+}
+
+template<class T, std::size_t N>
+dual<T, N> fmax( const dual<T, N> & x, const dual<T, N> & y ) noexcept
+{
+    return x.value() < y.value() ? y : x;
+}
+
+template<class T, std::size_t N>
+dual<T, N> fmin( const dual<T, N> & x, const dual<T, N> & y ) noexcept
+{
+    return y.value() < x.value() ? y : x;
+}
+
+template<class T, std::size_t N>
+dual<T, N> fdim( const dual<T, N> & x, const dual<T, N> & y ) noexcept
+{
+    return x.value() > y.value() ? x - y : dual<T, N>();
+}
+
+template<class T, std::size_t N, class E, ENGUNITS_ENABLE_IF( std::is_arithmetic<E>::value )>
+dual<T, N> pow( const dual<T, N> & x, E e ) noexcept
+{
+    // Not x^(e-1) * x, which is NaN at x == 0 for e < 1
+    const T d = T( e ) == T( 0 ) ? T( 0 ) : T( e ) * std::pow( x.value(), T( e ) - T( 1 ) );
+    return x.chain( std::pow( x.value(), T( e ) ), d );
+}
+
+template<class T, std::size_t N>
+dual<T, N> pow( const dual<T, N> & x, const dual<T, N> & e ) noexcept
+{
+    const T p = std::pow( x.value(), e.value() );
+    const T d = e.value() == T( 0 ) ? T( 0 ) : e.value() * std::pow( x.value(), e.value() - T( 1 ) );
+    return dual<T, N>::chain( p, d, x, p * std::log( x.value() ), e );
+}
+
+template<class T, std::size_t N>
+dual<T, N> sqrt( const dual<T, N> & x ) noexcept
+{
+    const T r = std::sqrt( x.value() );
+    return x.chain( r, T( 0.5 ) / r );
+}
+
+template<class T, std::size_t N>
+dual<T, N> cbrt( const dual<T, N> & x ) noexcept
+{
+    const T r = std::cbrt( x.value() );
+    return x.chain( r, T( 1 ) / ( T( 3 ) * r * r ) );
+}
+
+template<class T, std::size_t N>
+dual<T, N> hypot( const dual<T, N> & x, const dual<T, N> & y ) noexcept
+{
+    const T h = std::hypot( x.value(), y.value() );
+    return dual<T, N>::chain( h, x.value() / h, x, y.value() / h, y );
+}
+
+template<class T, std::size_t N>
+dual<T, N> hypot( const dual<T, N> & x, const dual<T, N> & y, const dual<T, N> & z ) noexcept
+{
+    const T h = std::hypot( std::hypot( x.value(), y.value() ), z.value() );
+    return dual<T, N>::chain( h, x.value() / h, x, y.value() / h, y ) + z.chain( T( 0 ), z.value() / h );
+}
+
+template<class T, std::size_t N>
+dual<T, N> atan2( const dual<T, N> & y, const dual<T, N> & x ) noexcept
+{
+    const T r2 = x.value() * x.value() + y.value() * y.value();
+    return dual<T, N>::chain( std::atan2( y.value(), x.value() ), x.value() / r2, y, -y.value() / r2, x );
+}
+
+template<class T, std::size_t N>
+dual<T, N> exp( const dual<T, N> & x ) noexcept
+{
+    const T e = std::exp( x.value() );
+    return x.chain( e, e );
+}
+
+template<class T, std::size_t N>
+dual<T, N> log( const dual<T, N> & x ) noexcept
+{
+    return x.chain( std::log( x.value() ), T( 1 ) / x.value() );
+}
+
+template<class T, std::size_t N>
+dual<T, N> sin( const dual<T, N> & x ) noexcept
+{
+    return x.chain( std::sin( x.value() ), std::cos( x.value() ) );
+}
+
+template<class T, std::size_t N>
+dual<T, N> cos( const dual<T, N> & x ) noexcept
+{
+    return x.chain( std::cos( x.value() ), -std::sin( x.value() ) );
+}
+
+template<class T, std::size_t N>
+dual<T, N> tan( const dual<T, N> & x ) noexcept
+{
+    const T t = std::tan( x.value() );
+    return x.chain( t, T( 1 ) + t * t );
+}
+
+/** @} */
+
+/** @} */
+
+namespace detail
+{
+
+// The input number i of N, as an independent variable
+template<std::size_t N, class T, ENGUNITS_ENABLE_IF( std::is_floating_point<T>::value )>
+dual<T, N> seed( T x, std::size_t i ) noexcept
+{
+    return dual<T, N>::variable( x, i );
+}
+
+template<std::size_t N, class T, class ... Units>
+quantity< dual<T, N>, Units ... > seed( const quantity<T, Units ... > & x, std::size_t i ) noexcept
+{
+    return quantity< dual<T, N>, Units ... >( dual<T, N>::variable( x.value(), i ) );
+}
+
+// An output of dual numbers, split in the value and the derivatives
+template<class Y>
+struct primal
+{
+    static_assert( sizeof(Y) == 0, "the function must return dual numbers or quantities of dual numbers" );
+};
+
+template<class T, std::size_t N>
+struct primal< dual<T, N> >
+{
+    typedef T type;
+    
+    static T value( const dual<T, N> & y ) noexcept { return y.value(); }
+    static T derivative( const dual<T, N> & y, std::size_t i ) noexcept { return y.derivative( i ); }
+};
+
+template<class T, std::size_t N, class ... Units>
+struct primal< quantity< dual<T, N>, Units ... > >
+{
+    typedef quantity<T, Units ...> type;
+    
+    static type value( const quantity< dual<T, N>, Units ... > & y ) noexcept { return type( y.value().value() ); }
+    static T derivative( const quantity< dual<T, N>, Units ... > & y, std::size_t i ) noexcept { return y.value().derivative( i ); }
+};
+
+template<class Y>
+using primal_t = typename primal<Y>::type;
+
+// A single output is a tuple of one
+template<class Y>
+std::tuple<Y> as_tuple( Y && y )
+{
+    return std::tuple<Y>( std::move( y ) );
+}
+
+template<class ... Y>
+std::tuple<Y...> as_tuple( std::tuple<Y...> && y )
+{
+    return std::move( y );
+}
+
+template<class Y>
+struct primal_tuple;
+
+template<class ... Y>
+struct primal_tuple< std::tuple<Y...> >
+{
+    typedef std::tuple< primal_t<Y> ... > type;
+};
+
+template<class F, class ... X, std::size_t ... J>
+auto evaluate_seeded( F & f, std::index_sequence<J...>, const X & ... x )
+{
+    return as_tuple( f( seed< sizeof...(X) >( x, J ) ... ) );
+}
+
+}
+
+/**
+ * @addtogroup numeric
+ * @{
+ */
+
+/**
+ * @brief Derivative of @p f at @p x, by forward automatic differentiation
+ * @param f A function of one argument, generic in its value type: it is 
+ *  called with a `dual<T>`, or a quantity of `dual<T>`
+ * @param x The point, a floating point number or a quantity
+ * 
+ * The unit of the result is the unit of @p f divided by the unit of @p x:
+ * the derivative of a pressure in @c si::pascal with respect to an 
+ * altitude in @c si::meter is in pascal per meter.
+ * 
+ * @code{.cpp}
+ *   auto p = []( auto h ) { return p0 * exp( -h / scale_height ); };
+ *   
+ *   quantity<double, si::pascal, si::meter_<-1> > dp = derivative( p, 1000.0_m );
+ * @endcode
+ */
+template<class F, class X>
+auto derivative( F f, const X & x )
+{
+    auto y = f( detail::seed<1>( x, 0 ) );
+    
+    typedef decltype( y ) y_type;
+    typedef detail::quotient_t< detail::primal_t<y_type>, X > result_type;
+    
+    return result_type( detail::primal<y_type>::derivative( y, 0 ) );
+}
+
+/**
+ * @brief The values and the partial derivatives of a function of many
+ *  quantities
+ * @tparam Outputs A @c std::tuple of the results of the function
+ * @tparam Inputs A @c std::tuple of the arguments of the function
+ * 
+ * Each entry has its own unit: `get<I, J>()` is the derivative of the 
+ * output @p I with respect to the input @p J, a quantity in the unit of
+ * the output divided by the unit of the input, or a plain number if the
+ * units cancel out.
+ * 
+ * @sa jacobian
+ */
+template<class Outputs, class Inputs>
+class jacobian_matrix;
+
+template<class ... Y, class ... X>
+class jacobian_matrix< std::tuple<Y...>, std::tuple<X...> >
+{
+    static_assert( sizeof...(Y) > 0 && sizeof...(X) > 0, "empty jacobian" );
+    
+public:
+    typedef std::common_type_t< detail::value_type_t<X> ... > value_type;
+    
+    /**
+     * @brief Type of the derivative of the output @p I with respect to the input @p J
+     */
+    template<std::size_t I, std::size_t J>
+    using entry_type = detail::quotient_t<
+        std::tuple_element_t< I, std::tuple<Y...> >,
+        std::tuple_element_t< J, std::tuple<X...> >
+    >;
+    
+    /**
+     * @brief Split the outputs of a function evaluated on dual numbers,
+     *  seeded with one input per lane
+     */
+    template<class ... D>
+    explicit jacobian_matrix( const std::tuple<D...> & y ) :
+        jacobian_matrix( y, std::index_sequence_for<D...>() )
+    {}
+    
+    static constexpr std::size_t rows() noexcept { return sizeof...(Y); }
+    static constexpr std::size_t cols() noexcept { return sizeof...(X); }
+    
+    /**
+     * @brief The value of the output @p I
+     */
+    template<std::size_t I>
+    const std::tuple_element_t< I, std::tuple<Y...> > & value() const noexcept
+    {
+        return std::get<I>( values_ );
+    }
+    
+    /**
+     * @brief The derivative of the output @p I with respect to the input @p J
+     */
+    template<std::size_t I, std::size_t J>
+    entry_type<I, J> get() const noexcept
+    {
+        return entry_type<I, J>( d_[I][J] );
+    }
+    
+    /**
+     * @brief The derivative of the output @p i with respect to the input 
+     *  @p j, as a number in the unit of `entry_type<i, j>`
+     */
+    value_type operator()( std::size_t i, std::size_t j ) const noexcept
+    {
+        assert( i < rows() && j < cols() );
+        return d_[i][j];
+    }
+    
+private:
+    template<class ... D, std::size_t ... I>
+    jacobian_matrix( const std::tuple<D...> & y, std::index_sequence<I...> ) :
+        values_( detail::primal<D>::value( std::get<I>( y ) ) ... )
+    {
+        using expand = int[];
+        
+        for ( std::size_t j = 0; j < cols(); ++j )
+            static_cast<void>( expand { 0, ( d_[I][j] = detail::primal<D>::derivative( std::get<I>( y ), j ), 0 ) ... } );
+    }
+    
+    std::tuple<Y...> values_;
+    value_type d_[ sizeof...(Y) ][ sizeof...(X) ];
+};
+
+/**
+ * @brief All the partial derivatives of @p f at @p x, in one evaluation
+ * @param f A function of `sizeof...(x)` arguments, generic in their value
+ *  types, that returns a quantity or a @c std::tuple of quantities
+ * @param x The point, floating point numbers or quantities
+ * 
+ * @p f is called once with `dual<T, sizeof...(x)>` values, each input
+ * seeded in its own lane, so that all the columns of the Jacobian come
+ * out of the same evaluation.
+ * 
+ * @code{.cpp}
+ *   // Polar to cartesian
+ *   auto J = jacobian( []( auto r, auto theta ) {
+ *       return std::make_tuple( r * cos( theta ), r * sin( theta ) );
+ *   }, 2.0_m, 0.5_rad );
+ *   
+ *   double dx_dr = J.get<0, 0>();
+ *   quantity<double, si::meter, radian_<-1> > dy_dtheta = J.get<1, 1>();
+ * @endcode
+ */
+template<class F, class ... X>
+auto jacobian( F f, const X & ... x )
+{
+    auto y = detail::evaluate_seeded( f, std::index_sequence_for<X...>(), x ... );
+    
+    typedef typename detail::primal_tuple< decltype( y ) >::type outputs;
+    
+    return jacobian_matrix< outputs, std::tuple<X...> >( y );
+}
+
+/** @} */
+
+}
+
+#endif //ENGINEERING_UNITS_NUMERIC_DUAL_HPP
@@ -0,0 +1,476 @@
+/*
+ * Boost Software License - Version 1.0 - August 17th, 2003
+ *
+ * Permission is hereby granted, free of charge, to any person or organization
+ * obtaining a copy of the software and accompanying documentation covered by
+ * this license (the "Software") to use, reproduce, display, distribute,
+ * execute, and transmit the Software, and to prepare derivative works of the
+ * Software, and to permit third-parties to whom the Software is furnished to
+ * do so, all subject to the following:
+ *
+ * The copyright notices in the Software and this entire statement, including
+ * the above license grant, this restriction and the following disclaimer,
+ * must be included in all copies of the Software, in whole or in part, and
+ * all derivative works of the Software, unless such copies or derivative
+ * works are solely in the form of machine-executable object code generated by
+ * a source language processor.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+ * SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+ * FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef ENGINEERING_UNITS_NUMERIC_HISTOGRAM_HPP
+#define ENGINEERING_UNITS_NUMERIC_HISTOGRAM_HPP
+
+#include <algorithm>
+#include <cassert>
+#include <climits>
+#include <cmath>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#include <engineering_units/quantity.hpp>
+
+#include <engineering_units/detail/allocator.hpp>
+#include <engineering_units/detail/cache_line.hpp>
+#include <engineering_units/detail/doxygen.hpp>
+
+namespace engunits
+{
+
+/**
+ * @addtogroup numeric
+ * @{
+ */
+
+/**
+ * @brief Spacing of the bin edges of a @c histogram
+ */
+enum class bin_scale
+{
+    uniform,     ///< Bins of the same width
+    logarithmic  ///< Bins of the same ratio between upper and lower edge
+};
+
+/**
+ * @brief Histogram of quantities, with bin edges of the same unit.
+ * @tparam Q The type of the samples, a @c quantity of floating point values
+ *
+ * The range [ @c lower(), @c upper() ) is divided in @c bins() bins,
+ * uniformly or logarithmically spaced. Samples outside of the range are
+ * counted in the underflow and overflow bins, which also receive the
+ * samples that are NaN or, for logarithmic bins, not positive.
+ *
+ * Samples can be pushed in any unit convertible to the one of @p Q: the
+ * conversion factor is folded in the scale of the bin index computation,
+ * so the samples are never converted one by one.
+ *
+ * @code{.cpp}
+ *   histogram< quantity<double, si::meter, si::second_<-1> > > speeds( 0.0_m / 1.0_s,
+ *                                                                    40.0_m / 1.0_s,
+ *                                                                    80 );
+ *
+ *   // A vector of quantities in km/h
+ *   speeds.push( measures.begin(), measures.end() );
+ *
+ *   auto p99 = speeds.quantile( 0.99 );
+ * @endcode
+ */
+template<class Q>
+class histogram
+{
+    static_assert( detail::is_quantity_v<Q>, "histogram can only hold quantities" );
+
+public:
+    typedef Q sample_type;
+    typedef detail::value_type_t<Q> value_type;
+
+    // Bin widths, fractions and quantiles are all computed in value_type
+    static_assert( std::is_floating_point<value_type>::value,
+                   "histogram needs a floating point value type" );
+
+    /**
+     * @brief Construct an empty histogram
+     * @param lower Lower edge of the first bin
+     * @param upper Upper edge of the last bin
+     * @param bins Number of bins
+     * @param scale Spacing of the edges
+     * @pre `lower < upper` and `bins > 0`, and `lower > 0` for logarithmic bins.
+     */
+    histogram( const Q & lower, const Q & upper, std::size_t bins,
+               bin_scale scale = bin_scale::uniform ) :
+        scale_( scale ),
+        counts_( bins + 2, 0 )
+    {
+        assert( lower < upper && bins > 0 && bins < std::size_t( INT_MAX - 1 ) );
+        assert( scale == bin_scale::uniform || value_type(0) < lower.value() );
+
+        const value_type t_upper = transform( upper.value() );
+
+        origin_ = transform( lower.value() );
+        width_ = ( t_upper - origin_ ) / value_type( bins );
+    }
+
+    /**
+     * @brief Number of bins, not counting underflow and overflow
+     */
+    std::size_t bins() const noexcept
+    {
+        return counts_.size() - 2;
+    }
+
+    /**
+     * @brief Spacing of the edges
+     */
+    bin_scale scale() const noexcept
+    {
+        return scale_;
+    }
+
+    /**
+     * @brief Lower edge of the bin @p i, or of the whole range if @p i is 0
+     * @pre `i <= bins()`
+     */
+    Q lower( std::size_t i = 0 ) const
+    {
+        return Q( inverse_transform( origin_ + value_type(i) * width_ ) );
+    }
+
+    /**
+     * @brief Upper edge of the bin @p i, or of the whole range if @p i is omitted
+     * @pre `i < bins()`
+     */
+    Q upper( std::size_t i ) const
+    {
+        return lower( i + 1 );
+    }
+
+    Q upper() const
+    {
+        return lower( bins() );
+    }
+
+    /**
+     * @brief Number of samples in the bin @p i
+     * @pre `i < bins()`
+     */
+    std::size_t count( std::size_t i ) const
+    {
+        return counts_[i + 1];
+    }
+
+    /**
+     * @brief Number of samples below @c lower(), or that could not be binned
+     */
+    std::size_t underflow() const noexcept
+    {
+        return counts_.front();
+    }
+
+    /**
+     * @brief Number of samples not below @c upper()
+     */
+    std::size_t overflow() const noexcept
+    {
+        return counts_.back();
+    }
+
+    /**
+     * @brief Number of samples, including underflow and overflow
+     */
+    std::size_t total() const noexcept
+    {
+        return total_;
+    }
+
+    /**
+     * @brief Add a sample, of any unit convertible to the one of @p Q
+     */
+    template<class U, class ... Units>
+    void push( const quantity<U, Units...> & x )
+    {
+        const value_type v = value_type( x.value() );
+        int i;
+
+        bin_index( &v, 1, factor< quantity<U, Units...> >(), &i );
+
+        ++counts_[i];
+        ++total_;
+    }
+
+    /**
+     * @brief Add all the samples in [ @p first, @p last )
+     *
+     * The samples are processed in blocks: the bin indices of a whole block
+     * are computed in a loop that the compiler can vectorize, then the counts
+     * are incremented.
+     */
+    template<class InputIt>
+    void push( InputIt first, InputIt last )
+    {
+        total_ += add_counts( first, last, counts_.data() );
+    }
+
+    /**
+     * @brief Add all the samples in [ @p first, @p last ) using several threads.
+     * @param threads Number of threads, all the hardware threads if 0.
+     *
+     * Each thread counts a slice of the range in its own counters, with the 
+     * same bins. The counters are summed at the end, so the threads never 
+     * write to the same cache line.
+     */
+    template<class RandomIt>
+    void push_parallel( RandomIt first, RandomIt last, unsigned threads = 0 )
+    {
+        push_parallel( first, last, std::allocator<char>(), threads );
+    }
+
+    /**
+     * @brief Add all the samples in [ @p first, @p last ) using several threads.
+     * @param alloc Any allocator, rebound to the types of the local counters,
+     *  e.g. an @c arena_allocator or a `std::pmr::polymorphic_allocator`.
+     *  It is only used by the calling thread.
+     * @param threads Number of threads, all the hardware threads if 0.
+     */
+    template<class RandomIt, class Allocator,
+             ENGUNITS_ENABLE_IF( detail::is_allocator_v<Allocator> )>
+    void push_parallel( RandomIt first, RandomIt last, const Allocator & alloc, unsigned threads = 0 )
+    {
+        if ( threads == 0 )
+            threads = std::max( 1u, std::thread::hardware_concurrency() );
+
+        // Not worth a thread for less than 64k samples
+        const std::size_t min_chunk = std::size_t( 1 ) << 16;
+        const std::size_t size = std::size_t( last - first );
+        const std::size_t n = std::max<std::size_t>( 1,
+            std::min<std::size_t>( threads, size / min_chunk ) );
+
+        if ( n == 1 )
+        {
+            push( first, last );
+            return;
+        }
+
+        // The counters of each thread start on their own cache line
+        const std::size_t line = detail::cache_line_size / sizeof( std::size_t );
+        const std::size_t stride = ( counts_.size() + line - 1 ) / line * line;
+
+        std::vector< std::size_t, detail::rebind_alloc_t<Allocator, std::size_t> > local( ( n - 1 ) * stride, 0, alloc );
+        std::vector< std::thread, detail::rebind_alloc_t<Allocator, std::thread> > workers( alloc );
+        workers.reserve( n - 1 );
+
+        for ( std::size_t k = 1; k < n; ++k )
+        {
+            std::size_t * counts = local.data() + ( k - 1 ) * stride;
+
+            workers.emplace_back( [this, counts, first, size, n, k]()
+            {
+                add_counts( first + size * k / n, first + size * ( k + 1 ) / n, counts );
+            } );
+        }
+
+        add_counts( first, first + size / n, counts_.data() );
+
+        for ( auto & w : workers )
+            w.join();
+
+        for ( std::size_t k = 1; k < n; ++k )
+        {
+            const std::size_t * counts = local.data() + ( k - 1 ) * stride;
+
+            for ( std::size_t i = 0; i < counts_.size(); ++i )
+                counts_[i] += counts[i];
+        }
+
+        total_ += size;
+    }
+
+    /**
+     * @brief Add the counts of another histogram
+     * @pre Both histograms have the same bins.
+     */
+    void merge( const histogram & other )
+    {
+        assert( scale_ == other.scale_ && origin_ == other.origin_ &&
+                width_ == other.width_ && bins() == other.bins() );
+
+        for ( std::size_t i = 0; i < counts_.size(); ++i )
+            counts_[i] += other.counts_[i];
+
+        total_ += other.total_;
+    }
+
+    /**
+     * @brief Fraction of the samples not greater than @p x
+     * @pre `total() > 0`
+     *
+     * Samples are assumed to be spread uniformly in each bin, in the space of
+     * the bin edges, while underflow and overflow are assumed to lie on the
+     * edges of the range.
+     */
+    template<class U, class ... Units>
+    value_type cdf( const quantity<U, Units...> & x ) const
+    {
+        assert( total_ > 0 );
+
+        const value_type v = value_type( x.value() );
+        const value_type t = ( transform( v * factor< quantity<U, Units...> >() ) - origin_ ) / width_;
+
+        if ( !( t >= value_type(0) ) )
+            return value_type(0);
+
+        if ( t >= value_type( bins() ) )
+            return value_type(1);
+
+        const std::size_t i = std::size_t( t );
+        std::size_t below = counts_[0];
+
+        for ( std::size_t j = 0; j < i; ++j )
+            below += counts_[j + 1];
+
+        return ( value_type( below ) + ( t - value_type(i) ) * value_type( counts_[i + 1] ) ) /
+                value_type( total_ );
+    }
+
+    /**
+     * @brief Value below which lies the fraction @p p of the samples
+     * @pre `total() > 0` and `0 <= p <= 1`
+     *
+     * The inverse of @c cdf, with the same assumptions on the distribution
+     * of the samples in each bin.
+     */
+    Q quantile( value_type p ) const
+    {
+        assert( total_ > 0 && value_type(0) <= p && p <= value_type(1) );
+
+        const value_type target = p * value_type( total_ );
+        value_type below = value_type( counts_[0] );
+
+        if ( target <= below )
+            return lower();
+
+        for ( std::size_t i = 0; i < bins(); ++i )
+        {
+            const value_type c = value_type( counts_[i + 1] );
+
+            if ( c > value_type(0) && target <= below + c )
+                return Q( inverse_transform( origin_ + ( value_type(i) + ( target - below ) / c ) * width_ ) );
+
+            below += c;
+        }
+
+        return upper();
+    }
+
+private:
+    static constexpr std::size_t block_size = 256;
+
+    // Add the bin counts of [ first, last ) to counts, and return the number of samples
+    template<class InputIt>
+    std::size_t add_counts( InputIt first, InputIt last, std::size_t * counts ) const
+    {
+        const value_type c = factor< typename std::iterator_traits<InputIt>::value_type >();
+
+        // A short last block is padded with stale values, or zeros, so
+        // that the index loop always has a constant trip count
+        value_type values[block_size] = {};
+        int index[block_size];
+        std::size_t total = 0;
+
+        while ( first != last )
+        {
+            std::size_t n = 0;
+
+            for ( ; n < block_size && first != last; ++n, ++first )
+                values[n] = value_type( (*first).value() );
+
+            bin_index( values, block_size, c, index );
+
+            for ( std::size_t j = 0; j < n; ++j )
+                ++counts[ index[j] ];
+
+            total += n;
+        }
+
+        return total;
+    }
+
+    template<class S>
+    static value_type factor()
+    {
+        return value_type( conversion_factor( typename S::unit_type {}, typename Q::unit_type {} ) );
+    }
+
+    value_type transform( value_type x ) const
+    {
+        using std::log;
+        return scale_ == bin_scale::uniform ? x : log( x );
+    }
+
+    value_type inverse_transform( value_type t ) const
+    {
+        using std::exp;
+        return scale_ == bin_scale::uniform ? t : exp( t );
+    }
+
+    // Index in counts_ of the samples x[0..n), in the unit with conversion factor c.
+    // The index is shifted by one so that the underflow is 0; the comparisons
+    // are written so that NaN goes to the underflow.
+    void bin_index( const value_type * x, std::size_t n, value_type c, int * out ) const
+    {
+        using std::log;
+
+        const value_type top = value_type( bins() + 1 );
+        const value_type inv_width = value_type(1) / width_;
+
+        if ( scale_ == bin_scale::uniform )
+        {
+            const value_type a = c * inv_width;
+            const value_type b = value_type(1) - origin_ * inv_width;
+
+            for ( std::size_t j = 0; j < n; ++j )
+            {
+                value_type u = x[j] * a + b;
+                u = u > value_type(0) ? u : value_type(0);
+                u = u < top ? u : top;
+                out[j] = int( u );
+            }
+        }
+        else
+        {
+            const value_type b = value_type(1) + ( log( c ) - origin_ ) * inv_width;
+
+            for ( std::size_t j = 0; j < n; ++j )
+            {
+                value_type u = log( x[j] ) * inv_width + b;
+                u = u > value_type(0) ? u : value_type(0);
+                u = u < top ? u : top;
+                out[j] = int( u );
+            }
+        }
+    }
+
+    bin_scale scale_;
+
+    // Lower edge and width of the bins, after the transformation of the scale
+    value_type origin_;
+    value_type width_;
+
+    std::vector<std::size_t> counts_;
+    std::size_t total_ = 0;
+};
+
+/** @} */
+
+}
+
+#endif //ENGINEERING_UNITS_NUMERIC_HISTOGRAM_HPP
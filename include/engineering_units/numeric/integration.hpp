@@ -0,0 +1,376 @@
+/*
+ * Boost Software License - Version 1.0 - August 17th, 2003
+ *
+ * Permission is hereby granted, free of charge, to any person or organization
+ * obtaining a copy of the software and accompanying documentation covered by
+ * this license (the "Software") to use, reproduce, display, distribute,
+ * execute, and transmit the Software, and to prepare derivative works of the
+ * Software, and to permit third-parties to whom the Software is furnished to
+ * do so, all subject to the following:
+ *
+ * The copyright notices in the Software and this entire statement, including
+ * the above license grant, this restriction and the following disclaimer,
+ * must be included in all copies of the Software, in whole or in part, and
+ * all derivative works of the Software, unless such copies or derivative
+ * works are solely in the form of machine-executable object code generated by
+ * a source language processor.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+ * SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+ * FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef ENGINEERING_UNITS_NUMERIC_INTEGRATION_HPP
+#define ENGINEERING_UNITS_NUMERIC_INTEGRATION_HPP
+
+#include <cstddef>
+#include <type_traits>
+
+#include <engineering_units/quantity.hpp>
+
+#include <engineering_units/detail/doxygen.hpp>
+#include <engineering_units/detail/iterator.hpp>
+
+namespace engunits
+{
+
+namespace detail
+{
+
+/**
+ * @internal
+ * @brief Sum @p f(i) for i in [ @p first, @p last ).
+ * 
+ * Four independent partial sums break the dependency chain of the 
+ * additions, so the loop can be vectorized without reassociating 
+ * floating point operations.
+ */
+template<class T, class F>
+T unrolled_sum( std::ptrdiff_t first, std::ptrdiff_t last, F && f )
+{
+    T s0 {}, s1 {}, s2 {}, s3 {};
+    
+    std::ptrdiff_t i = first;
+    
+    for ( ; i + 4 <= last; i += 4 )
+    {
+        s0 = s0 + f( i );
+        s1 = s1 + f( i + 1 );
+        s2 = s2 + f( i + 2 );
+        s3 = s3 + f( i + 3 );
+    }
+    
+    for ( ; i < last; ++i )
+        s0 = s0 + f( i );
+    
+    return ( s0 + s1 ) + ( s2 + s3 );
+}
+
+}
+
+/**
+ * @addtogroup numeric
+ * @{
+ */
+
+/**
+ * @brief Integrate uniformly spaced samples with the trapezoidal rule.
+ * @param first,last Samples of the integrand, a @c RandomAccessIterator range
+ * @param dx Spacing of the abscissa
+ * @return The integral, whose unit is the integrand unit times the unit of @p dx
+ * 
+ * @code{.cpp}
+ *   std::vector< quantity<double, si::newton> > force = ...;
+ * 
+ *   // quantity<double, si::newton, si::meter>
+ *   auto work = trapezoid( force.begin(), force.end(), 1.0_mm );
+ * @endcode
+ */
+template<class RandomIt, class X>
+auto trapezoid( RandomIt first, RandomIt last, const X & dx,
+                ENGUNITS_ENABLE_IF( !detail::is_iterator_v<X> ) )
+{
+    using y_type = detail::iterator_value_t<RandomIt>;
+    using result_type = detail::product_t< y_type, X >;
+    
+    const std::ptrdiff_t n = last - first;
+    
+    if ( n < 2 )
+        return result_type {};
+    
+    const auto interior = detail::unrolled_sum< y_type >( 1, n - 1, [&]( std::ptrdiff_t i ) {
+        return first[i];
+    } );
+    
+    return result_type( ( interior + ( first[0] + first[n-1] ) / 2 ) * dx );
+}
+
+/**
+ * @brief Integrate samples at arbitrary abscissae with the trapezoidal rule.
+ * @param x_first,x_last Abscissae, a @c RandomAccessIterator range
+ * @param y_first Samples of the integrand, one for each abscissa
+ * @return The integral, whose unit is the integrand unit times the abscissa unit
+ */
+template<class RandomIt1, class RandomIt2>
+auto trapezoid( RandomIt1 x_first, RandomIt1 x_last, RandomIt2 y_first,
+                ENGUNITS_ENABLE_IF( detail::is_iterator_v<RandomIt2> ) )
+{
+    using x_type = detail::iterator_value_t<RandomIt1>;
+    using y_type = detail::iterator_value_t<RandomIt2>;
+    using result_type = detail::product_t< y_type, x_type >;
+    
+    const std::ptrdiff_t n = x_last - x_first;
+    
+    if ( n < 2 )
+        return result_type {};
+    
+    const auto sum = detail::unrolled_sum< result_type >( 0, n - 1, [&]( std::ptrdiff_t i ) {
+        return ( y_first[i] + y_first[i+1] ) * ( x_first[i+1] - x_first[i] );
+    } );
+    
+    return result_type( sum / 2 );
+}
+
+/**
+ * @brief Integrate uniformly spaced samples with the composite Simpson's rule.
+ * @param first,last Samples of the integrand, a @c RandomAccessIterator range
+ * @param dx Spacing of the abscissa
+ * @return The integral, whose unit is the integrand unit times the unit of @p dx
+ * 
+ * When the number of intervals is odd, the last three intervals are 
+ * integrated with Simpson's 3/8 rule. With only two samples this falls back
+ * to the trapezoidal rule.
+ */
+template<class RandomIt, class X>
+auto simpson( RandomIt first, RandomIt last, const X & dx,
+              ENGUNITS_ENABLE_IF( !detail::is_iterator_v<X> ) )
+{
+    using y_type = detail::iterator_value_t<RandomIt>;
+    using result_type = detail::product_t< y_type, X >;
+    
+    const std::ptrdiff_t n = last - first;
+    
+    if ( n < 3 )
+        return trapezoid( first, last, dx );
+    
+    // Number of points handled by the 1/3 rule.
+    const std::ptrdiff_t m = n % 2 == 1 ? n : n - 3;
+
+    const auto sum = detail::unrolled_sum< y_type >( 0, (m - 1) / 2, [&]( std::ptrdiff_t k ) {
+        return first[2*k] + 4 * first[2*k+1] + first[2*k+2];
+    } );
+    
+    result_type result( sum * dx / 3 );
+    
+    if ( m != n )
+    {
+        result = result + ( first[n-4] + 3 * ( first[n-3] + first[n-2] ) + first[n-1] ) * dx * 3 / 8;
+    }
+    
+    return result;
+}
+
+/**
+ * @brief Integrate samples at arbitrary abscissae with the composite Simpson's rule.
+ * @param x_first,x_last Abscissae, a @c RandomAccessIterator range
+ * @param y_first Samples of the integrand, one for each abscissa
+ * @return The integral, whose unit is the integrand unit times the abscissa unit
+ * 
+ * When the number of intervals is odd, the last interval is integrated with
+ * the parabola through the last three samples.
+ */
+template<class RandomIt1, class RandomIt2>
+auto simpson( RandomIt1 x_first, RandomIt1 x_last, RandomIt2 y_first,
+              ENGUNITS_ENABLE_IF( detail::is_iterator_v<RandomIt2> ) )
+{
+    using x_type = detail::iterator_value_t<RandomIt1>;
+    using y_type = detail::iterator_value_t<RandomIt2>;
+    using result_type = detail::product_t< y_type, x_type >;
+    
+    const std::ptrdiff_t n = x_last - x_first;
+    
+    if ( n < 3 )
+        return trapezoid( x_first, x_last, y_first );
+    
+    const std::ptrdiff_t m = n % 2 == 1 ? n : n - 1;
+    
+    const auto sum = detail::unrolled_sum< result_type >( 0, (m - 1) / 2, [&]( std::ptrdiff_t k ) {
+        const auto h0 = x_first[2*k+1] - x_first[2*k];
+        const auto h1 = x_first[2*k+2] - x_first[2*k+1];
+        const auto hs = h0 + h1;
+        
+        return ( ( 2 - h1 / h0 ) * y_first[2*k] +
+                 ( hs * hs / ( h0 * h1 ) ) * y_first[2*k+1] +
+                 ( 2 - h0 / h1 ) * y_first[2*k+2] ) * hs;
+    } );
+    
+    result_type result( sum / 6 );
+    
+    if ( m != n )
+    {
+        const auto h0 = x_first[n-2] - x_first[n-3];
+        const auto h1 = x_first[n-1] - x_first[n-2];
+        
+        const auto alpha = ( 2 + 3 * h0 / h1 ) / ( h0 / h1 + 1 );
+        const auto beta  = h1 / h0 + 3;
+        const auto eta   = ( h1 / h0 ) / ( h0 / h1 + 1 );
+        
+        result = result + ( alpha * y_first[n-1] + 
+                            beta * y_first[n-2] - 
+                            eta * y_first[n-3] ) * h1 / 6;
+    }
+    
+    return result;
+}
+
+/**
+ * @brief Running integral of a stream of samples, with the trapezoidal rule.
+ * @tparam X Type of the abscissa
+ * @tparam Y Type of the integrand
+ * 
+ * Only the last sample is kept, so the memory usage does not depend on
+ * the length of the stream.
+ * 
+ * @code{.cpp}
+ *   trapezoid_accumulator< quantity<double, second>,
+ *                          quantity<double, si::meter, second_<-3> > > flow;
+ * 
+ *   while ( read_sample(t, rate) )
+ *       flow.push( t, rate );
+ * 
+ *   auto volume = flow.value(); // m^3
+ * @endcode
+ */
+template<class X, class Y>
+class trapezoid_accumulator
+{
+public:
+    typedef X abscissa_type;
+    typedef Y integrand_type;
+    typedef detail::product_t< Y, X > result_type;
+    
+    /**
+     * @brief Add a sample
+     * @pre @p x must not be smaller than the previous abscissa.
+     */
+    void push( const X & x, const Y & y )
+    {
+        if ( count_ != 0 )
+            sum_ = sum_ + ( y_ + y ) * ( x - x_ ) / 2;
+        
+        x_ = x;
+        y_ = y;
+        ++count_;
+    }
+    
+    /**
+     * @brief The integral from the first to the last sample.
+     */
+    const result_type & value() const noexcept
+    {
+        return sum_;
+    }
+
+    /**
+     * @brief Number of samples pushed
+     */
+    std::size_t count() const noexcept
+    {
+        return count_;
+    }
+    
+    /**
+     * @brief Forget all the samples
+     */
+    void reset() noexcept
+    {
+        sum_ = result_type {};
+        count_ = 0;
+    }
+
+private:
+    X x_ {};
+    Y y_ {};
+    result_type sum_ {};
+    std::size_t count_ = 0;
+};
+
+/**
+ * @brief Cumulative integral of uniformly spaced samples, with the trapezoidal rule.
+ * @param first,last Samples of the integrand, an @c InputIterator range
+ * @param dx Spacing of the abscissa
+ * @param d_first Beginning of the destination range, 
+ *  receives one value for each sample, starting with zero.
+ * @return Output iterator to the element past the last element written.
+ * 
+ * The input is read in a single pass, so this can be used on streams.
+ */
+template<class InputIt, class X, class OutputIt>
+OutputIt cumulative_trapezoid( InputIt first, InputIt last, const X & dx, OutputIt d_first,
+                               ENGUNITS_ENABLE_IF( !detail::is_iterator_v<X> ) )
+{
+    using y_type = detail::iterator_value_t<InputIt>;
+    using result_type = detail::product_t< y_type, X >;
+    
+    if ( first == last )
+        return d_first;
+    
+    result_type sum {};
+    y_type prev = *first;
+    
+    *d_first = sum;
+    ++d_first;
+    
+    while ( ++first != last )
+    {
+        const y_type y = *first;
+        sum = sum + ( prev + y ) * dx / 2;
+        prev = y;
+        
+        *d_first = sum;
+        ++d_first;
+    }
+    
+    return d_first;
+}
+
+/**
+ * @brief Cumulative integral of samples at arbitrary abscissae, with the trapezoidal rule.
+ * @param x_first,x_last Abscissae, an @c InputIterator range
+ * @param y_first Samples of the integrand, one for each abscissa
+ * @param d_first Beginning of the destination range, 
+ *  receives one value for each sample, starting with zero.
+ * @return Output iterator to the element past the last element written.
+ * 
+ * The input is read in a single pass, so this can be used on streams.
+ * 
+ * @sa trapezoid_accumulator
+ */
+template<class InputIt1, class InputIt2, class OutputIt>
+OutputIt cumulative_trapezoid( InputIt1 x_first, InputIt1 x_last,
+                               InputIt2 y_first, OutputIt d_first,
+                               ENGUNITS_ENABLE_IF( detail::is_iterator_v<InputIt2> ) )
+{
+    trapezoid_accumulator< detail::iterator_value_t<InputIt1>,
+                           detail::iterator_value_t<InputIt2> > acc;
+    
+    for ( ; x_first != x_last; ++x_first, ++y_first )
+    {
+        acc.push( *x_first, *y_first );
+        
+        *d_first = acc.value();
+        ++d_first;
+    }
+    
+    return d_first;
+}
+
+/** @} */
+
+}
+
+#endif //ENGINEERING_UNITS_NUMERIC_INTEGRATION_HPP
@@ -0,0 +1,691 @@
+/*
+ * Boost Software License - Version 1.0 - August 17th, 2003
+ *
+ * Permission is hereby granted, free of charge, to any person or organization
+ * obtaining a copy of the software and accompanying documentation covered by
+ * this license (the "Software") to use, reproduce, display, distribute,
+ * execute, and transmit the Software, and to prepare derivative works of the
+ * Software, and to permit third-parties to whom the Software is furnished to
+ * do so, all subject to the following:
+ *
+ * The copyright notices in the Software and this entire statement, including
+ * the above license grant, this restriction and the following disclaimer,
+ * must be included in all copies of the Software, in whole or in part, and
+ * all derivative works of the Software, unless such copies or derivative
+ * works are solely in the form of machine-executable object code generated by
+ * a source language processor.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+ * SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+ * FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef ENGINEERING_UNITS_NUMERIC_INTERVAL_HPP
+#define ENGINEERING_UNITS_NUMERIC_INTERVAL_HPP
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <limits>
+#include <ostream>
+#include <type_traits>
+
+#include <engineering_units/quantity.hpp>
+
+#include <engineering_units/detail/doxygen.hpp>
+
+namespace engunits
+{
+
+namespace detail
+{
+
+// Error free transforms need a fused multiply add in hardware; std::fma
+// is a slow library call otherwise.
+#if defined(__FMA__) || defined(FP_FAST_FMA)
+#define ENGUNITS_HAS_FMA 1
+#endif
+
+// A floating point number above x: the successor of x, or rarely the 
+// one after it. Rump, Zimmermann, Boldo and Melquiond, "Computing
+// predecessor and successor in rounding to nearest" (2009). Adding at
+// least twice the smallest normal keeps the increment a normal number,
+// subnormals are very slow on most hardware; very small x may move by a
+// few ulps.
+template<class T>
+inline T next_up( T x ) noexcept
+{
+    constexpr T u = std::numeric_limits<T>::epsilon() / T( 2 );
+    constexpr T phi = u * ( T( 1 ) + T( 2 ) * u );
+    constexpr T small = T( 2 ) * std::numeric_limits<T>::min();
+    
+    if ( x == -std::numeric_limits<T>::infinity() )
+        return std::numeric_limits<T>::lowest();
+    
+    return x + std::max( phi * std::fabs( x ), small );
+}
+
+template<class T>
+inline T next_down( T x ) noexcept
+{
+    return -next_up( -x );
+}
+
+// Below this the error of a product may be subnormal, and inexact
+template<class T>
+constexpr T eft_threshold() noexcept
+{
+    return std::numeric_limits<T>::min() / std::numeric_limits<T>::epsilon() * T( 4 );
+}
+
+template<class T>
+inline T inexact_error() noexcept
+{
+    return std::numeric_limits<T>::quiet_NaN();
+}
+
+// Error free transforms: the exact result of an operation is r + e, 
+// with r the rounded result. e is NaN when it can not be computed 
+// exactly, because of overflow or underflow.
+template<class T>
+inline T two_sum( T a, T b, T r ) noexcept
+{
+    const T bb = r - a;
+    return ( a - ( r - bb ) ) + ( b - bb );
+}
+
+template<class T>
+inline T two_product( T a, T b, T r ) noexcept
+{
+    // A zero product is only exact if one of the factors is zero
+    if ( !( std::fabs( r ) >= eft_threshold<T>() ) && a != T( 0 ) && b != T( 0 ) )
+        return inexact_error<T>();
+    
+#if defined(ENGUNITS_HAS_FMA)
+    return std::fma( a, b, -r );
+#else
+    // Dekker's product; the split overflows to NaN for huge operands
+    const T split = T( ( 1ull << ( ( std::numeric_limits<T>::digits + 1 ) / 2 ) ) + 1 );
+    
+    const T ca = split * a;
+    const T ah = ca - ( ca - a );
+    const T al = a - ah;
+    
+    const T cb = split * b;
+    const T bh = cb - ( cb - b );
+    const T bl = b - bh;
+    
+    return ( ( ( ah * bh - r ) + ah * bl ) + al * bh ) + al * bl;
+#endif
+}
+
+// a - b c, exactly when b c is close to a. With a hardware fma this is a
+// single operation, which the compiler can not contract differently.
+template<class T>
+inline T residual( T a, T b, T c ) noexcept
+{
+    if ( !( std::fabs( a ) >= eft_threshold<T>() ) && a != T( 0 ) )
+        return inexact_error<T>();
+    
+#if defined(ENGUNITS_HAS_FMA)
+    return std::fma( -b, c, a );
+#else
+    const T p = b * c;
+    return ( a - p ) - two_product( b, c, p );
+#endif
+}
+
+// Round r down or up, given the sign of the error e of the exact result.
+// The sign of e is unpredictable: compute both, and select without a branch.
+template<class T>
+inline T round_down( T r, T e ) noexcept
+{
+    const T d = next_down( r );
+    return !( e >= T( 0 ) ) ? d : r;
+}
+
+template<class T>
+inline T round_up( T r, T e ) noexcept
+{
+    const T u = next_up( r );
+    return !( e <= T( 0 ) ) ? u : r;
+}
+
+template<class T>
+inline T add_down( T a, T b ) noexcept { const T r = a + b; return round_down( r, two_sum( a, b, r ) ); }
+
+template<class T>
+inline T add_up( T a, T b ) noexcept { const T r = a + b; return round_up( r, two_sum( a, b, r ) ); }
+
+template<class T>
+inline T mul_down( T a, T b ) noexcept { const T r = a * b; return round_down( r, two_product( a, b, r ) ); }
+
+template<class T>
+inline T mul_up( T a, T b ) noexcept { const T r = a * b; return round_up( r, two_product( a, b, r ) ); }
+
+// The exact quotient is q + ( a - q b ) / b
+template<class T>
+inline T division_error( T a, T b, T q ) noexcept
+{
+    const T r = residual( a, q, b );
+    return b < T( 0 ) ? -r : r;
+}
+
+template<class T>
+inline T div_down( T a, T b ) noexcept { const T q = a / b; return round_down( q, division_error( a, b, q ) ); }
+
+template<class T>
+inline T div_up( T a, T b ) noexcept { const T q = a / b; return round_up( q, division_error( a, b, q ) ); }
+
+// The exact root is s + ( a - s^2 ) / ( 2 s ) to first order
+template<class T>
+inline T sqrt_error( T a, T s ) noexcept
+{
+    return residual( a, s, s );
+}
+
+template<class T>
+inline T sqrt_down( T a ) noexcept { const T s = std::sqrt( a ); return s == T( 0 ) ? s : round_down( s, sqrt_error( a, s ) ); }
+
+template<class T>
+inline T sqrt_up( T a ) noexcept { const T s = std::sqrt( a ); return s == T( 0 ) && a == T( 0 ) ? s : round_up( s, sqrt_error( a, s ) ); }
+
+}
+
+/**
+ * @addtogroup numeric
+ * @{
+ */
+
+/**
+ * @brief A closed interval that is guaranteed to contain a real number
+ * 
+ * Every operation returns an interval that contains all the possible 
+ * results for operands within the input intervals, so that a formula 
+ * evaluated on intervals bounds the exact result, rounding errors 
+ * included. The type works as the value of a @c quantity.
+ * 
+ * @code{.cpp}
+ *   typedef quantity< interval<double>, si::meter > length_t;
+ *   
+ *   length_t a( interval<double>( 2.99, 3.01 ) );
+ *   length_t b( interval<double>( 3.99, 4.01 ) );
+ *   
+ *   auto c = hypot( a, b );   // within [4.985, 5.015] m
+ * @endcode
+ * 
+ * Additions, products, quotients and square roots round outward only 
+ * when needed: the rounding error is computed exactly with error free 
+ * transforms, and the bound moves by one ulp (rarely two) in the 
+ * direction of the error. The rounding mode of the FPU is never changed,
+ * so intervals mix freely with ordinary floating point code.
+ * 
+ * @note Transcendental functions assume the C library is accurate to 
+ *  one ulp, as glibc documents for double; their bounds are widened by 
+ *  one ulp.
+ * 
+ * @note Do not compile with @c -ffast-math, which breaks error free 
+ *  transforms.
+ * 
+ * @note The ordering operators are certain comparisons: `x < y` holds
+ *  when every point of @p x is smaller than every point of @p y.
+ */
+template<class T>
+class interval
+{
+    static_assert( std::is_floating_point<T>::value, "interval needs a floating point type" );
+    
+public:
+    typedef T value_type;
+    
+    /**
+     * @brief The point @p x
+     */
+    constexpr interval( T x = T( 0 ) ) noexcept :
+        lo_( x ),
+        hi_( x )
+    {}
+    
+    /**
+     * @brief The smallest interval that contains @p x
+     * 
+     * A @c long double conversion factor, or a large integer, may fall 
+     * between two values of @p T.
+     */
+    template<class U, ENGUNITS_ENABLE_IF(( std::is_arithmetic<U>::value && !std::is_same<U, T>::value ))>
+    interval( U x ) noexcept :
+        lo_( static_cast<T>( x ) ),
+        hi_( lo_ )
+    {
+        typedef long double wide;
+        
+        if ( static_cast<wide>( lo_ ) < static_cast<wide>( x ) )
+            hi_ = detail::next_up( lo_ );
+        else if ( static_cast<wide>( lo_ ) > static_cast<wide>( x ) )
+            lo_ = detail::next_down( lo_ );
+    }
+    
+    /**
+     * @pre `lower <= upper`
+     */
+    constexpr interval( T lower, T upper ) noexcept :
+        lo_( lower ),
+        hi_( upper )
+    {}
+    
+    /**
+     * @brief The interval of all real numbers
+     */
+    static constexpr interval entire() noexcept
+    {
+        return interval( -std::numeric_limits<T>::infinity(), std::numeric_limits<T>::infinity() );
+    }
+    
+    constexpr T lower() const noexcept { return lo_; }
+    constexpr T upper() const noexcept { return hi_; }
+    
+    constexpr T mid() const noexcept { return lo_ + ( hi_ - lo_ ) / T( 2 ); }
+    
+    /**
+     * @brief An upper bound of the width
+     */
+    T width() const noexcept { return detail::add_up( hi_, -lo_ ); }
+    
+    constexpr bool contains( T x ) const noexcept { return lo_ <= x && x <= hi_; }
+    
+    constexpr interval operator+() const noexcept { return *this; }
+    constexpr interval operator-() const noexcept { return interval( -hi_, -lo_ ); }
+    
+    interval & operator+=( const interval & rhs ) noexcept { return *this = *this + rhs; }
+    interval & operator-=( const interval & rhs ) noexcept { return *this = *this - rhs; }
+    interval & operator*=( const interval & rhs ) noexcept { return *this = *this * rhs; }
+    interval & operator/=( const interval & rhs ) noexcept { return *this = *this / rhs; }
+    
+    friend interval operator+( const interval & lhs, const interval & rhs ) noexcept
+    {
+        return interval( detail::add_down( lhs.lo_, rhs.lo_ ), detail::add_up( lhs.hi_, rhs.hi_ ) );
+    }
+    
+    friend interval operator-( const interval & lhs, const interval & rhs ) noexcept
+    {
+        return interval( detail::add_down( lhs.lo_, -rhs.hi_ ), detail::add_up( lhs.hi_, -rhs.lo_ ) );
+    }
+    
+    friend interval operator*( const interval & x, const interval & y ) noexcept
+    {
+        using detail::mul_down;
+        using detail::mul_up;
+        
+        if ( y.lo_ >= T( 0 ) )
+        {
+            if ( x.lo_ >= T( 0 ) )
+                return interval( mul_down( x.lo_, y.lo_ ), mul_up( x.hi_, y.hi_ ) );
+            if ( x.hi_ <= T( 0 ) )
+                return interval( mul_down( x.lo_, y.hi_ ), mul_up( x.hi_, y.lo_ ) );
+            
+            return interval( mul_down( x.lo_, y.hi_ ), mul_up( x.hi_, y.hi_ ) );
+        }
+        
+        if ( y.hi_ <= T( 0 ) )
+            return -( x * -y );
+        
+        if ( x.lo_ >= T( 0 ) )
+            return interval( mul_down( x.hi_, y.lo_ ), mul_up( x.hi_, y.hi_ ) );
+        if ( x.hi_ <= T( 0 ) )
+            return interval( mul_down( x.lo_, y.hi_ ), mul_up( x.lo_, y.lo_ ) );
+        
+        return interval( std::min( mul_down( x.lo_, y.hi_ ), mul_down( x.hi_, y.lo_ ) ),
+                         std::max( mul_up( x.lo_, y.lo_ ), mul_up( x.hi_, y.hi_ ) ) );
+    }
+    
+    /**
+     * Dividing by an interval that contains zero gives the entire line.
+     */
+    friend interval operator/( const interval & x, const interval & y ) noexcept
+    {
+        using detail::div_down;
+        using detail::div_up;
+        
+        if ( y.lo_ > T( 0 ) )
+        {
+            if ( x.lo_ >= T( 0 ) )
+                return interval( div_down( x.lo_, y.hi_ ), div_up( x.hi_, y.lo_ ) );
+            if ( x.hi_ <= T( 0 ) )
+                return interval( div_down( x.lo_, y.lo_ ), div_up( x.hi_, y.hi_ ) );
+            
+            return interval( div_down( x.lo_, y.lo_ ), div_up( x.hi_, y.lo_ ) );
+        }
+        
+        if ( y.hi_ < T( 0 ) )
+            return -( x / -y );
+        
+        return entire();
+    }
+    
+    friend constexpr bool operator==( const interval & lhs, const interval & rhs ) noexcept
+    {
+        return lhs.lo_ == rhs.lo_ && lhs.hi_ == rhs.hi_;
+    }
+    
+    friend constexpr bool operator!=( const interval & lhs, const interval & rhs ) noexcept
+    {
+        return !( lhs == rhs );
+    }
+    
+    friend constexpr bool operator<( const interval & lhs, const interval & rhs ) noexcept { return lhs.hi_ < rhs.lo_; }
+    friend constexpr bool operator<=( const interval & lhs, const interval & rhs ) noexcept { return lhs.hi_ <= rhs.lo_; }
+    friend constexpr bool operator>( const interval & lhs, const interval & rhs ) noexcept { return rhs < lhs; }
+    friend constexpr bool operator>=( const interval & lhs, const interval & rhs ) noexcept { return rhs <= lhs; }
+    
+    /**
+     * @brief Print as `[lower, upper]`
+     */
+    friend std::ostream & operator<<( std::ostream & os, const interval & x )
+    {
+        return os << "[" << x.lo_ << ", " << x.hi_ << "]";
+    }
+    
+private:
+    T lo_;
+    T hi_;
+};
+
+namespace detail
+{
+
+// f is increasing, and accurate to one ulp
+template<class T, class F>
+interval<T> increasing( const interval<T> & x, F f ) noexcept
+{
+    return interval<T>( next_down( f( x.lower() ) ), next_up( f( x.upper() ) ) );
+}
+
+// Smallest and largest absolute value
+template<class T>
+T mignitude( const interval<T> & x ) noexcept
+{
+    return x.lower() > T( 0 ) ? x.lower() : ( x.upper() < T( 0 ) ? -x.upper() : T( 0 ) );
+}
+
+template<class T>
+T magnitude( const interval<T> & x ) noexcept
+{
+    return std::max( -x.lower(), x.upper() );
+}
+
+// Whether [lo, hi] may contain offset + k pi, for an even or an odd k.
+// Near misses count as hits, the bounds stay conservative.
+template<class T>
+void critical_points( const interval<T> & x, long double offset, bool & even, bool & odd ) noexcept
+{
+    const long double pi = 3.141592653589793238462643383279502884L;
+    const long double a = ( x.lower() - offset ) / pi;
+    const long double b = ( x.upper() - offset ) / pi;
+    const long double tolerance = 8 * std::numeric_limits<T>::epsilon() * std::max( { 1.0L, std::fabs( a ), std::fabs( b ) } );
+    
+    const long double first = std::ceil( a - tolerance );
+    const long double last = std::floor( b + tolerance );
+    
+    even = false;
+    odd = false;
+    
+    for ( long double k = first; k <= last && k <= first + 2; ++k )
+    {
+        if ( std::fmod( k, 2.0L ) == 0 )
+            even = true;
+        else
+            odd = true;
+    }
+}
+
+// sin and cos, which have a maximum at offset + 2 k pi
+template<class T, class F>
+interval<T> periodic( const interval<T> & x, long double offset, F f ) noexcept
+{
+    if ( !( x.upper() - x.lower() < T( 6 ) ) )
+        return interval<T>( T( -1 ), T( 1 ) );
+    
+    bool has_max, has_min;
+    critical_points( x, offset, has_max, has_min );
+    
+    const T a = f( x.lower() );
+    const T b = f( x.upper() );
+    
+    return interval<T>( has_min ? T( -1 ) : std::max( T( -1 ), next_down( std::min( a, b ) ) ),
+                        has_max ? T( 1 ) : std::min( T( 1 ), next_up( std::max( a, b ) ) ) );
+}
+
+template<class T>
+T pi_up() noexcept
+{
+    return static_cast<T>( interval<T>( 3.141592653589793238462643383279502884L ).upper() );
+}
+
+}
+
+/**
+ * @name Math functions of intervals
+ * @relates interval
+ * @{
+ */
+
+template<class T>
+interval<T> abs( const interval<T> & x ) noexcept
+{
+    return interval<T>( detail::mignitude( x ), detail::magnitude( x ) );
+}
+
+template<class T>
+interval<T> fabs( const interval<T> & x ) noexcept
+{
+    return abs( x );
+}
+
+template<class T>
+interval<T> fma( const interval<T> & x, const interval<T> & y, const interval<T> & z ) noexcept
+{
+    return x * y + z;
+}
+
+template<class T>
+interval<T> fmax( const interval<T> & x, const interval<T> & y ) noexcept
+{
+    return interval<T>( std::max( x.lower(), y.lower() ), std::max( x.upper(), y.upper() ) );
+}
+
+template<class T>
+interval<T> fmin( const interval<T> & x, const interval<T> & y ) noexcept
+{
+    return interval<T>( std::min( x.lower(), y.lower() ), std::min( x.upper(), y.upper() ) );
+}
+
+template<class T>
+interval<T> fdim( const interval<T> & x, const interval<T> & y ) noexcept
+{
+    const interval<T> d = x - y;
+    return interval<T>( std::max( d.lower(), T( 0 ) ), std::max( d.upper(), T( 0 ) ) );
+}
+
+namespace detail
+{
+
+// Bounds of |x|^e, by repeated products of non negative intervals
+template<class T, class E>
+interval<T> abs_pow( const interval<T> & x, E e ) noexcept
+{
+    const interval<T> b = abs( x );
+    interval<T> r( T( 1 ) );
+    
+    for ( E i = 0; i < e; ++i )
+        r *= b;
+    
+    return r;
+}
+
+}
+
+/**
+ * @brief Integral power, by repeated products
+ */
+template<class T, class E, ENGUNITS_ENABLE_IF( std::is_integral<E>::value )>
+interval<T> pow( const interval<T> & x, E e ) noexcept
+{
+    if ( e < 0 )
+        return interval<T>( T( 1 ) ) / pow( x, -e );
+    
+    if ( e % 2 == 0 )
+        return detail::abs_pow( x, e );
+    
+    // Odd powers are increasing
+    const interval<T> lo = detail::abs_pow( interval<T>( x.lower() ), e );
+    const interval<T> hi = detail::abs_pow( interval<T>( x.upper() ), e );
+    
+    return interval<T>( x.lower() < T( 0 ) ? -lo.upper() : lo.lower(),
+                        x.upper() < T( 0 ) ? -hi.lower() : hi.upper() );
+}
+
+/**
+ * @pre `x.lower() >= 0`
+ */
+template<class T, class E, ENGUNITS_ENABLE_IF( std::is_floating_point<E>::value )>
+interval<T> pow( const interval<T> & x, E e ) noexcept
+{
+    const interval<T> k( e );
+    
+    if ( k.lower() != k.upper() )
+        return pow( x, k );
+    
+    // Monotonic in x
+    const T a = std::pow( x.lower(), k.lower() );
+    const T b = std::pow( x.upper(), k.lower() );
+    
+    return interval<T>( std::max( T( 0 ), detail::next_down( std::min( a, b ) ) ),
+                        detail::next_up( std::max( a, b ) ) );
+}
+
+/**
+ * @pre `x.lower() >= 0`
+ */
+template<class T>
+interval<T> pow( const interval<T> & x, const interval<T> & e ) noexcept
+{
+    // Monotonic in each argument, the extremes are at the corners
+    const T c[] = { std::pow( x.lower(), e.lower() ), std::pow( x.lower(), e.upper() ),
+                    std::pow( x.upper(), e.lower() ), std::pow( x.upper(), e.upper() ) };
+    
+    return interval<T>( std::max( T( 0 ), detail::next_down( *std::min_element( c, c + 4 ) ) ),
+                        detail::next_up( *std::max_element( c, c + 4 ) ) );
+}
+
+/**
+ * Negative values are ignored, the square root of an interval with no 
+ * positive value is NaN.
+ */
+template<class T>
+interval<T> sqrt( const interval<T> & x ) noexcept
+{
+    if ( x.upper() < T( 0 ) )
+        return interval<T>( std::numeric_limits<T>::quiet_NaN() );
+    
+    return interval<T>( detail::sqrt_down( std::max( x.lower(), T( 0 ) ) ), detail::sqrt_up( x.upper() ) );
+}
+
+template<class T>
+interval<T> cbrt( const interval<T> & x ) noexcept
+{
+    return detail::increasing( x, []( T a ) { return std::cbrt( a ); } );
+}
+
+template<class T>
+interval<T> hypot( const interval<T> & x, const interval<T> & y ) noexcept
+{
+    using detail::mignitude;
+    using detail::magnitude;
+    
+    return interval<T>( detail::next_down( std::hypot( mignitude( x ), mignitude( y ) ) ),
+                        detail::next_up( std::hypot( magnitude( x ), magnitude( y ) ) ) );
+}
+
+template<class T>
+interval<T> hypot( const interval<T> & x, const interval<T> & y, const interval<T> & z ) noexcept
+{
+    using detail::mignitude;
+    using detail::magnitude;
+    
+    return interval<T>( detail::next_down( std::hypot( mignitude( x ), mignitude( y ), mignitude( z ) ) ),
+                        detail::next_up( std::hypot( magnitude( x ), magnitude( y ), magnitude( z ) ) ) );
+}
+
+/**
+ * The range of the angle of the points in the box @p x by @p y; the 
+ * whole circle if the box contains the origin, or crosses the branch cut 
+ * on the negative x axis.
+ */
+template<class T>
+interval<T> atan2( const interval<T> & y, const interval<T> & x ) noexcept
+{
+    const T pi = detail::pi_up<T>();
+    
+    if ( ( x.contains( T( 0 ) ) && y.contains( T( 0 ) ) ) ||
+         ( x.lower() < T( 0 ) && y.lower() < T( 0 ) && y.upper() >= T( 0 ) ) )
+        return interval<T>( -pi, pi );
+    
+    // The extreme angles of a convex set are at its corners
+    const T c[] = { std::atan2( y.lower(), x.lower() ), std::atan2( y.lower(), x.upper() ),
+                    std::atan2( y.upper(), x.lower() ), std::atan2( y.upper(), x.upper() ) };
+    
+    return interval<T>( std::max( -pi, detail::next_down( *std::min_element( c, c + 4 ) ) ),
+                        std::min( pi, detail::next_up( *std::max_element( c, c + 4 ) ) ) );
+}
+
+template<class T>
+interval<T> exp( const interval<T> & x ) noexcept
+{
+    const interval<T> r = detail::increasing( x, []( T a ) { return std::exp( a ); } );
+    return interval<T>( std::max( r.lower(), T( 0 ) ), r.upper() );
+}
+
+template<class T>
+interval<T> log( const interval<T> & x ) noexcept
+{
+    return detail::increasing( x, []( T a ) { return std::log( a ); } );
+}
+
+template<class T>
+interval<T> sin( const interval<T> & x ) noexcept
+{
+    return detail::periodic( x, 1.570796326794896619231321691639751442L, []( T a ) { return std::sin( a ); } );
+}
+
+template<class T>
+interval<T> cos( const interval<T> & x ) noexcept
+{
+    return detail::periodic( x, 0.0L, []( T a ) { return std::cos( a ); } );
+}
+
+/**
+ * The entire line if @p x may contain a pole.
+ */
+template<class T>
+interval<T> tan( const interval<T> & x ) noexcept
+{
+    bool even, odd;
+    detail::critical_points( x, 1.570796326794896619231321691639751442L, even, odd );
+    
+    if ( even || odd || !( x.upper() - x.lower() < T( 3 ) ) )
+        return interval<T>::entire();
+    
+    return detail::increasing( x, []( T a ) { return std::tan( a ); } );
+}
+
+/** @} */
+
+/** @} */
+
+}
+
+#endif //ENGINEERING_UNITS_NUMERIC_INTERVAL_HPP
@@ -0,0 +1,654 @@
+/*
+ * Boost Software License - Version 1.0 - August 17th, 2003
+ *
+ * Permission is hereby granted, free of charge, to any person or organization
+ * obtaining a copy of the software and accompanying documentation covered by
+ * this license (the "Software") to use, reproduce, display, distribute,
+ * execute, and transmit the Software, and to prepare derivative works of the
+ * Software, and to permit third-parties to whom the Software is furnished to
+ * do so, all subject to the following:
+ *
+ * The copyright notices in the Software and this entire statement, including
+ * the above license grant, this restriction and the following disclaimer,
+ * must be included in all copies of the Software, in whole or in part, and
+ * all derivative works of the Software, unless such copies or derivative
+ * works are solely in the form of machine-executable object code generated by
+ * a source language processor.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+ * SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+ * FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef ENGINEERING_UNITS_NUMERIC_MEASUREMENT_HPP
+#define ENGINEERING_UNITS_NUMERIC_MEASUREMENT_HPP
+
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <ostream>
+#include <random>
+#include <type_traits>
+
+#include <engineering_units/quantity.hpp>
+
+#include <engineering_units/detail/cache_line.hpp>
+#include <engineering_units/detail/doxygen.hpp>
+
+namespace engunits
+{
+
+namespace detail
+{
+
+template<class T>
+T root_sum_square( T a, T b ) noexcept
+{
+    return std::sqrt( a * a + b * b );
+}
+
+}
+
+/**
+ * @addtogroup numeric
+ * @{
+ */
+
+/**
+ * @brief A value with a standard uncertainty
+ * 
+ * Arithmetic and the math functions propagate the uncertainty to first 
+ * order, assuming that the operands are independent: the result of 
+ * @c f(x,y) has standard deviation 
+ * \f$ \sqrt{ (\partial_x f\,\sigma_x)^2 + (\partial_y f\,\sigma_y)^2 } \f$.
+ * The type works as the value of a @c quantity.
+ * 
+ * @code{.cpp}
+ *   typedef quantity< measurement<double>, si::hectopascal > pressure_t;
+ *   typedef quantity< measurement<double>, si::kelvin > temperature_t;
+ *   
+ *   pressure_t p( measurement<double>( 1013.25, 0.5 ) );
+ *   temperature_t t( measurement<double>( 288.15, 0.2 ) );
+ *   
+ *   auto rho = p / ( t * R );  // rho.value().stddev() is about 0.08% of the mean
+ * @endcode
+ * 
+ * @note Correlations are not tracked, so `x - x` has standard deviation
+ *  \f$ \sqrt{2}\,\sigma_x \f$ rather than zero. Use @c sampled when the 
+ *  inputs appear more than once, or the formula is far from linear.
+ * 
+ * @note Comparisons other than @c == and @c != compare the mean values.
+ */
+template<class T>
+class measurement
+{
+    static_assert( std::is_floating_point<T>::value, "measurement needs a floating point type" );
+    
+public:
+    typedef T value_type;
+    
+    /**
+     * @brief An exact value
+     */
+    constexpr measurement( T value = T( 0 ) ) noexcept :
+        value_( value ),
+        stddev_( T( 0 ) )
+    {}
+    
+    /**
+     * @pre `stddev >= 0`
+     */
+    constexpr measurement( T value, T stddev ) noexcept :
+        value_( value ),
+        stddev_( stddev )
+    {}
+    
+    constexpr T value() const noexcept { return value_; }
+    constexpr T stddev() const noexcept { return stddev_; }
+    constexpr T variance() const noexcept { return stddev_ * stddev_; }
+    
+    constexpr measurement operator+() const noexcept { return *this; }
+    constexpr measurement operator-() const noexcept { return measurement( -value_, stddev_ ); }
+    
+    measurement & operator+=( const measurement & rhs ) noexcept { return *this = *this + rhs; }
+    measurement & operator-=( const measurement & rhs ) noexcept { return *this = *this - rhs; }
+    measurement & operator*=( const measurement & rhs ) noexcept { return *this = *this * rhs; }
+    measurement & operator/=( const measurement & rhs ) noexcept { return *this = *this / rhs; }
+    
+    friend measurement operator+( const measurement & lhs, const measurement & rhs ) noexcept
+    {
+        return measurement( lhs.value_ + rhs.value_, detail::root_sum_square( lhs.stddev_, rhs.stddev_ ) );
+    }
+    
+    friend measurement operator-( const measurement & lhs, const measurement & rhs ) noexcept
+    {
+        return measurement( lhs.value_ - rhs.value_, detail::root_sum_square( lhs.stddev_, rhs.stddev_ ) );
+    }
+    
+    friend measurement operator*( const measurement & lhs, const measurement & rhs ) noexcept
+    {
+        return measurement( lhs.value_ * rhs.value_, 
+                            detail::root_sum_square( rhs.value_ * lhs.stddev_, lhs.value_ * rhs.stddev_ ) );
+    }
+    
+    friend measurement operator/( const measurement & lhs, const measurement & rhs ) noexcept
+    {
+        const T q = lhs.value_ / rhs.value_;
+        return measurement( q, detail::root_sum_square( lhs.stddev_, q * rhs.stddev_ ) / std::fabs( rhs.value_ ) );
+    }
+    
+    friend constexpr bool operator==( const measurement & lhs, const measurement & rhs ) noexcept
+    {
+        return lhs.value_ == rhs.value_ && lhs.stddev_ == rhs.stddev_;
+    }
+    
+    friend constexpr bool operator!=( const measurement & lhs, const measurement & rhs ) noexcept
+    {
+        return !( lhs == rhs );
+    }
+    
+    friend constexpr bool operator<( const measurement & lhs, const measurement & rhs ) noexcept { return lhs.value_ < rhs.value_; }
+    friend constexpr bool operator<=( const measurement & lhs, const measurement & rhs ) noexcept { return lhs.value_ <= rhs.value_; }
+    friend constexpr bool operator>( const measurement & lhs, const measurement & rhs ) noexcept { return lhs.value_ > rhs.value_; }
+    friend constexpr bool operator>=( const measurement & lhs, const measurement & rhs ) noexcept { return lhs.value_ >= rhs.value_; }
+    
+    /**
+     * @brief Print as `(value +/- stddev)`
+     */
+    friend std::ostream & operator<<( std::ostream & os, const measurement & m )
+    {
+        return os << "(" << m.value_ << " +/- " << m.stddev_ << ")";
+    }
+    
+private:
+    T value_;
+    T stddev_;
+};
+
+/**
+ * @name Math functions of measurements
+ * @relates measurement
+ * @{
+ */
+
+template<class T>
+measurement<T> abs( const measurement<T> & x ) noexcept
+{
+    return measurement<T>( std::fabs( x.value() ), x.stddev() );
+}
+
+template<class T>
+measurement<T> fabs( const measurement<T> & x ) noexcept
+{
+    return abs( x );
+}
+
+template<class T>
+measurement<T> fma( const measurement<T> & x, const measurement<T> & y, const measurement<T> & z ) noexcept
+{
+    const T a = y.value() * x.stddev();
+    const T b = x.value() * y.stddev();
+    
+    return measurement<T>( std::fma( x.value(), y.value(), z.value() ),
+                           std::sqrt( a * a + b * b + z.variance() ) );
+}
+
+template<class T>
+measurement<T> fmax( const measurement<T> & x, const measurement<T> & y ) noexcept
+{
+    return x.value() < y.value() ? y : x;
+}
+
+template<class T>
+measurement<T> fmin( const measurement<T> & x, const measurement<T> & y ) noexcept
+{
+    return y.value() < x.value() ? y : x;
+}
+
+template<class T>
+measurement<T> fdim( const measurement<T> & x, const measurement<T> & y ) noexcept
+{
+    return x.value() > y.value() ? x - y : measurement<T>();
+}
+
+template<class T, class E, ENGUNITS_ENABLE_IF( std::is_arithmetic<E>::value )>
+measurement<T> pow( const measurement<T> & x, E e ) noexcept
+{
+    const T d = T( e ) * std::pow( x.value(), T( e ) - T( 1 ) );
+    return measurement<T>( std::pow( x.value(), T( e ) ), std::fabs( d ) * x.stddev() );
+}
+
+template<class T>
+measurement<T> pow( const measurement<T> & x, const measurement<T> & e ) noexcept
+{
+    const T p = std::pow( x.value(), e.value() );
+    
+    return measurement<T>( p, detail::root_sum_square( e.value() * p / x.value() * x.stddev(),
+                                                       p * std::log( x.value() ) * e.stddev() ) );
+}
+
+template<class T>
+measurement<T> sqrt( const measurement<T> & x ) noexcept
+{
+    const T r = std::sqrt( x.value() );
+    return measurement<T>( r, x.stddev() / ( T( 2 ) * r ) );
+}
+
+template<class T>
+measurement<T> cbrt( const measurement<T> & x ) noexcept
+{
+    const T r = std::cbrt( x.value() );
+    return measurement<T>( r, x.stddev() / ( T( 3 ) * r * r ) );
+}
+
+template<class T>
+measurement<T> hypot( const measurement<T> & x, const measurement<T> & y ) noexcept
+{
+    const T h = std::hypot( x.value(), y.value() );
+    return measurement<T>( h, detail::root_sum_square( x.value() * x.stddev(), y.value() * y.stddev() ) / h );
+}
+
+template<class T>
+measurement<T> hypot( const measurement<T> & x, const measurement<T> & y, const measurement<T> & z ) noexcept
+{
+    const T h = std::hypot( x.value(), y.value(), z.value() );
+    const T a = x.value() * x.stddev();
+    const T b = y.value() * y.stddev();
+    const T c = z.value() * z.stddev();
+    
+    return measurement<T>( h, std::sqrt( a * a + b * b + c * c ) / h );
+}
+
+template<class T>
+measurement<T> atan2( const measurement<T> & y, const measurement<T> & x ) noexcept
+{
+    const T r2 = x.value() * x.value() + y.value() * y.value();
+    
+    return measurement<T>( std::atan2( y.value(), x.value() ),
+                           detail::root_sum_square( x.value() * y.stddev(), y.value() * x.stddev() ) / r2 );
+}
+
+template<class T>
+measurement<T> exp( const measurement<T> & x ) noexcept
+{
+    const T e = std::exp( x.value() );
+    return measurement<T>( e, e * x.stddev() );
+}
+
+template<class T>
+measurement<T> log( const measurement<T> & x ) noexcept
+{
+    return measurement<T>( std::log( x.value() ), x.stddev() / std::fabs( x.value() ) );
+}
+
+template<class T>
+measurement<T> sin( const measurement<T> & x ) noexcept
+{
+    return measurement<T>( std::sin( x.value() ), std::fabs( std::cos( x.value() ) ) * x.stddev() );
+}
+
+template<class T>
+measurement<T> cos( const measurement<T> & x ) noexcept
+{
+    return measurement<T>( std::cos( x.value() ), std::fabs( std::sin( x.value() ) ) * x.stddev() );
+}
+
+template<class T>
+measurement<T> tan( const measurement<T> & x ) noexcept
+{
+    const T t = std::tan( x.value() );
+    return measurement<T>( t, ( T( 1 ) + t * t ) * x.stddev() );
+}
+
+/** @} */
+
+/**
+ * @brief @p N Monte Carlo samples of an uncertain value
+ * 
+ * Every operation applies lane by lane to the samples, which are stored
+ * contiguously and aligned to a cache line, so that the loops vectorize.
+ * A formula written for @c double, or for a @c quantity, evaluates 
+ * unchanged on @c sampled values, and the statistics of the result 
+ * account for correlations and non linearities that @c measurement 
+ * ignores.
+ * 
+ * @tparam N Number of samples; a multiple of the SIMD width is best
+ * 
+ * @code{.cpp}
+ *   std::mt19937_64 rng;
+ *   
+ *   auto p = draw<256>( pressure_t( measurement<double>( 1013.25, 0.5 ) ), rng );
+ *   auto t = draw<256>( temperature_t( measurement<double>( 288.15, 0.2 ) ), rng );
+ *   
+ *   auto rho = summarize( p / ( t * R ) );  // quantity< measurement<double>, ... >
+ * @endcode
+ * 
+ * @note Only the comparison for equality is defined: there is no single
+ *  answer to which of two distributions is the smaller one.
+ */
+template<class T, std::size_t N>
+class sampled
+{
+    static_assert( std::is_floating_point<T>::value, "sampled needs a floating point type" );
+    static_assert( N > 0, "sampled needs at least one sample" );
+    
+public:
+    typedef T value_type;
+    
+    /**
+     * @brief Uninitialized samples
+     */
+    sampled() = default;
+    
+    /**
+     * @brief All samples equal to @p x
+     */
+    sampled( T x ) noexcept
+    {
+        for ( std::size_t i = 0; i < N; ++i )
+            samples_[i] = x;
+    }
+    
+    static constexpr std::size_t size() noexcept { return N; }
+    
+    T * data() noexcept { return samples_; }
+    const T * data() const noexcept { return samples_; }
+    
+    T & operator[]( std::size_t i ) noexcept { assert( i < N ); return samples_[i]; }
+    const T & operator[]( std::size_t i ) const noexcept { assert( i < N ); return samples_[i]; }
+    
+    T mean() const noexcept
+    {
+        T s = T( 0 );
+        
+        for ( std::size_t i = 0; i < N; ++i )
+            s += samples_[i];
+        
+        return s / T( N );
+    }
+    
+    /**
+     * @brief The sample standard deviation
+     */
+    T stddev() const noexcept
+    {
+        if ( N == 1 )
+            return T( 0 );
+        
+        const T m = mean();
+        T s = T( 0 );
+        
+        for ( std::size_t i = 0; i < N; ++i )
+            s += ( samples_[i] - m ) * ( samples_[i] - m );
+        
+        return std::sqrt( s / T( N - 1 ) );
+    }
+    
+    /**
+     * @brief Apply @p f to every sample
+     */
+    template<class F>
+    friend sampled map( const sampled & x, F f ) noexcept
+    {
+        sampled r;
+        
+        for ( std::size_t i = 0; i < N; ++i )
+            r.samples_[i] = f( x.samples_[i] );
+        
+        return r;
+    }
+    
+    /**
+     * @brief Apply @p f to every pair of samples
+     */
+    template<class F>
+    friend sampled map( const sampled & x, const sampled & y, F f ) noexcept
+    {
+        sampled r;
+        
+        for ( std::size_t i = 0; i < N; ++i )
+            r.samples_[i] = f( x.samples_[i], y.samples_[i] );
+        
+        return r;
+    }
+    
+    sampled operator+() const noexcept { return *this; }
+    sampled operator-() const noexcept { return map( *this, []( T a ) { return -a; } ); }
+    
+    sampled & operator+=( const sampled & rhs ) noexcept { return *this = *this + rhs; }
+    sampled & operator-=( const sampled & rhs ) noexcept { return *this = *this - rhs; }
+    sampled & operator*=( const sampled & rhs ) noexcept { return *this = *this * rhs; }
+    sampled & operator/=( const sampled & rhs ) noexcept { return *this = *this / rhs; }
+    
+    friend sampled operator+( const sampled & lhs, const sampled & rhs ) noexcept
+    {
+        return map( lhs, rhs, []( T a, T b ) { return a + b; } );
+    }
+    
+    friend sampled operator-( const sampled & lhs, const sampled & rhs ) noexcept
+    {
+        return map( lhs, rhs, []( T a, T b ) { return a - b; } );
+    }
+    
+    friend sampled operator*( const sampled & lhs, const sampled & rhs ) noexcept
+    {
+        return map( lhs, rhs, []( T a, T b ) { return a * b; } );
+    }
+    
+    friend sampled operator/( const sampled & lhs, const sampled & rhs ) noexcept
+    {
+        return map( lhs, rhs, []( T a, T b ) { return a / b; } );
+    }
+    
+    // Scalars, including the long double conversion factors of quantity
+    template<class U, ENGUNITS_ENABLE_IF( std::is_arithmetic<U>::value )>
+    friend sampled operator*( const sampled & lhs, U rhs ) noexcept
+    {
+        const T k = T( rhs );
+        return map( lhs, [k]( T a ) { return a * k; } );
+    }
+    
+    template<class U, ENGUNITS_ENABLE_IF( std::is_arithmetic<U>::value )>
+    friend sampled operator*( U lhs, const sampled & rhs ) noexcept
+    {
+        return rhs * lhs;
+    }
+    
+    template<class U, ENGUNITS_ENABLE_IF( std::is_arithmetic<U>::value )>
+    friend sampled operator/( const sampled & lhs, U rhs ) noexcept
+    {
+        const T k = T( rhs );
+        return map( lhs, [k]( T a ) { return a / k; } );
+    }
+    
+    template<class U, ENGUNITS_ENABLE_IF( std::is_arithmetic<U>::value )>
+    friend sampled operator/( U lhs, const sampled & rhs ) noexcept
+    {
+        const T k = T( lhs );
+        return map( rhs, [k]( T a ) { return k / a; } );
+    }
+    
+    friend bool operator==( const sampled & lhs, const sampled & rhs ) noexcept
+    {
+        for ( std::size_t i = 0; i < N; ++i )
+            if ( lhs.samples_[i] != rhs.samples_[i] )
+                return false;
+        
+        return true;
+    }
+    
+    friend bool operator!=( const sampled & lhs, const sampled & rhs ) noexcept
+    {
+        return !( lhs == rhs );
+    }
+    
+private:
+    alignas(detail::cache_line_size) T samples_[N];
+};
+
+/**
+ * @name Math functions of samples
+ * @relates sampled
+ * @{
+ */
+
+#define ENGUNITS_SAMPLED_FUNCTION(name)                                     \
+    template<class T, std::size_t N>                                        \
+    sampled<T, N> name( const sampled<T, N> & x ) noexcept                  \
+    {                                                                       \
+        return map( x, []( T a ) { return std::name( a ); } );              \
+    }
+
+#define ENGUNITS_SAMPLED_FUNCTION2(name)                                    \
+    template<class T, std::size_t N>                                        \
+    sampled<T, N> name( const sampled<T, N> & x,                            \
+                        const sampled<T, N> & y ) noexcept                  \
+    {                                                                       \
+        return map( x, y, []( T a, T b ) { return std::name( a, b ); } );   \
+    }
+
+ENGUNITS_SAMPLED_FUNCTION( abs )
+ENGUNITS_SAMPLED_FUNCTION( fabs )
+ENGUNITS_SAMPLED_FUNCTION( sqrt )
+ENGUNITS_SAMPLED_FUNCTION( cbrt )
+ENGUNITS_SAMPLED_FUNCTION( exp )
+ENGUNITS_SAMPLED_FUNCTION( log )
+ENGUNITS_SAMPLED_FUNCTION( sin )
+ENGUNITS_SAMPLED_FUNCTION( cos )
+ENGUNITS_SAMPLED_FUNCTION( tan )
+
+ENGUNITS_SAMPLED_FUNCTION2( fmax )
+ENGUNITS_SAMPLED_FUNCTION2( fmin )
+ENGUNITS_SAMPLED_FUNCTION2( fdim )
+ENGUNITS_SAMPLED_FUNCTION2( hypot )
+ENGUNITS_SAMPLED_FUNCTION2( atan2 )
+ENGUNITS_SAMPLED_FUNCTION2( pow )
+
+#undef ENGUNITS_SAMPLED_FUNCTION
+#undef ENGUNITS_SAMPLED_FUNCTION2
+
+template<class T, std::size_t N, class E, ENGUNITS_ENABLE_IF( std::is_arithmetic<E>::value )>
+sampled<T, N> pow( const sampled<T, N> & x, E e ) noexcept
+{
+    // Integral exponents, as quantity's pow<Exp> uses, multiply out
+    if ( std::is_integral<E>::value && e >= 0 && e <= 4 )
+    {
+        sampled<T, N> r( T( 1 ) );
+        
+        for ( E i = 0; i < e; ++i )
+            r *= x;
+        
+        return r;
+    }
+    
+    const T k = T( e );
+    return map( x, [k]( T a ) { return std::pow( a, k ); } );
+}
+
+template<class T, std::size_t N>
+sampled<T, N> fma( const sampled<T, N> & x, const sampled<T, N> & y, const sampled<T, N> & z ) noexcept
+{
+    sampled<T, N> r;
+    
+    for ( std::size_t i = 0; i < N; ++i )
+        r[i] = x[i] * y[i] + z[i];
+    
+    return r;
+}
+
+template<class T, std::size_t N>
+sampled<T, N> hypot( const sampled<T, N> & x, const sampled<T, N> & y, const sampled<T, N> & z ) noexcept
+{
+    sampled<T, N> r;
+    
+    for ( std::size_t i = 0; i < N; ++i )
+        r[i] = std::hypot( x[i], y[i], z[i] );
+    
+    return r;
+}
+
+/** @} */
+
+/**
+ * @brief @p N normally distributed samples of @p m
+ * @relates sampled
+ */
+template<std::size_t N, class T, class URBG>
+sampled<T, N> draw( const measurement<T> & m, URBG & g )
+{
+    std::normal_distribution<T> d( m.value(), m.stddev() );
+    sampled<T, N> r;
+    
+    for ( std::size_t i = 0; i < N; ++i )
+        r[i] = d( g );
+    
+    return r;
+}
+
+/**
+ * @brief @p N normally distributed samples of a quantity
+ * @relates sampled
+ */
+template<std::size_t N, class T, class ... Units, class URBG>
+quantity< sampled<T, N>, Units ... > draw( const quantity< measurement<T>, Units ... > & q, URBG & g )
+{
+    return quantity< sampled<T, N>, Units ... >( draw<N>( q.value(), g ) );
+}
+
+/**
+ * @brief Samples of @p m made from standard normal samples @p z
+ * @relates sampled
+ * 
+ * Drawing random numbers costs much more than evaluating most formulas. 
+ * When the same analysis runs on many inputs, draw @p z once per 
+ * independent variable, e.g. `draw<N>( measurement<double>( 0, 1 ), rng )`,
+ * and scale it for every input.
+ */
+template<class T, std::size_t N>
+sampled<T, N> draw( const measurement<T> & m, const sampled<T, N> & z ) noexcept
+{
+    const T mu = m.value();
+    const T sigma = m.stddev();
+    
+    return map( z, [mu, sigma]( T a ) { return mu + sigma * a; } );
+}
+
+/**
+ * @brief Samples of a quantity made from standard normal samples @p z
+ * @relates sampled
+ */
+template<class T, std::size_t N, class ... Units>
+quantity< sampled<T, N>, Units ... > draw( const quantity< measurement<T>, Units ... > & q, const sampled<T, N> & z ) noexcept
+{
+    return quantity< sampled<T, N>, Units ... >( draw( q.value(), z ) );
+}
+
+/**
+ * @brief Mean and standard deviation of the samples
+ * @relates sampled
+ */
+template<class T, std::size_t N>
+measurement<T> summarize( const sampled<T, N> & x ) noexcept
+{
+    return measurement<T>( x.mean(), x.stddev() );
+}
+
+/**
+ * @brief Mean and standard deviation of the samples of a quantity
+ * @relates sampled
+ */
+template<class T, std::size_t N, class ... Units>
+quantity< measurement<T>, Units ... > summarize( const quantity< sampled<T, N>, Units ... > & q ) noexcept
+{
+    return quantity< measurement<T>, Units ... >( summarize( q.value() ) );
+}
+
+/** @} */
+
+}
+
+#endif //ENGINEERING_UNITS_NUMERIC_MEASUREMENT_HPP
@@ -0,0 +1,608 @@
+/*
+ * Boost Software License - Version 1.0 - August 17th, 2003
+ *
+ * Permission is hereby granted, free of charge, to any person or organization
+ * obtaining a copy of the software and accompanying documentation covered by
+ * this license (the "Software") to use, reproduce, display, distribute,
+ * execute, and transmit the Software, and to prepare derivative works of the
+ * Software, and to permit third-parties to whom the Software is furnished to
+ * do so, all subject to the following:
+ *
+ * The copyright notices in the Software and this entire statement, including
+ * the above license grant, this restriction and the following disclaimer,
+ * must be included in all copies of the Software, in whole or in part, and
+ * all derivative works of the Software, unless such copies or derivative
+ * works are solely in the form of machine-executable object code generated by
+ * a source language processor.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+ * SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+ * FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef ENGINEERING_UNITS_NUMERIC_ODE_HPP
+#define ENGINEERING_UNITS_NUMERIC_ODE_HPP
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include <engineering_units/quantity.hpp>
+
+#include <engineering_units/detail/algebra.hpp>
+#include <engineering_units/detail/doxygen.hpp>
+
+namespace engunits
+{
+
+namespace detail
+{
+
+template<class Q, class Time>
+using derivative_t = quotient_t<Q, Time>;
+
+}
+
+/**
+ * @addtogroup numeric
+ * @{
+ */
+
+/**
+ * @brief Classic fourth order Runge-Kutta stepper.
+ * @tparam Time A @c quantity used for the independent variable, 
+ *  usually `quantity<double, second>`.
+ * @tparam Algebra Storage policy, either a single state or a batch of states.
+ * @tparam Qs The quantities that make up the state.
+ * 
+ * The derivative of each component of the state is obtained by dividing
+ * the component by @p Time, so the system function can not return a 
+ * derivative with the wrong unit.
+ * 
+ * The system is a callable with signature 
+ * `void (const state_type & x, derivative_type & dxdt, time_type t)`.
+ * 
+ * All the intermediate stages are stored inside the stepper, 
+ * so @c do_step never allocates.
+ * 
+ * @sa runge_kutta4
+ * @sa batch_runge_kutta4
+ */
+template<class Time, class Algebra, class ... Qs>
+class basic_runge_kutta4
+{
+    static_assert( detail::is_quantity_v<Time>, "Time must be a quantity" );
+    static_assert( sizeof ... (Qs) > 0, "Empty state not allowed" );
+
+public:
+    typedef Time time_type;
+    typedef typename Time::value_type value_type;
+
+    /**
+     * @brief The state, a tuple of quantities (or of arrays of quantities in batch mode)
+     */
+    typedef std::tuple< typename Algebra::template container<Qs> ... > state_type;
+    
+    /**
+     * @brief The derivative of @c state_type with respect to @c time_type
+     */
+    typedef std::tuple< typename Algebra::template container<
+        detail::derivative_t<Qs, Time> > ... > derivative_type;
+    
+    /**
+     * @brief Construct a stepper
+     * @param n Number of trajectories integrated in lockstep, 
+     *          ignored for a single state.
+     */
+    explicit basic_runge_kutta4( std::size_t n = 1 )
+    {
+        Algebra::resize( tmp_, n );
+        Algebra::resize( k1_, n );
+        Algebra::resize( k2_, n );
+        Algebra::resize( k3_, n );
+        Algebra::resize( k4_, n );
+    }
+    
+    /**
+     * @brief Advance @p x from @p t to @p t + @p dt
+     */
+    template<class System>
+    void do_step( System && system,
+                  state_type & x,
+                  time_type & t,
+                  const time_type & dt )
+    {
+        assert( Algebra::same_size( x, tmp_ ) );
+        
+        const time_type half_dt = dt / value_type(2);
+        const time_type dt6 = dt / value_type(6);
+        
+        system( static_cast<const state_type &>(x), k1_, t );
+        
+        Algebra::for_each( [&]( auto & tmp, auto const & xi, auto const & k ) {
+            tmp = xi + half_dt * k;
+        }, tmp_, x, k1_ );
+        
+        system( static_cast<const state_type &>(tmp_), k2_, t + half_dt );
+        
+        Algebra::for_each( [&]( auto & tmp, auto const & xi, auto const & k ) {
+            tmp = xi + half_dt * k;
+        }, tmp_, x, k2_ );
+        
+        system( static_cast<const state_type &>(tmp_), k3_, t + half_dt );
+        
+        Algebra::for_each( [&]( auto & tmp, auto const & xi, auto const & k ) {
+            tmp = xi + dt * k;
+        }, tmp_, x, k3_ );
+        
+        system( static_cast<const state_type &>(tmp_), k4_, t + dt );
+        
+        Algebra::for_each( [&]( auto & xi, 
+                                auto const & k1, 
+                                auto const & k2,
+                                auto const & k3,
+                                auto const & k4 ) {
+            xi = xi + dt6 * ( k1 + value_type(2) * ( k2 + k3 ) + k4 );
+        }, x, k1_, k2_, k3_, k4_ );
+        
+        t = t + dt;
+    }
+
+private:
+    state_type tmp_;
+    derivative_type k1_;
+    derivative_type k2_;
+    derivative_type k3_;
+    derivative_type k4_;
+};
+
+/**
+ * @brief Adaptive Dormand-Prince 5(4) Runge-Kutta stepper.
+ * @tparam Time A @c quantity used for the independent variable.
+ * @tparam Algebra Storage policy, either a single state or a batch of states.
+ * @tparam Qs The quantities that make up the state.
+ * 
+ * The local error of each component is compared against 
+ * `atol + rtol * |x|`, where the absolute tolerance is a quantity 
+ * with the same unit of the component.
+ * 
+ * In batch mode all the trajectories share the same step, 
+ * which is controlled by the largest error in the batch.
+ * 
+ * The last stage is reused as the first stage of the next step, 
+ * call @c reset if the state is modified between two steps.
+ * 
+ * @sa runge_kutta45
+ * @sa batch_runge_kutta45
+ */
+template<class Time, class Algebra, class ... Qs>
+class basic_runge_kutta45
+{
+    static_assert( detail::is_quantity_v<Time>, "Time must be a quantity" );
+    static_assert( sizeof ... (Qs) > 0, "Empty state not allowed" );
+
+public:
+    typedef Time time_type;
+    typedef typename Time::value_type value_type;
+    
+    typedef std::tuple< typename Algebra::template container<Qs> ... > state_type;
+    
+    typedef std::tuple< typename Algebra::template container<
+        detail::derivative_t<Qs, Time> > ... > derivative_type;
+    
+    /**
+     * @brief Absolute tolerance, one value for each component of the state.
+     */
+    typedef std::tuple< Qs ... > tolerance_type;
+    
+    /**
+     * @brief Construct a stepper
+     * @param atol Absolute tolerance for each component.
+     * @param rtol Relative tolerance.
+     * @param n Number of trajectories integrated in lockstep, 
+     *          ignored for a single state.
+     */
+    explicit basic_runge_kutta45( const tolerance_type & atol,
+                                  value_type rtol = value_type(1e-6),
+                                  std::size_t n = 1 ) :
+        atol_( atol ),
+        rtol_( rtol )
+    {
+        Algebra::resize( tmp_, n );
+        Algebra::resize( x_new_, n );
+        Algebra::resize( k1_, n );
+        Algebra::resize( k2_, n );
+        Algebra::resize( k3_, n );
+        Algebra::resize( k4_, n );
+        Algebra::resize( k5_, n );
+        Algebra::resize( k6_, n );
+        Algebra::resize( k7_, n );
+    }
+    
+    /**
+     * @brief Discard the derivative cached from the previous step.
+     */
+    void reset() noexcept
+    {
+        fsal_ = false;
+    }
+
+    /**
+     * @brief Try to advance @p x from @p t to @p t + @p dt
+     * @return true if the step was accepted.
+     * 
+     * On success @p x and @p t are updated. In both cases @p dt is set
+     * to the step size suggested for the next attempt.
+     */
+    template<class System>
+    bool try_step( System && system,
+                   state_type & x,
+                   time_type & t,
+                   time_type & dt )
+    {
+        using std::pow;
+        
+        assert( Algebra::same_size( x, tmp_ ) );
+        
+        if ( !fsal_ )
+        {
+            system( static_cast<const state_type &>(x), k1_, t );
+            fsal_ = true;
+        }
+        
+        const time_type h = dt;
+        
+        // Dormand-Prince tableau
+        const value_type c2 = value_type(1.0 / 5.0);
+        const value_type c3 = value_type(3.0 / 10.0);
+        const value_type c4 = value_type(4.0 / 5.0);
+        const value_type c5 = value_type(8.0 / 9.0);
+        
+        const value_type a21 = value_type(1.0 / 5.0);
+        const value_type a31 = value_type(3.0 / 40.0);
+        const value_type a32 = value_type(9.0 / 40.0);
+        const value_type a41 = value_type(44.0 / 45.0);
+        const value_type a42 = value_type(-56.0 / 15.0);
+        const value_type a43 = value_type(32.0 / 9.0);
+        const value_type a51 = value_type(19372.0 / 6561.0);
+        const value_type a52 = value_type(-25360.0 / 2187.0);
+        const value_type a53 = value_type(64448.0 / 6561.0);
+        const value_type a54 = value_type(-212.0 / 729.0);
+        const value_type a61 = value_type(9017.0 / 3168.0);
+        const value_type a62 = value_type(-355.0 / 33.0);
+        const value_type a63 = value_type(46732.0 / 5247.0);
+        const value_type a64 = value_type(49.0 / 176.0);
+        const value_type a65 = value_type(-5103.0 / 18656.0);
+        const value_type a71 = value_type(35.0 / 384.0);
+        const value_type a73 = value_type(500.0 / 1113.0);
+        const value_type a74 = value_type(125.0 / 192.0);
+        const value_type a75 = value_type(-2187.0 / 6784.0);
+        const value_type a76 = value_type(11.0 / 84.0);
+        
+        // Difference between the fifth and the embedded fourth order solution
+        const value_type e1 = value_type(71.0 / 57600.0);
+        const value_type e3 = value_type(-71.0 / 16695.0);
+        const value_type e4 = value_type(71.0 / 1920.0);
+        const value_type e5 = value_type(-17253.0 / 339200.0);
+        const value_type e6 = value_type(22.0 / 525.0);
+        const value_type e7 = value_type(-1.0 / 40.0);
+        
+        stage( system, x, t + c2 * h, k2_, [&]( auto const & k1, auto const &, 
+                                                auto const &, auto const &, auto const & ) {
+            return h * ( a21 * k1 );
+        } );
+
+        stage( system, x, t + c3 * h, k3_, [&]( auto const & k1, auto const & k2,
+                                                auto const &, auto const &, auto const & ) {
+            return h * ( a31 * k1 + a32 * k2 );
+        } );
+
+        stage( system, x, t + c4 * h, k4_, [&]( auto const & k1, auto const & k2,
+                                                auto const & k3, auto const &, auto const & ) {
+            return h * ( a41 * k1 + a42 * k2 + a43 * k3 );
+        } );
+
+        stage( system, x, t + c5 * h, k5_, [&]( auto const & k1, auto const & k2,
+                                                auto const & k3, auto const & k4, auto const & ) {
+            return h * ( a51 * k1 + a52 * k2 + a53 * k3 + a54 * k4 );
+        } );
+
+        stage( system, x, t + h, k6_, [&]( auto const & k1, auto const & k2,
+                                           auto const & k3, auto const & k4, auto const & k5 ) {
+            return h * ( a61 * k1 + a62 * k2 + a63 * k3 + a64 * k4 + a65 * k5 );
+        } );
+        
+        Algebra::for_each( [&]( auto & xn, 
+                                auto const & xi,
+                                auto const & k1,
+                                auto const & k3,
+                                auto const & k4,
+                                auto const & k5,
+                                auto const & k6 ) {
+            xn = xi + h * ( a71 * k1 + a73 * k3 + a74 * k4 + a75 * k5 + a76 * k6 );
+        }, x_new_, x, k1_, k3_, k4_, k5_, k6_ );
+        
+        system( static_cast<const state_type &>(x_new_), k7_, t + h );
+        
+        // Scaled max norm of the embedded error estimate
+        value_type error = 0;
+        
+        Algebra::for_each( [&]( auto const & xn,
+                                auto const & xi,
+                                auto const & k1,
+                                auto const & k3,
+                                auto const & k4,
+                                auto const & k5,
+                                auto const & k6,
+                                auto const & k7,
+                                auto const & atol ) {
+            using std::abs;
+            using std::max;
+            
+            const auto e = h * ( e1 * k1 + e3 * k3 + e4 * k4 + e5 * k5 + e6 * k6 + e7 * k7 );
+            const auto scale = atol + rtol_ * max( abs(xi), abs(xn) );
+            
+            error = max( error, value_type( abs(e) / scale ) );
+        }, static_cast<const state_type &>(x_new_), x, 
+           k1_, k3_, k4_, k5_, k6_, k7_, atol_ );
+        
+        if ( error <= value_type(1) )
+        {
+            using std::swap;
+            swap( x, x_new_ );
+            swap( k1_, k7_ );
+            t = t + h;
+            
+            const value_type growth = error == value_type(0) ?
+                value_type(5) :
+                value_type(0.9) * pow( error, value_type(-0.2) );
+            
+            dt = h * std::min( value_type(5), std::max( value_type(0.2), growth ) );
+            return true;
+        }
+        
+        dt = h * std::max( value_type(0.2), value_type(0.9) * pow( error, value_type(-0.25) ) );
+        return false;
+    }
+    
+    /**
+     * @brief Integrate @p x from @p t0 to @p t1 with adaptive step size
+     * @param dt Initial step size guess, updated with the last suggested step.
+     *  The last step, shortened to end exactly at @p t1, does not shrink it.
+     * @return The number of accepted steps.
+     * @throws std::invalid_argument if the size of the batch @p x is not
+     *  the one the stepper was constructed with.
+     */
+    template<class System>
+    std::size_t integrate( System && system,
+                           state_type & x,
+                           time_type t0,
+                           const time_type & t1,
+                           time_type & dt )
+    {
+        if ( !Algebra::same_size( x, tmp_ ) )
+            throw std::invalid_argument( "integrate: wrong batch size" );
+        
+        std::size_t steps = 0;
+        
+        reset();
+        
+        while ( t0 < t1 )
+        {
+            const bool clipped = t1 - t0 < dt;
+            time_type h = clipped ? time_type( t1 - t0 ) : dt;
+            
+            const bool accepted = try_step( system, x, t0, h );
+            
+            if ( accepted )
+                ++steps;
+            
+            // Keep the adaptive step across the clipped one
+            if ( !clipped || !accepted || dt < h )
+                dt = h;
+        }
+        
+        return steps;
+    }
+
+private:
+    template<class System, class Increment>
+    void stage( System & system,
+                const state_type & x,
+                const time_type & t,
+                derivative_type & k,
+                Increment && increment )
+    {
+        Algebra::for_each( [&]( auto & tmp, 
+                                auto const & xi,
+                                auto const & k1,
+                                auto const & k2,
+                                auto const & k3,
+                                auto const & k4,
+                                auto const & k5 ) {
+            tmp = xi + increment( k1, k2, k3, k4, k5 );
+        }, tmp_, x, k1_, k2_, k3_, k4_, k5_ );
+        
+        system( static_cast<const state_type &>(tmp_), k, t );
+    }
+    
+    tolerance_type atol_;
+    value_type rtol_;
+    bool fsal_ = false;
+
+    state_type tmp_;
+    state_type x_new_;
+    derivative_type k1_;
+    derivative_type k2_;
+    derivative_type k3_;
+    derivative_type k4_;
+    derivative_type k5_;
+    derivative_type k6_;
+    derivative_type k7_;
+};
+
+/**
+ * @brief Velocity Verlet symplectic stepper, for second order systems.
+ * @tparam Time A @c quantity used for the independent variable.
+ * @tparam Algebra Storage policy, either a single state or a batch of states.
+ * @tparam Qs The quantities that make up the position.
+ * 
+ * The velocity is the derivative of the position, and the acceleration
+ * the derivative of the velocity, both with respect to @p Time.
+ * 
+ * The acceleration is a callable with signature
+ * `void (const position_type & q, acceleration_type & a, time_type t)`.
+ * 
+ * The acceleration computed at the end of a step is reused at the beginning
+ * of the next one, call @c reset if the position is modified between two steps.
+ * 
+ * @sa velocity_verlet
+ * @sa batch_velocity_verlet
+ */
+template<class Time, class Algebra, class ... Qs>
+class basic_velocity_verlet
+{
+    static_assert( detail::is_quantity_v<Time>, "Time must be a quantity" );
+    static_assert( sizeof ... (Qs) > 0, "Empty state not allowed" );
+
+public:
+    typedef Time time_type;
+    typedef typename Time::value_type value_type;
+    
+    typedef std::tuple< typename Algebra::template container<Qs> ... > position_type;
+    
+    typedef std::tuple< typename Algebra::template container<
+        detail::derivative_t<Qs, Time> > ... > velocity_type;
+    
+    typedef std::tuple< typename Algebra::template container<
+        detail::derivative_t< detail::derivative_t<Qs, Time>, Time > > ... > acceleration_type;
+    
+    /**
+     * @brief Construct a stepper
+     * @param n Number of trajectories integrated in lockstep, 
+     *          ignored for a single state.
+     */
+    explicit basic_velocity_verlet( std::size_t n = 1 )
+    {
+        Algebra::resize( a_, n );
+    }
+    
+    /**
+     * @brief Discard the acceleration cached from the previous step.
+     */
+    void reset() noexcept
+    {
+        valid_ = false;
+    }
+    
+    /**
+     * @brief Advance @p q and @p v from @p t to @p t + @p dt
+     */
+    template<class Acceleration>
+    void do_step( Acceleration && acceleration,
+                  position_type & q,
+                  velocity_type & v,
+                  time_type & t,
+                  const time_type & dt )
+    {
+        assert( Algebra::same_size( q, a_ ) && Algebra::same_size( v, a_ ) );
+        
+        const time_type half_dt = dt / value_type(2);
+        
+        if ( !valid_ )
+        {
+            acceleration( static_cast<const position_type &>(q), a_, t );
+            valid_ = true;
+        }
+        
+        Algebra::for_each( [&]( auto & qi, auto & vi, auto const & ai ) {
+            vi = vi + half_dt * ai;
+            qi = qi + dt * vi;
+        }, q, v, a_ );
+        
+        t = t + dt;
+        
+        acceleration( static_cast<const position_type &>(q), a_, t );
+        
+        Algebra::for_each( [&]( auto & vi, auto const & ai ) {
+            vi = vi + half_dt * ai;
+        }, v, a_ );
+    }
+
+private:
+    acceleration_type a_;
+    bool valid_ = false;
+};
+
+/**
+ * @brief Fourth order Runge-Kutta on a single state.
+ * @relates basic_runge_kutta4
+ * 
+ * @code{.cpp}
+ *   using state = std::tuple< quantity<double, si::meter>,
+ *                             quantity<double, si::meter, second_<-1> > >;
+ * 
+ *   runge_kutta4< quantity<double, second>,
+ *                 quantity<double, si::meter>,
+ *                 quantity<double, si::meter, second_<-1> > > rk;
+ * 
+ *   rk.do_step( []( auto const & x, auto & dxdt, auto ) {
+ *       std::get<0>(dxdt) = std::get<1>(x);
+ *       std::get<1>(dxdt) = -std::get<0>(x) * second_<-2>(); // ok: m/s^2
+ *   }, x, t, 0.01_s );
+ * @endcode
+ */
+template<class Time, class ... Qs>
+using runge_kutta4 = basic_runge_kutta4< Time, detail::tuple_algebra, Qs... >;
+
+/**
+ * @brief Fourth order Runge-Kutta on a batch of states, in structure-of-arrays layout.
+ * @relates basic_runge_kutta4
+ * 
+ * Each component of the state is a `std::vector` with one entry per trajectory.
+ */
+template<class Time, class ... Qs>
+using batch_runge_kutta4 = basic_runge_kutta4< Time, detail::batch_algebra, Qs... >;
+
+/**
+ * @brief Adaptive Dormand-Prince stepper on a single state.
+ * @relates basic_runge_kutta45
+ */
+template<class Time, class ... Qs>
+using runge_kutta45 = basic_runge_kutta45< Time, detail::tuple_algebra, Qs... >;
+
+/**
+ * @brief Adaptive Dormand-Prince stepper on a batch of states, in structure-of-arrays layout.
+ * @relates basic_runge_kutta45
+ */
+template<class Time, class ... Qs>
+using batch_runge_kutta45 = basic_runge_kutta45< Time, detail::batch_algebra, Qs... >;
+
+/**
+ * @brief Velocity Verlet on a single state.
+ * @relates basic_velocity_verlet
+ */
+template<class Time, class ... Qs>
+using velocity_verlet = basic_velocity_verlet< Time, detail::tuple_algebra, Qs... >;
+
+/**
+ * @brief Velocity Verlet on a batch of states, in structure-of-arrays layout.
+ * @relates basic_velocity_verlet
+ */
+template<class Time, class ... Qs>
+using batch_velocity_verlet = basic_velocity_verlet< Time, detail::batch_algebra, Qs... >;
+
+/** @} */
+
+}
+
+#endif //ENGINEERING_UNITS_NUMERIC_ODE_HPP
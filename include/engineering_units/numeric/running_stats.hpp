@@ -0,0 +1,418 @@
+/*
+ * Boost Software License - Version 1.0 - August 17th, 2003
+ *
+ * Permission is hereby granted, free of charge, to any person or organization
+ * obtaining a copy of the software and accompanying documentation covered by
+ * this license (the "Software") to use, reproduce, display, distribute,
+ * execute, and transmit the Software, and to prepare derivative works of the
+ * Software, and to permit third-parties to whom the Software is furnished to
+ * do so, all subject to the following:
+ *
+ * The copyright notices in the Software and this entire statement, including
+ * the above license grant, this restriction and the following disclaimer,
+ * must be included in all copies of the Software, in whole or in part, and
+ * all derivative works of the Software, unless such copies or derivative
+ * works are solely in the form of machine-executable object code generated by
+ * a source language processor.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+ * SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+ * FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef ENGINEERING_UNITS_NUMERIC_RUNNING_STATS_HPP
+#define ENGINEERING_UNITS_NUMERIC_RUNNING_STATS_HPP
+
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+#include <engineering_units/quantity.hpp>
+
+#include <engineering_units/detail/doxygen.hpp>
+
+namespace engunits
+{
+
+template<class Q>
+class batch_running_stats;
+
+/**
+ * @addtogroup numeric
+ * @{
+ */
+
+/**
+ * @brief Single pass statistics of a stream of quantities.
+ * @tparam Q The type of the samples, usually a @c quantity
+ * 
+ * Mean and variance are updated with Welford's algorithm, which is 
+ * numerically stable on long streams. Each statistic is returned with
+ * its own unit: the variance of kelvins is in kelvin squared.
+ * 
+ * The exponentially weighted moving average is bias corrected, so it
+ * is not skewed towards zero for the first samples, and two accumulators
+ * can be merged exactly.
+ * 
+ * @code{.cpp}
+ *   running_stats< quantity<double, si::kelvin> > stats;
+ * 
+ *   for ( auto t : samples )
+ *       stats.push( t );
+ * 
+ *   quantity<double, si::kelvin_<2> > v = stats.variance();
+ * @endcode
+ * 
+ * @sa batch_running_stats
+ */
+template<class Q>
+class running_stats
+{
+public:
+    typedef Q sample_type;
+    typedef detail::value_type_t<Q> value_type;
+    
+    /**
+     * @brief The unit of the variance is the square of the unit of @p Q
+     */
+    typedef detail::product_t<Q, Q> variance_type;
+
+    /**
+     * @brief Construct an empty accumulator
+     * @param alpha Smoothing factor of the moving average, in (0, 1]
+     */
+    explicit running_stats( value_type alpha = value_type(0.1) ) noexcept :
+        alpha_( alpha )
+    {}
+    
+    /**
+     * @brief Add a sample
+     */
+    void push( const Q & x )
+    {
+        ++count_;
+        
+        if ( count_ == 1 )
+        {
+            min_ = x;
+            max_ = x;
+        }
+        else
+        {
+            min_ = x < min_ ? x : min_;
+            max_ = max_ < x ? x : max_;
+        }
+        
+        const Q delta = x - mean_;
+        mean_ = mean_ + delta / value_type(count_);
+        m2_ = m2_ + delta * ( x - mean_ );
+        
+        ewma_ = alpha_ * x + ( value_type(1) - alpha_ ) * ewma_;
+        decay_ = decay_ * ( value_type(1) - alpha_ );
+    }
+    
+    /**
+     * @brief Add all the samples in [ @p first, @p last )
+     */
+    template<class InputIt>
+    void push( InputIt first, InputIt last )
+    {
+        for ( ; first != last; ++first )
+            push( *first );
+    }
+    
+    /**
+     * @brief Combine with the statistics of another stream.
+     * 
+     * Count, mean, variance, minimum and maximum do not depend on the
+     * order of the samples. The moving average assumes that @p other
+     * holds the samples that came after the ones in this accumulator.
+     * 
+     * @pre Both accumulators use the same smoothing factor.
+     */
+    void merge( const running_stats & other )
+    {
+        if ( other.count_ == 0 )
+            return;
+        
+        if ( count_ == 0 )
+        {
+            *this = other;
+            return;
+        }
+        
+        const std::size_t n = count_ + other.count_;
+        const Q delta = other.mean_ - mean_;
+        const value_type nb = value_type(other.count_) / value_type(n);
+        
+        mean_ = mean_ + delta * nb;
+        m2_ = m2_ + other.m2_ + delta * delta * ( value_type(count_) * nb );
+        
+        min_ = other.min_ < min_ ? other.min_ : min_;
+        max_ = max_ < other.max_ ? other.max_ : max_;
+        
+        ewma_ = other.ewma_ + other.decay_ * ewma_;
+        decay_ = decay_ * other.decay_;
+        
+        count_ = n;
+    }
+    
+    /**
+     * @brief Number of samples
+     */
+    std::size_t count() const noexcept
+    {
+        return count_;
+    }
+    
+    /**
+     * @brief Arithmetic mean
+     * @pre `count() > 0`
+     */
+    Q mean() const
+    {
+        return mean_;
+    }
+    
+    /**
+     * @brief Unbiased sample variance
+     * @pre `count() > 1`
+     */
+    variance_type variance() const
+    {
+        return m2_ / value_type( count_ - 1 );
+    }
+    
+    /**
+     * @brief Sample standard deviation, with the same unit of the samples
+     * @pre `count() > 1`
+     */
+    Q stddev() const
+    {
+        using std::sqrt;
+        return Q( sqrt( variance() ) );
+    }
+    
+    /**
+     * @brief Smallest sample
+     * @pre `count() > 0`
+     */
+    Q min() const
+    {
+        return min_;
+    }
+    
+    /**
+     * @brief Largest sample
+     * @pre `count() > 0`
+     */
+    Q max() const
+    {
+        return max_;
+    }
+    
+    /**
+     * @brief Exponentially weighted moving average
+     * @pre `count() > 0`
+     */
+    Q ewma() const
+    {
+        return ewma_ / ( value_type(1) - decay_ );
+    }
+
+private:
+    friend class batch_running_stats<Q>;
+    
+    value_type alpha_;
+    std::size_t count_ = 0;
+    Q mean_ {};
+    variance_type m2_ {};
+    Q min_ {};
+    Q max_ {};
+    
+    // Weighted sum of the samples, and weight that is missing from it
+    Q ewma_ {};
+    value_type decay_ = value_type(1);
+};
+
+/**
+ * @brief Single pass statistics of many channels sampled together.
+ * @tparam Q The type of the samples, usually a @c quantity
+ * 
+ * Computes the same statistics of @c running_stats, independently for 
+ * each channel. The accumulators are stored as a structure of arrays,
+ * and each frame is processed with a loop over the channels that the 
+ * compiler can vectorize.
+ * 
+ * @code{.cpp}
+ *   batch_running_stats< quantity<double, si::kelvin> > stats( 64 );
+ * 
+ *   // frames holds one sample per channel, for several frames
+ *   stats.push( frames.begin(), frames.end() );
+ * 
+ *   auto t12 = stats.channel( 12 ).mean();
+ * @endcode
+ */
+template<class Q>
+class batch_running_stats
+{
+public:
+    typedef Q sample_type;
+    typedef detail::value_type_t<Q> value_type;
+    typedef detail::product_t<Q, Q> variance_type;
+    
+    /**
+     * @brief Construct empty accumulators
+     * @param channels Number of channels
+     * @param alpha Smoothing factor of the moving average, in (0, 1]
+     */
+    explicit batch_running_stats( std::size_t channels,
+                                  value_type alpha = value_type(0.1) ) :
+        alpha_( alpha ),
+        mean_( channels ),
+        m2_( channels ),
+        min_( channels ),
+        max_( channels ),
+        ewma_( channels )
+    {}
+    
+    /**
+     * @brief Number of channels
+     */
+    std::size_t channels() const noexcept
+    {
+        return mean_.size();
+    }
+    
+    /**
+     * @brief Number of frames pushed
+     */
+    std::size_t count() const noexcept
+    {
+        return count_;
+    }
+    
+    /**
+     * @brief Add one or more frames
+     * @param first,last A @c RandomAccessIterator range holding a whole number of
+     *  frames, each frame has one sample per channel.
+     */
+    template<class RandomIt>
+    void push( RandomIt first, RandomIt last )
+    {
+        const std::size_t n = channels();
+        
+        assert( n != 0 && std::size_t( last - first ) % n == 0 );
+        
+        for ( ; first != last; first += n )
+            push_frame( first );
+    }
+    
+    /**
+     * @brief Combine with the statistics of another set of streams.
+     * @pre Both have the same number of channels and smoothing factor.
+     * 
+     * @sa running_stats::merge
+     */
+    void merge( const batch_running_stats & other )
+    {
+        assert( channels() == other.channels() );
+        
+        for ( std::size_t i = 0; i < channels(); ++i )
+        {
+            running_stats<Q> s = channel( i );
+            s.merge( other.channel( i ) );
+            
+            mean_[i] = s.mean_;
+            m2_[i] = s.m2_;
+            min_[i] = s.min_;
+            max_[i] = s.max_;
+            ewma_[i] = s.ewma_;
+        }
+        
+        decay_ = decay_ * other.decay_;
+        count_ += other.count_;
+    }
+    
+    /**
+     * @brief Get the statistics of one channel
+     */
+    running_stats<Q> channel( std::size_t i ) const
+    {
+        running_stats<Q> s( alpha_ );
+        
+        s.count_ = count_;
+        s.mean_ = mean_[i];
+        s.m2_ = m2_[i];
+        s.min_ = min_[i];
+        s.max_ = max_[i];
+        s.ewma_ = ewma_[i];
+        s.decay_ = decay_;
+        
+        return s;
+    }
+
+private:
+    template<class RandomIt>
+    void push_frame( RandomIt x )
+    {
+        const std::size_t n = channels();
+        
+        ++count_;
+        
+        const value_type inv_count = value_type(1) / value_type(count_);
+        const value_type beta = value_type(1) - alpha_;
+        
+        decay_ = decay_ * beta;
+        
+        Q * mean = mean_.data();
+        variance_type * m2 = m2_.data();
+        Q * mn = min_.data();
+        Q * mx = max_.data();
+        Q * ewma = ewma_.data();
+        
+        if ( count_ == 1 )
+        {
+            for ( std::size_t i = 0; i < n; ++i )
+            {
+                mn[i] = x[i];
+                mx[i] = x[i];
+            }
+        }
+        
+        for ( std::size_t i = 0; i < n; ++i )
+        {
+            const Q xi = x[i];
+            const Q delta = xi - mean[i];
+            
+            mean[i] = mean[i] + delta * inv_count;
+            m2[i] = m2[i] + delta * ( xi - mean[i] );
+            
+            mn[i] = xi < mn[i] ? xi : mn[i];
+            mx[i] = mx[i] < xi ? xi : mx[i];
+            
+            ewma[i] = alpha_ * xi + beta * ewma[i];
+        }
+    }
+    
+    value_type alpha_;
+    std::size_t count_ = 0;
+    value_type decay_ = value_type(1);
+    
+    std::vector<Q> mean_;
+    std::vector<variance_type> m2_;
+    std::vector<Q> min_;
+    std::vector<Q> max_;
+    std::vector<Q> ewma_;
+};
+
+/** @} */
+
+}
+
+#endif //ENGINEERING_UNITS_NUMERIC_RUNNING_STATS_HPP
@@ -0,0 +1,909 @@
+/*
+ * Boost Software License - Version 1.0 - August 17th, 2003
+ *
+ * Permission is hereby granted, free of charge, to any person or organization
+ * obtaining a copy of the software and accompanying documentation covered by
+ * this license (the "Software") to use, reproduce, display, distribute,
+ * execute, and transmit the Software, and to prepare derivative works of the
+ * Software, and to permit third-parties to whom the Software is furnished to
+ * do so, all subject to the following:
+ *
+ * The copyright notices in the Software and this entire statement, including
+ * the above license grant, this restriction and the following disclaimer,
+ * must be included in all copies of the Software, in whole or in part, and
+ * all derivative works of the Software, unless such copies or derivative
+ * works are solely in the form of machine-executable object code generated by
+ * a source language processor.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+ * SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+ * FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef ENGINEERING_UNITS_PIPELINE_HPP
+#define ENGINEERING_UNITS_PIPELINE_HPP
+
+#if !defined(__cpp_impl_coroutine)
+#error "engineering_units/pipeline.hpp requires C++20 coroutines"
+#endif
+
+#include <cassert>
+#include <condition_variable>
+#include <coroutine>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <thread>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <engineering_units/quantity.hpp>
+#include <engineering_units/detail/doxygen.hpp>
+
+namespace engunits
+{
+
+/**
+ * @addtogroup concurrency
+ * @{
+ */
+
+/**
+ * @brief A lazy sequence produced by a coroutine with @c co_yield
+ * 
+ * The coroutine runs on the thread that iterates the generator, and 
+ * only as far as needed to produce the next element. Exceptions escaping
+ * the coroutine are rethrown by @c begin or by the increment.
+ * 
+ * @code{.cpp}
+ *   generator<int> iota( int n )
+ *   {
+ *       for ( int i = 0; i < n; ++i )
+ *           co_yield i;
+ *   }
+ * @endcode
+ */
+template<class T>
+class generator
+{
+public:
+    typedef T value_type;
+    
+    struct promise_type
+    {
+        generator get_return_object() noexcept
+        {
+            return generator( std::coroutine_handle<promise_type>::from_promise( *this ) );
+        }
+        
+        std::suspend_always initial_suspend() const noexcept { return {}; }
+        std::suspend_always final_suspend() const noexcept { return {}; }
+        
+        // The yielded object lives in the coroutine frame until it resumes
+        std::suspend_always yield_value( T & v ) noexcept
+        {
+            value_ = std::addressof( v );
+            return {};
+        }
+        
+        std::suspend_always yield_value( T && v ) noexcept
+        {
+            value_ = std::addressof( v );
+            return {};
+        }
+        
+        void return_void() const noexcept {}
+        
+        void unhandled_exception() noexcept { error_ = std::current_exception(); }
+        
+        // A generator can not wait on anything but its consumer
+        template<class U>
+        std::suspend_never await_transform( U && ) = delete;
+        
+        T * value_ = nullptr;
+        std::exception_ptr error_;
+    };
+    
+    class iterator
+    {
+    public:
+        typedef std::input_iterator_tag iterator_category;
+        typedef std::ptrdiff_t difference_type;
+        typedef T value_type;
+        typedef T & reference;
+        typedef T * pointer;
+        
+        iterator() = default;
+        
+        reference operator*() const noexcept { return *handle_.promise().value_; }
+        pointer operator->() const noexcept { return handle_.promise().value_; }
+        
+        iterator & operator++()
+        {
+            resume( handle_ );
+            return *this;
+        }
+        
+        void operator++(int) { ++*this; }
+        
+        friend bool operator==( const iterator & it, std::default_sentinel_t ) noexcept
+        {
+            return !it.handle_ || it.handle_.done();
+        }
+        
+    private:
+        friend class generator;
+        
+        explicit iterator( std::coroutine_handle<promise_type> h ) noexcept : handle_( h ) {}
+        
+        std::coroutine_handle<promise_type> handle_;
+    };
+    
+    generator() = default;
+    
+    generator( generator && other ) noexcept :
+        handle_( std::exchange( other.handle_, nullptr ) )
+    {}
+    
+    generator & operator=( generator && other ) noexcept
+    {
+        if ( this != &other )
+        {
+            if ( handle_ ) handle_.destroy();
+            handle_ = std::exchange( other.handle_, nullptr );
+        }
+        return *this;
+    }
+    
+    ~generator()
+    {
+        if ( handle_ ) handle_.destroy();
+    }
+    
+    /**
+     * @brief Run the coroutine up to the first element
+     * @pre Called once
+     */
+    iterator begin()
+    {
+        resume( handle_ );
+        return iterator( handle_ );
+    }
+    
+    std::default_sentinel_t end() const noexcept { return {}; }
+    
+private:
+    explicit generator( std::coroutine_handle<promise_type> h ) noexcept : handle_( h ) {}
+    
+    static void resume( std::coroutine_handle<promise_type> h )
+    {
+        if ( !h || h.done() )
+            return;
+        
+        h.resume();
+        
+        if ( h.promise().error_ )
+            std::rethrow_exception( std::exchange( h.promise().error_, nullptr ) );
+    }
+    
+    std::coroutine_handle<promise_type> handle_;
+};
+
+template<class Q>
+class batch_pool;
+
+/**
+ * @brief A fixed capacity buffer of quantities, borrowed from a @c batch_pool
+ * 
+ * A batch gives its storage back to the pool when destroyed, so the 
+ * same few buffers travel down a pipeline over and over.
+ * 
+ * @pre The pool outlives all its batches.
+ */
+template<class Q>
+class batch
+{
+public:
+    typedef Q value_type;
+    typedef Q * iterator;
+    typedef const Q * const_iterator;
+    
+    batch() = default;
+    
+    batch( batch && other ) noexcept :
+        pool_( std::exchange( other.pool_, nullptr ) ),
+        data_( std::move( other.data_ ) ),
+        size_( std::exchange( other.size_, 0 ) )
+    {}
+    
+    batch & operator=( batch && other ) noexcept
+    {
+        if ( this != &other )
+        {
+            release();
+            pool_ = std::exchange( other.pool_, nullptr );
+            data_ = std::move( other.data_ );
+            size_ = std::exchange( other.size_, 0 );
+        }
+        return *this;
+    }
+    
+    ~batch() { release(); }
+    
+    std::size_t size() const noexcept { return size_; }
+    std::size_t capacity() const noexcept { return pool_ ? pool_->batch_capacity() : 0; }
+    bool empty() const noexcept { return size_ == 0; }
+    bool full() const noexcept { return size_ == capacity(); }
+    
+    Q * data() noexcept { return data_.get(); }
+    const Q * data() const noexcept { return data_.get(); }
+    
+    iterator begin() noexcept { return data(); }
+    iterator end() noexcept { return data() + size_; }
+    const_iterator begin() const noexcept { return data(); }
+    const_iterator end() const noexcept { return data() + size_; }
+    
+    Q & operator[]( std::size_t i ) noexcept { assert( i < size_ ); return data_[i]; }
+    const Q & operator[]( std::size_t i ) const noexcept { assert( i < size_ ); return data_[i]; }
+    
+    /**
+     * @pre `!full()`
+     */
+    void push_back( const Q & q ) noexcept( std::is_nothrow_copy_assignable<Q>::value )
+    {
+        assert( size_ < capacity() );
+        data_[ size_++ ] = q;
+    }
+    
+    /**
+     * @brief Change the number of elements
+     * @pre `n <= capacity()`
+     * 
+     * Elements past the old size keep whatever value the buffer had.
+     */
+    void resize( std::size_t n ) noexcept
+    {
+        assert( n <= capacity() );
+        size_ = n;
+    }
+    
+    void clear() noexcept { size_ = 0; }
+    
+private:
+    friend class batch_pool<Q>;
+    
+    batch( batch_pool<Q> * pool, std::unique_ptr<Q[]> data ) noexcept :
+        pool_( pool ),
+        data_( std::move( data ) )
+    {}
+    
+    void release() noexcept
+    {
+        if ( pool_ )
+            pool_->release( std::move( data_ ) );
+        
+        pool_ = nullptr;
+        size_ = 0;
+    }
+    
+    batch_pool<Q> * pool_ = nullptr;
+    std::unique_ptr<Q[]> data_;
+    std::size_t size_ = 0;
+};
+
+/**
+ * @brief A thread safe free list of batch buffers
+ * 
+ * @c acquire allocates only when all the buffers are in use; once a 
+ * pipeline has as many buffers as it has batches in flight, it runs
+ * without touching the heap.
+ */
+template<class Q>
+class batch_pool
+{
+public:
+    explicit batch_pool( std::size_t batch_capacity ) :
+        capacity_( batch_capacity )
+    {
+        assert( batch_capacity > 0 );
+    }
+    
+    batch_pool( const batch_pool & ) = delete;
+    batch_pool & operator=( const batch_pool & ) = delete;
+    
+    /**
+     * @brief An empty batch
+     */
+    batch<Q> acquire()
+    {
+        {
+            std::lock_guard<std::mutex> lock( mutex_ );
+            
+            if ( !free_.empty() )
+            {
+                std::unique_ptr<Q[]> data = std::move( free_.back() );
+                free_.pop_back();
+                return batch<Q>( this, std::move( data ) );
+            }
+            
+            ++allocated_;
+            free_.reserve( allocated_ );
+        }
+        
+        return batch<Q>( this, std::unique_ptr<Q[]>( new Q[ capacity_ ] ) );
+    }
+    
+    std::size_t batch_capacity() const noexcept { return capacity_; }
+    
+    /**
+     * @brief Number of buffers allocated so far
+     */
+    std::size_t allocated() const
+    {
+        std::lock_guard<std::mutex> lock( mutex_ );
+        return allocated_;
+    }
+    
+private:
+    friend class batch<Q>;
+    
+    void release( std::unique_ptr<Q[]> data ) noexcept
+    {
+        std::lock_guard<std::mutex> lock( mutex_ );
+        
+        // Never reallocates: the capacity is reserved in acquire
+        free_.push_back( std::move( data ) );
+    }
+    
+    const std::size_t capacity_;
+    mutable std::mutex mutex_;
+    std::vector< std::unique_ptr<Q[]> > free_;
+    std::size_t allocated_ = 0;
+};
+
+/**
+ * @brief A bounded queue between threads
+ * 
+ * @c push blocks while the channel is full, @c pop while it is empty, 
+ * which keeps a fast producer from running ahead of its consumer.
+ * Closing the channel wakes both sides: further pushes fail, and pops
+ * return what is left, then @c std::nullopt.
+ */
+template<class T>
+class channel
+{
+public:
+    explicit channel( std::size_t capacity ) :
+        slots_( capacity )
+    {
+        assert( capacity > 0 );
+    }
+    
+    channel( const channel & ) = delete;
+    channel & operator=( const channel & ) = delete;
+    
+    /**
+     * @return false if the channel was closed, and @p value was not queued
+     */
+    bool push( T && value )
+    {
+        std::unique_lock<std::mutex> lock( mutex_ );
+        
+        not_full_.wait( lock, [this] { return closed_ || size_ < slots_.size(); } );
+        
+        if ( closed_ )
+            return false;
+        
+        slots_[ ( head_ + size_ ) % slots_.size() ].emplace( std::move( value ) );
+        ++size_;
+        
+        lock.unlock();
+        not_empty_.notify_one();
+        return true;
+    }
+    
+    std::optional<T> pop()
+    {
+        std::unique_lock<std::mutex> lock( mutex_ );
+        
+        not_empty_.wait( lock, [this] { return closed_ || size_ > 0; } );
+        
+        if ( size_ == 0 )
+            return std::nullopt;
+        
+        std::optional<T> result( std::move( slots_[ head_ ] ) );
+        slots_[ head_ ].reset();
+        head_ = ( head_ + 1 ) % slots_.size();
+        --size_;
+        
+        lock.unlock();
+        not_full_.notify_one();
+        return result;
+    }
+    
+    void close()
+    {
+        {
+            std::lock_guard<std::mutex> lock( mutex_ );
+            closed_ = true;
+        }
+        
+        not_full_.notify_all();
+        not_empty_.notify_all();
+    }
+    
+    /**
+     * @brief Pop until the channel is closed and empty
+     */
+    generator<T> items()
+    {
+        while ( std::optional<T> value = pop() )
+            co_yield std::move( *value );
+    }
+    
+private:
+    std::mutex mutex_;
+    std::condition_variable not_full_;
+    std::condition_variable not_empty_;
+    std::vector< std::optional<T> > slots_;
+    std::size_t head_ = 0;
+    std::size_t size_ = 0;
+    bool closed_ = false;
+};
+
+/**
+ * @brief A fixed set of worker threads running queued tasks
+ */
+class thread_pool
+{
+public:
+    /**
+     * @param threads Number of workers; zero means one per hardware thread
+     */
+    explicit thread_pool( unsigned threads = 0 )
+    {
+        if ( threads == 0 )
+            threads = std::max( 1u, std::thread::hardware_concurrency() );
+        
+        workers_.reserve( threads );
+        
+        for ( unsigned i = 0; i < threads; ++i )
+            workers_.emplace_back( [this] { work(); } );
+    }
+    
+    thread_pool( const thread_pool & ) = delete;
+    thread_pool & operator=( const thread_pool & ) = delete;
+    
+    /**
+     * @brief Finish the queued tasks, and join the workers
+     */
+    ~thread_pool()
+    {
+        {
+            std::lock_guard<std::mutex> lock( mutex_ );
+            stopping_ = true;
+        }
+        
+        ready_.notify_all();
+        
+        for ( std::thread & t : workers_ )
+            t.join();
+    }
+    
+    std::size_t size() const noexcept { return workers_.size(); }
+    
+    /**
+     * @pre @p task does not throw
+     */
+    void submit( std::function<void()> task )
+    {
+        {
+            std::lock_guard<std::mutex> lock( mutex_ );
+            tasks_.push_back( std::move( task ) );
+        }
+        
+        ready_.notify_one();
+    }
+    
+private:
+    void work()
+    {
+        for (;;)
+        {
+            std::function<void()> task;
+            
+            {
+                std::unique_lock<std::mutex> lock( mutex_ );
+                ready_.wait( lock, [this] { return stopping_ || !tasks_.empty(); } );
+                
+                if ( tasks_.empty() )
+                    return;
+                
+                task = std::move( tasks_.front() );
+                tasks_.pop_front();
+            }
+            
+            task();
+        }
+    }
+    
+    std::mutex mutex_;
+    std::condition_variable ready_;
+    std::deque< std::function<void()> > tasks_;
+    bool stopping_ = false;
+    std::vector<std::thread> workers_;
+};
+
+/**
+ * @brief Sizes of the batches and of the channels of a pipeline
+ */
+struct pipeline_options
+{
+    /// Quantities per batch
+    std::size_t batch_size = 4096;
+    
+    /// Batches queued between two stages
+    std::size_t channel_capacity = 4;
+};
+
+/** @} */
+
+namespace detail
+{
+
+template<class G>
+struct generator_batch {};
+
+template<class Q>
+struct generator_batch< generator< batch<Q> > >
+{
+    typedef Q type;
+};
+
+template<class G>
+using generator_batch_t = typename generator_batch< std::decay_t<G> >::type;
+
+// Argument and result types of a stage, a lambda or a function pointer
+template<class F>
+struct stage_signature : stage_signature< decltype( &F::operator() ) > {};
+
+template<class R, class ... Args>
+struct stage_signature< R (*)( Args ... ) >
+{
+    typedef R result_type;
+    typedef std::tuple< std::decay_t<Args> ... > arguments;
+};
+
+template<class C, class R, class ... Args>
+struct stage_signature< R (C::*)( Args ... ) > : stage_signature< R (*)( Args ... ) > {};
+
+template<class C, class R, class ... Args>
+struct stage_signature< R (C::*)( Args ... ) const > : stage_signature< R (*)( Args ... ) > {};
+
+template<class F>
+using stage_output_t = generator_batch_t< typename stage_signature<F>::result_type >;
+
+template<class F>
+using stage_input_t = generator_batch_t< std::tuple_element_t< 0, typename stage_signature<F>::arguments > >;
+
+struct pipeline_state
+{
+    explicit pipeline_state( const pipeline_options & o ) : options( o ) {}
+    
+    // Channels are destroyed before the pools that own their batches
+    ~pipeline_state()
+    {
+        while ( !resources.empty() )
+            resources.pop_back();
+    }
+    
+    template<class T, class ... Args>
+    T * make( Args && ... args )
+    {
+        std::shared_ptr<T> p = std::make_shared<T>( std::forward<Args>( args ) ... );
+        resources.push_back( p );
+        return p.get();
+    }
+    
+    void fail() noexcept
+    {
+        std::lock_guard<std::mutex> lock( mutex );
+        
+        if ( !error )
+            error = std::current_exception();
+    }
+    
+    void finish()
+    {
+        std::lock_guard<std::mutex> lock( mutex );
+        
+        if ( --running == 0 )
+            idle.notify_all();
+    }
+    
+    void wait()
+    {
+        std::unique_lock<std::mutex> lock( mutex );
+        idle.wait( lock, [this] { return running == 0; } );
+    }
+    
+    void rethrow()
+    {
+        if ( error )
+            std::rethrow_exception( error );
+    }
+    
+    pipeline_options options;
+    std::vector< std::shared_ptr<void> > resources;
+    std::vector< std::function<void()> > tasks;
+    std::mutex mutex;
+    std::condition_variable idle;
+    std::size_t running = 0;
+    std::exception_ptr error;
+};
+
+}
+
+/**
+ * @addtogroup concurrency
+ * @{
+ */
+
+template<class Q>
+class pipeline;
+
+template<class Source>
+auto make_pipeline( Source source, const pipeline_options & options = pipeline_options() );
+
+/**
+ * @brief A chain of coroutine stages, connected by bounded channels
+ * 
+ * Every stage is a coroutine that yields batches of quantities:
+ * -    a source is called as `source( batch_pool<Q> & )`;
+ * -    a stage as `stage( generator< batch<In> >, batch_pool<Out> & )`;
+ * -    a sink as `sink( generator< batch<In> > )`, and returns the result of
+ *      @c run.
+ * 
+ * When run, each source and stage gets a thread of a @c thread_pool; 
+ * batches travel through a channel to the next stage, so all of them work
+ * at the same time on consecutive batches.
+ * 
+ * Boundaries are typed: when a stage takes batches in another unit than
+ * the previous one yields, the pipeline inserts a conversion stage, with 
+ * the conversion factor known at compile time. Connecting stages of 
+ * different dimensions does not compile.
+ * 
+ * @tparam Q The quantity yielded by the last stage
+ * 
+ * @code{.cpp}
+ *   typedef quantity<double, si::kilopascal> kilopascal;
+ *   typedef quantity<double, si::pascal> pascal;
+ *   
+ *   auto readings = []( batch_pool<kilopascal> & pool ) -> generator< batch<kilopascal> >
+ *   {
+ *       // co_yield batches acquired from pool
+ *   };
+ *   
+ *   auto peak = []( generator< batch<pascal> > in ) -> pascal
+ *   {
+ *       pascal m( 0.0 );
+ *       for ( batch<pascal> & b : in )
+ *           for ( pascal p : b ) m = std::max( m, p );
+ *       return m;
+ *   };
+ *   
+ *   thread_pool threads( 2 );
+ *   pascal p = make_pipeline( readings ).run( peak, threads ); // kPa to Pa in between
+ * @endcode
+ * 
+ * @note A stage holds its thread until the input is exhausted, the 
+ *  @c thread_pool needs at least one thread per source and stage.
+ *  The sink runs on the thread that calls @c run.
+ * 
+ * @note The first exception thrown by a stage stops the pipeline and is
+ *  rethrown by @c run.
+ */
+template<class Q>
+class pipeline
+{
+    static_assert( detail::is_quantity_v<Q>, "pipeline stages exchange batches of quantities" );
+    
+public:
+    typedef Q value_type;
+    
+    pipeline( pipeline && ) noexcept = default;
+    pipeline & operator=( pipeline && ) noexcept = default;
+    
+    /**
+     * @brief Append a stage
+     * @return A pipeline yielding the output of @p stage
+     */
+    template<class Stage>
+    pipeline< detail::stage_output_t<Stage> > then( Stage stage ) &&
+    {
+        typedef detail::stage_input_t<Stage> input;
+        typedef detail::stage_output_t<Stage> output;
+        
+        if constexpr ( !std::is_same<input, Q>::value )
+        {
+            return std::move( *this ).template convert<input>().then( std::move( stage ) );
+        }
+        else
+        {
+            channel< batch<Q> > * in = tail_;
+            batch_pool<output> * pool = state_->template make< batch_pool<output> >( state_->options.batch_size );
+            channel< batch<output> > * out = state_->template make< channel< batch<output> > >( state_->options.channel_capacity );
+            detail::pipeline_state * state = state_.get();
+            
+            state_->tasks.push_back( [=]() mutable
+            {
+                try
+                {
+                    for ( batch<output> & b : stage( in->items(), *pool ) )
+                        if ( !out->push( std::move( b ) ) )
+                            break;
+                }
+                catch (...)
+                {
+                    state->fail();
+                }
+                
+                in->close();
+                out->close();
+            } );
+            
+            return pipeline<output>( std::move( state_ ), out );
+        }
+    }
+    
+    /**
+     * @brief Append a stage that converts every quantity to @p Q2
+     */
+    template<class Q2>
+    pipeline<Q2> convert() &&
+    {
+        static_assert( std::is_constructible<Q2, const Q &>::value, 
+                       "Stage boundary between quantities of different dimensions" );
+        
+        return std::move( *this ).then( []( generator< batch<Q> > in, batch_pool<Q2> & pool ) -> generator< batch<Q2> >
+        {
+            for ( batch<Q> & b : in )
+            {
+                batch<Q2> c = pool.acquire();
+                c.resize( b.size() );
+                
+                for ( std::size_t i = 0; i < b.size(); ++i )
+                    c[i] = Q2( b[i] );
+                
+                co_yield std::move( c );
+            }
+        } );
+    }
+    
+    /**
+     * @brief Run the pipeline until the source is exhausted
+     * @return What @p sink returns
+     * @throw std::invalid_argument if @p threads has fewer threads than 
+     *  the pipeline has stages
+     */
+    template<class Sink>
+    auto run( Sink sink, thread_pool & threads ) &&
+    {
+        typedef detail::stage_input_t<Sink> input;
+        
+        if constexpr ( !std::is_same<input, Q>::value )
+        {
+            return std::move( *this ).template convert<input>().run( std::move( sink ), threads );
+        }
+        else
+        {
+            std::shared_ptr<detail::pipeline_state> state = std::move( state_ );
+            channel< batch<Q> > * tail = tail_;
+            
+            if ( threads.size() < state->tasks.size() )
+                throw std::invalid_argument( "thread_pool smaller than the number of pipeline stages" );
+            
+            state->running = state->tasks.size();
+            
+            // The state stays with this thread, which waits for every task
+            for ( std::function<void()> & task : state->tasks )
+                threads.submit( [s = state.get(), &task] { task(); s->finish(); } );
+            
+            // Closing the tail stops the stages if the sink returns early
+            auto join = [&]
+            {
+                tail->close();
+                state->wait();
+            };
+            
+            typedef decltype( sink( tail->items() ) ) result_type;
+            
+            if constexpr ( std::is_void<result_type>::value )
+            {
+                try { sink( tail->items() ); } catch (...) { join(); throw; }
+                
+                join();
+                state->rethrow();
+            }
+            else
+            {
+                std::optional<result_type> r;
+                
+                try { r.emplace( sink( tail->items() ) ); } catch (...) { join(); throw; }
+                
+                join();
+                state->rethrow();
+                return std::move( *r );
+            }
+        }
+    }
+    
+private:
+    template<class>
+    friend class pipeline;
+    
+    template<class Source>
+    friend auto make_pipeline( Source, const pipeline_options & );
+    
+    pipeline( std::shared_ptr<detail::pipeline_state> state, channel< batch<Q> > * tail ) noexcept :
+        state_( std::move( state ) ),
+        tail_( tail )
+    {}
+    
+    std::shared_ptr<detail::pipeline_state> state_;
+    channel< batch<Q> > * tail_;
+};
+
+/**
+ * @brief Start a pipeline with a source stage
+ * 
+ * @p source is called as `source( batch_pool<Q> & )`, and returns a
+ * `generator< batch<Q> >`; batches acquired from the pool come back to 
+ * it once the next stages are done with them.
+ */
+template<class Source>
+auto make_pipeline( Source source, const pipeline_options & options )
+{
+    typedef detail::stage_output_t<Source> output;
+    
+    std::shared_ptr<detail::pipeline_state> state = std::make_shared<detail::pipeline_state>( options );
+    batch_pool<output> * pool = state->make< batch_pool<output> >( options.batch_size );
+    channel< batch<output> > * out = state->make< channel< batch<output> > >( options.channel_capacity );
+    detail::pipeline_state * s = state.get();
+    
+    state->tasks.push_back( [=]() mutable
+    {
+        try
+        {
+            for ( batch<output> & b : source( *pool ) )
+                if ( !out->push( std::move( b ) ) )
+                    break;
+        }
+        catch (...)
+        {
+            s->fail();
+        }
+        
+        out->close();
+    } );
+    
+    return pipeline<output>( std::move( state ), out );
+}
+
+/** @} */
+
+}
+
+#endif //ENGINEERING_UNITS_PIPELINE_HPP
@@ -0,0 +1,334 @@
+/*
+ * Boost Software License - Version 1.0 - August 17th, 2003
+ *
+ * Permission is hereby granted, free of charge, to any person or organization
+ * obtaining a copy of the software and accompanying documentation covered by
+ * this license (the "Software") to use, reproduce, display, distribute,
+ * execute, and transmit the Software, and to prepare derivative works of the
+ * Software, and to permit third-parties to whom the Software is furnished to
+ * do so, all subject to the following:
+ *
+ * The copyright notices in the Software and this entire statement, including
+ * the above license grant, this restriction and the following disclaimer,
+ * must be included in all copies of the Software, in whole or in part, and
+ * all derivative works of the Software, unless such copies or derivative
+ * works are solely in the form of machine-executable object code generated by
+ * a source language processor.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+ * SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+ * FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef ENGINEERING_UNITS_POINT_HPP
+#define ENGINEERING_UNITS_POINT_HPP
+
+#include <cstddef>
+#include <type_traits>
+
+#include <engineering_units/quantity.hpp>
+
+#include <engineering_units/detail/doxygen.hpp>
+
+namespace engunits
+{
+
+template<class T, class Origin>
+class quantity_point;
+
+namespace detail
+{
+
+/**
+ * @internal
+ * @brief Affine map between the values of points measured from two origins.
+ *
+ * A point @c x from @p From is at `x * scale() + offset()` from @p To. 
+ * Both factors are constant expressions.
+ */
+template<class From, class To>
+struct point_conversion
+{
+    static_assert( std::is_same< typename From::reference_type, 
+                                 typename To::reference_type >::value,
+                   "Points measured from unrelated origins" );
+    
+    static constexpr long double scale()
+    {
+        return conversion_factor( typename From::unit_type {}, typename To::unit_type {} );
+    }
+    
+    static constexpr long double offset()
+    {
+        return From::offset() * scale() - To::offset();
+    }
+};
+
+/**
+ * @internal
+ * @brief Type in which a point of value type @p T is converted
+ * 
+ * Floating point values are converted in their own type. Integers go 
+ * through @c long double, so that neither factor is truncated, and are
+ * rounded once with @c round_point.
+ */
+template<class T>
+using point_arithmetic_t = std::conditional_t< std::is_floating_point<T>::value, T, long double >;
+
+template<class T, ENGUNITS_ENABLE_IF( std::is_floating_point<T>::value )>
+constexpr T round_point( T x ) noexcept
+{
+    return x;
+}
+
+// Half away from zero, as std::round, which is not constexpr
+template<class T, ENGUNITS_ENABLE_IF( std::is_integral<T>::value )>
+constexpr T round_point( long double x ) noexcept
+{
+    return x < 0 ? T( x - 0.5L ) : T( x + 0.5L );
+}
+
+template<class T>
+struct is_quantity_point : std::false_type {};
+
+template<class T, class Origin>
+struct is_quantity_point< quantity_point<T, Origin> > : std::true_type {};
+
+}
+
+/**
+ * @brief A point of an affine space, such as a temperature read on a given scale.
+ * @tparam T Type to hold
+ * @tparam Origin The origin of the scale
+ * 
+ * A @c quantity is a difference, or a vector: it can be scaled and added
+ * to another quantity. A @c quantity_point is a position measured from 
+ * @p Origin, and only supports the operations that make sense for positions:
+ * 
+ *  - point - point gives the difference between them, a @c quantity;
+ *  - point + quantity and point - quantity give another point;
+ *  - points of the same origin can be compared.
+ * 
+ * @p Origin is a type with:
+ *  - a typedef @c unit_type, the unit of the differences;
+ *  - a typedef @c reference_type, another origin from which @p Origin is measured;
+ *  - a static constexpr function @c offset(), the position of @p Origin from 
+ *    its reference, in @c unit_type.
+ * 
+ * Points measured from origins with the same reference can be converted 
+ * with the explicit constructor, that applies both the conversion factor 
+ * between the units and the offset between the origins. The two factors
+ * are folded in a single multiply-add at compile time.
+ * 
+ * @code{.cpp}
+ *   si::celsius_point<double> t( 20.0 );
+ *   si::kelvin_point<double> k( t );                   // 293.15 K
+ *   imperial::fahrenheit_point<double> f( t );         // 68 F
+ * 
+ *   quantity<double, si::kelvin> dt = k - si::kelvin_point<double>( 250.0 ); // 43.15 K
+ * @endcode
+ * 
+ * @sa convert
+ */
+template<class T, class Origin>
+class quantity_point
+{
+public:
+    typedef T value_type;
+    typedef Origin origin_type;
+    typedef typename Origin::unit_type unit_type;
+    
+    /**
+     * @brief The type of the difference between two points
+     */
+    typedef quantity<T, unit_type> difference_type;
+    
+    constexpr quantity_point() = default;
+    
+    /**
+     * @brief Construct from the position relative to @p Origin
+     */
+    explicit constexpr quantity_point( const T & value ) :
+        value_( value )
+    {}
+    
+    explicit constexpr quantity_point( const difference_type & from_origin ) :
+        value_( from_origin.value() )
+    {}
+    
+    /**
+     * @brief Convert from a point of another scale, or another value type
+     */
+    template<class U, class OtherOrigin,
+             ENGUNITS_ENABLE_IF(( !std::is_same< quantity_point<U, OtherOrigin>, quantity_point >::value ))>
+    explicit constexpr quantity_point( const quantity_point<U, OtherOrigin> & other ) :
+        value_( detail::round_point<T>(
+            other.value() * detail::point_arithmetic_t<T>( detail::point_conversion<OtherOrigin, Origin>::scale() ) +
+            detail::point_arithmetic_t<T>( detail::point_conversion<OtherOrigin, Origin>::offset() ) ) )
+    {}
+    
+    /**
+     * @brief The position relative to @p Origin, as a number
+     */
+    constexpr const T & value() const noexcept
+    {
+        return value_;
+    }
+    
+    /**
+     * @brief The position relative to @p Origin, as a @c quantity
+     */
+    constexpr difference_type from_origin() const
+    {
+        return difference_type( value_ );
+    }
+    
+    quantity_point & operator+=( const difference_type & d )
+    {
+        value_ += d.value();
+        return *this;
+    }
+    
+    quantity_point & operator-=( const difference_type & d )
+    {
+        value_ -= d.value();
+        return *this;
+    }
+    
+private:
+    T value_ {};
+};
+
+/**
+ * @addtogroup operators
+ * @{
+ */
+
+/**
+ * @brief The difference between two points of the same scale
+ * @relates quantity_point
+ */
+template<class T, class Origin>
+constexpr auto operator-( const quantity_point<T, Origin> & lhs,
+                          const quantity_point<T, Origin> & rhs )
+{
+    return typename quantity_point<T, Origin>::difference_type( lhs.value() - rhs.value() );
+}
+
+/**
+ * @brief Move a point by a difference
+ * @relates quantity_point
+ */
+template<class T, class Origin>
+constexpr auto operator+( const quantity_point<T, Origin> & lhs,
+                          const typename quantity_point<T, Origin>::difference_type & rhs )
+{
+    return quantity_point<T, Origin>( lhs.value() + rhs.value() );
+}
+
+template<class T, class Origin>
+constexpr auto operator+( const typename quantity_point<T, Origin>::difference_type & lhs,
+                          const quantity_point<T, Origin> & rhs )
+{
+    return quantity_point<T, Origin>( lhs.value() + rhs.value() );
+}
+
+template<class T, class Origin>
+constexpr auto operator-( const quantity_point<T, Origin> & lhs,
+                          const typename quantity_point<T, Origin>::difference_type & rhs )
+{
+    return quantity_point<T, Origin>( lhs.value() - rhs.value() );
+}
+
+/**
+ * @brief Compare two points of the same scale
+ * @relates quantity_point
+ */
+template<class T, class Origin>
+constexpr bool operator==( const quantity_point<T, Origin> & lhs, const quantity_point<T, Origin> & rhs )
+{
+    return lhs.value() == rhs.value();
+}
+
+template<class T, class Origin>
+constexpr bool operator!=( const quantity_point<T, Origin> & lhs, const quantity_point<T, Origin> & rhs )
+{
+    return lhs.value() != rhs.value();
+}
+
+template<class T, class Origin>
+constexpr bool operator<( const quantity_point<T, Origin> & lhs, const quantity_point<T, Origin> & rhs )
+{
+    return lhs.value() < rhs.value();
+}
+
+template<class T, class Origin>
+constexpr bool operator<=( const quantity_point<T, Origin> & lhs, const quantity_point<T, Origin> & rhs )
+{
+    return lhs.value() <= rhs.value();
+}
+
+template<class T, class Origin>
+constexpr bool operator>( const quantity_point<T, Origin> & lhs, const quantity_point<T, Origin> & rhs )
+{
+    return lhs.value() > rhs.value();
+}
+
+template<class T, class Origin>
+constexpr bool operator>=( const quantity_point<T, Origin> & lhs, const quantity_point<T, Origin> & rhs )
+{
+    return lhs.value() >= rhs.value();
+}
+
+/**
+ * @brief Convert an array of points to another scale
+ * @relates quantity_point
+ * @param first,last The points to convert
+ * @param out The first of `last - first` points, can be equal to @p first
+ * @return The end of the converted points
+ * 
+ * Each point is converted with the same multiply-add of the converting 
+ * constructor, with both factors computed at compile time. The loop is 
+ * vectorized, and uses FMA instructions where the target has them and 
+ * floating point contraction is allowed (the default in GNU mode).
+ * Integral points are converted in @c long double, and rounded.
+ */
+template<class T, class From, class U, class To>
+quantity_point<U, To> * convert( const quantity_point<T, From> * first,
+                                 const quantity_point<T, From> * last,
+                                 quantity_point<U, To> * out )
+{
+    typedef detail::point_arithmetic_t<U> C;
+    
+    constexpr C a = C( detail::point_conversion<From, To>::scale() );
+    constexpr C b = C( detail::point_conversion<From, To>::offset() );
+    
+    // The results go through a local block, so that the compiler can vectorize
+    // the arithmetic without checking at run time whether out overlaps first
+    constexpr std::ptrdiff_t block = 64;
+    C tmp[block];
+    
+    for ( ; last - first >= block; first += block, out += block )
+    {
+        for ( std::ptrdiff_t i = 0; i < block; ++i )
+            tmp[i] = C( first[i].value() ) * a + b;
+        
+        for ( std::ptrdiff_t i = 0; i < block; ++i )
+            out[i] = quantity_point<U, To>( detail::round_point<U>( tmp[i] ) );
+    }
+    
+    for ( ; first != last; ++first, ++out )
+        *out = quantity_point<U, To>( detail::round_point<U>( C( first->value() ) * a + b ) );
+    
+    return out;
+}
+
+/** @} */
+
+}
+
+#endif //ENGINEERING_UNITS_POINT_HPP
@@ -0,0 +1,157 @@
+/*
+ * Boost Software License - Version 1.0 - August 17th, 2003
+ *
+ * Permission is hereby granted, free of charge, to any person or organization
+ * obtaining a copy of the software and accompanying documentation covered by
+ * this license (the "Software") to use, reproduce, display, distribute,
+ * execute, and transmit the Software, and to prepare derivative works of the
+ * Software, and to permit third-parties to whom the Software is furnished to
+ * do so, all subject to the following:
+ *
+ * The copyright notices in the Software and this entire statement, including
+ * the above license grant, this restriction and the following disclaimer,
+ * must be included in all copies of the Software, in whole or in part, and
+ * all derivative works of the Software, unless such copies or derivative
+ * works are solely in the form of machine-executable object code generated by
+ * a source language processor.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+ * SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+ * FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef ENGINEERING_UNITS_PRECOMPILED_HPP
+#define ENGINEERING_UNITS_PRECOMPILED_HPP
+
+#include <engineering_units/si.hpp>
+
+#include <engineering_units/imperial/force.hpp>
+#include <engineering_units/imperial/length.hpp>
+#include <engineering_units/imperial/mass.hpp>
+#include <engineering_units/imperial/pressure.hpp>
+#include <engineering_units/imperial/velocity.hpp>
+
+/**
+ * @file precompiled.hpp
+ * @brief Explicit instantiations provided by `engineering_units_precompiled`
+ * 
+ * Every translation unit that includes this header, directly or through
+ * @c si.hpp when `ENGUNITS_USE_PRECOMPILED` is defined, will not instantiate
+ * the quantities and conversions listed here, and will link against the
+ * instances compiled once in `engineering_units_precompiled`.
+ * 
+ * The CMake target `engineering_units_precompiled` defines 
+ * `ENGUNITS_USE_PRECOMPILED` for all the targets that link it, and with 
+ * CMake 3.16 or later also uses this header as their precompiled header.
+ */
+
+namespace engunits
+{
+
+namespace detail
+{
+namespace precompiled
+{
+
+// Aliases, so that the lists below do not contain commas
+typedef mixed_unit< si::meter, second_<-1> > meter_per_second;
+typedef mixed_unit< si::meter, second_<-2> > meter_per_second_squared;
+
+}
+}
+
+}
+
+#ifndef ENGUNITS_DOXYGEN
+
+#define ENGUNITS_PRECOMPILED_UNITS(X)           \
+    X( si::meter )                              \
+    X( si::kilometer )                          \
+    X( si::millimeter )                         \
+    X( si::kilogram )                           \
+    X( second )                                 \
+    X( minute )                                 \
+    X( hour )                                   \
+    X( si::newton )                             \
+    X( si::pascal )                             \
+    X( si::hectopascal )                        \
+    X( si::kilopascal )                         \
+    X( si::bar )                                \
+    X( si::joule )                              \
+    X( si::kilojoule )                          \
+    X( si::watt )                               \
+    X( si::kilowatt )                           \
+    X( si::kelvin )                             \
+    X( radian )                                 \
+    X( degree )                                 \
+    X( imperial::foot )                         \
+    X( imperial::inch )                         \
+    X( imperial::nautical_mile )                \
+    X( imperial::knot )                         \
+    X( imperial::pound )                        \
+    X( imperial::pound_force )                  \
+    X( imperial::pound_square_inch )            \
+    X( detail::precompiled::meter_per_second )  \
+    X( detail::precompiled::meter_per_second_squared )
+
+#define ENGUNITS_PRECOMPILED_CONVERSIONS(X)                             \
+    X( imperial::foot, si::meter )                                      \
+    X( si::meter, imperial::foot )                                      \
+    X( imperial::inch, si::millimeter )                                 \
+    X( si::kilometer, si::meter )                                       \
+    X( si::meter, si::kilometer )                                       \
+    X( imperial::nautical_mile, si::kilometer )                         \
+    X( imperial::pound, si::kilogram )                                  \
+    X( si::kilogram, imperial::pound )                                  \
+    X( imperial::pound_force, si::newton )                              \
+    X( si::newton, imperial::pound_force )                              \
+    X( imperial::pound_square_inch, si::pascal )                        \
+    X( si::pascal, imperial::pound_square_inch )                        \
+    X( si::hectopascal, si::pascal )                                    \
+    X( si::pascal, si::hectopascal )                                    \
+    X( si::bar, si::pascal )                                            \
+    X( si::kilopascal, si::pascal )                                     \
+    X( si::kilojoule, si::joule )                                       \
+    X( si::kilowatt, si::watt )                                         \
+    X( degree, radian )                                                 \
+    X( radian, degree )                                                 \
+    X( minute, second )                                                 \
+    X( hour, second )                                                   \
+    X( imperial::knot, detail::precompiled::meter_per_second )          \
+    X( detail::precompiled::meter_per_second, imperial::knot )
+
+// src/precompiled.cpp defines this as empty, to turn the declarations
+// into definitions.
+#ifndef ENGUNITS_PRECOMPILED_EXTERN
+#define ENGUNITS_PRECOMPILED_EXTERN extern
+#endif
+
+#define ENGUNITS_PRECOMPILED_QUANTITY( U )                                      \
+    ENGUNITS_PRECOMPILED_EXTERN template class quantity< double, U >;          \
+    ENGUNITS_PRECOMPILED_EXTERN template class quantity< float, U >;
+
+// The converting constructor takes an extra unnamed int, which carries its
+// enable_if in both language modes
+#define ENGUNITS_PRECOMPILED_CONVERSION( From, To )                             \
+    ENGUNITS_PRECOMPILED_EXTERN template quantity< double, To >::quantity(     \
+        const quantity< double, From > &, int );                                \
+    ENGUNITS_PRECOMPILED_EXTERN template quantity< float, To >::quantity(      \
+        const quantity< float, From > &, int );                                 \
+    ENGUNITS_PRECOMPILED_EXTERN template long double conversion_factor(        \
+        const From &, const To & );
+
+namespace engunits
+{
+
+ENGUNITS_PRECOMPILED_UNITS( ENGUNITS_PRECOMPILED_QUANTITY )
+ENGUNITS_PRECOMPILED_CONVERSIONS( ENGUNITS_PRECOMPILED_CONVERSION )
+
+}
+
+#endif //ENGUNITS_DOXYGEN
+
+#endif //ENGINEERING_UNITS_PRECOMPILED_HPP
@@ -0,0 +1,104 @@
+/*
+ * Boost Software License - Version 1.0 - August 17th, 2003
+ *
+ * Permission is hereby granted, free of charge, to any person or organization
+ * obtaining a copy of the software and accompanying documentation covered by
+ * this license (the "Software") to use, reproduce, display, distribute,
+ * execute, and transmit the Software, and to prepare derivative works of the
+ * Software, and to permit third-parties to whom the Software is furnished to
+ * do so, all subject to the following:
+ *
+ * The copyright notices in the Software and this entire statement, including
+ * the above license grant, this restriction and the following disclaimer,
+ * must be included in all copies of the Software, in whole or in part, and
+ * all derivative works of the Software, unless such copies or derivative
+ * works are solely in the form of machine-executable object code generated by
+ * a source language processor.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+ * SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+ * FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef ENGINEERING_UNITS_PREDEFINED_UNITS_HPP
+#define ENGINEERING_UNITS_PREDEFINED_UNITS_HPP
+
+#include <engineering_units/information.hpp>
+#include <engineering_units/si.hpp>
+
+#include <engineering_units/imperial/force.hpp>
+#include <engineering_units/imperial/length.hpp>
+#include <engineering_units/imperial/mass.hpp>
+#include <engineering_units/imperial/pressure.hpp>
+#include <engineering_units/imperial/temperature.hpp>
+#include <engineering_units/imperial/velocity.hpp>
+
+#include <engineering_units/unit/registry.hpp>
+
+namespace engunits
+{
+
+/**
+ * @brief Registry of all the units shipped with this library
+ * @addtogroup predef_units
+ * 
+ * @note The symbol @c C is taken by @c si::celsius, not by @c si::coulomb.
+ * @sa unit_registry
+ */
+inline const unit_registry & predefined_units()
+{
+    static const unit_registry registry = []
+    {
+        unit_registry r;
+        
+        r.add( second(), decisecond(), centisecond(), millisecond(),
+               microsecond(), nanosecond(), minute(), hour() );
+        
+        r.add( count(), byte(), kibibyte(), mebibyte(), gibibyte() );
+        
+        r.add( radian(), degree(), gradian(), turn() );
+        
+        r.add( si::meter(), si::decimeter(), si::centimeter(), si::millimeter(),
+               si::decameter(), si::hectometer(), si::kilometer() );
+        
+        r.add( si::kilogram(), si::tonne(), si::hectogram(), si::decagram(),
+               si::gram(), si::decigram(), si::centigram(), si::milligram() );
+        
+        r.add( si::kelvin(), si::celsius() );
+        
+        r.add( si::ampere(), si::milliampere(), si::microampere(), 
+               si::nanoampere(), si::picoampere(),
+               si::coulomb(), si::volt(), si::ohm(),
+               si::farad(), si::millifarad(), si::microfarad(), 
+               si::nanofarad(), si::picofarad() );
+        
+        r.add( si::newton(), si::kilonewton(), si::dyne() );
+        
+        r.add( si::joule(), si::decijoule(), si::centijoule(), si::millijoule(),
+               si::decajoule(), si::hectojoule(), si::kilojoule(), 
+               si::erg(), si::kilowatt_hour() );
+        
+        r.add( si::watt(), si::deciwatt(), si::centiwatt(), si::milliwatt(),
+               si::decawatt(), si::hectowatt(), si::kilowatt() );
+        
+        r.add( si::pascal(), si::hectopascal(), si::bar(), si::kilopascal(),
+               si::megapascal(), si::atmosphere() );
+        
+        r.add( imperial::foot(), imperial::inch(), imperial::nautical_mile(),
+               imperial::knot(), imperial::pound(), imperial::slug(),
+               imperial::pound_force(), imperial::pound_square_inch(),
+               imperial::rankine() );
+        
+        return r;
+    }();
+    
+    return registry;
+}
+
+}
+
+#endif //ENGINEERING_UNITS_PREDEFINED_UNITS_HPP
@@ -32,6 +32,7 @@
 #include <utility>
 
 #include <engineering_units/unit/traits.hpp>
+#include <engineering_units/unit/concepts.hpp>
 #include <engineering_units/unit/mixed_unit.hpp>
 
 #include <engineering_units/unit/conversion.hpp>
@@ -67,13 +68,44 @@ template<class ... Ts>
 using unit_type_t = typename unit_type<Ts...>::type;
 
 template<class T>
-constexpr bool is_quantity_v = false;
+struct is_quantity : std::false_type {};
 
 template<class T, class ... Ts>
-constexpr bool is_quantity_v<  quantity<T, Ts ...> > = true;
+struct is_quantity< quantity<T, Ts ...> > : std::true_type {};
+
+template<class T>
+constexpr bool is_quantity_v = is_quantity<T>::value;
+
+/**
+ * @internal
+ * @brief Conversion between the quantity @p Q and the external type @p X
+ * 
+ * Specializations, such as the one for `std::chrono::duration` in 
+ * @c chrono.hpp, set @c value to true and provide:
+ *  - `static constexpr bool implicit_from`, `implicit_to`: whether
+ *    the conversions from and to @p X are implicit;
+ *  - `static constexpr Q from( const X & )`;
+ *  - `static constexpr X to( const Q & )`.
+ */
+template<class Q, class X, class = void>
+struct quantity_interop
+{
+    static constexpr bool value = false;
+    static constexpr bool implicit_from = false;
+    static constexpr bool implicit_to = false;
+};
 
 }
 
+#if defined(ENGUNITS_HAS_CONCEPTS)
+/**
+ * @brief Satisfied by specializations of @c quantity
+ * @note Only available with concepts support.
+ */
+template<class T>
+concept Quantity = detail::is_quantity<T>::value;
+#endif
+
 /**
  * @brief Tag a type @p T with a (list of) unit.
  * @tparam T Type to hold
@@ -133,20 +165,27 @@ public:
     typedef ENGUNITS_UNSPECIFIED(detail::unit_type_t<Units...>) unit_type;
 
 private:
+    template<class ... OtherUnits>
+    static constexpr bool same_unit = 
+        detail::same_unit_v<unit_type, detail::unit_type_t<OtherUnits...> >;
+
+#if !defined(ENGUNITS_HAS_CONCEPTS)
     template<class U, class ... OtherUnits>
     static constexpr bool allow_implicit_constructor =
         std::is_convertible<U, T>::value &&
-        unit_type() == detail::unit_type_t<OtherUnits...>();
+        same_unit<OtherUnits...>;
 
     template<class U, class ... OtherUnits>
     static constexpr bool allow_explicit_constructor =
         !std::is_convertible<U, T>::value &&
         std::is_constructible<T, U>::value &&
-        unit_type() == detail::unit_type_t<OtherUnits...>();
+        same_unit<OtherUnits...>;
+
+#endif
 
     template<class U, class ... OtherUnits>
     static constexpr bool allow_converting_constructor =
-        !allow_explicit_constructor<U, OtherUnits...> &&
+        !same_unit<OtherUnits...> &&
         std::is_constructible<T, U>::value &&
         is_convertible_v<detail::unit_type_t<OtherUnits...>, unit_type >;
 
@@ -163,6 +202,76 @@ public:
      */
     constexpr quantity() noexcept( std::is_nothrow_default_constructible<T>::value ) = default;
 
+    /**
+     * @brief Copy construct from a convertible unit and explicitly convertible @c value_type
+     * 
+     * Declared with enable_if in both language modes, so that its mangled name 
+     * does not depend on concepts support and the conversions instantiated in
+     * `engineering_units_precompiled` link from C++14 and C++20 alike.
+     */
+    template<class U, class ... OtherUnits >
+    explicit constexpr quantity(
+        const quantity<U, OtherUnits ... > & other,
+        ENGUNITS_ENABLE_IF( ( allow_converting_constructor<const U &, OtherUnits ... > ) )
+    ) noexcept( std::is_nothrow_constructible<T, U>::value ) :
+        value_( other.value() * conversion_factor( other.unit(), unit() ) )
+    {}
+
+#if defined(ENGUNITS_HAS_CONCEPTS)
+    // Same overload set as below, with requires-clauses in place of
+    // enable_if: no default template argument has to be substituted, 
+    // and the unit checks are only reached if the value type matches.
+    
+    template<class U>
+        requires std::is_constructible_v<T, U&&>
+    explicit constexpr quantity( U && other ) 
+        noexcept( std::is_nothrow_constructible<T, U&&>::value ) :
+        value_( std::forward<U>(other) )
+    {}
+
+    template<class U, Unit ... OtherUnits>
+        requires std::is_convertible_v<const U &, T> &&
+                 same_unit<OtherUnits...>
+    constexpr quantity( const quantity<U, OtherUnits ... > & other )
+        noexcept( std::is_nothrow_constructible<T, U>::value ) :
+        value_( other.value() )
+    {}
+
+    template<class U, Unit ... OtherUnits>
+        requires ( !std::is_convertible_v<const U &, T> ) &&
+                 std::is_constructible_v<T, const U &> &&
+                 same_unit<OtherUnits...>
+    explicit constexpr quantity( const quantity<U, OtherUnits ... > & other )
+        noexcept( std::is_nothrow_constructible<T, U>::value ) :
+        value_( other.value() )
+    {}
+
+    template<class U, Unit ... OtherUnits>
+        requires std::is_convertible_v<U &&, T> &&
+                 same_unit<OtherUnits...>
+    constexpr quantity( quantity<U, OtherUnits ... > && other )
+        noexcept( std::is_nothrow_constructible<T, U>::value ) :
+        value_( std::move(other.value()) )
+    {}
+
+    template<class U, Unit ... OtherUnits>
+        requires ( !std::is_convertible_v<U &&, T> ) &&
+                 std::is_constructible_v<T, U &&> &&
+                 same_unit<OtherUnits...>
+    explicit constexpr quantity( quantity<U, OtherUnits ... > && other )
+        noexcept( std::is_nothrow_constructible<T, U>::value ) :
+        value_( std::move(other.value()) )
+    {}
+
+    template<class U, Unit ... OtherUnits>
+        requires std::is_constructible_v<T, U &&> &&
+                 ( !same_unit<OtherUnits...> ) &&
+                 ConvertibleTo< detail::unit_type_t<OtherUnits...>, unit_type >
+    explicit constexpr quantity( quantity<U, OtherUnits ... > && other )
+        noexcept( std::is_nothrow_constructible<T, U>::value ) :
+        value_( std::move(other.value()) * conversion_factor( other.unit(), unit() ) )
+    {}
+#else
     /**
      * @brief Construct with a value
      * 
@@ -201,17 +310,6 @@ public:
         value_( other.value() )
     {}
 
-    /**
-     * @brief Copy construct from a convertible unit and explicitly convertible @c value_type
-     */
-    template<class U, class ... OtherUnits >
-    explicit constexpr quantity(
-        const quantity<U, OtherUnits ... > & other,
-        ENGUNITS_ENABLE_IF( ( allow_converting_constructor<const U &, OtherUnits ... > ) )
-    ) noexcept( std::is_nothrow_constructible<T, U>::value ) :
-        value_( other.value() * conversion_factor( other.unit(), unit() ) )
-    {}
-    
     /**
      * @brief Move construct from equivalent unit, and implicitly convertible @c value_type
      */
@@ -244,6 +342,48 @@ public:
     ) noexcept( std::is_nothrow_constructible<T, U>::value ) :
         value_( std::move(other.value()) * conversion_factor( other.unit(), unit() ) )
     {}
+#endif
+    
+    /**
+     * @brief Convert from an external type, such as `std::chrono::duration`
+     * 
+     * Only available for the types that have a conversion, which is 
+     * implicit if it does not lose precision.
+     * 
+     * @sa chrono.hpp
+     */
+    template<class X, 
+             ENGUNITS_ENABLE_IF(( detail::quantity_interop<quantity, X>::implicit_from ))>
+    constexpr quantity( const X & other ) :
+        quantity( detail::quantity_interop<quantity, X>::from( other ) )
+    {}
+    
+    template<class X, 
+             ENGUNITS_ENABLE_IF(( detail::quantity_interop<quantity, X>::value &&
+                                  !detail::quantity_interop<quantity, X>::implicit_from ))>
+    explicit constexpr quantity( const X & other ) :
+        quantity( detail::quantity_interop<quantity, X>::from( other ) )
+    {}
+    
+    /**
+     * @brief Convert to an external type, such as `std::chrono::duration`
+     * 
+     * @sa chrono.hpp
+     */
+    template<class X,
+             ENGUNITS_ENABLE_IF(( detail::quantity_interop<quantity, X>::implicit_to ))>
+    constexpr operator X() const
+    {
+        return detail::quantity_interop<quantity, X>::to( *this );
+    }
+    
+    template<class X,
+             ENGUNITS_ENABLE_IF(( detail::quantity_interop<quantity, X>::value &&
+                                  !detail::quantity_interop<quantity, X>::implicit_to ))>
+    explicit constexpr operator X() const
+    {
+        return detail::quantity_interop<quantity, X>::to( *this );
+    }
     
     /**
      * @brief Copy constructor
@@ -257,23 +397,15 @@ public:
 
     /**
      * @brief Copy-assignment
+     * 
+     * Defaulted, so that quantities of trivial types are trivially copyable.
      */
-    constexpr quantity& operator=(const quantity & other)
-        noexcept( std::is_nothrow_copy_assignable<T>::value )
-    {
-        value_ = other.value();
-        return *this;
-    }
+    quantity& operator=(const quantity &) = default;
     
     /**
      * @brief Move-assignment
      */
-    constexpr quantity& operator=(quantity && other)
-        noexcept( std::is_nothrow_move_assignable<T>::value )
-    {
-        value_ = std::move(other.value());
-        return *this;
-    }
+    quantity& operator=(quantity &&) = default;
     
     /**
      * @brief Return a const reference to the underlying value.
@@ -307,6 +439,23 @@ public:
         return unit_type {};
     }
     
+#if defined(ENGUNITS_HAS_CONCEPTS)
+    template< class U, class ... OtherUnits >
+        requires std::is_convertible_v<U&&, T> && same_unit<OtherUnits...>
+    constexpr quantity operator+=( const quantity<U, OtherUnits ...> & other )
+    {
+        value_ += other.value_;
+        return *this;
+    }
+    
+    template< class U, class ... OtherUnits >
+        requires std::is_convertible_v<U&&, T> && same_unit<OtherUnits...>
+    constexpr quantity operator-=( const quantity<U, OtherUnits ...> & other )
+    {
+        value_ -= other.value_;
+        return *this;
+    }
+#else
     template< class U, class ... OtherUnits >
     constexpr ENGUNITS_ENABLE_IF_T(
         (allow_implicit_constructor<U&&, OtherUnits ... >),
@@ -324,6 +473,7 @@ public:
         value_ -= other.value_;
         return *this;
     }
+#endif
 
     constexpr quantity& operator*=( const T & other )
     {
@@ -442,6 +592,41 @@ constexpr auto quantity_cast( const quantity<T, Ts ... > & u )
                              unit );
 }
 
+/**
+ * @brief Round a quantity to the nearest point of an integral grid.
+ * @relates quantity
+ * @tparam Q The result, a @c quantity of an integral type
+ * @param q The quantity to round, of any unit convertible to the one of @p Q
+ * @param step The spacing of the grid, one unit of @p Q if omitted.
+ * @pre `step > Q(0)`
+ *
+ * The result is a multiple of @p step. Halfway cases are rounded away from zero.
+ * Integral quantities compare and hash exactly, so the result can be used
+ * as the key of a spatial hash.
+ *
+ * @code{.cpp}
+ *    using mm = quantity<std::int64_t, si::millimeter>;
+ *
+ *    quantize<mm>( 0.01234_m );          // 12 mm
+ *    quantize<mm>( 0.01234_m, mm(5) );   // 10 mm
+ * @endcode
+ */
+template<class Q, class T, class ... Ts>
+Q quantize( const quantity<T, Ts ... > & q, const Q & step = Q( 1 ) )
+{
+    static_assert( detail::is_quantity_v<Q> && std::is_integral<typename Q::value_type>::value,
+                   "quantize needs a quantity of an integral type" );
+
+    typedef typename Q::value_type I;
+    typedef std::common_type_t<T, double> R;
+
+    using std::round;
+
+    const R x = R( q.value() ) * R( conversion_factor( q.unit(), step.unit() ) ) / R( step.value() );
+    return Q( I( round( x ) ) * step.value() );
+}
+
+#if !defined(ENGUNITS_HAS_CONCEPTS)
 namespace detail
 {
 
@@ -525,6 +710,7 @@ constexpr auto dispatch_div( const quantity<Lhs, LhsUnits ... > & lhs,
     return make_quantity(lhs.value() / rhs, lhs.unit() );
 }
 }
+#endif
 
 /**
  * @addtogroup operators
@@ -552,8 +738,9 @@ template<class Lhs,
 constexpr auto operator+( const quantity<Lhs, LhsUnits ... > & lhs,
                           const quantity<Rhs, RhsUnits ... > & rhs )
 {
-    static_assert( quantity<Lhs, LhsUnits ... >::unit() ==
-                   quantity<Rhs, RhsUnits ... >::unit(), 
+    static_assert( detail::same_unit_v< 
+                       typename quantity<Lhs, LhsUnits ... >::unit_type,
+                       typename quantity<Rhs, RhsUnits ... >::unit_type >, 
                    "operator+ with different units" );
     
     return make_quantity( lhs.value() + rhs.value(), lhs.unit() );
@@ -566,8 +753,9 @@ template<class Lhs,
 constexpr auto operator-( const quantity<Lhs, LhsUnits ... > & lhs,
                           const quantity<Rhs, RhsUnits ... > & rhs )
 {
-    static_assert( quantity<Lhs, LhsUnits ... >::unit() ==
-                   quantity<Rhs, RhsUnits ... >::unit(), 
+    static_assert( detail::same_unit_v< 
+                       typename quantity<Lhs, LhsUnits ... >::unit_type,
+                       typename quantity<Rhs, RhsUnits ... >::unit_type >, 
                    "operator- with different units" );
     
     return make_quantity( lhs.value() - rhs.value(), lhs.unit() );
@@ -583,6 +771,63 @@ constexpr auto operator*( const quantity<Lhs, LhsUnits ... > & lhs,
     return make_quantity( lhs.value() * rhs.value(), lhs.unit() * rhs.unit() );
 }
 
+#if defined(ENGUNITS_HAS_CONCEPTS)
+template<Unit Lhs,
+         class Rhs,
+         class ... RhsUnits>
+constexpr auto operator*( const Lhs & lhs,
+                          const quantity<Rhs, RhsUnits ... > & rhs )
+{    
+    return make_quantity( rhs.value(), lhs * rhs.unit() );
+}
+
+template<class Lhs,
+         class Rhs,
+         class ... RhsUnits>
+    requires ( !Unit<Lhs> )
+constexpr auto operator*( const Lhs & lhs,
+                          const quantity<Rhs, RhsUnits ... > & rhs )
+{    
+    return make_quantity( lhs * rhs.value(), rhs.unit() );
+}
+
+template<class Lhs,
+         class ... LhsUnits,
+         Unit Rhs>
+constexpr auto operator*( const quantity<Lhs, LhsUnits ... > & lhs,
+                          const Rhs & rhs )
+{    
+    return make_quantity( lhs.value(), lhs.unit() * rhs );
+}
+
+template<class Lhs,
+         class ... LhsUnits,
+         class Rhs>
+    requires ( !Unit<Rhs> )
+constexpr auto operator*( const quantity<Lhs, LhsUnits ... > & lhs,
+                          const Rhs & rhs )
+{    
+    return make_quantity( lhs.value() * rhs, lhs.unit() );
+}
+
+template<Unit Lhs,
+         class Rhs>
+    requires ( !Unit<Rhs> )
+constexpr quantity<Rhs, Lhs> operator*( const Lhs &,
+                                        const Rhs & rhs )
+{    
+    return quantity<Rhs, Lhs>(rhs);
+}
+
+template<class Lhs,
+         Unit Rhs>
+    requires ( !Unit<Lhs> )
+constexpr quantity<Lhs, Rhs> operator*( const Lhs & lhs,
+                                        const Rhs & )
+{    
+    return quantity<Lhs, Rhs>(lhs);
+}
+#else
 template<class Lhs,
          class Rhs,
          class ... RhsUnits>
@@ -620,6 +865,7 @@ constexpr ENGUNITS_ENABLE_IF_T(
 {    
     return quantity<Lhs, Rhs>(lhs);
 }
+#endif
 
 template<class Lhs,
          class ... LhsUnits,
@@ -632,6 +878,45 @@ constexpr auto operator/( const quantity<Lhs, LhsUnits ... > & lhs,
                           lhs.unit() * inverse(rhs.unit()) );
 }
 
+#if defined(ENGUNITS_HAS_CONCEPTS)
+template<Unit Lhs,
+         class Rhs,
+         class ... RhsUnits>
+constexpr auto operator/( const Lhs & lhs,
+                          const quantity<Rhs, RhsUnits ... > & rhs )
+{    
+    return make_quantity( Rhs(1.0) / rhs.value(), lhs * inverse(rhs.unit()) );
+}
+
+template<class Lhs,
+         class Rhs,
+         class ... RhsUnits>
+    requires ( !Unit<Lhs> )
+constexpr auto operator/( const Lhs & lhs,
+                          const quantity<Rhs, RhsUnits ... > & rhs )
+{    
+    return make_quantity( lhs / rhs.value(), inverse(rhs.unit()) );
+}
+
+template<class Lhs,
+         class ... LhsUnits,
+         Unit Rhs>
+constexpr auto operator/( const quantity<Lhs, LhsUnits ... > & lhs,
+                          const Rhs & rhs )
+{    
+    return make_quantity( lhs.value(), lhs.unit() * inverse(rhs) );
+}
+
+template<class Lhs,
+         class ... LhsUnits,
+         class Rhs>
+    requires ( !Unit<Rhs> )
+constexpr auto operator/( const quantity<Lhs, LhsUnits ... > & lhs,
+                          const Rhs & rhs )
+{    
+    return make_quantity( lhs.value() / rhs, lhs.unit() );
+}
+#else
 template<class Lhs,
          class Rhs,
          class ... RhsUnits>
@@ -649,6 +934,7 @@ constexpr auto operator/( const quantity<Lhs, LhsUnits ... > & lhs,
 {    
     return detail::dispatch_div( lhs, rhs, is_unit<Rhs>{} );
 }
+#endif
 
 template<class Lhs,
          class ... LhsUnits,
@@ -657,8 +943,9 @@ template<class Lhs,
 constexpr auto operator==( const quantity<Lhs, LhsUnits ... > & lhs,
                            const quantity<Rhs, RhsUnits ... > & rhs )
 {
-    static_assert( quantity<Lhs, LhsUnits ... >::unit() ==
-                   quantity<Rhs, RhsUnits ... >::unit(), 
+    static_assert( detail::same_unit_v< 
+                       typename quantity<Lhs, LhsUnits ... >::unit_type,
+                       typename quantity<Rhs, RhsUnits ... >::unit_type >, 
                    "operator== with different units" );
     
     return lhs.value() == rhs.value();
@@ -671,8 +958,9 @@ template<class Lhs,
 constexpr auto operator!=( const quantity<Lhs, LhsUnits ... > & lhs,
                            const quantity<Rhs, RhsUnits ... > & rhs )
 {
-    static_assert( quantity<Lhs, LhsUnits ... >::unit() ==
-                   quantity<Rhs, RhsUnits ... >::unit(), 
+    static_assert( detail::same_unit_v< 
+                       typename quantity<Lhs, LhsUnits ... >::unit_type,
+                       typename quantity<Rhs, RhsUnits ... >::unit_type >, 
                    "operator!= with different units" );
     
     return lhs.value() != rhs.value();
@@ -685,8 +973,9 @@ template<class Lhs,
 constexpr auto operator<( const quantity<Lhs, LhsUnits ... > & lhs,
                           const quantity<Rhs, RhsUnits ... > & rhs )
 {
-    static_assert( quantity<Lhs, LhsUnits ... >::unit() ==
-                   quantity<Rhs, RhsUnits ... >::unit(), 
+    static_assert( detail::same_unit_v< 
+                       typename quantity<Lhs, LhsUnits ... >::unit_type,
+                       typename quantity<Rhs, RhsUnits ... >::unit_type >, 
                    "operator< with different units" );
     
     return lhs.value() < rhs.value();
@@ -699,8 +988,9 @@ template<class Lhs,
 constexpr auto operator<=( const quantity<Lhs, LhsUnits ... > & lhs,
                            const quantity<Rhs, RhsUnits ... > & rhs )
 {
-    static_assert( quantity<Lhs, LhsUnits ... >::unit() ==
-                   quantity<Rhs, RhsUnits ... >::unit(), 
+    static_assert( detail::same_unit_v< 
+                       typename quantity<Lhs, LhsUnits ... >::unit_type,
+                       typename quantity<Rhs, RhsUnits ... >::unit_type >, 
                    "operator<= with different units" );
     
     return lhs.value() <= rhs.value();
@@ -713,8 +1003,9 @@ template<class Lhs,
 constexpr auto operator>( const quantity<Lhs, LhsUnits ... > & lhs,
                           const quantity<Rhs, RhsUnits ... > & rhs )
 {
-    static_assert( quantity<Lhs, LhsUnits ... >::unit() ==
-                   quantity<Rhs, RhsUnits ... >::unit(), 
+    static_assert( detail::same_unit_v< 
+                       typename quantity<Lhs, LhsUnits ... >::unit_type,
+                       typename quantity<Rhs, RhsUnits ... >::unit_type >, 
                    "operator> with different units" );
     
     return lhs.value() > rhs.value();
@@ -727,8 +1018,9 @@ template<class Lhs,
 constexpr auto operator>=( const quantity<Lhs, LhsUnits ... > & lhs,
                            const quantity<Rhs, RhsUnits ... > & rhs )
 {
-    static_assert( quantity<Lhs, LhsUnits ... >::unit() ==
-                   quantity<Rhs, RhsUnits ... >::unit(), 
+    static_assert( detail::same_unit_v< 
+                       typename quantity<Lhs, LhsUnits ... >::unit_type,
+                       typename quantity<Rhs, RhsUnits ... >::unit_type >, 
                    "operator>= with different units" );
     
     return lhs.value() >= rhs.value();
@@ -897,6 +1189,48 @@ constexpr auto atan2( const quantity<T, TsUnits ... > & y,
 
 /** @} */
 
+namespace detail
+{
+
+/**
+ * @internal
+ * @brief Type of the product of @p Lhs and @p Rhs, either quantities or values.
+ */
+template<class Lhs, class Rhs>
+using product_t = std::decay_t<
+    decltype( std::declval<Lhs const &>() * std::declval<Rhs const &>() )
+>;
+
+/**
+ * @internal
+ * @brief Type of the ratio of @p Lhs and @p Rhs, either quantities or values.
+ */
+template<class Lhs, class Rhs>
+using quotient_t = std::decay_t<
+    decltype( std::declval<Lhs const &>() / std::declval<Rhs const &>() )
+>;
+
+template<class T>
+struct value_type
+{
+    typedef T type;
+};
+
+template<class T, class ... Units>
+struct value_type< quantity<T, Units...> >
+{
+    typedef T type;
+};
+
+/**
+ * @internal
+ * @brief The underlying type of a quantity, or @p T itself if it is not a quantity.
+ */
+template<class T>
+using value_type_t = typename value_type<T>::type;
+
+}
+
 }
 
 #endif //ENGINEERING_UNITS_QUANTITY_HPP
@@ -40,4 +40,8 @@
 #include <engineering_units/si/pressure.hpp>
 #include <engineering_units/si/temperature.hpp>
 
+#ifdef ENGUNITS_USE_PRECOMPILED
+#include <engineering_units/precompiled.hpp>
+#endif
+
 #endif //ENGINEERING_UNITS_SI_HPP
@@ -29,6 +29,8 @@
 
 #include <engineering_units/unit/helper_macros.hpp>
 #include <engineering_units/quantity.hpp>
+#include <engineering_units/point.hpp>
+#include <engineering_units/detail/inline_variable.hpp>
 
 namespace engunits
 {
@@ -53,24 +55,68 @@ ENGUNITS_DEFINE_UDL( celsius, C )
 
 ENGUNITS_IMPORT_OPERATORS
 
+/**
+ * @brief Origin of the thermodynamic temperature scale, absolute zero
+ */
+struct kelvin_origin
+{
+    typedef kelvin unit_type;
+    typedef kelvin_origin reference_type;
+    
+    static constexpr long double offset()
+    {
+        return 0.0L;
+    }
+};
+
+/**
+ * @brief Origin of the Celsius scale, 273.15 K above absolute zero
+ * 
+ * Differences of Celsius temperatures are in kelvin.
+ */
+struct celsius_origin
+{
+    typedef kelvin unit_type;
+    typedef kelvin_origin reference_type;
+    
+    static constexpr long double offset()
+    {
+        return 273.15L;
+    }
+};
+
+/**
+ * @brief Absolute temperature
+ * @sa quantity_point
+ */
+template<class T>
+using kelvin_point = quantity_point<T, kelvin_origin>;
+
+/**
+ * @brief Temperature on the Celsius scale
+ * @sa quantity_point
+ */
+template<class T>
+using celsius_point = quantity_point<T, celsius_origin>;
+
 /** @} */
 
 
 struct abs_zero_t {};
-constexpr abs_zero_t abs_zero{};
+ENGUNITS_INLINE_VARIABLE constexpr abs_zero_t abs_zero{};
 
 template<class T>
 constexpr auto operator+(const quantity<T, si::kelvin> & lhs,
                          abs_zero_t )
 {
-    return quantity<T, si::celsius>( lhs.value() - 273.15L );
+    return quantity<T, si::celsius>( lhs.value() - celsius_origin::offset() );
 }
 
 template<class T>
 constexpr auto operator-(const quantity<T, si::celsius> & lhs,
                          abs_zero_t )
 {
-    return quantity<T, si::kelvin>( lhs.value() + 273.15L );
+    return quantity<T, si::kelvin>( lhs.value() + celsius_origin::offset() );
 }
 
 
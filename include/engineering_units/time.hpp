@@ -41,6 +41,8 @@ ENGUNITS_DEFINE_ROOT_UNIT( second, s, time );
 ENGUNITS_DEFINE_BASE_UNIT( decisecond,  ds, second, 0.1L );
 ENGUNITS_DEFINE_BASE_UNIT( centisecond, cs, second, 0.01L );
 ENGUNITS_DEFINE_BASE_UNIT( millisecond, ms, second, 0.001L );
+ENGUNITS_DEFINE_BASE_UNIT( microsecond, us, second, 1e-6L );
+ENGUNITS_DEFINE_BASE_UNIT( nanosecond,  ns, second, 1e-9L );
 ENGUNITS_DEFINE_BASE_UNIT( minute,     min, second, 60.0L );
 ENGUNITS_DEFINE_BASE_UNIT( hour,         h, second, 3600.0L );
 
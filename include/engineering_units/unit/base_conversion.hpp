@@ -60,6 +60,17 @@ struct is_ancestor_of<
 template<class T, class U>
 constexpr bool is_ancestor_of_v = is_ancestor_of<T,U>::value;
 
+// The root unit of the hierarchy that contains U
+template<class U, class = void>
+struct root_unit
+{
+    typedef U type;
+};
+
+template<class U>
+struct root_unit< U, void_t< typename U::parent_unit > > :
+    root_unit< typename U::parent_unit > {};
+
 
 struct convert_via_lca_tag {};
 struct convert_via_ancestor_tag : convert_via_lca_tag {};
@@ -29,6 +29,8 @@
 
 #include <type_traits>
 #include <engineering_units/unit/traits.hpp>
+#include <engineering_units/unit/predicates.hpp>
+#include <engineering_units/unit/conversion.hpp>
 #include <engineering_units/detail/doxygen.hpp>
 
 /**
@@ -165,8 +167,38 @@ namespace engunits
  */
 
 /** @} */
+
+#if defined(ENGUNITS_HAS_CONCEPTS)
+
+/**
+ * @addtogroup Concepts
+ * @{
+ */
+
+/**
+ * @brief C++20 concept for @ref Unit
+ * @note Only available with concepts support.
+ */
+template<class T>
+concept Unit = is_unit_v<T>;
+
+/**
+ * @brief Satisfied if @p From can be converted to @p To
+ * 
+ * Either argument can also be @c dimensionless.
+ * 
+ * @note Only available with concepts support.
+ * @sa is_convertible_v
+ */
+template<class From, class To>
+concept ConvertibleTo = is_convertible_v<From, To>;
+
+/** @} */
+
+#endif
+
 }
 
 
-#endif //ENGINEERING_UNITS_UNIT_TRAITS_HPP
+#endif //ENGINEERING_UNITS_UNIT_CONCEPTS_HPP
 
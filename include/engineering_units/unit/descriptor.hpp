@@ -0,0 +1,229 @@
+/*
+ * Boost Software License - Version 1.0 - August 17th, 2003
+ *
+ * Permission is hereby granted, free of charge, to any person or organization
+ * obtaining a copy of the software and accompanying documentation covered by
+ * this license (the "Software") to use, reproduce, display, distribute,
+ * execute, and transmit the Software, and to prepare derivative works of the
+ * Software, and to permit third-parties to whom the Software is furnished to
+ * do so, all subject to the following:
+ *
+ * The copyright notices in the Software and this entire statement, including
+ * the above license grant, this restriction and the following disclaimer,
+ * must be included in all copies of the Software, in whole or in part, and
+ * all derivative works of the Software, unless such copies or derivative
+ * works are solely in the form of machine-executable object code generated by
+ * a source language processor.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+ * SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+ * FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef ENGINEERING_UNITS_UNIT_DESCRIPTOR_HPP
+#define ENGINEERING_UNITS_UNIT_DESCRIPTOR_HPP
+
+#include <algorithm>
+#include <cstdint>
+#include <initializer_list>
+#include <string>
+#include <vector>
+
+#include <engineering_units/unit/base_conversion.hpp>
+#include <engineering_units/unit/conversion.hpp>
+#include <engineering_units/unit/dimensionless.hpp>
+#include <engineering_units/unit/mixed_unit.hpp>
+#include <engineering_units/unit/symbol.hpp>
+#include <engineering_units/unit/traits.hpp>
+
+#include <engineering_units/detail/doxygen.hpp>
+
+namespace engunits
+{
+
+/**
+ * @brief Exponent of a single dimension in a @c unit_descriptor
+ * 
+ * The dimension is identified by the symbol of its root unit, 
+ * e.g. `"m"` for length, `"kg"` for mass.
+ */
+struct unit_dimension
+{
+    std::string symbol;
+    std::intmax_t num;
+    std::intmax_t den;
+};
+
+inline bool operator==( const unit_dimension & lhs, const unit_dimension & rhs )
+{
+    return lhs.symbol == rhs.symbol && lhs.num == rhs.num && lhs.den == rhs.den;
+}
+
+inline bool operator!=( const unit_dimension & lhs, const unit_dimension & rhs )
+{
+    return !( lhs == rhs );
+}
+
+/**
+ * @brief Run-time description of a unit
+ * 
+ * This is what is left of a unit once the type is gone: the flattened 
+ * dimension exponents, sorted by root symbol, and the factor that converts
+ * a value to the root units. It is used to store units in files, and to 
+ * check them when reading the files back.
+ * 
+ * @code{.cpp}
+ *   const unit_descriptor d = describe_unit( imperial::foot_<-1>() );
+ * 
+ *   // d.symbol == "ft^-1"
+ *   // d.dimensions == { { "m", -1, 1 } }
+ *   // d.scale == 1 / 0.3048
+ * @endcode
+ * 
+ * @sa describe_unit
+ */
+struct unit_descriptor
+{
+    /**
+     * @brief Symbol of the unit, as in @c unit_traits::symbol
+     */
+    std::string symbol;
+    
+    /**
+     * @brief Multiply a value by this to express it in root units.
+     */
+    long double scale = 1.0L;
+    
+    /**
+     * @brief Flattened dimension exponents, sorted by symbol.
+     */
+    std::vector< unit_dimension > dimensions;
+    
+    /**
+     * @brief Check if the two units measure the same physical quantity
+     */
+    bool same_dimensions( const unit_descriptor & other ) const
+    {
+        return dimensions == other.dimensions;
+    }
+};
+
+namespace detail
+{
+
+inline std::intmax_t gcd( std::intmax_t a, std::intmax_t b )
+{
+    while ( b != 0 )
+    {
+        const std::intmax_t t = a % b;
+        a = b;
+        b = t;
+    }
+    
+    return a < 0 ? -a : a;
+}
+
+inline void add_dimension( unit_descriptor & d, 
+                           std::string symbol, 
+                           std::intmax_t num, 
+                           std::intmax_t den )
+{
+    auto it = std::find_if( d.dimensions.begin(), d.dimensions.end(), 
+                            [&]( const unit_dimension & x ) { return x.symbol == symbol; } );
+    
+    if ( it == d.dimensions.end() )
+    {
+        d.dimensions.push_back( unit_dimension { std::move( symbol ), 0, 1 } );
+        it = d.dimensions.end() - 1;
+    }
+    
+    // Two units with the same root, e.g. ft m
+    it->num = it->num * den + num * it->den;
+    it->den = it->den * den;
+    
+    const std::intmax_t g = gcd( it->num, it->den );
+    
+    if ( it->num == 0 )
+        d.dimensions.erase( it );
+    else
+    {
+        it->num /= g;
+        it->den /= g;
+    }
+}
+
+inline void sort_dimensions( unit_descriptor & d )
+{
+    std::sort( d.dimensions.begin(), 
+               d.dimensions.end(),
+               []( const unit_dimension & l, const unit_dimension & r ) { return l.symbol < r.symbol; } );
+}
+
+template<class B>
+int describe_base_unit( unit_descriptor & d )
+{
+    typedef unit_traits<B> traits;
+    typedef typename root_unit< typename traits::base >::type root;
+    typedef typename unit_traits<root>::template base_< 
+        traits::exponent::num, 
+        traits::exponent::den > root_with_exponent;
+    
+    d.scale *= conversion_factor( B{}, root_with_exponent{} );
+    add_dimension( d, unit_symbol_v<root>.c_str(), traits::exponent::num, traits::exponent::den );
+    
+    return 0;
+}
+
+template<class ... Bs>
+void describe_flat( unit_descriptor & d, mixed_unit<Bs...> )
+{
+    (void) std::initializer_list<int> { describe_base_unit<Bs>( d ) ... };
+}
+
+inline void describe_flat( unit_descriptor &, dimensionless ) {}
+
+template<class B>
+void describe_flat( unit_descriptor & d, B )
+{
+    describe_base_unit<B>( d );
+}
+
+}
+
+/**
+ * @brief Describe the unit @p U at run-time.
+ * @relates unit_descriptor
+ */
+template<class U>
+ENGUNITS_ENABLE_IF_T( is_unit_v<U>, unit_descriptor ) describe_unit( const U & )
+{
+    unit_descriptor result;
+    
+    result.symbol = unit_symbol_v<U>.c_str();
+    detail::describe_flat( result, unit_traits<U>::flat() );
+    
+    detail::sort_dimensions( result );
+    
+    return result;
+}
+
+/**
+ * @brief Conversion factor between two units described at run-time
+ * @pre `from.same_dimensions( to )`
+ * @relates unit_descriptor
+ * 
+ * Same as @c conversion_factor, but for units only known at run-time.
+ */
+inline long double conversion_factor( const unit_descriptor & from, 
+                                      const unit_descriptor & to )
+{
+    return from.scale / to.scale;
+}
+
+}
+
+#endif //ENGINEERING_UNITS_UNIT_DESCRIPTOR_HPP
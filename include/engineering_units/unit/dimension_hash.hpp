@@ -0,0 +1,181 @@
+/*
+ * Boost Software License - Version 1.0 - August 17th, 2003
+ *
+ * Permission is hereby granted, free of charge, to any person or organization
+ * obtaining a copy of the software and accompanying documentation covered by
+ * this license (the "Software") to use, reproduce, display, distribute,
+ * execute, and transmit the Software, and to prepare derivative works of the
+ * Software, and to permit third-parties to whom the Software is furnished to
+ * do so, all subject to the following:
+ *
+ * The copyright notices in the Software and this entire statement, including
+ * the above license grant, this restriction and the following disclaimer,
+ * must be included in all copies of the Software, in whole or in part, and
+ * all derivative works of the Software, unless such copies or derivative
+ * works are solely in the form of machine-executable object code generated by
+ * a source language processor.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+ * SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+ * FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef ENGINEERING_UNITS_UNIT_DIMENSION_HASH_HPP
+#define ENGINEERING_UNITS_UNIT_DIMENSION_HASH_HPP
+
+#include <cstddef>
+#include <cstdint>
+
+#include <engineering_units/unit/base_conversion.hpp>
+#include <engineering_units/unit/conversion.hpp>
+#include <engineering_units/unit/dimensionless.hpp>
+#include <engineering_units/unit/mixed_unit.hpp>
+#include <engineering_units/unit/traits.hpp>
+
+#include <engineering_units/detail/doxygen.hpp>
+
+namespace engunits
+{
+
+namespace detail
+{
+
+constexpr std::uint64_t fnv1a( const char * s, std::uint64_t h = 0xcbf29ce484222325ull )
+{
+    while ( *s != '\0' )
+    {
+        h ^= static_cast<unsigned char>( *s++ );
+        h *= 0x100000001b3ull;
+    }
+    
+    return h;
+}
+
+// Finalizer of splitmix64
+constexpr std::uint64_t mix64( std::uint64_t x )
+{
+    x = ( x ^ ( x >> 30 ) ) * 0xbf58476d1ce4e5b9ull;
+    x = ( x ^ ( x >> 27 ) ) * 0x94d049bb133111ebull;
+    return x ^ ( x >> 31 );
+}
+
+// Multiple of all the denominators up to 16, so that rational exponents
+// are mapped to integers.
+constexpr std::intmax_t exponent_scale = 720720;
+
+template<class B>
+constexpr std::uint64_t dimension_term()
+{
+    typedef unit_traits<B> traits;
+    typedef typename root_unit< typename traits::base >::type root;
+    
+    static_assert( exponent_scale % traits::exponent::den == 0,
+                   "Exponent denominator not supported by dimension_hash" );
+    
+    return fnv1a( root::symbol().c_str() ) * 
+           static_cast<std::uint64_t>( traits::exponent::num * ( exponent_scale / traits::exponent::den ) );
+}
+
+template<class ... Bs>
+constexpr std::uint64_t dimension_sum( mixed_unit<Bs...> )
+{
+    const std::uint64_t terms[] = { dimension_term<Bs>() ... };
+    std::uint64_t sum = 0;
+    
+    for ( std::uint64_t t : terms )
+        sum += t;
+    
+    return sum;
+}
+
+constexpr std::uint64_t dimension_sum( dimensionless )
+{
+    return 0;
+}
+
+template<class B>
+constexpr std::uint64_t dimension_sum( B )
+{
+    return dimension_term<B>();
+}
+
+template<class B>
+constexpr long double root_scale_term()
+{
+    typedef unit_traits<B> traits;
+    typedef typename root_unit< typename traits::base >::type root;
+    
+    return conversion_factor( B{}, 
+                              typename unit_traits<root>::template base_< 
+                                traits::exponent::num, 
+                                traits::exponent::den >{} );
+}
+
+template<class ... Bs>
+constexpr long double root_scale( mixed_unit<Bs...> )
+{
+    const long double terms[] = { root_scale_term<Bs>() ... };
+    long double result = 1.0L;
+    
+    for ( long double t : terms )
+        result *= t;
+    
+    return result;
+}
+
+constexpr long double root_scale( dimensionless )
+{
+    return 1.0L;
+}
+
+template<class B>
+constexpr long double root_scale( B )
+{
+    return root_scale_term<B>();
+}
+
+}
+
+/**
+ * @addtogroup metafunctions
+ * @{
+ */
+
+/**
+ * @brief A 64-bit hash of the dimensions of the unit @p U
+ * 
+ * Units that are convertible to each other have the same hash, whatever 
+ * their scale: `dimension_hash_v<imperial::foot>` is equal to
+ * `dimension_hash_v<si::meter>`, and `dimension_hash_v<si::newton>` is equal to
+ * `dimension_hash_v< mixed_unit< si::kilogram, si::meter, second_<-2> > >`.
+ * 
+ * The hash is computed at compile time from `unit_traits<U>::flat()`, where 
+ * each base unit is identified by the symbol of the root unit of its 
+ * dimension. It does not depend on the order of the units, nor on the
+ * platform, so it can be used to check units across processes.
+ * 
+ * @sa unit_root_scale_v
+ */
+template<class U>
+constexpr std::uint64_t dimension_hash_v = detail::mix64( detail::dimension_sum( unit_traits<U>::flat() ) );
+
+/**
+ * @brief The factor that converts a value in @p U to the root units
+ * 
+ * Together with @c dimension_hash_v, this identifies the unit @p U.
+ * @code{.cpp}
+ *   static_assert( unit_root_scale_v< si::kilometer > == 1000.0L, "" );
+ * @endcode
+ */
+template<class U>
+constexpr long double unit_root_scale_v = detail::root_scale( unit_traits<U>::flat() );
+
+/** @} */
+
+}
+
+#endif //ENGINEERING_UNITS_UNIT_DIMENSION_HASH_HPP
@@ -233,6 +233,28 @@ constexpr ENGUNITS_ENABLE_IF_T(
 
 /** @} */
 
+namespace detail
+{
+
+/**
+ * @internal
+ * @brief Cached result of `Lhs() == Rhs()`
+ * 
+ * Class template instances are memoized by the compiler, so the flattening
+ * behind the comparison happens once per pair of units, rather than once 
+ * per overload that checks it. Identical units do not flatten at all.
+ */
+template<class Lhs, class Rhs>
+struct same_unit : std::integral_constant<bool, Lhs() == Rhs()> {};
+
+template<class U>
+struct same_unit<U, U> : std::true_type {};
+
+template<class Lhs, class Rhs>
+constexpr bool same_unit_v = same_unit<Lhs, Rhs>::value;
+
+}
+
 }
 
 #endif //ENGINEERING_UNITS_UNIT_EQUALITY_HPP
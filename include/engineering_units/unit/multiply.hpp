@@ -201,9 +201,9 @@ struct can_multiply<dimensionless, U> : std::true_type {};
 template<>
 struct can_multiply<dimensionless, dimensionless> : std::true_type {};
 
-constexpr merge_t< mixed_unit,
-                   multiply_strategy,
-                   can_multiply > multiplies{};
+ENGUNITS_INLINE_VARIABLE constexpr merge_t< mixed_unit,
+                                            multiply_strategy,
+                                            can_multiply > multiplies{};
 
 template<class Lhs, class Rhs, class = void>
 struct multiply_result {};
@@ -0,0 +1,238 @@
+/*
+ * Boost Software License - Version 1.0 - August 17th, 2003
+ *
+ * Permission is hereby granted, free of charge, to any person or organization
+ * obtaining a copy of the software and accompanying documentation covered by
+ * this license (the "Software") to use, reproduce, display, distribute,
+ * execute, and transmit the Software, and to prepare derivative works of the
+ * Software, and to permit third-parties to whom the Software is furnished to
+ * do so, all subject to the following:
+ *
+ * The copyright notices in the Software and this entire statement, including
+ * the above license grant, this restriction and the following disclaimer,
+ * must be included in all copies of the Software, in whole or in part, and
+ * all derivative works of the Software, unless such copies or derivative
+ * works are solely in the form of machine-executable object code generated by
+ * a source language processor.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+ * SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+ * FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef ENGINEERING_UNITS_UNIT_REGISTRY_HPP
+#define ENGINEERING_UNITS_UNIT_REGISTRY_HPP
+
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <initializer_list>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <utility>
+
+#include <engineering_units/unit/descriptor.hpp>
+
+#include <engineering_units/detail/doxygen.hpp>
+
+namespace engunits
+{
+
+namespace detail
+{
+
+// into *= u^(num/den)
+inline void accumulate_unit( unit_descriptor & into, 
+                             const unit_descriptor & u, 
+                             std::intmax_t num, 
+                             std::intmax_t den )
+{
+    into.scale *= std::pow( u.scale, static_cast<long double>( num ) / den );
+    
+    for ( const unit_dimension & d : u.dimensions )
+        add_dimension( into, d.symbol, d.num * num, d.den * den );
+}
+
+inline std::intmax_t parse_integer( const std::string & s, std::size_t & pos )
+{
+    const std::size_t start = pos;
+    
+    if ( pos < s.size() && ( s[pos] == '-' || s[pos] == '+' ) )
+        ++pos;
+    
+    while ( pos < s.size() && std::isdigit( static_cast<unsigned char>( s[pos] ) ) )
+        ++pos;
+    
+    if ( pos == start || !std::isdigit( static_cast<unsigned char>( s[pos - 1] ) ) )
+        throw std::invalid_argument( "unit_registry: bad exponent in " + s );
+    
+    return std::strtoll( s.c_str() + start, nullptr, 10 );
+}
+
+}
+
+/**
+ * @brief Map from unit symbols to @c unit_descriptor
+ * 
+ * A registry is used to give a meaning to the unit symbols found in text
+ * files, where the type of the unit is not known at compile time.
+ * 
+ * @code{.cpp}
+ *   unit_registry r;
+ *   r.add( si::meter(), si::kilogram(), imperial::foot(), second() );
+ * 
+ *   unit_descriptor density = r.parse( "kg m^-3" );
+ *   unit_descriptor accel = r.parse( "ft/s^2" );
+ * @endcode
+ * 
+ * @sa predefined_units
+ */
+class unit_registry
+{
+public:
+    /**
+     * @brief Register the units @p us, by their symbol.
+     * 
+     * If a symbol is already taken, the unit registered first is kept.
+     */
+    template<class ... Us>
+    void add( const Us & ... us )
+    {
+        (void) std::initializer_list<bool> { add( describe_unit( us ) ) ... };
+    }
+    
+    /**
+     * @brief Register the unit @p u
+     * @return false if the symbol of @p u was already registered.
+     */
+    bool add( unit_descriptor u )
+    {
+        std::string key = u.symbol;
+        return units_.emplace( std::move( key ), std::move( u ) ).second;
+    }
+    
+    /**
+     * @brief Find a unit by its symbol
+     * @return nullptr if there is no such unit.
+     */
+    const unit_descriptor * find( const std::string & symbol ) const
+    {
+        auto it = units_.find( symbol );
+        return it == units_.end() ? nullptr : &it->second;
+    }
+    
+    /**
+     * @brief Number of registered units
+     */
+    std::size_t size() const noexcept
+    {
+        return units_.size();
+    }
+    
+    /**
+     * @brief Parse a unit expression
+     * @throw std::invalid_argument if the expression is malformed, or contains
+     *   an unknown symbol.
+     * 
+     * An expression is a list of registered symbols, each with an optional
+     * exponent in the form `^n` or `^(n/d)`. The symbols are separated by 
+     * spaces, as in @c unit_traits::symbol, or by @c *. A @c / inverts the 
+     * following symbol only.
+     * 
+     * The result has the expression as symbol, and an empty expression
+     * gives a dimensionless unit.
+     */
+    unit_descriptor parse( const std::string & expression ) const
+    {
+        unit_descriptor result;
+        result.symbol = expression;
+        
+        std::size_t pos = 0;
+        bool invert = false;
+        
+        while ( pos < expression.size() )
+        {
+            const char c = expression[pos];
+            
+            if ( c == ' ' || c == '*' )
+            {
+                ++pos;
+                continue;
+            }
+            
+            if ( c == '/' )
+            {
+                invert = true;
+                ++pos;
+                continue;
+            }
+            
+            const std::size_t end = expression.find_first_of( " */^", pos );
+            const std::string symbol = expression.substr( pos, end - pos );
+            
+            pos = std::min( end, expression.size() );
+            
+            const unit_descriptor * u = find( symbol );
+            
+            if ( u == nullptr )
+                throw std::invalid_argument( "unit_registry: unknown unit " + symbol );
+            
+            std::intmax_t num = 1;
+            std::intmax_t den = 1;
+            
+            if ( pos < expression.size() && expression[pos] == '^' )
+            {
+                ++pos;
+                
+                if ( pos < expression.size() && expression[pos] == '(' )
+                {
+                    ++pos;
+                    num = detail::parse_integer( expression, pos );
+                    
+                    if ( pos < expression.size() && expression[pos] == '/' )
+                    {
+                        ++pos;
+                        den = detail::parse_integer( expression, pos );
+                    }
+                    
+                    if ( pos == expression.size() || expression[pos] != ')' || den <= 0 )
+                        throw std::invalid_argument( "unit_registry: bad exponent in " + expression );
+                    
+                    ++pos;
+                }
+                else
+                {
+                    num = detail::parse_integer( expression, pos );
+                }
+            }
+            
+            if ( invert )
+                num = -num;
+            
+            invert = false;
+            
+            detail::accumulate_unit( result, *u, num, den );
+        }
+        
+        if ( invert )
+            throw std::invalid_argument( "unit_registry: dangling / in " + expression );
+        
+        detail::sort_dimensions( result );
+        
+        return result;
+    }
+    
+private:
+    std::unordered_map< std::string, unit_descriptor > units_;
+};
+
+}
+
+#endif //ENGINEERING_UNITS_UNIT_REGISTRY_HPP
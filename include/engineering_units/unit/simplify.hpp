@@ -185,9 +185,9 @@ struct simplify_strategy
     }
 };
 
-constexpr merge_t< conversion_factor_with_unit,
-                   simplify_strategy,
-                   can_simplify > simplifies{};
+ENGUNITS_INLINE_VARIABLE constexpr merge_t< conversion_factor_with_unit,
+                                            simplify_strategy,
+                                            can_simplify > simplifies{};
 
 }
 }
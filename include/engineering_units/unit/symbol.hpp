@@ -0,0 +1,109 @@
+/*
+ * Boost Software License - Version 1.0 - August 17th, 2003
+ *
+ * Permission is hereby granted, free of charge, to any person or organization
+ * obtaining a copy of the software and accompanying documentation covered by
+ * this license (the "Software") to use, reproduce, display, distribute,
+ * execute, and transmit the Software, and to prepare derivative works of the
+ * Software, and to permit third-parties to whom the Software is furnished to
+ * do so, all subject to the following:
+ *
+ * The copyright notices in the Software and this entire statement, including
+ * the above license grant, this restriction and the following disclaimer,
+ * must be included in all copies of the Software, in whole or in part, and
+ * all derivative works of the Software, unless such copies or derivative
+ * works are solely in the form of machine-executable object code generated by
+ * a source language processor.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+ * SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+ * FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef ENGINEERING_UNITS_UNIT_SYMBOL_HPP
+#define ENGINEERING_UNITS_UNIT_SYMBOL_HPP
+
+#include <type_traits>
+
+#include <engineering_units/unit/traits.hpp>
+#include <engineering_units/unit/predicates.hpp>
+
+#include <engineering_units/detail/doxygen.hpp>
+#include <engineering_units/detail/inline_variable.hpp>
+#include <engineering_units/detail/string_literal.hpp>
+
+#if __cplusplus >= 201703L && defined(__has_include)
+#if __has_include(<string_view>)
+#include <string_view>
+#define ENGUNITS_HAS_STRING_VIEW 1
+#endif
+#endif
+
+namespace engunits
+{
+
+namespace detail
+{
+
+/**
+ * @internal
+ * @brief Single copy of the symbol of @p U in the whole program
+ * 
+ * Static members of class templates are merged by the linker, so this 
+ * works without inline variables.
+ */
+template<class U>
+struct unit_symbol_storage
+{
+    static_assert( is_unit_v<U>, "U is not a unit" );
+    
+    typedef std::decay_t< decltype( unit_traits<U>::symbol() ) > type;
+    
+    static constexpr type value = unit_traits<U>::symbol();
+};
+
+#ifndef ENGUNITS_HAS_INLINE_VARIABLES
+template<class U>
+constexpr typename unit_symbol_storage<U>::type unit_symbol_storage<U>::value;
+#endif
+
+}
+
+/**
+ * @addtogroup metafunctions
+ * @{
+ */
+
+/**
+ * @brief The symbol of the unit @p U, in static storage.
+ * 
+ * Same as `unit_traits<U>::symbol()`, but the symbol is computed once per
+ * unit, at compile time, and every use refers to the same object.
+ * 
+ * @code{.cpp}
+ *   static_assert( unit_symbol_v< mixed_unit< si::meter, second_<-1> > > == "m s^-1", "" );
+ * 
+ *   const char * s = unit_symbol_v< si::newton >.c_str(); // never dangles
+ * @endcode
+ */
+template<class U>
+ENGUNITS_INLINE_VARIABLE constexpr const auto & unit_symbol_v = detail::unit_symbol_storage<U>::value;
+
+#if defined(ENGUNITS_HAS_STRING_VIEW) || defined(ENGUNITS_DOXYGEN)
+/**
+ * @brief The symbol of the unit @p U as a `std::string_view`
+ * @note Only available in C++17.
+ */
+template<class U>
+inline constexpr std::string_view unit_symbol_view_v { unit_symbol_v<U>.c_str(), unit_symbol_v<U>.size() };
+#endif
+
+/** @} */
+
+}
+
+#endif //ENGINEERING_UNITS_UNIT_SYMBOL_HPP
@@ -118,6 +118,8 @@ struct unit_traits
      * API you can only assume that he returned type will provided a member 
      * @c c_str function that returns a non-null `const char *`, pointing 
      * to a null-terminating string that represents the symbol
+     * 
+     * @sa unit_symbol_v, to get a reference to a single static copy.
      */
     static constexpr std::string_literal<N> symbol();
     
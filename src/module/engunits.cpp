@@ -0,0 +1,74 @@
+/*
+ * Boost Software License - Version 1.0 - August 17th, 2003
+ *
+ * Permission is hereby granted, free of charge, to any person or organization
+ * obtaining a copy of the software and accompanying documentation covered by
+ * this license (the "Software") to use, reproduce, display, distribute,
+ * execute, and transmit the Software, and to prepare derivative works of the
+ * Software, and to permit third-parties to whom the Software is furnished to
+ * do so, all subject to the following:
+ *
+ * The copyright notices in the Software and this entire statement, including
+ * the above license grant, this restriction and the following disclaimer,
+ * must be included in all copies of the Software, in whole or in part, and
+ * all derivative works of the Software, unless such copies or derivative
+ * works are solely in the form of machine-executable object code generated by
+ * a source language processor.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+ * SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+ * FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+// Interface unit of the C++20 module 'engunits'.
+//
+// The standard headers go into the global module fragment, everything
+// else in the purview, so that the standard library is not attached to
+// the module.
+module;
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <ratio>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+export module engunits;
+
+export extern "C++" {
+
+#include <engineering_units/quantity.hpp>
+#include <engineering_units/io.hpp>
+#include <engineering_units/unit/symbol.hpp>
+
+#include <engineering_units/angle.hpp>
+#include <engineering_units/information.hpp>
+#include <engineering_units/time.hpp>
+
+#include <engineering_units/si/current.hpp>
+#include <engineering_units/si/energy.hpp>
+#include <engineering_units/si/force.hpp>
+#include <engineering_units/si/length.hpp>
+#include <engineering_units/si/mass.hpp>
+#include <engineering_units/si/power.hpp>
+#include <engineering_units/si/pressure.hpp>
+#include <engineering_units/si/temperature.hpp>
+
+#include <engineering_units/imperial/force.hpp>
+#include <engineering_units/imperial/length.hpp>
+#include <engineering_units/imperial/mass.hpp>
+#include <engineering_units/imperial/pressure.hpp>
+#include <engineering_units/imperial/temperature.hpp>
+#include <engineering_units/imperial/velocity.hpp>
+
+}
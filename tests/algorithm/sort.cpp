@@ -0,0 +1,232 @@
+/*
+ * Boost Software License - Version 1.0 - August 17th, 2003
+ *
+ * Permission is hereby granted, free of charge, to any person or organization
+ * obtaining a copy of the software and accompanying documentation covered by
+ * this license (the "Software") to use, reproduce, display, distribute,
+ * execute, and transmit the Software, and to prepare derivative works of the
+ * Software, and to permit third-parties to whom the Software is furnished to
+ * do so, all subject to the following:
+ *
+ * The copyright notices in the Software and this entire statement, including
+ * the above license grant, this restriction and the following disclaimer,
+ * must be included in all copies of the Software, in whole or in part, and
+ * all derivative works of the Software, unless such copies or derivative
+ * works are solely in the form of machine-executable object code generated by
+ * a source language processor.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+ * SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+ * FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <engineering_units/quantity.hpp>
+#include <engineering_units/algorithm/sort.hpp>
+
+#include <engineering_units/time.hpp>
+
+using engunits::quantity;
+
+using seconds_t = quantity<double, engunits::second>;
+using ms_t = quantity<double, engunits::millisecond>;
+
+template<class Q>
+bool same_values( const std::vector<Q> & x, const std::vector<Q> & y )
+{
+    return std::equal( x.begin(), x.end(), y.begin(), y.end(), []( const Q & a, const Q & b )
+    {
+        return a.value() == b.value();
+    } );
+}
+
+void test_sort_double()
+{
+    std::vector<seconds_t> v { seconds_t( 3.0 ), seconds_t( -1.5 ), seconds_t( 0.0 ), seconds_t( -0.0 ),
+                               seconds_t( 1e300 ), seconds_t( -std::numeric_limits<double>::infinity() ),
+                               seconds_t( 2.0 ), seconds_t( -1e-300 ) };
+    
+    engunits::sort( v );
+    
+    assert( v[0].value() == -std::numeric_limits<double>::infinity() );
+    assert( v[1].value() == -1.5 );
+    assert( v[2].value() == -1e-300 );
+    assert( std::signbit( v[3].value() ) && v[3].value() == 0.0 );
+    assert( !std::signbit( v[4].value() ) && v[4].value() == 0.0 );
+    assert( v[5].value() == 2.0 );
+    assert( v[7].value() == 1e300 );
+    
+    // Large enough to use the radix sort, with several threads
+    std::mt19937_64 gen( 42 );
+    std::normal_distribution<double> dist( 0.0, 1e3 );
+    
+    std::vector<seconds_t> big;
+    
+    for ( int i = 0; i < 600000; ++i )
+        big.emplace_back( dist( gen ) );
+    
+    std::vector<seconds_t> ref = big;
+    std::sort( ref.begin(), ref.end() );
+    
+    std::vector<seconds_t> serial = big;
+    engunits::sort( serial, 1 );
+    assert( same_values( serial, ref ) );
+    
+    engunits::stable_sort( big.data(), big.data() + big.size(), 3 );
+    assert( same_values( big, ref ) );
+    
+    // NaN go to the end
+    std::vector<seconds_t> with_nan { seconds_t( std::nan("") ), seconds_t( 1.0 ), seconds_t( -1.0 ) };
+    engunits::sort( with_nan );
+    assert( with_nan[0].value() == -1.0 && with_nan[1].value() == 1.0 && std::isnan( with_nan[2].value() ) );
+}
+
+void test_sort_integer()
+{
+    using ticks_t = quantity<std::int32_t, engunits::millisecond>;
+    using uticks_t = quantity<std::uint16_t, engunits::millisecond>;
+    
+    std::vector<ticks_t> v;
+    std::vector<uticks_t> u;
+    
+    std::mt19937 gen( 7 );
+    
+    for ( int i = 0; i < 5000; ++i )
+    {
+        v.emplace_back( std::int32_t( gen() ) );
+        u.emplace_back( std::uint16_t( gen() % 1000 ) );
+    }
+    
+    v.emplace_back( std::numeric_limits<std::int32_t>::min() );
+    v.emplace_back( std::numeric_limits<std::int32_t>::max() );
+    
+    std::vector<ticks_t> ref = v;
+    std::sort( ref.begin(), ref.end() );
+    
+    engunits::sort( v );
+    assert( same_values( v, ref ) );
+    assert( v.front().value() == std::numeric_limits<std::int32_t>::min() );
+    
+    std::vector<uticks_t> uref = u;
+    std::sort( uref.begin(), uref.end() );
+    
+    engunits::sort( u );
+    assert( same_values( u, uref ) );
+    
+    // Fallback to std::stable_sort
+    std::array< quantity<long double, engunits::second>, 3 > l {{ 
+        quantity<long double, engunits::second>( 2.0L ),
+        quantity<long double, engunits::second>( -2.0L ),
+        quantity<long double, engunits::second>( 0.5L ) }};
+    
+    engunits::sort( l );
+    assert( l[0].value() == -2.0L && l[1].value() == 0.5L && l[2].value() == 2.0L );
+}
+
+void test_sort_by_key()
+{
+    std::vector<seconds_t> times;
+    std::vector<std::string> names;
+    
+    for ( int i = 0; i < 1000; ++i )
+    {
+        times.emplace_back( double( ( i * 37 ) % 10 ) );
+        names.push_back( std::to_string( i ) );
+    }
+    
+    engunits::sort_by_key( times, names );
+    
+    assert( std::is_sorted( times.begin(), times.end() ) );
+    
+    // Stable: equal keys keep the order of the values
+    for ( std::size_t i = 0; i < times.size(); ++i )
+    {
+        const int k = std::stoi( names[i] );
+        assert( double( ( k * 37 ) % 10 ) == times[i].value() );
+        
+        if ( i > 0 && times[i - 1].value() == times[i].value() )
+            assert( std::stoi( names[i - 1] ) < k );
+    }
+    
+    // Fallback path
+    std::vector< quantity<long double, engunits::second> > lt { 
+        quantity<long double, engunits::second>( 3.0L ), 
+        quantity<long double, engunits::second>( 1.0L ),
+        quantity<long double, engunits::second>( 2.0L ) };
+    std::vector<int> payload { 3, 1, 2 };
+    
+    engunits::sort_by_key( lt, payload );
+    assert( payload[0] == 1 && payload[1] == 2 && payload[2] == 3 );
+    assert( lt[0].value() == 1.0L );
+}
+
+void test_bounds()
+{
+    std::vector<seconds_t> v;
+    
+    for ( int i = 0; i < 100; ++i )
+        v.emplace_back( i * 0.01 );
+    
+    // 250 ms is between 0.24 and 0.25 s after the conversion
+    auto lo = engunits::lower_bound( v.begin(), v.end(), ms_t( 245.0 ) );
+    auto hi = engunits::upper_bound( v.begin(), v.end(), ms_t( 500.0 ) );
+    
+    assert( lo - v.begin() == 25 );
+    assert( hi - v.begin() == 51 );
+    
+    // Unqualified calls resolve to engunits, and std::sort is not ambiguous
+    auto it = lower_bound( v.begin(), v.end(), ms_t( 0.0 ) );
+    assert( it == v.begin() );
+    
+    sort( v.begin(), v.end() );
+    assert( std::is_sorted( v.begin(), v.end() ) );
+}
+
+void test_bounds_across_types()
+{
+    typedef quantity<int, engunits::second> int_s_t;
+    typedef quantity<int, engunits::millisecond> int_ms_t;
+    
+    const std::vector<int_s_t> s { int_s_t( 1 ), int_s_t( 2 ) };
+    
+    // 1500 ms is not rounded to a whole second
+    assert( engunits::lower_bound( s.begin(), s.end(), int_ms_t( 1500 ) ) - s.begin() == 1 );
+    assert( engunits::upper_bound( s.begin(), s.end(), int_ms_t( 1500 ) ) - s.begin() == 1 );
+    assert( engunits::lower_bound( s.begin(), s.end(), int_ms_t( 999 ) ) - s.begin() == 0 );
+    
+    // Equal across units
+    assert( engunits::lower_bound( s.begin(), s.end(), int_ms_t( 1000 ) ) - s.begin() == 0 );
+    assert( engunits::upper_bound( s.begin(), s.end(), int_ms_t( 1000 ) ) - s.begin() == 1 );
+    assert( engunits::upper_bound( s.begin(), s.end(), ms_t( 2000.0 ) ) - s.begin() == 2 );
+    
+    // 0.1 is below 0.1f: the probe is not rounded to float
+    typedef quantity<float, engunits::second> float_s_t;
+    
+    const std::vector<float_s_t> f { float_s_t( 0.1f ), float_s_t( 0.2f ) };
+    
+    assert( engunits::lower_bound( f.begin(), f.end(), seconds_t( 0.1 ) ) - f.begin() == 0 );
+    assert( engunits::upper_bound( f.begin(), f.end(), seconds_t( 0.1 ) ) - f.begin() == 0 );
+    assert( engunits::upper_bound( f.begin(), f.end(), seconds_t( double( 0.1f ) ) ) - f.begin() == 1 );
+}
+
+int main()
+{
+    test_sort_double();
+    test_sort_integer();
+    test_sort_by_key();
+    test_bounds();
+    test_bounds_across_types();
+}
@@ -1,6 +1,7 @@
 
 // Just check if this compiles
 #include <engineering_units/angle.hpp>
+#include <engineering_units/information.hpp>
 #include <engineering_units/time.hpp>
 
 #include <engineering_units/si/energy.hpp>
@@ -0,0 +1,139 @@
+/*
+ * Boost Software License - Version 1.0 - August 17th, 2003
+ *
+ * Permission is hereby granted, free of charge, to any person or organization
+ * obtaining a copy of the software and accompanying documentation covered by
+ * this license (the "Software") to use, reproduce, display, distribute,
+ * execute, and transmit the Software, and to prepare derivative works of the
+ * Software, and to permit third-parties to whom the Software is furnished to
+ * do so, all subject to the following:
+ *
+ * The copyright notices in the Software and this entire statement, including
+ * the above license grant, this restriction and the following disclaimer,
+ * must be included in all copies of the Software, in whole or in part, and
+ * all derivative works of the Software, unless such copies or derivative
+ * works are solely in the form of machine-executable object code generated by
+ * a source language processor.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+ * SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+ * FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#include <cassert>
+#include <chrono>
+#include <cstdint>
+#include <thread>
+#include <type_traits>
+
+#include <engineering_units/quantity.hpp>
+#include <engineering_units/chrono.hpp>
+
+#include <engineering_units/si/length.hpp>
+
+namespace si = engunits::si;
+
+using engunits::quantity;
+
+using ms_t = quantity<std::int64_t, engunits::millisecond>;
+using us_t = quantity<std::int64_t, engunits::microsecond>;
+using s_t = quantity<std::int64_t, engunits::second>;
+using fs_t = quantity<double, engunits::second>;
+
+void test_implicit()
+{
+    // Exact conversions are implicit, in both directions
+    constexpr ms_t timeout = std::chrono::seconds( 2 );
+    static_assert( timeout.value() == 2000, "" );
+    
+    constexpr std::chrono::microseconds us = timeout;
+    static_assert( us.count() == 2000000, "" );
+    
+    constexpr std::chrono::milliseconds same = timeout;
+    static_assert( same.count() == 2000, "" );
+    
+    // Floating point representation can hold any period
+    constexpr fs_t fs = std::chrono::milliseconds( 1500 );
+    static_assert( fs.value() == 1.5, "" );
+    
+    constexpr std::chrono::duration<double> d = fs;
+    static_assert( d.count() == 1.5, "" );
+    
+    const quantity<std::int64_t, engunits::minute> m = std::chrono::hours( 2 );
+    assert( m.value() == 120 );
+    
+    static_assert( std::is_convertible< std::chrono::seconds, ms_t >::value, "" );
+    static_assert( std::is_convertible< ms_t, std::chrono::nanoseconds >::value, "" );
+}
+
+void test_explicit()
+{
+    // Lossy conversions are explicit, and truncate like duration_cast
+    static_assert( !std::is_convertible< std::chrono::milliseconds, s_t >::value, "" );
+    static_assert( std::is_constructible< s_t, std::chrono::milliseconds >::value, "" );
+    
+    static_assert( !std::is_convertible< ms_t, std::chrono::seconds >::value, "" );
+    static_assert( std::is_constructible< std::chrono::seconds, ms_t >::value, "" );
+    
+    static_assert( !std::is_convertible< fs_t, std::chrono::seconds >::value, "" );
+    
+    const s_t s( std::chrono::milliseconds( 1999 ) );
+    assert( s.value() == 1 );
+    
+    const std::chrono::seconds sec( ms_t( 1500 ) );
+    assert( sec.count() == 1 );
+    
+    const std::chrono::milliseconds rounded( fs_t( 0.0025 ) );
+    assert( rounded.count() == 2 );
+    
+    // Not a time unit
+    static_assert( !std::is_constructible< quantity<double, si::meter>, std::chrono::seconds >::value, "" );
+    static_assert( !std::is_constructible< std::chrono::seconds, quantity<double, si::meter> >::value, "" );
+}
+
+void test_helpers()
+{
+    const auto q = engunits::to_quantity( std::chrono::microseconds( 42 ) );
+    
+    static_assert( std::is_same< decltype(q), const quantity< std::chrono::microseconds::rep, engunits::microsecond > >::value, "" );
+    assert( q.value() == 42 );
+    
+    const auto d = engunits::to_duration( us_t( 7 ) );
+    
+    static_assert( std::is_same< decltype(d), const std::chrono::duration< std::int64_t, std::micro > >::value, "" );
+    assert( d.count() == 7 );
+    
+    // Time arithmetic stays in quantities
+    const us_t total = us_t( std::chrono::milliseconds( 3 ) ) + us_t( 250 );
+    assert( total.value() == 3250 );
+}
+
+void test_stopwatch()
+{
+    engunits::stopwatch w;
+    
+    const auto latency = engunits::measure_latency( []( int ms )
+    {
+        std::this_thread::sleep_for( std::chrono::milliseconds( ms ) );
+    }, 2 );
+    
+    assert( latency >= decltype(latency)( std::chrono::milliseconds( 2 ) ) );
+    
+    const ms_t lap( w.lap() );
+    assert( lap.value() >= 2 );
+    
+    const quantity<double, engunits::millisecond> since( w.elapsed() );
+    assert( since.value() >= 0.0 && since.value() < 1000.0 );
+}
+
+int main()
+{
+    test_implicit();
+    test_explicit();
+    test_helpers();
+    test_stopwatch();
+}
@@ -0,0 +1,196 @@
+/*
+ * Boost Software License - Version 1.0 - August 17th, 2003
+ *
+ * Permission is hereby granted, free of charge, to any person or organization
+ * obtaining a copy of the software and accompanying documentation covered by
+ * this license (the "Software") to use, reproduce, display, distribute,
+ * execute, and transmit the Software, and to prepare derivative works of the
+ * Software, and to permit third-parties to whom the Software is furnished to
+ * do so, all subject to the following:
+ *
+ * The copyright notices in the Software and this entire statement, including
+ * the above license grant, this restriction and the following disclaimer,
+ * must be included in all copies of the Software, in whole or in part, and
+ * all derivative works of the Software, unless such copies or derivative
+ * works are solely in the form of machine-executable object code generated by
+ * a source language processor.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+ * SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+ * FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#include <cassert>
+#include <cmath>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include <engineering_units/quantity.hpp>
+#include <engineering_units/hash.hpp>
+#include <engineering_units/container/flat_hash_map.hpp>
+
+#include <engineering_units/si/length.hpp>
+
+namespace si = engunits::si;
+using namespace si::literals;
+
+using engunits::quantity;
+using engunits::flat_hash_map;
+
+using mm_t = quantity<std::int64_t, si::millimeter>;
+using m_t = quantity<double, si::meter>;
+
+void test_quantize()
+{
+    assert( engunits::quantize<mm_t>( 0.01234_m ).value() == 12 );
+    assert( engunits::quantize<mm_t>( 0.01234_m, mm_t( 5 ) ).value() == 10 );
+    assert( engunits::quantize<mm_t>( 0.0125_m, mm_t( 5 ) ).value() == 15 );
+    assert( engunits::quantize<mm_t>( -0.0126_m, mm_t( 5 ) ).value() == -15 );
+    assert( engunits::quantize<mm_t>( 3.0_km ).value() == 3000000 );
+    
+    static_assert( std::is_same< decltype( engunits::quantize<mm_t>( 1.0_m ) ), mm_t >::value, "" );
+}
+
+void test_hash()
+{
+    std::hash<m_t> h;
+    
+    assert( h( m_t( 1.5 ) ) == std::hash<double>{}( 1.5 ) );
+    assert( h( m_t( 0.0 ) ) == h( m_t( -0.0 ) ) );
+    
+    std::unordered_set<mm_t> cells { mm_t( 1 ), mm_t( 2 ), mm_t( 1 ) };
+    assert( cells.size() == 2 );
+}
+
+void test_flat_hash_map()
+{
+    flat_hash_map< mm_t, int > map;
+    
+    assert( map.empty() );
+    assert( map.find( mm_t( 3 ) ) == map.end() );
+    
+    for ( int i = -5000; i < 5000; ++i )
+        map[ mm_t( i * 10 ) ] = i;
+    
+    assert( map.size() == 10000 );
+    assert( map.load_factor() <= 0.75 );
+    
+    for ( int i = -5000; i < 5000; ++i )
+    {
+        assert( map.at( mm_t( i * 10 ) ) == i );
+        assert( !map.contains( mm_t( i * 10 + 1 ) ) );
+    }
+    
+    auto r = map.try_emplace( mm_t( 0 ), 42 );
+    assert( !r.second && r.first->second == 0 );
+    
+    r = map.insert( { mm_t( 7 ), 7 } );
+    assert( r.second && map.at( mm_t( 7 ) ) == 7 );
+    
+    // Erase every other key, the rest must still be found
+    for ( int i = -5000; i < 5000; i += 2 )
+        assert( map.erase( mm_t( i * 10 ) ) == 1 );
+    
+    assert( map.erase( mm_t( 1 ) ) == 0 );
+    assert( map.size() == 5001 );
+    
+    for ( int i = -4999; i < 5000; i += 2 )
+        assert( map.at( mm_t( i * 10 ) ) == i );
+    
+    for ( int i = -5000; i < 5000; i += 2 )
+        assert( map.count( mm_t( i * 10 ) ) == 0 );
+    
+    std::size_t n = 0;
+    long long sum = 0;
+    
+    for ( const auto & kv : map )
+    {
+        ++n;
+        sum += kv.second;
+    }
+    
+    assert( n == map.size() );
+    assert( sum == 7 );
+    
+    flat_hash_map< mm_t, int >::const_iterator it = map.begin();
+    assert( it != map.cend() );
+    
+    bool thrown = false;
+    
+    try
+    {
+        map.at( mm_t( 1 ) );
+    }
+    catch ( const std::out_of_range & )
+    {
+        thrown = true;
+    }
+    
+    assert( thrown );
+    
+    map.clear();
+    assert( map.empty() && map.begin() == map.end() );
+}
+
+void test_rehash()
+{
+    flat_hash_map< mm_t, int > map;
+    
+    for ( int i = 0; i < 8; ++i )
+        map[ mm_t( i ) ] = i;
+    
+    // Rounded up to a power of two
+    map.rehash( 100 );
+    assert( map.bucket_count() == 128 );
+    
+    // Not below the capacity needed by the elements
+    map.rehash( 3 );
+    assert( map.bucket_count() == 16 );
+    
+    for ( int i = 8; i < 100; ++i )
+        map[ mm_t( i ) ] = i;
+    
+    map.rehash( 0 );
+    assert( map.bucket_count() == 256 && map.load_factor() <= 0.75 );
+    
+    for ( int i = 0; i < 100; ++i )
+        assert( map.at( mm_t( i ) ) == i );
+}
+
+void test_spatial_hash()
+{
+    // Compare with std::unordered_map, keyed by grid cells of 2 cm
+    flat_hash_map< mm_t, std::string > flat;
+    std::unordered_map< mm_t, std::string > ref;
+    
+    for ( int i = 0; i < 20000; ++i )
+    {
+        const m_t x( std::sin( i * 0.37 ) * 3.0 );
+        const mm_t cell = engunits::quantize<mm_t>( x, mm_t( 20 ) );
+        
+        flat[cell] += "x";
+        ref[cell] += "x";
+    }
+    
+    assert( flat.size() == ref.size() );
+    
+    for ( const auto & kv : ref )
+        assert( flat.at( kv.first ) == kv.second );
+}
+
+int main()
+{
+    test_quantize();
+    test_hash();
+    test_flat_hash_map();
+    test_rehash();
+    test_spatial_hash();
+}
@@ -0,0 +1,293 @@
+/*
+ * Boost Software License - Version 1.0 - August 17th, 2003
+ *
+ * Permission is hereby granted, free of charge, to any person or organization
+ * obtaining a copy of the software and accompanying documentation covered by
+ * this license (the "Software") to use, reproduce, display, distribute,
+ * execute, and transmit the Software, and to prepare derivative works of the
+ * Software, and to permit third-parties to whom the Software is furnished to
+ * do so, all subject to the following:
+ *
+ * The copyright notices in the Software and this entire statement, including
+ * the above license grant, this restriction and the following disclaimer,
+ * must be included in all copies of the Software, in whole or in part, and
+ * all derivative works of the Software, unless such copies or derivative
+ * works are solely in the form of machine-executable object code generated by
+ * a source language processor.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+ * SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+ * FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#include <cassert>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <unistd.h>
+
+#include <engineering_units/quantity.hpp>
+#include <engineering_units/container/ring_buffer.hpp>
+
+#include <engineering_units/si/length.hpp>
+#include <engineering_units/si/pressure.hpp>
+
+namespace si = engunits::si;
+using namespace si::literals;
+
+using engunits::quantity;
+
+using pascal_t = quantity<float, si::pascal>;
+using meter_t = quantity<float, si::meter>;
+
+void test_spsc()
+{
+    engunits::spsc_ring_buffer< pascal_t > q( 8 );
+    
+    assert( q.capacity() == 8 );
+    assert( q.size() == 0 );
+    
+    std::vector< pascal_t > in;
+    for ( int i = 0; i < 12; ++i )
+        in.emplace_back( float(i) );
+    
+    // Only 8 fit
+    assert( q.push( in.begin(), in.end() ) == 8 );
+    assert( !q.push( pascal_t( 1.0f ) ) );
+    assert( q.size() == 8 );
+    
+    std::vector< pascal_t > out( 5 );
+    assert( q.pop( out.begin(), out.size() ) == 5 );
+    assert( out[4] == pascal_t( 4.0f ) );
+    
+    // Wrap around
+    assert( q.push( in.begin() + 8, in.end() ) == 4 );
+    
+    std::vector< pascal_t > rest;
+    assert( q.pop( std::back_inserter( rest ), 100 ) == 7 );
+    
+    for ( std::size_t i = 0; i < rest.size(); ++i )
+        assert( rest[i] == in[i + 5] );
+    
+    pascal_t x;
+    assert( !q.pop( x ) );
+}
+
+void test_mpsc()
+{
+    engunits::mpsc_ring_buffer< pascal_t > q( 8 );
+    
+    std::vector< pascal_t > in;
+    for ( int i = 0; i < 20; ++i )
+        in.push_back( pascal_t( float( i ) ) );
+    
+    // Ranges are read across their boundaries, and around the end
+    assert( q.push( in.begin(), in.begin() + 3 ) == 3 );
+    assert( q.push( in.begin() + 3, in.begin() + 5 ) == 2 );
+    assert( q.size() == 5 );
+    
+    std::vector< pascal_t > out;
+    assert( q.pop( std::back_inserter( out ), 4 ) == 4 );
+    assert( q.push( in.begin() + 5, in.end() ) == 7 );
+    assert( q.size() == 8 );
+    assert( !q.push( pascal_t( 1.0f ) ) );
+    assert( q.pop( std::back_inserter( out ), 100 ) == 8 );
+    
+    for ( std::size_t i = 0; i < out.size(); ++i )
+        assert( out[i] == in[i] );
+    
+    // A marker left from the previous lap does not publish anything
+    assert( q.size() == 0 );
+    
+    pascal_t x;
+    assert( !q.pop( x ) );
+    assert( q.push( in.begin(), in.begin() + 8 ) == 8 );
+    assert( q.pop( std::back_inserter( out ), 100 ) == 8 );
+    assert( out.back() == in[7] );
+}
+
+void test_capacity()
+{
+    bool thrown = false;
+    
+    try
+    {
+        engunits::spsc_ring_buffer< pascal_t > q( 6 );
+    }
+    catch ( const std::invalid_argument & )
+    {
+        thrown = true;
+    }
+    
+    assert( thrown );
+}
+
+void test_spsc_threads()
+{
+    engunits::spsc_ring_buffer< meter_t > q( 64 );
+    const int total = 100000;
+    
+    std::thread producer( [&]
+    {
+        meter_t batch[16];
+        int next = 0;
+        
+        while ( next < total )
+        {
+            const int n = std::min( 16, total - next );
+            
+            for ( int i = 0; i < n; ++i )
+                batch[i] = meter_t( float( ( next + i ) % 1024 ) );
+            
+            const std::size_t pushed = q.push( batch, batch + n );
+            
+            if ( pushed == 0 )
+                std::this_thread::yield();
+            
+            next += int( pushed );
+        }
+    } );
+    
+    int received = 0;
+    meter_t buffer[32];
+    
+    while ( received < total )
+    {
+        const std::size_t n = q.pop( buffer, 32 );
+        
+        if ( n == 0 )
+            std::this_thread::yield();
+        
+        for ( std::size_t i = 0; i < n; ++i, ++received )
+            assert( buffer[i] == meter_t( float( received % 1024 ) ) );
+    }
+    
+    producer.join();
+}
+
+void test_mpsc_threads()
+{
+    engunits::mpsc_ring_buffer< meter_t > q( 128 );
+    const int producers = 4;
+    const int per_producer = 20000;
+    
+    std::vector< std::thread > threads;
+    
+    // Producer p writes p, p + producers, p + 2 * producers, ...
+    for ( int p = 0; p < producers; ++p )
+    {
+        threads.emplace_back( [&q, p]
+        {
+            for ( int i = 0; i < per_producer; ++i )
+                while ( !q.push( meter_t( float( p + i * producers ) ) ) )
+                    std::this_thread::yield();
+        } );
+    }
+    
+    std::vector< int > last( producers, -1 );
+    int received = 0;
+    meter_t buffer[64];
+    
+    while ( received < producers * per_producer )
+    {
+        const std::size_t n = q.pop( buffer, 64 );
+        
+        if ( n == 0 )
+            std::this_thread::yield();
+        
+        for ( std::size_t i = 0; i < n; ++i, ++received )
+        {
+            const int v = int( buffer[i].value() );
+            const int p = v % producers;
+            
+            // Values of each producer arrive in order
+            assert( v > last[p] );
+            last[p] = v;
+        }
+    }
+    
+    for ( auto & t : threads )
+        t.join();
+    
+    for ( int p = 0; p < producers; ++p )
+        assert( last[p] == p + ( per_producer - 1 ) * producers );
+}
+
+void test_shared()
+{
+    const std::string name = "/engunits_ring_buffer_test_" + std::to_string( ::getpid() );
+    
+    auto writer = engunits::spsc_ring_buffer< pascal_t >::create_shared( name.c_str(), 16 );
+    
+    // Same unit, different handle: both point to the same memory
+    auto reader = engunits::spsc_ring_buffer< pascal_t >::open_shared( name.c_str() );
+    
+    assert( reader.capacity() == 16 );
+    
+    const pascal_t in[] = { pascal_t( 101325.0f ), pascal_t( 99000.0f ) };
+    assert( writer.push( std::begin( in ), std::end( in ) ) == 2 );
+    
+    pascal_t out[2];
+    assert( reader.pop( out, 2 ) == 2 );
+    assert( out[0] == in[0] && out[1] == in[1] );
+    
+    bool thrown = false;
+    
+    try
+    {
+        auto wrong = engunits::spsc_ring_buffer< meter_t >::open_shared( name.c_str() );
+    }
+    catch ( const std::runtime_error & )
+    {
+        thrown = true;
+    }
+    
+    assert( thrown );
+    
+    // A consumer that attaches late starts where the previous one stopped
+    assert( writer.push( pascal_t( 1.0f ) ) );
+    auto late = engunits::spsc_ring_buffer< pascal_t >::open_shared( name.c_str() );
+    assert( late.pop( out, 2 ) == 1 && out[0] == pascal_t( 1.0f ) );
+    
+    // The segment records the kind of producer
+    thrown = false;
+    
+    try
+    {
+        auto wrong = engunits::mpsc_ring_buffer< pascal_t >::open_shared( name.c_str() );
+    }
+    catch ( const std::runtime_error & )
+    {
+        thrown = true;
+    }
+    
+    assert( thrown );
+    
+    engunits::spsc_ring_buffer< pascal_t >::unlink_shared( name.c_str() );
+    
+    auto mp_writer = engunits::mpsc_ring_buffer< pascal_t >::create_shared( name.c_str(), 16 );
+    auto mp_reader = engunits::mpsc_ring_buffer< pascal_t >::open_shared( name.c_str() );
+    
+    assert( mp_writer.push( std::begin( in ), std::end( in ) ) == 2 );
+    assert( mp_reader.size() == 2 );
+    assert( mp_reader.pop( out, 2 ) == 2 );
+    assert( out[0] == in[0] && out[1] == in[1] );
+    
+    engunits::mpsc_ring_buffer< pascal_t >::unlink_shared( name.c_str() );
+}
+
+int main()
+{
+    test_spsc();
+    test_mpsc();
+    test_capacity();
+    test_spsc_threads();
+    test_mpsc_threads();
+    test_shared();
+}
@@ -0,0 +1,226 @@
+/*
+ * Boost Software License - Version 1.0 - August 17th, 2003
+ *
+ * Permission is hereby granted, free of charge, to any person or organization
+ * obtaining a copy of the software and accompanying documentation covered by
+ * this license (the "Software") to use, reproduce, display, distribute,
+ * execute, and transmit the Software, and to prepare derivative works of the
+ * Software, and to permit third-parties to whom the Software is furnished to
+ * do so, all subject to the following:
+ *
+ * The copyright notices in the Software and this entire statement, including
+ * the above license grant, this restriction and the following disclaimer,
+ * must be included in all copies of the Software, in whole or in part, and
+ * all derivative works of the Software, unless such copies or derivative
+ * works are solely in the form of machine-executable object code generated by
+ * a source language processor.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+ * SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+ * FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#include <cassert>
+#include <cstdio>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <engineering_units/quantity.hpp>
+#include <engineering_units/io/columnar.hpp>
+
+#include <engineering_units/si/length.hpp>
+#include <engineering_units/si/pressure.hpp>
+#include <engineering_units/imperial/length.hpp>
+
+namespace si = engunits::si;
+namespace imperial = engunits::imperial;
+
+using engunits::quantity;
+
+using feet_t = quantity<float, imperial::foot>;
+using meter_t = quantity<float, si::meter>;
+using pascal_t = quantity<double, si::pascal>;
+
+const std::string path = "columnar_test.engu";
+
+void write_file()
+{
+    std::vector< feet_t > altitude;
+    std::vector< pascal_t > pressure;
+    
+    for ( int i = 0; i < 3000; ++i )
+    {
+        altitude.emplace_back( float( i ) );
+        pressure.emplace_back( 101325.0 - i );
+    }
+    
+    engunits::column_writer w( path );
+    
+    w.write( "altitude", altitude.begin(), altitude.end() );
+    w.write( "pressure", pressure.begin(), pressure.end() );
+    
+    bool thrown = false;
+    
+    try
+    {
+        w.write( "altitude", altitude.begin(), altitude.end() );
+    }
+    catch ( const std::invalid_argument & )
+    {
+        thrown = true;
+    }
+    
+    assert( thrown );
+}
+
+void test_directory()
+{
+    engunits::column_reader r( path );
+    
+    assert( r.size() == 2 );
+    
+    const engunits::column_info & c = r.info( 0 );
+    
+    assert( c.name == "altitude" );
+    assert( c.value_kind == 'f' );
+    assert( c.value_size == sizeof( float ) );
+    assert( c.count == 3000 );
+    assert( c.offset % 64 == 0 );
+    assert( c.unit.symbol == "ft" );
+    assert( c.unit.same_dimensions( engunits::describe_unit( si::meter() ) ) );
+    
+    assert( r.find( "pressure" ) != nullptr );
+    assert( r.find( "temperature" ) == nullptr );
+}
+
+void test_zero_copy()
+{
+    engunits::column_reader r( path );
+    
+    const auto p = r.column< pascal_t >( "pressure" );
+    
+    assert( !p.needs_conversion() );
+    assert( p.size() == 3000 );
+    assert( p[10] == pascal_t( 101315.0 ) );
+    assert( p.raw()[10] == 101315.0 );
+    
+    const auto ft = r.column< feet_t >( "altitude" );
+    
+    assert( !ft.needs_conversion() );
+    assert( ft[2999] == feet_t( 2999.0f ) );
+}
+
+void test_conversion()
+{
+    engunits::column_reader r( path );
+    
+    const auto m = r.column< meter_t >( "altitude" );
+    
+    assert( m.needs_conversion() );
+    
+    // Lazy
+    assert( m[100] == meter_t( 100.0f * 0.3048f ) );
+    assert( *( m.begin() + 100 ) == m[100] );
+    assert( m.end() - m.begin() == 3000 );
+    
+    // Bulk
+    std::vector< meter_t > out( m.size() );
+    assert( m.convert( out.begin() ) == out.end() );
+    
+    for ( std::size_t i = 0; i < out.size(); ++i )
+        assert( out[i] == m[i] );
+}
+
+void test_mismatch()
+{
+    engunits::column_reader r( path );
+    
+    bool thrown = false;
+    
+    try
+    {
+        r.column< quantity<float, si::pascal> >( "altitude" );
+    }
+    catch ( const std::runtime_error & )
+    {
+        thrown = true;
+    }
+    
+    assert( thrown );
+    thrown = false;
+    
+    try
+    {
+        r.column< quantity<double, si::meter> >( "altitude" );
+    }
+    catch ( const std::runtime_error & )
+    {
+        thrown = true;
+    }
+    
+    assert( thrown );
+    thrown = false;
+    
+    try
+    {
+        r.column< meter_t >( "temperature" );
+    }
+    catch ( const std::out_of_range & )
+    {
+        thrown = true;
+    }
+    
+    assert( thrown );
+}
+
+void test_integral()
+{
+    const std::string int_path = "columnar_int_test.engu";
+    
+    {
+        const quantity<int, si::centimeter> cm[] = { 
+            quantity<int, si::centimeter>( 150 ), 
+            quantity<int, si::centimeter>( 249 ),
+            quantity<int, si::centimeter>( -150 ),
+            quantity<int, si::centimeter>( 25 )
+        };
+        
+        engunits::column_writer w( int_path );
+        w.write( "length", std::begin( cm ), std::end( cm ) );
+    }
+    
+    engunits::column_reader r( int_path );
+    
+    // Down: the factor is 0.01, the values are rounded
+    const auto m = r.column< quantity<int, si::meter> >( "length" );
+    
+    assert( m.needs_conversion() );
+    assert( m[0].value() == 2 && m[1].value() == 2 && m[2].value() == -2 && m[3].value() == 0 );
+    
+    std::vector< quantity<int, si::meter> > out( m.size() );
+    m.convert( out.begin() );
+    assert( out[0] == m[0] && out[2] == m[2] );
+    
+    // Up
+    const auto mm = r.column< quantity<int, si::millimeter> >( "length" );
+    assert( mm[1].value() == 2490 && mm[2].value() == -1500 );
+    
+    std::remove( int_path.c_str() );
+}
+
+int main()
+{
+    write_file();
+    test_directory();
+    test_zero_copy();
+    test_conversion();
+    test_mismatch();
+    test_integral();
+    
+    std::remove( path.c_str() );
+}
@@ -0,0 +1,275 @@
+/*
+ * Boost Software License - Version 1.0 - August 17th, 2003
+ *
+ * Permission is hereby granted, free of charge, to any person or organization
+ * obtaining a copy of the software and accompanying documentation covered by
+ * this license (the "Software") to use, reproduce, display, distribute,
+ * execute, and transmit the Software, and to prepare derivative works of the
+ * Software, and to permit third-parties to whom the Software is furnished to
+ * do so, all subject to the following:
+ *
+ * The copyright notices in the Software and this entire statement, including
+ * the above license grant, this restriction and the following disclaimer,
+ * must be included in all copies of the Software, in whole or in part, and
+ * all derivative works of the Software, unless such copies or derivative
+ * works are solely in the form of machine-executable object code generated by
+ * a source language processor.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+ * SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+ * FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#include <cassert>
+#include <cmath>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <engineering_units/quantity.hpp>
+#include <engineering_units/io/csv.hpp>
+#include <engineering_units/memory/arena.hpp>
+
+#include <engineering_units/si/length.hpp>
+#include <engineering_units/si/pressure.hpp>
+#include <engineering_units/imperial/length.hpp>
+
+namespace si = engunits::si;
+namespace imperial = engunits::imperial;
+
+using engunits::quantity;
+
+using meter_t = quantity<double, si::meter>;
+using feet_t = quantity<float, imperial::foot>;
+using pascal_t = quantity<float, si::pascal>;
+
+const std::string path = "csv_test.csv";
+
+bool close( double x, double y )
+{
+    return std::fabs( x - y ) < 1e-6 * ( 1.0 + std::fabs( y ) );
+}
+
+void write_file( const std::string & contents )
+{
+    std::ofstream out( path, std::ios::binary );
+    out << contents;
+}
+
+void test_header()
+{
+    write_file( "time, altitude [ft], pressure [hPa] ,speed [m/s], flag [furlong]\n" );
+    
+    engunits::csv_reader csv( path );
+    
+    assert( csv.columns() == 5 );
+    assert( csv.name( 0 ) == "time" );
+    assert( csv.name( 1 ) == "altitude" );
+    assert( csv.name( 2 ) == "pressure" );
+    assert( csv.name( 3 ) == "speed" );
+    
+    assert( csv.unit( 0 ).dimensions.empty() );
+    assert( csv.unit( 1 ).symbol == "ft" );
+    assert( csv.unit( 2 ).same_dimensions( engunits::describe_unit( si::pascal() ) ) );
+    assert( close( double( csv.unit( 3 ).scale ), 1.0 ) );
+    
+    bool thrown = false;
+    
+    try
+    {
+        csv.unit( 4 );
+    }
+    catch ( const std::invalid_argument & )
+    {
+        thrown = true;
+    }
+    
+    assert( thrown );
+    
+    // Empty file, no rows
+    assert( csv.read() == 0 );
+}
+
+void test_read()
+{
+    write_file( "time, altitude [ft], pressure [hPa]\r\n"
+                "0.0, 1500, 1013.25\r\n"
+                "\r\n"
+                "0.5, +1502.5, 1013.0\r\n"
+                "1.0,1505,1012.75" );
+    
+    engunits::csv_reader csv( path );
+    
+    std::vector< double > time;
+    std::vector< meter_t > altitude;
+    std::vector< feet_t > feet;
+    std::vector< pascal_t > pressure;
+    
+    csv.bind( "time", time );
+    csv.bind( "altitude", altitude );
+    csv.bind( "pressure", pressure );
+    
+    assert( csv.read() == 3 );
+    
+    assert( time.size() == 3 && time[2] == 1.0 );
+    assert( altitude.size() == 3 );
+    assert( close( altitude[1].value(), 1502.5 * 0.3048 ) );
+    assert( close( pressure[2].value(), 101275.0 ) );
+    
+    // Same unit: no conversion at all
+    csv.bind( "altitude", feet );
+    csv.read();
+    
+    assert( feet[0] == feet_t( 1500.0f ) );
+    
+    // Any allocator
+    engunits::bump_arena arena;
+    engunits::arena_vector< feet_t > in_arena( arena );
+    
+    csv.bind( "altitude", in_arena );
+    csv.read();
+    
+    assert( in_arena.size() == 3 && in_arena[2] == feet_t( 1505.0f ) );
+    assert( arena.used() >= 3 * sizeof(feet_t) );
+}
+
+void test_integral()
+{
+    write_file( "length [mm], count\n"
+                "1500, 7\n"
+                "2499, -3\n"
+                "-1500, 0\n" );
+    
+    engunits::csv_reader csv( path );
+    
+    std::vector< quantity<int, si::meter> > m;
+    std::vector< quantity<long, si::millimeter> > mm;
+    std::vector< int > count;
+    
+    csv.bind( "length", m );
+    csv.bind( "count", count );
+    
+    assert( csv.read() == 3 );
+    
+    // mm to m is 0.001: rounded, not truncated to zero
+    assert( m[0].value() == 2 && m[1].value() == 2 && m[2].value() == -2 );
+    assert( count[0] == 7 && count[1] == -3 );
+    
+    csv.bind( "length", mm );
+    csv.read();
+    
+    assert( mm[1].value() == 2499 );
+}
+
+void test_parallel()
+{
+    std::ostringstream ss;
+    ss << "index, length [km]\n";
+    
+    const int rows = 200000;
+    
+    for ( int i = 0; i < rows; ++i )
+        ss << i << ", " << i * 0.001 << "\n";
+    
+    write_file( ss.str() );
+    
+    engunits::csv_reader csv( path );
+    
+    std::vector< long > index;
+    std::vector< meter_t > length;
+    
+    csv.bind( "index", index );
+    csv.bind( "length", length );
+    
+    // More threads than CPUs, to get several chunks everywhere
+    assert( csv.read( 4 ) == std::size_t( rows ) );
+    
+    for ( int i = 0; i < rows; ++i )
+    {
+        assert( index[i] == i );
+        assert( close( length[i].value(), i * 1.0 ) );
+    }
+}
+
+void test_errors()
+{
+    write_file( "altitude [ft], pressure [hPa]\n1, 2\n3\n" );
+    
+    engunits::csv_reader csv( path );
+    
+    std::vector< pascal_t > wrong;
+    bool thrown = false;
+    
+    try
+    {
+        csv.bind( "altitude", wrong );
+    }
+    catch ( const std::runtime_error & )
+    {
+        thrown = true;
+    }
+    
+    assert( thrown );
+    thrown = false;
+    
+    try
+    {
+        csv.bind( "temperature", wrong );
+    }
+    catch ( const std::out_of_range & )
+    {
+        thrown = true;
+    }
+    
+    assert( thrown );
+    thrown = false;
+    
+    std::vector< pascal_t > pressure;
+    csv.bind( "pressure", pressure );
+    
+    try
+    {
+        csv.read();
+    }
+    catch ( const std::runtime_error & )
+    {
+        thrown = true;
+    }
+    
+    assert( thrown );
+    thrown = false;
+    
+    write_file( "altitude [ft]\n12abc\n" );
+    
+    engunits::csv_reader bad( path );
+    std::vector< feet_t > altitude;
+    bad.bind( "altitude", altitude );
+    
+    try
+    {
+        bad.read();
+    }
+    catch ( const std::runtime_error & )
+    {
+        thrown = true;
+    }
+    
+    assert( thrown );
+}
+
+int main()
+{
+    test_header();
+    test_read();
+    test_integral();
+    test_parallel();
+    test_errors();
+    
+    std::remove( path.c_str() );
+}
@@ -0,0 +1,214 @@
+/*
+ * Boost Software License - Version 1.0 - August 17th, 2003
+ *
+ * Permission is hereby granted, free of charge, to any person or organization
+ * obtaining a copy of the software and accompanying documentation covered by
+ * this license (the "Software") to use, reproduce, display, distribute,
+ * execute, and transmit the Software, and to prepare derivative works of the
+ * Software, and to permit third-parties to whom the Software is furnished to
+ * do so, all subject to the following:
+ *
+ * The copyright notices in the Software and this entire statement, including
+ * the above license grant, this restriction and the following disclaimer,
+ * must be included in all copies of the Software, in whole or in part, and
+ * all derivative works of the Software, unless such copies or derivative
+ * works are solely in the form of machine-executable object code generated by
+ * a source language processor.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+ * SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+ * FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#include <array>
+#include <cassert>
+#include <cmath>
+#include <stdexcept>
+#include <tuple>
+#include <vector>
+
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <engineering_units/quantity.hpp>
+#include <engineering_units/io/serialize.hpp>
+
+#include <engineering_units/si/length.hpp>
+#include <engineering_units/si/pressure.hpp>
+#include <engineering_units/imperial/length.hpp>
+
+namespace si = engunits::si;
+namespace imperial = engunits::imperial;
+
+using engunits::quantity;
+
+using meter_t = quantity<double, si::meter>;
+using feet_t = quantity<double, imperial::foot>;
+using pascal_t = quantity<float, si::pascal>;
+
+bool close( double x, double y )
+{
+    return std::fabs( x - y ) < 1e-9 * ( 1.0 + std::fabs( y ) );
+}
+
+// Send the buffer through a local socket, as between two services
+std::vector<char> transfer( const std::vector<char> & in )
+{
+    int fds[2];
+    const int rc = ::socketpair( AF_UNIX, SOCK_STREAM, 0, fds );
+    assert( rc == 0 );
+    (void) rc;
+    
+    const std::uint64_t n = in.size();
+    assert( ::write( fds[0], &n, sizeof( n ) ) == sizeof( n ) );
+    assert( ::write( fds[0], in.data(), in.size() ) == ssize_t( in.size() ) );
+    
+    std::uint64_t m = 0;
+    assert( ::read( fds[1], &m, sizeof( m ) ) == sizeof( m ) );
+    
+    std::vector<char> out( m );
+    std::size_t got = 0;
+    
+    while ( got < m )
+        got += std::size_t( ::read( fds[1], out.data() + got, m - got ) );
+    
+    ::close( fds[0] );
+    ::close( fds[1] );
+    
+    return out;
+}
+
+void test_schema_hash()
+{
+    using engunits::schema_hash_v;
+    
+    static_assert( schema_hash_v< meter_t > == schema_hash_v< feet_t >, "" );
+    static_assert( schema_hash_v< meter_t > != schema_hash_v< quantity<float, si::meter> >, "" );
+    static_assert( schema_hash_v< meter_t > != schema_hash_v< quantity<double, si::pascal> >, "" );
+}
+
+void test_quantity()
+{
+    const auto buffer = transfer( engunits::serialize( meter_t( 3.0 ) ) );
+    
+    // Header + value
+    assert( buffer.size() == 8 + 8 + 8 );
+    
+    meter_t m;
+    const char * end = engunits::deserialize( buffer.data(), buffer.data() + buffer.size(), m );
+    
+    assert( end == buffer.data() + buffer.size() );
+    assert( m == meter_t( 3.0 ) );
+    
+    // Converted on arrival
+    feet_t f;
+    engunits::deserialize( buffer.data(), buffer.data() + buffer.size(), f );
+    
+    assert( close( f.value(), 3.0 / 0.3048 ) );
+}
+
+void test_integral()
+{
+    const std::vector< quantity<int, si::millimeter> > mm { 
+        quantity<int, si::millimeter>( 1500 ),
+        quantity<int, si::millimeter>( 2499 ),
+        quantity<int, si::millimeter>( -1500 )
+    };
+    
+    const auto buffer = transfer( engunits::serialize( mm ) );
+    
+    // To a coarser unit: rounded, not truncated to zero
+    std::vector< quantity<int, si::meter> > m;
+    engunits::deserialize( buffer.data(), buffer.data() + buffer.size(), m );
+    
+    assert( m.size() == 3 );
+    assert( m[0].value() == 2 && m[1].value() == 2 && m[2].value() == -2 );
+    
+    // Same unit: unchanged
+    std::vector< quantity<int, si::millimeter> > same;
+    engunits::deserialize( buffer.data(), buffer.data() + buffer.size(), same );
+    
+    assert( same == mm );
+}
+
+void test_aggregate()
+{
+    std::vector< pascal_t > pressure;
+    
+    for ( int i = 0; i < 1000; ++i )
+        pressure.emplace_back( 101325.0f - i );
+    
+    const std::array< meter_t, 3 > position { { meter_t( 1.0 ), meter_t( 2.0 ), meter_t( 3.0 ) } };
+    
+    const auto buffer = transfer( engunits::serialize( 
+        std::make_tuple( position, pressure, std::make_pair( meter_t( 5.0 ), pascal_t( 1.0f ) ) ) ) );
+    
+    std::tuple< std::array< feet_t, 3 >, 
+                std::vector< pascal_t >, 
+                std::pair< meter_t, pascal_t > > msg;
+    
+    engunits::deserialize( buffer.data(), buffer.data() + buffer.size(), msg );
+    
+    assert( close( std::get<0>( msg )[2].value(), 3.0 / 0.3048 ) );
+    assert( std::get<1>( msg ) == pressure );
+    assert( std::get<2>( msg ).first == meter_t( 5.0 ) );
+    assert( std::get<2>( msg ).second == pascal_t( 1.0f ) );
+}
+
+void test_errors()
+{
+    const auto buffer = engunits::serialize( meter_t( 3.0 ) );
+    
+    bool thrown = false;
+    
+    try
+    {
+        quantity<double, si::pascal> p;
+        engunits::deserialize( buffer.data(), buffer.data() + buffer.size(), p );
+    }
+    catch ( const std::runtime_error & )
+    {
+        thrown = true;
+    }
+    
+    assert( thrown );
+    thrown = false;
+    
+    try
+    {
+        meter_t m;
+        engunits::deserialize( buffer.data(), buffer.data() + buffer.size() - 1, m );
+    }
+    catch ( const std::runtime_error & )
+    {
+        thrown = true;
+    }
+    
+    assert( thrown );
+    thrown = false;
+    
+    try
+    {
+        std::array< meter_t, 2 > a;
+        engunits::deserialize( buffer.data(), buffer.data() + buffer.size(), a );
+    }
+    catch ( const std::runtime_error & )
+    {
+        thrown = true;
+    }
+    
+    assert( thrown );
+}
+
+int main()
+{
+    test_schema_hash();
+    test_quantity();
+    test_integral();
+    test_aggregate();
+    test_errors();
+}
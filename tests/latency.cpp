@@ -0,0 +1,162 @@
+/*
+ * Boost Software License - Version 1.0 - August 17th, 2003
+ *
+ * Permission is hereby granted, free of charge, to any person or organization
+ * obtaining a copy of the software and accompanying documentation covered by
+ * this license (the "Software") to use, reproduce, display, distribute,
+ * execute, and transmit the Software, and to prepare derivative works of the
+ * Software, and to permit third-parties to whom the Software is furnished to
+ * do so, all subject to the following:
+ *
+ * The copyright notices in the Software and this entire statement, including
+ * the above license grant, this restriction and the following disclaimer,
+ * must be included in all copies of the Software, in whole or in part, and
+ * all derivative works of the Software, unless such copies or derivative
+ * works are solely in the form of machine-executable object code generated by
+ * a source language processor.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+ * SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+ * FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#include <cassert>
+#include <cstdint>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <engineering_units/latency.hpp>
+
+using engunits::latency_histogram;
+using engunits::latency_site;
+using engunits::latency_snapshot;
+using engunits::tick_clock;
+
+void test_buckets()
+{
+    for ( std::uint64_t v : { 0ull, 1ull, 31ull, 32ull, 33ull, 63ull, 64ull, 65ull, 1000ull, 123456789ull, ~0ull } )
+    {
+        const std::size_t i = latency_histogram::index( v );
+        
+        assert( i < latency_histogram::buckets );
+        assert( latency_histogram::lower( i ) <= v );
+        assert( v - latency_histogram::lower( i ) < latency_histogram::width( i ) );
+    }
+    
+    // Contiguous buckets
+    for ( std::size_t i = 0; i + 1 < latency_histogram::buckets; ++i )
+    {
+        assert( latency_histogram::lower( i ) + latency_histogram::width( i ) == latency_histogram::lower( i + 1 ) );
+        assert( latency_histogram::index( latency_histogram::lower( i ) ) == i );
+    }
+    
+    assert( latency_histogram::index( ~0ull ) == latency_histogram::buckets - 1 );
+}
+
+void test_percentiles()
+{
+    latency_histogram h;
+    
+    for ( std::uint64_t v = 1; v <= 10000; ++v )
+        h.record( v );
+    
+    assert( h.sum() == 10000ull * 10001 / 2 );
+    assert( h.max() == 10000 );
+    
+    latency_snapshot s( "uniform", engunits::quantity<double, engunits::second>( 1.0 ) );
+    s.merge( h );
+    s.merge( h );
+    
+    assert( s.count() == 20000 );
+    assert( s.max().value() == 10000.0 );
+    assert( s.mean().value() == 5000.5 );
+    
+    const double tolerance = 1.0 / latency_histogram::sub_buckets;
+    
+    for ( double p : { 0.01, 0.25, 0.5, 0.9, 0.99 } )
+    {
+        const double expected = p * 10000;
+        assert( std::abs( s.percentile( p ).value() - expected ) <= tolerance * expected );
+    }
+    
+    assert( s.percentile( 0.0 ).value() == 1.0 );
+    assert( s.percentile( 1.0 ).value() <= 10000.0 );
+}
+
+void work()
+{
+    ENGUNITS_SCOPED_LATENCY( "work" );
+    std::this_thread::sleep_for( std::chrono::microseconds( 100 ) );
+}
+
+void test_sites()
+{
+    static latency_site site( "site" );
+    
+    std::vector<std::thread> threads;
+    
+    for ( int t = 0; t < 4; ++t )
+        threads.emplace_back( [] {
+            for ( std::uint64_t i = 0; i < 1000; ++i )
+                site.record( i );
+        } );
+    
+    for ( auto & t : threads )
+        t.join();
+    
+    // Histograms of finished threads are still there
+    const latency_snapshot s = site.snapshot();
+    
+    assert( s.name() == "site" );
+    assert( s.count() == 4000 );
+    assert( s.max() == tick_clock::period() * 999.0 );
+    
+    for ( int i = 0; i < 10; ++i )
+        work();
+    
+    bool found = false;
+    
+    for ( const latency_snapshot & w : engunits::latency_snapshots() )
+    {
+        if ( w.name() != "work" )
+            continue;
+        
+        found = true;
+        
+        assert( w.count() == 10 );
+        assert( w.percentile( 0.5 ).value() >= 100e-6 * ( 1 - 1.0 / latency_histogram::sub_buckets ) );
+        assert( w.max().value() < 1.0 );
+        
+        std::ostringstream os;
+        os << w;
+        assert( os.str().find( "work: count=10 mean=" ) == 0 );
+        assert( os.str().find( "us p50=" ) != std::string::npos );
+    }
+    
+    assert( found );
+}
+
+void test_clock()
+{
+    const std::uint64_t t0 = tick_clock::now();
+    std::this_thread::sleep_for( std::chrono::milliseconds( 20 ) );
+    const std::uint64_t t1 = tick_clock::now();
+    
+    const double elapsed = ( tick_clock::period() * double( t1 - t0 ) ).value();
+    
+    assert( elapsed >= 0.019 && elapsed < 1.0 );
+}
+
+int main()
+{
+    test_buckets();
+    test_percentiles();
+    test_sites();
+    test_clock();
+}
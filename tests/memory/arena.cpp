@@ -0,0 +1,231 @@
+/*
+ * Boost Software License - Version 1.0 - August 17th, 2003
+ *
+ * Permission is hereby granted, free of charge, to any person or organization
+ * obtaining a copy of the software and accompanying documentation covered by
+ * this license (the "Software") to use, reproduce, display, distribute,
+ * execute, and transmit the Software, and to prepare derivative works of the
+ * Software, and to permit third-parties to whom the Software is furnished to
+ * do so, all subject to the following:
+ *
+ * The copyright notices in the Software and this entire statement, including
+ * the above license grant, this restriction and the following disclaimer,
+ * must be included in all copies of the Software, in whole or in part, and
+ * all derivative works of the Software, unless such copies or derivative
+ * works are solely in the form of machine-executable object code generated by
+ * a source language processor.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+ * SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+ * FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#include <cassert>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include <engineering_units/quantity.hpp>
+#include <engineering_units/memory/arena.hpp>
+#include <engineering_units/algorithm/sort.hpp>
+#include <engineering_units/container/flat_hash_map.hpp>
+#include <engineering_units/numeric/histogram.hpp>
+
+#include <engineering_units/si/length.hpp>
+
+namespace si = engunits::si;
+
+using engunits::quantity;
+using engunits::bump_arena;
+using engunits::arena_allocator;
+using engunits::arena_vector;
+
+using meter_t = quantity<float, si::meter>;
+using mm_t = quantity<std::int64_t, si::millimeter>;
+
+bool aligned( const void * p, std::size_t alignment )
+{
+    return reinterpret_cast<std::uintptr_t>( p ) % alignment == 0;
+}
+
+void test_arena()
+{
+    bump_arena arena( 1024 );
+    
+    assert( arena.capacity() == 1024 && arena.used() == 0 );
+    
+    void * a = arena.allocate( 3, 1 );
+    void * b = arena.allocate( 8, 8 );
+    void * c = arena.allocate( 64, 64 );
+    
+    assert( static_cast<char*>( b ) >= static_cast<char*>( a ) + 3 );
+    assert( aligned( b, 8 ) && aligned( c, 64 ) );
+    assert( arena.used() >= 75 && arena.used() <= 1024 );
+    
+    // Grow past the first block
+    void * d = arena.allocate( 4000 );
+    assert( d != nullptr && aligned( d, alignof(std::max_align_t) ) );
+    assert( arena.capacity() > 1024 );
+    assert( arena.used() >= 4075 );
+    
+    // Blocks are merged, and the same frame does not grow any more
+    const std::size_t capacity = arena.capacity();
+    arena.reset();
+    
+    assert( arena.used() == 0 );
+    assert( arena.capacity() == capacity );
+    
+    for ( int frame = 0; frame < 3; ++frame )
+    {
+        arena.allocate( 3, 1 );
+        arena.allocate( 8, 8 );
+        arena.allocate( 64, 64 );
+        arena.allocate( 4000 );
+        
+        assert( arena.capacity() == capacity );
+        arena.reset();
+    }
+}
+
+void test_containers()
+{
+    bump_arena arena;
+    
+    arena_vector< meter_t > v( arena );
+    
+    for ( int i = 0; i < 1000; ++i )
+        v.push_back( meter_t( float( i ) ) );
+    
+    assert( v.size() == 1000 && v[999] == meter_t( 999.0f ) );
+    assert( arena.used() >= 1000 * sizeof(meter_t) );
+    
+    engunits::flat_hash_map< mm_t, int, std::hash<mm_t>, std::equal_to<mm_t>,
+                             arena_allocator< std::pair<mm_t, int> > > map( arena );
+    
+    for ( int i = 0; i < 100; ++i )
+        map[ mm_t( i * 10 ) ] = i;
+    
+    assert( map.size() == 100 && map.at( mm_t( 990 ) ) == 99 );
+    assert( &map.get_allocator().arena() == &arena );
+    
+    map.erase( mm_t( 0 ) );
+    assert( !map.contains( mm_t( 0 ) ) && map.size() == 99 );
+}
+
+void test_sort()
+{
+    std::mt19937 gen( 42 );
+    std::uniform_real_distribution<float> dist( -1000.0f, 1000.0f );
+    
+    std::vector< meter_t > x( 5000 );
+    std::vector< int > index( x.size() );
+    
+    for ( std::size_t i = 0; i < x.size(); ++i )
+    {
+        x[i] = meter_t( dist( gen ) );
+        index[i] = int( i );
+    }
+    
+    std::vector< meter_t > expected = x;
+    engunits::sort( expected );
+    
+    bump_arena arena;
+    
+    std::vector< meter_t > y = x;
+    engunits::sort( y, arena_allocator<char>( arena ) );
+    
+    assert( y == expected );
+    assert( arena.used() >= 2 * x.size() * sizeof(float) );
+    
+    // Once the arena is large enough, sorting does not allocate any block
+    arena.reset();
+    const std::size_t capacity = arena.capacity();
+    
+    std::vector< meter_t > z = x;
+    engunits::stable_sort( z.data(), z.data() + z.size(), arena_allocator<char>( arena ) );
+    
+    assert( z == expected );
+    assert( arena.capacity() == capacity );
+    
+    arena.reset();
+    
+    std::vector< meter_t > keys = x;
+    engunits::sort_by_key( keys, index, arena_allocator<char>( arena ) );
+    
+    assert( keys == expected );
+    
+    for ( std::size_t i = 0; i < x.size(); ++i )
+        assert( x[ index[i] ] == keys[i] );
+}
+
+void test_histogram()
+{
+    std::mt19937 gen( 42 );
+    std::uniform_real_distribution<float> dist( -1000.0f, 1000.0f );
+    
+    std::vector< meter_t > x( 300000 );
+    
+    for ( auto & v : x )
+        v = meter_t( dist( gen ) );
+    
+    engunits::histogram< meter_t > expected( meter_t( -1000.0f ), meter_t( 1000.0f ), 100 );
+    expected.push( x.begin(), x.end() );
+    
+    bump_arena arena;
+    
+    engunits::histogram< meter_t > h( meter_t( -1000.0f ), meter_t( 1000.0f ), 100 );
+    h.push_parallel( x.begin(), x.end(), arena_allocator<char>( arena ), 4 );
+    
+    // The counters of the three other threads
+    assert( arena.used() >= 3 * 102 * sizeof(std::size_t) );
+    assert( h.total() == expected.total() );
+    
+    for ( std::size_t i = 0; i < h.bins(); ++i )
+        assert( h.count( i ) == expected.count( i ) );
+}
+
+#if defined(ENGUNITS_HAS_MEMORY_RESOURCE)
+
+void test_pmr()
+{
+    bump_arena arena( 256 );
+    
+    std::pmr::vector< meter_t > v( &arena );
+    v.assign( 100, meter_t( 1.0f ) );
+    
+    assert( arena.used() >= 100 * sizeof(meter_t) );
+    
+    // The arena as upstream of the standard resources
+    std::pmr::unsynchronized_pool_resource pool( &arena );
+    engunits::pmr::flat_hash_map< mm_t, int > map( &pool );
+    
+    for ( int i = 0; i < 100; ++i )
+        map[ mm_t( i ) ] = i;
+    
+    assert( map.size() == 100 && map.at( mm_t( 42 ) ) == 42 );
+    
+    std::pmr::monotonic_buffer_resource frame( &arena );
+    std::vector< meter_t > x( 1000, meter_t( 2.0f ) );
+    x[10] = meter_t( -1.0f );
+    
+    engunits::sort( x, std::pmr::polymorphic_allocator<char>( &frame ) );
+    assert( x[0] == meter_t( -1.0f ) && x[999] == meter_t( 2.0f ) );
+}
+
+#endif
+
+int main()
+{
+    test_arena();
+    test_containers();
+    test_sort();
+    test_histogram();
+    
+#if defined(ENGUNITS_HAS_MEMORY_RESOURCE)
+    test_pmr();
+#endif
+}
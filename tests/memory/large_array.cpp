@@ -0,0 +1,121 @@
+/*
+ * Boost Software License - Version 1.0 - August 17th, 2003
+ *
+ * Permission is hereby granted, free of charge, to any person or organization
+ * obtaining a copy of the software and accompanying documentation covered by
+ * this license (the "Software") to use, reproduce, display, distribute,
+ * execute, and transmit the Software, and to prepare derivative works of the
+ * Software, and to permit third-parties to whom the Software is furnished to
+ * do so, all subject to the following:
+ *
+ * The copyright notices in the Software and this entire statement, including
+ * the above license grant, this restriction and the following disclaimer,
+ * must be included in all copies of the Software, in whole or in part, and
+ * all derivative works of the Software, unless such copies or derivative
+ * works are solely in the form of machine-executable object code generated by
+ * a source language processor.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+ * SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+ * FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#include <cassert>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include <engineering_units/quantity.hpp>
+#include <engineering_units/memory/large_array.hpp>
+
+#include <engineering_units/si/pressure.hpp>
+
+namespace si = engunits::si;
+
+using engunits::quantity;
+using engunits::aligned_allocator;
+using engunits::large_array;
+using engunits::huge_pages;
+
+using pascal_t = quantity<double, si::pascal>;
+
+bool aligned( const void * p, std::size_t alignment )
+{
+    return reinterpret_cast<std::uintptr_t>( p ) % alignment == 0;
+}
+
+void test_aligned_allocator()
+{
+    for ( std::size_t n : { 1, 3, 100, 1000 } )
+    {
+        std::vector< pascal_t, aligned_allocator<pascal_t> > v( n, pascal_t( 1.0 ) );
+        assert( aligned( v.data(), 64 ) );
+        
+        std::vector< pascal_t, aligned_allocator<pascal_t, 8> > w( n );
+        assert( aligned( w.data(), 8 ) );
+        
+        std::vector< pascal_t, aligned_allocator<pascal_t, 4096> > x( v.begin(), v.end() );
+        assert( aligned( x.data(), 4096 ) && x.back() == pascal_t( 1.0 ) );
+        
+        x.push_back( pascal_t( 2.0 ) );
+        assert( aligned( x.data(), 4096 ) && x.back() == pascal_t( 2.0 ) );
+    }
+    
+    static_assert( std::is_same< std::allocator_traits< aligned_allocator<double, 128> >::rebind_alloc<char>,
+                                 aligned_allocator<char, 128> >::value, "" );
+}
+
+void test_large_array()
+{
+    large_array<pascal_t> empty;
+    assert( empty.empty() && empty.begin() == empty.end() );
+    
+    for ( huge_pages pages : { huge_pages::none, huge_pages::transparent, huge_pages::reserved } )
+    {
+        // Large enough to be touched by several threads
+        const std::size_t n = 3 * 1024 * 1024 + 7;
+        
+        large_array<pascal_t> a( n, pascal_t( 101325.0 ), pages, 4 );
+        
+        assert( a.size() == n );
+        assert( aligned( a.data(), 64 ) );
+        
+#ifdef ENGUNITS_HAS_MMAP
+        assert( aligned( a.data(), 2 << 20 ) );
+        
+        if ( pages == huge_pages::none )
+            assert( a.pages() == huge_pages::none );
+        else
+            assert( a.pages() != huge_pages::none );
+#endif
+        
+        for ( std::size_t i = 0; i < n; i += 4099 )
+            assert( a[i] == pascal_t( 101325.0 ) );
+        
+        assert( a[ n - 1 ] == pascal_t( 101325.0 ) );
+        
+        a[ n - 1 ] = pascal_t( 0.0 );
+        
+        large_array<pascal_t> b( std::move( a ) );
+        assert( a.empty() && b.size() == n && b[ n - 1 ] == pascal_t( 0.0 ) );
+        
+        a = std::move( b );
+        assert( a.size() == n && b.empty() );
+    }
+    
+    // Value initialized
+    large_array<pascal_t> z( 1000, huge_pages::none );
+    
+    for ( const pascal_t & x : z )
+        assert( x == pascal_t( 0.0 ) );
+}
+
+int main()
+{
+    test_aligned_allocator();
+    test_large_array();
+}
@@ -0,0 +1,182 @@
+/*
+ * Boost Software License - Version 1.0 - August 17th, 2003
+ *
+ * Permission is hereby granted, free of charge, to any person or organization
+ * obtaining a copy of the software and accompanying documentation covered by
+ * this license (the "Software") to use, reproduce, display, distribute,
+ * execute, and transmit the Software, and to prepare derivative works of the
+ * Software, and to permit third-parties to whom the Software is furnished to
+ * do so, all subject to the following:
+ *
+ * The copyright notices in the Software and this entire statement, including
+ * the above license grant, this restriction and the following disclaimer,
+ * must be included in all copies of the Software, in whole or in part, and
+ * all derivative works of the Software, unless such copies or derivative
+ * works are solely in the form of machine-executable object code generated by
+ * a source language processor.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+ * SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+ * FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <stdexcept>
+#include <vector>
+
+#include <engineering_units/quantity.hpp>
+#include <engineering_units/memory/numa.hpp>
+
+#include <engineering_units/si/pressure.hpp>
+
+namespace si = engunits::si;
+
+using engunits::quantity;
+using engunits::numa_topology;
+using engunits::numa_executor;
+using engunits::partitioned_array;
+
+using pascal_t = quantity<double, si::pascal>;
+using hpa_t = quantity<double, si::hectopascal>;
+
+void test_topology()
+{
+    const std::vector<unsigned> cpus = engunits::detail::parse_cpu_list( "0-3,8,10-11" );
+    assert(( cpus == std::vector<unsigned>{ 0, 1, 2, 3, 8, 10, 11 } ));
+    assert( engunits::detail::parse_cpu_list( "" ).empty() );
+    
+    const numa_topology & system = numa_topology::system();
+    
+    assert( system.nodes() >= 1 );
+    
+    for ( unsigned n = 0; n < system.nodes(); ++n )
+        assert( !system.node( n ).cpus.empty() );
+}
+
+// Three nodes on the CPUs of the first real one: only the first can be bound
+numa_topology fake_topology()
+{
+    const std::vector<unsigned> & cpus = numa_topology::system().node( 0 ).cpus;
+    
+    return numa_topology( { { 0, cpus }, { 1, cpus }, { 2, cpus } } );
+}
+
+void test_executor()
+{
+    numa_executor executor( 2, fake_topology() );
+    
+    assert( executor.workers() == 6 );
+    assert( executor.workers( 1 ) == 2 && executor.first_worker( 2 ) == 4 );
+    
+    std::vector<int> calls( executor.workers(), 0 );
+    
+    for ( int round = 0; round < 3; ++round )
+        executor.run( [&]( unsigned node, unsigned worker, unsigned workers )
+        {
+            assert( workers == 2 );
+            ++calls[ executor.first_worker( node ) + worker ];
+        } );
+    
+    for ( int c : calls )
+        assert( c == 3 );
+    
+    bool thrown = false;
+    
+    try
+    {
+        executor.run( []( unsigned node, unsigned, unsigned )
+        {
+            if ( node == 1 )
+                throw std::runtime_error( "node 1" );
+        } );
+    }
+    catch ( const std::runtime_error & )
+    {
+        thrown = true;
+    }
+    
+    assert( thrown );
+}
+
+void test_partitioned_array()
+{
+    numa_executor executor( 2, fake_topology() );
+    
+    const std::size_t n = 1000003;
+    
+    partitioned_array<pascal_t> p( executor, n, pascal_t( 100000.0 ) );
+    partitioned_array<hpa_t> b( executor, n );
+    
+    assert( p.size() == n && p.partitions() == 3 );
+    assert( p.size( 0 ) + p.size( 1 ) + p.size( 2 ) == n );
+    assert( p.offset( 1 ) == p.size( 0 ) && p.offset( 2 ) == p.size( 0 ) + p.size( 1 ) );
+    assert( &p[ p.offset( 2 ) ] == p.data( 2 ) );
+    
+    for ( std::size_t i = 0; i < n; i += 997 )
+        p[i] = pascal_t( double( i ) );
+    
+    engunits::transform( executor, p, b, []( pascal_t x ) { return hpa_t( x ); } );
+    
+    assert( b[0] == hpa_t( 0.0 ) );
+    assert( std::abs( b[1].value() - 1000.0 ) < 1e-9 );
+    assert( b[997] == hpa_t( pascal_t( 997.0 ) ) );
+    assert( std::abs( b[ n - 1 ].value() - 1000.0 ) < 1e-9 );
+    
+    // Sum, in the units of the result
+    const hpa_t total = engunits::transform_reduce( executor, b, hpa_t( 0.0 ),
+                                                    []( hpa_t x, hpa_t y ) { return x + y; },
+                                                    []( hpa_t x ) { return x; } );
+    
+    double expected = 0.0;
+    
+    for ( std::size_t i = 0; i < n; ++i )
+        expected += b[i].value();
+    
+    assert( std::abs( total.value() - expected ) < 1e-9 * expected );
+    
+    // The partial results are reduced in order
+    partitioned_array<std::size_t> index( executor, n );
+    
+    for ( std::size_t i = 0; i < n; ++i )
+        index[i] = i;
+    
+    const std::size_t last = engunits::transform_reduce( executor, index, std::size_t( 0 ),
+                                                         []( std::size_t, std::size_t y ) { return y; },
+                                                         []( std::size_t i ) { return i; } );
+    assert( last == n - 1 );
+    
+    // Fewer elements than workers
+    partitioned_array<pascal_t> small( executor, 4, pascal_t( 1.0 ) );
+    assert( small.size( 0 ) == 2 && small.size( 1 ) == 2 && small.size( 2 ) == 0 );
+    
+    const pascal_t sum = engunits::transform_reduce( executor, small, pascal_t( 10.0 ),
+                                                     []( pascal_t x, pascal_t y ) { return x + y; },
+                                                     []( pascal_t x ) { return x; } );
+    assert( sum == pascal_t( 14.0 ) );
+}
+
+void test_system()
+{
+    numa_executor executor;
+    
+    partitioned_array<pascal_t> p( executor, 100000, pascal_t( 2.0 ) );
+    
+    const pascal_t sum = engunits::transform_reduce( executor, p, pascal_t( 0.0 ),
+                                                     []( pascal_t x, pascal_t y ) { return x + y; },
+                                                     []( pascal_t x ) { return x; } );
+    assert( sum == pascal_t( 200000.0 ) );
+}
+
+int main()
+{
+    test_topology();
+    test_executor();
+    test_partitioned_array();
+    test_system();
+}
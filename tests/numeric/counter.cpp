@@ -0,0 +1,142 @@
+/*
+ * Boost Software License - Version 1.0 - August 17th, 2003
+ *
+ * Permission is hereby granted, free of charge, to any person or organization
+ * obtaining a copy of the software and accompanying documentation covered by
+ * this license (the "Software") to use, reproduce, display, distribute,
+ * execute, and transmit the Software, and to prepare derivative works of the
+ * Software, and to permit third-parties to whom the Software is furnished to
+ * do so, all subject to the following:
+ *
+ * The copyright notices in the Software and this entire statement, including
+ * the above license grant, this restriction and the following disclaimer,
+ * must be included in all copies of the Software, in whole or in part, and
+ * all derivative works of the Software, unless such copies or derivative
+ * works are solely in the form of machine-executable object code generated by
+ * a source language processor.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+ * SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+ * FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#include <cassert>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <sstream>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#include <engineering_units/quantity.hpp>
+#include <engineering_units/io.hpp>
+#include <engineering_units/numeric/counter.hpp>
+
+#include <engineering_units/information.hpp>
+#include <engineering_units/time.hpp>
+
+using namespace engunits::literals;
+
+using engunits::quantity;
+using engunits::sharded_counter;
+using engunits::count;
+using engunits::byte;
+using engunits::kibibyte;
+using engunits::mebibyte;
+using engunits::gibibyte;
+using engunits::second;
+using engunits::second_;
+using engunits::minute_;
+
+using bytes_t = quantity<std::uint64_t, byte>;
+using events_t = quantity<std::uint64_t, count>;
+
+void test_units()
+{
+    static_assert( engunits::conversion_factor( gibibyte(), byte() ) == 1073741824.0L, "" );
+    
+    assert( bytes_t( quantity<int, kibibyte>( 3 ) ).value() == 3072 );
+    assert( ( quantity<double, mebibyte>( 2048.0_B * 1024.0 ).value() == 2.0 ) );
+    
+    // Different dimensions
+    static_assert( !std::is_constructible< bytes_t, events_t >::value, "" );
+    
+    std::ostringstream os;
+    os << quantity<double, kibibyte, second_<-1> >( 4.0 ) << " " << 3.0_ct;
+    assert( os.str() == "4KiB s^-1 3ct" );
+}
+
+void test_counter()
+{
+    sharded_counter<bytes_t> c( 3 );
+    
+    assert( c.shards() == 4 );
+    assert( c.load().value() == 0 );
+    
+    c += bytes_t( 10 );
+    c.add( quantity<int, kibibyte>( 1 ) );
+    ++c;
+    
+    assert( c.load().value() == 1035 );
+    
+    sharded_counter< quantity<double, count> > f( 1 );
+    f += quantity<double, count>( 0.5 );
+    f += quantity<double, count>( 0.25 );
+    
+    assert( f.load().value() == 0.75 );
+}
+
+void test_threads()
+{
+    sharded_counter<events_t> c;
+    
+    std::vector<std::thread> threads;
+    
+    for ( int t = 0; t < 8; ++t )
+        threads.emplace_back( [&c] {
+            for ( int i = 0; i < 100000; ++i )
+                ++c;
+        } );
+    
+    for ( auto & t : threads )
+        t.join();
+    
+    assert( c.load().value() == 800000 );
+}
+
+void test_rate()
+{
+    sharded_counter<bytes_t> c( 1 );
+    
+    const auto before = c.snapshot();
+    c += quantity<int, mebibyte>( 1 );
+    std::this_thread::sleep_for( std::chrono::milliseconds( 50 ) );
+    const auto after = c.snapshot();
+    
+    const auto r = rate( before, after );
+    static_assert( std::is_same< std::decay_t<decltype(r)>, sharded_counter<bytes_t>::rate_type >::value, "" );
+    
+    const quantity<double, mebibyte, second_<-1> > mibps( r );
+    assert( mibps.value() > 1.0 && mibps.value() <= 20.0 );
+    
+    sharded_counter<events_t> e( 1 );
+    const engunits::counter_snapshot<events_t> t0 { events_t( 0 ), std::chrono::steady_clock::time_point() };
+    const engunits::counter_snapshot<events_t> t1 { events_t( 30 ), t0.time + std::chrono::seconds( 2 ) };
+    
+    // Events per minute
+    const quantity<double, count, minute_<-1> > per_minute( rate( t0, t1 ) );
+    assert( std::abs( per_minute.value() - 900.0 ) < 1e-9 );
+}
+
+int main()
+{
+    test_units();
+    test_counter();
+    test_threads();
+    test_rate();
+}
@@ -0,0 +1,94 @@
+/*
+ * Boost Software License - Version 1.0 - August 17th, 2003
+ *
+ * Permission is hereby granted, free of charge, to any person or organization
+ * obtaining a copy of the software and accompanying documentation covered by
+ * this license (the "Software") to use, reproduce, display, distribute,
+ * execute, and transmit the Software, and to prepare derivative works of the
+ * Software, and to permit third-parties to whom the Software is furnished to
+ * do so, all subject to the following:
+ *
+ * The copyright notices in the Software and this entire statement, including
+ * the above license grant, this restriction and the following disclaimer,
+ * must be included in all copies of the Software, in whole or in part, and
+ * all derivative works of the Software, unless such copies or derivative
+ * works are solely in the form of machine-executable object code generated by
+ * a source language processor.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+ * SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+ * FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#include <cassert>
+#include <cmath>
+#include <vector>
+
+#include <engineering_units/quantity.hpp>
+#include <engineering_units/numeric/differentiation.hpp>
+
+#include <engineering_units/time.hpp>
+#include <engineering_units/si/length.hpp>
+
+namespace si = engunits::si;
+using namespace si::literals;
+using namespace engunits::literals;
+
+using engunits::quantity;
+using engunits::second;
+using engunits::second_;
+
+using time_t_ = quantity<double, second>;
+using length_t = quantity<double, si::meter>;
+using velocity_t = quantity<double, si::meter, second_<-1> >;
+
+void test_uniform()
+{
+    // x(t) = t^2 m/s^2
+    std::vector< length_t > x;
+    
+    for ( int i = 0; i < 11; ++i )
+        x.emplace_back( 0.01 * i * i );
+    
+    std::vector< velocity_t > v( x.size() );
+    
+    const auto end = engunits::gradient( x.begin(), x.end(), 0.1_s, v.begin() );
+    
+    assert( end == v.end() );
+    
+    // Central differences are exact on parabolas
+    for ( std::size_t i = 1; i + 1 < v.size(); ++i )
+        assert( std::fabs( v[i].value() - 0.2 * i ) < 1e-12 );
+    
+    assert( std::fabs( v.front().value() - 0.1 ) < 1e-12 );
+    assert( std::fabs( v.back().value() - 1.9 ) < 1e-12 );
+    
+    // Less than two samples: nothing written
+    assert( engunits::gradient( x.begin(), x.begin() + 1, 0.1_s, v.begin() ) == v.begin() );
+}
+
+void test_non_uniform()
+{
+    std::vector< time_t_ > t { 0.0_s, 0.1_s, 0.5_s, 0.7_s, 1.5_s, 2.0_s };
+    std::vector< length_t > x;
+    
+    for ( auto ti : t )
+        x.emplace_back( ti.value() * ti.value() );
+    
+    std::vector< velocity_t > v( x.size() );
+    
+    engunits::gradient( t.begin(), t.end(), x.begin(), v.begin() );
+    
+    for ( std::size_t i = 1; i + 1 < v.size(); ++i )
+        assert( std::fabs( v[i].value() - 2.0 * t[i].value() ) < 1e-12 );
+}
+
+int main()
+{
+    test_uniform();
+    test_non_uniform();
+}
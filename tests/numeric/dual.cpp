@@ -0,0 +1,222 @@
+/*
+ * Boost Software License - Version 1.0 - August 17th, 2003
+ *
+ * Permission is hereby granted, free of charge, to any person or organization
+ * obtaining a copy of the software and accompanying documentation covered by
+ * this license (the "Software") to use, reproduce, display, distribute,
+ * execute, and transmit the Software, and to prepare derivative works of the
+ * Software, and to permit third-parties to whom the Software is furnished to
+ * do so, all subject to the following:
+ *
+ * The copyright notices in the Software and this entire statement, including
+ * the above license grant, this restriction and the following disclaimer,
+ * must be included in all copies of the Software, in whole or in part, and
+ * all derivative works of the Software, unless such copies or derivative
+ * works are solely in the form of machine-executable object code generated by
+ * a source language processor.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+ * SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+ * FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#include <cassert>
+#include <cmath>
+#include <sstream>
+#include <tuple>
+#include <type_traits>
+
+#include <engineering_units/quantity.hpp>
+#include <engineering_units/angle.hpp>
+#include <engineering_units/io.hpp>
+#include <engineering_units/numeric/dual.hpp>
+
+#include <engineering_units/si/length.hpp>
+#include <engineering_units/si/pressure.hpp>
+
+namespace si = engunits::si;
+
+using engunits::quantity;
+using engunits::dual;
+using engunits::radian;
+
+using namespace si::literals;
+
+typedef dual<double> d_t;
+
+bool close( double a, double b, double tol = 1e-12 )
+{
+    return std::abs( a - b ) <= tol * std::max( 1.0, std::abs( b ) );
+}
+
+void test_arithmetic()
+{
+    const d_t x = d_t::variable( 2.0 );
+    
+    const d_t y = x * x * x - 2.0 * x + 1.0;
+    assert( y.value() == 5.0 );
+    assert( y.derivative() == 10.0 );
+    
+    const d_t q = 1.0 / x + x / ( x + 1.0 );
+    assert( close( q.value(), 0.5 + 2.0 / 3.0 ) );
+    assert( close( q.derivative(), -0.25 + 1.0 / 9.0 ) );
+    
+    d_t z = x;
+    z *= x;
+    z -= 1.0;
+    z /= x;
+    assert( close( z.value(), 1.5 ) );
+    assert( close( z.derivative(), 1.25 ) );
+    
+    assert( -x < x && x == 2.0 && x != 3.0 );
+    
+    const d_t c = 4.0;
+    assert( c.value() == 4.0 && c.derivative() == 0.0 );
+    
+    std::ostringstream os;
+    os << x;
+    assert( os.str() == "(2; 1)" );
+}
+
+void test_math_functions()
+{
+    const double v = 0.7;
+    const d_t x = d_t::variable( v );
+    
+    assert( close( sqrt( x ).derivative(), 0.5 / std::sqrt( v ) ) );
+    assert( close( cbrt( x ).derivative(), 1.0 / ( 3.0 * std::cbrt( v * v ) ) ) );
+    assert( close( exp( x ).derivative(), std::exp( v ) ) );
+    assert( close( log( x ).derivative(), 1.0 / v ) );
+    assert( close( sin( x ).derivative(), std::cos( v ) ) );
+    assert( close( cos( x ).derivative(), -std::sin( v ) ) );
+    assert( close( tan( x ).derivative(), 1.0 / ( std::cos( v ) * std::cos( v ) ) ) );
+    assert( close( pow( x, 3 ).derivative(), 3.0 * v * v ) );
+    assert( close( pow( x, 2.5 ).derivative(), 2.5 * std::pow( v, 1.5 ) ) );
+    assert( close( pow( x, x ).derivative(), std::pow( v, v ) * ( std::log( v ) + 1.0 ) ) );
+    assert( close( abs( -x ).derivative(), 1.0 ) );
+    assert( close( fabs( x - 1.0 ).derivative(), -1.0 ) );
+    assert( close( fmax( x, d_t( 0.5 ) ).derivative(), 1.0 ) );
+    assert( close( fmin( x, d_t( 0.5 ) ).derivative(), 0.0 ) );
+    assert( close( fdim( x, d_t( 0.5 ) ).derivative(), 1.0 ) );
+    assert( close( fma( x, x, x ).derivative(), 2.0 * v + 1.0 ) );
+    assert( close( hypot( x, d_t( 2.0 ) ).derivative(), v / std::hypot( v, 2.0 ) ) );
+    assert( close( hypot( x, x, x ).derivative(), std::sqrt( 3.0 ) ) );
+    assert( close( atan2( d_t( 1.0 ), x ).derivative(), -1.0 / ( v * v + 1.0 ) ) );
+    assert( close( atan2( x, d_t( 1.0 ) ).derivative(), 1.0 / ( v * v + 1.0 ) ) );
+}
+
+void test_pow_at_zero()
+{
+    const d_t zero = d_t::variable( 0.0 );
+    
+    assert( pow( zero, 0 ).value() == 1.0 && pow( zero, 0 ).derivative() == 0.0 );
+    assert( pow( zero, 1 ).value() == 0.0 && pow( zero, 1 ).derivative() == 1.0 );
+    assert( pow( zero, 2 ).value() == 0.0 && pow( zero, 2 ).derivative() == 0.0 );
+    assert( pow( zero, 3.0 ).value() == 0.0 && pow( zero, 3.0 ).derivative() == 0.0 );
+    
+    // The slope of the square root is infinite at zero
+    assert( pow( zero, 0.5 ).value() == 0.0 );
+    assert( std::isinf( pow( zero, 0.5 ).derivative() ) );
+}
+
+void test_lanes()
+{
+    typedef dual<double, 4> d4;
+    
+    // Four directional derivatives of f(x, y) = x^2 y at (3, 2) at once
+    d4 x = 3.0, y = 2.0;
+    x.derivative( 0 ) = 1.0; y.derivative( 0 ) = 0.0;
+    x.derivative( 1 ) = 0.0; y.derivative( 1 ) = 1.0;
+    x.derivative( 2 ) = 1.0; y.derivative( 2 ) = 1.0;
+    x.derivative( 3 ) = 1.0; y.derivative( 3 ) = -2.0;
+    
+    const d4 f = x * x * y;
+    
+    assert( f.value() == 18.0 );
+    assert( f.derivative( 0 ) == 12.0 );
+    assert( f.derivative( 1 ) == 9.0 );
+    assert( f.derivative( 2 ) == 21.0 );
+    assert( f.derivative( 3 ) == -6.0 );
+    
+    const d4 v = d4::variable( 1.0, 2 );
+    assert( v.derivative( 0 ) == 0.0 && v.derivative( 2 ) == 1.0 );
+}
+
+void test_derivative()
+{
+    assert( engunits::derivative( []( auto x ) { return x * x * x; }, 2.0 ) == 12.0 );
+    
+    // Isothermal atmosphere
+    const quantity<double, si::pascal> p0( 101325.0 );
+    const quantity<double, si::meter> H( 8434.5 );
+    
+    const auto p = [&]( auto h ) { return p0 * exp( -h / H ); };
+    
+    const auto dp = engunits::derivative( p, 1000.0_m );
+    
+    typedef quantity<double, si::pascal, si::meter_<-1> > pa_per_m;
+    static_assert( std::is_constructible< pa_per_m, decltype( dp ) >::value, "dp/dh is a pressure over a length" );
+    static_assert( !std::is_constructible< quantity<double, si::pascal>, decltype( dp ) >::value, "dp/dh is not a pressure" );
+    
+    const quantity<double, si::meter> dh( 1e-3 );
+    const auto fd = ( p( 1000.0_m + dh ) - p( 1000.0_m - dh ) ) / ( 2.0 * dh );
+    assert( close( pa_per_m( dp ).value(), pa_per_m( fd ).value(), 1e-7 ) );
+    assert( close( pa_per_m( dp ).value(), -( p0 / H ).value() * std::exp( -1000.0 / 8434.5 ) ) );
+    
+    // Units are converted inside the function, and the derivative follows
+    const auto dp_kpa = engunits::derivative( [&]( auto h ) {
+        typedef engunits::detail::value_type_t<decltype(h)> value_type;
+        return quantity<value_type, si::kilopascal>( p( quantity<value_type, si::meter>( h ) ) );
+    }, 1.0_km );
+    
+    typedef quantity<double, si::kilopascal, si::kilometer_<-1> > kpa_per_km;
+    static_assert( std::is_same< decltype( dp_kpa ), const kpa_per_km >::value, "dp/dh is in kPa/km" );
+    assert( close( dp_kpa.value(), pa_per_m( dp ).value(), 1e-12 ) );
+}
+
+void test_jacobian()
+{
+    const quantity<double, si::meter> r( 2.0 );
+    const quantity<double, radian> theta( 0.5 );
+    
+    const auto J = engunits::jacobian( []( auto r, auto theta ) {
+        return std::make_tuple( r * cos( theta ), r * sin( theta ) );
+    }, r, theta );
+    
+    static_assert( J.rows() == 2 && J.cols() == 2, "two by two" );
+    
+    // m / m is a number, m / rad is not
+    static_assert( std::is_same< decltype( J.template get<0, 0>() ), double >::value, "dx/dr is dimensionless" );
+    
+    typedef quantity<double, si::meter, engunits::radian_<-1> > m_per_rad;
+    static_assert( std::is_constructible< m_per_rad, decltype( J.template get<1, 1>() ) >::value, "dy/dtheta is a length over an angle" );
+    
+    assert( close( J.template value<0>().value(), 2.0 * std::cos( 0.5 ) ) );
+    assert( close( J.template value<1>().value(), 2.0 * std::sin( 0.5 ) ) );
+    assert( close( J.template get<0, 0>(), std::cos( 0.5 ) ) );
+    assert( close( J.template get<1, 0>(), std::sin( 0.5 ) ) );
+    assert( close( m_per_rad( J.template get<0, 1>() ).value(), -2.0 * std::sin( 0.5 ) ) );
+    assert( close( m_per_rad( J.template get<1, 1>() ).value(), 2.0 * std::cos( 0.5 ) ) );
+    assert( close( J( 1, 1 ), 2.0 * std::cos( 0.5 ) ) );
+    
+    // A single output is a row
+    const auto g = engunits::jacobian( []( auto x, auto y ) { return x * y; }, 3.0_m, 4.0_mm );
+    
+    static_assert( g.rows() == 1, "one output" );
+    assert( close( quantity<double, si::millimeter>( g.template get<0, 0>() ).value(), 4.0 ) );
+    assert( close( quantity<double, si::meter>( g.template get<0, 1>() ).value(), 3.0 ) );
+}
+
+int main()
+{
+    test_arithmetic();
+    test_math_functions();
+    test_pow_at_zero();
+    test_lanes();
+    test_derivative();
+    test_jacobian();
+}
@@ -0,0 +1,190 @@
+/*
+ * Boost Software License - Version 1.0 - August 17th, 2003
+ *
+ * Permission is hereby granted, free of charge, to any person or organization
+ * obtaining a copy of the software and accompanying documentation covered by
+ * this license (the "Software") to use, reproduce, display, distribute,
+ * execute, and transmit the Software, and to prepare derivative works of the
+ * Software, and to permit third-parties to whom the Software is furnished to
+ * do so, all subject to the following:
+ *
+ * The copyright notices in the Software and this entire statement, including
+ * the above license grant, this restriction and the following disclaimer,
+ * must be included in all copies of the Software, in whole or in part, and
+ * all derivative works of the Software, unless such copies or derivative
+ * works are solely in the form of machine-executable object code generated by
+ * a source language processor.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+ * SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+ * FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#include <cassert>
+#include <cmath>
+#include <vector>
+
+#include <engineering_units/quantity.hpp>
+#include <engineering_units/numeric/histogram.hpp>
+
+#include <engineering_units/si/length.hpp>
+#include <engineering_units/si/temperature.hpp>
+#include <engineering_units/time.hpp>
+
+namespace si = engunits::si;
+using namespace si::literals;
+
+using engunits::quantity;
+using engunits::histogram;
+using engunits::bin_scale;
+
+using kelvin_t = quantity<double, si::kelvin>;
+using mps_t = quantity<double, si::meter, engunits::second_<-1> >;
+using kmh_t = quantity<double, si::kilometer, engunits::hour_<-1> >;
+
+bool close( double x, double y, double tol = 1e-9 )
+{
+    return std::fabs( x - y ) < tol * ( 1.0 + std::fabs(y) );
+}
+
+void test_uniform()
+{
+    histogram< kelvin_t > h( 0.0_K, 10.0_K, 10 );
+    
+    assert( h.bins() == 10 );
+    assert( h.lower() == 0.0_K );
+    assert( h.upper() == 10.0_K );
+    assert( h.lower( 3 ) == 3.0_K );
+    assert( h.upper( 3 ) == 4.0_K );
+    
+    const std::vector< kelvin_t > samples { -1.0_K, 0.0_K, 0.5_K, 3.0_K, 3.9_K, 9.99_K, 10.0_K, 12.0_K,
+                                            kelvin_t( std::nan("") ) };
+    
+    h.push( samples.begin(), samples.end() );
+    h.push( 4.5_K );
+    
+    assert( h.total() == 10 );
+    assert( h.underflow() == 2 );
+    assert( h.overflow() == 2 );
+    assert( h.count( 0 ) == 2 );
+    assert( h.count( 3 ) == 2 );
+    assert( h.count( 4 ) == 1 );
+    assert( h.count( 9 ) == 1 );
+    assert( h.count( 5 ) == 0 );
+}
+
+void test_logarithmic()
+{
+    histogram< kelvin_t > h( 1.0_K, 1000.0_K, 3, bin_scale::logarithmic );
+    
+    assert( close( h.upper( 0 ).value(), 10.0 ) );
+    assert( close( h.upper( 1 ).value(), 100.0 ) );
+    
+    const std::vector< kelvin_t > samples { 0.0_K, -5.0_K, 2.0_K, 20.0_K, 50.0_K, 500.0_K, 2000.0_K };
+    
+    h.push( samples.begin(), samples.end() );
+    
+    assert( h.underflow() == 2 );
+    assert( h.count( 0 ) == 1 );
+    assert( h.count( 1 ) == 2 );
+    assert( h.count( 2 ) == 1 );
+    assert( h.overflow() == 1 );
+}
+
+void test_conversion()
+{
+    histogram< mps_t > h( mps_t( 0.0 ), mps_t( 40.0 ), 40 );
+    
+    // 36 km/h is 10 m/s, and 7.2 km/h is 2 m/s
+    const std::vector< kmh_t > samples { kmh_t( 35.0 ), kmh_t( 37.0 ), kmh_t( 7.3 ), kmh_t( 200.0 ) };
+    
+    h.push( samples.begin(), samples.end() );
+    h.push( kmh_t( 7.1 ) );
+    
+    assert( h.count( 9 ) == 1 );
+    assert( h.count( 10 ) == 1 );
+    assert( h.count( 2 ) == 1 );
+    assert( h.count( 1 ) == 1 );
+    assert( h.overflow() == 1 );
+    
+    histogram< mps_t > log_h( mps_t( 1.0 ), mps_t( 100.0 ), 2, bin_scale::logarithmic );
+    
+    log_h.push( samples.begin(), samples.end() );
+    
+    assert( log_h.count( 0 ) == 2 );
+    assert( log_h.count( 1 ) == 2 );
+}
+
+void test_quantile()
+{
+    histogram< kelvin_t > h( 0.0_K, 100.0_K, 100 );
+    
+    std::vector< kelvin_t > samples;
+    
+    for ( int i = 0; i < 1000; ++i )
+        samples.emplace_back( ( i + 0.5 ) * 0.1 );
+    
+    h.push( samples.begin(), samples.end() );
+    
+    assert( close( h.quantile( 0.5 ).value(), 50.0 ) );
+    assert( close( h.quantile( 0.25 ).value(), 25.0 ) );
+    assert( h.quantile( 0.0 ) == 0.0_K );
+    assert( h.quantile( 1.0 ) == 100.0_K );
+    
+    assert( close( h.cdf( 50.0_K ), 0.5 ) );
+    assert( close( h.cdf( 12.5_K ), 0.125 ) );
+    assert( h.cdf( -1.0_K ) == 0.0 );
+    assert( h.cdf( 200.0_K ) == 1.0 );
+    
+    // Round trip
+    for ( double p : { 0.01, 0.3, 0.77, 0.99 } )
+        assert( close( h.cdf( h.quantile( p ) ), p ) );
+    
+    histogram< kelvin_t > log_h( 1.0_K, 1e4_K, 40, bin_scale::logarithmic );
+    log_h.push( samples.begin() + 10, samples.end() );
+    
+    for ( double p : { 0.1, 0.5, 0.9 } )
+        assert( close( log_h.cdf( log_h.quantile( p ) ), p ) );
+    
+    // The quantile of a logarithmic histogram lies within the right bin
+    const kelvin_t median = log_h.quantile( 0.5 );
+    assert( 40.0_K < median && median < 60.0_K );
+}
+
+void test_parallel()
+{
+    std::vector< kelvin_t > samples;
+    
+    for ( int i = 0; i < 500000; ++i )
+        samples.emplace_back( 300.0 + 20.0 * std::sin( i * 0.001 ) );
+    
+    histogram< kelvin_t > serial( 270.0_K, 330.0_K, 120 );
+    histogram< kelvin_t > parallel( 270.0_K, 330.0_K, 120 );
+    
+    serial.push( samples.begin(), samples.end() );
+    parallel.push_parallel( samples.begin(), samples.end(), 4 );
+    
+    assert( parallel.total() == serial.total() );
+    
+    for ( std::size_t i = 0; i < serial.bins(); ++i )
+        assert( parallel.count( i ) == serial.count( i ) );
+    
+    histogram< kelvin_t > twice( serial );
+    twice.merge( serial );
+    
+    assert( twice.total() == 2 * samples.size() );
+    assert( twice.count( 60 ) == 2 * serial.count( 60 ) );
+}
+
+int main()
+{
+    test_uniform();
+    test_logarithmic();
+    test_conversion();
+    test_quantile();
+    test_parallel();
+}
@@ -0,0 +1,155 @@
+/*
+ * Boost Software License - Version 1.0 - August 17th, 2003
+ *
+ * Permission is hereby granted, free of charge, to any person or organization
+ * obtaining a copy of the software and accompanying documentation covered by
+ * this license (the "Software") to use, reproduce, display, distribute,
+ * execute, and transmit the Software, and to prepare derivative works of the
+ * Software, and to permit third-parties to whom the Software is furnished to
+ * do so, all subject to the following:
+ *
+ * The copyright notices in the Software and this entire statement, including
+ * the above license grant, this restriction and the following disclaimer,
+ * must be included in all copies of the Software, in whole or in part, and
+ * all derivative works of the Software, unless such copies or derivative
+ * works are solely in the form of machine-executable object code generated by
+ * a source language processor.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+ * SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+ * FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#include <cassert>
+#include <cmath>
+#include <iterator>
+#include <sstream>
+#include <vector>
+
+#include <engineering_units/quantity.hpp>
+#include <engineering_units/numeric/integration.hpp>
+
+#include <engineering_units/time.hpp>
+#include <engineering_units/si/length.hpp>
+#include <engineering_units/si/force.hpp>
+#include <engineering_units/si/energy.hpp>
+
+namespace si = engunits::si;
+using namespace si::literals;
+using namespace engunits::literals;
+
+using engunits::quantity;
+using engunits::second;
+using engunits::second_;
+
+using force_t = quantity<double, si::newton>;
+using length_t = quantity<double, si::meter>;
+
+bool close( double x, double y, double eps )
+{
+    return std::fabs( x - y ) <= eps;
+}
+
+void test_trapezoid()
+{
+    // F(x) = 2 N/m * x, over [0, 1] m
+    std::vector< length_t > x;
+    std::vector< force_t > f;
+    
+    for ( int i = 0; i <= 10; ++i )
+    {
+        x.push_back( length_t( i / 10.0 ) );
+        f.push_back( force_t( 2.0 * i / 10.0 ) );
+    }
+    
+    const auto w = engunits::trapezoid( f.begin(), f.end(), 0.1_m );
+    const auto w2 = engunits::trapezoid( x.begin(), x.end(), f.begin() );
+    
+    static_assert( decltype(w)::unit() == si::joule(), "N * m is J" );
+    
+    assert( close( w.value(), 1.0, 1e-12 ) );
+    assert( close( w2.value(), 1.0, 1e-12 ) );
+    
+    assert( engunits::trapezoid( f.begin(), f.begin() + 1, 0.1_m ).value() == 0.0 );
+}
+
+void test_simpson()
+{
+    // v(t) = t^2 m/s^3, exact for Simpson
+    using rate_t = quantity<double, si::meter, second_<-1> >;
+    
+    for ( int n : { 3, 4, 5, 6, 11, 12 } )
+    {
+        std::vector< quantity<double, second> > t;
+        std::vector< rate_t > v;
+        
+        for ( int i = 0; i < n; ++i )
+        {
+            const double ti = 2.0 * i / ( n - 1 );
+            t.emplace_back( ti );
+            v.emplace_back( ti * ti );
+        }
+        
+        const auto d = engunits::simpson( v.begin(), v.end(), t[1] - t[0] );
+        const auto d2 = engunits::simpson( t.begin(), t.end(), v.begin() );
+        
+        static_assert( decltype(d)::unit() == si::meter(), "m/s * s = m" );
+        
+        assert( close( d.value(), 8.0 / 3.0, 1e-12 ) );
+        assert( close( d2.value(), 8.0 / 3.0, 1e-12 ) );
+    }
+    
+    // Non-uniform grid
+    std::vector< quantity<double, second> > t { 0.0_s, 0.1_s, 0.5_s, 0.7_s, 1.5_s, 2.0_s };
+    std::vector< rate_t > v;
+    
+    for ( auto ti : t )
+        v.emplace_back( ti.value() * ti.value() );
+    
+    assert( close( engunits::simpson( t.begin(), t.end(), v.begin() ).value(), 8.0 / 3.0, 1e-12 ) );
+}
+
+void test_cumulative()
+{
+    std::vector< force_t > f( 5, 3.0_N );
+    std::vector< quantity<double, si::newton, si::meter> > w;
+    
+    engunits::cumulative_trapezoid( f.begin(), f.end(), 2.0_m, std::back_inserter(w) );
+    
+    assert( w.size() == 5 );
+    for ( std::size_t i = 0; i < w.size(); ++i )
+        assert( w[i].value() == 6.0 * i );
+    
+    // Streaming from an input iterator
+    std::istringstream ss( "0 1 2 3" );
+    std::vector< quantity<double, second> > y;
+    
+    engunits::cumulative_trapezoid( std::istream_iterator<double>( ss ),
+                                    std::istream_iterator<double>(),
+                                    1.0_s,
+                                    std::back_inserter( y ) );
+    
+    assert( y.size() == 4 );
+    assert( y[3] == 4.5_s );
+    
+    engunits::trapezoid_accumulator< quantity<double, second>, force_t > impulse;
+    
+    for ( int i = 0; i <= 100; ++i )
+        impulse.push( quantity<double, second>( i / 100.0 ), force_t( i / 100.0 ) );
+    
+    static_assert( decltype(impulse)::result_type::unit() == si::newton() * second(), "" );
+    
+    assert( impulse.count() == 101 );
+    assert( close( impulse.value().value(), 0.5, 1e-12 ) );
+}
+
+int main()
+{
+    test_trapezoid();
+    test_simpson();
+    test_cumulative();
+}
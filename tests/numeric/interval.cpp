@@ -0,0 +1,237 @@
+/*
+ * Boost Software License - Version 1.0 - August 17th, 2003
+ *
+ * Permission is hereby granted, free of charge, to any person or organization
+ * obtaining a copy of the software and accompanying documentation covered by
+ * this license (the "Software") to use, reproduce, display, distribute,
+ * execute, and transmit the Software, and to prepare derivative works of the
+ * Software, and to permit third-parties to whom the Software is furnished to
+ * do so, all subject to the following:
+ *
+ * The copyright notices in the Software and this entire statement, including
+ * the above license grant, this restriction and the following disclaimer,
+ * must be included in all copies of the Software, in whole or in part, and
+ * all derivative works of the Software, unless such copies or derivative
+ * works are solely in the form of machine-executable object code generated by
+ * a source language processor.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+ * SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+ * FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#include <cassert>
+#include <cmath>
+#include <limits>
+#include <random>
+#include <sstream>
+#include <type_traits>
+
+#include <engineering_units/quantity.hpp>
+#include <engineering_units/angle.hpp>
+#include <engineering_units/io.hpp>
+#include <engineering_units/numeric/interval.hpp>
+
+#include <engineering_units/si/length.hpp>
+
+namespace si = engunits::si;
+
+using engunits::quantity;
+using engunits::interval;
+
+typedef interval<double> i_t;
+
+const double pi = 3.14159265358979323846;
+
+void test_rounding()
+{
+    using engunits::detail::next_up;
+    using engunits::detail::next_down;
+    
+    assert( next_up( 1.0 ) == std::nextafter( 1.0, 2.0 ) );
+    assert( next_down( 1.0 ) == std::nextafter( 1.0, 0.0 ) );
+    assert( next_up( 1e300 ) == std::nextafter( 1e300, 2e300 ) );
+    assert( next_up( -0.0 ) > 0.0 && next_up( -0.0 ) <= 2 * std::numeric_limits<double>::min() );
+    assert( next_down( std::numeric_limits<double>::infinity() ) == std::numeric_limits<double>::max() );
+    assert( next_up( 1.0f ) == std::nextafter( 1.0f, 2.0f ) );
+    
+    // Exact operations give points
+    assert( i_t( 2.0 ) * i_t( 3.0 ) == i_t( 6.0 ) );
+    assert( i_t( 1.0 ) + i_t( 0.5 ) == i_t( 1.5 ) );
+    assert( i_t( 1.0 ) / i_t( 4.0 ) == i_t( 0.25 ) );
+    assert( sqrt( i_t( 2.25 ) ) == i_t( 1.5 ) );
+    
+    // Inexact ones are one ulp wide
+    const i_t s = i_t( 0.1 ) + i_t( 0.2 );
+    assert( s.upper() == next_up( s.lower() ) && s.contains( 0.1 + 0.2 ) );
+    
+    const i_t t = i_t( 1.0 ) / i_t( 3.0 );
+    assert( t.upper() == next_up( t.lower() ) );
+    
+    // Overflow
+    const i_t big = i_t( std::numeric_limits<double>::max() ) * i_t( 2.0 );
+    assert( big.lower() == std::numeric_limits<double>::max() && std::isinf( big.upper() ) );
+    
+    // Underflow to zero: 1e-400 and -1e-400 are not zero
+    const double tiny = 2 * std::numeric_limits<double>::min();
+    const i_t u = i_t( 1e-200 ) * i_t( 1e-200 );
+    assert( u.lower() <= 0.0 && u.upper() > 0.0 && u.upper() <= tiny );
+    
+    const i_t v = i_t( -1e-200 ) * i_t( 1e-200 );
+    assert( v.lower() < 0.0 && v.lower() >= -tiny && v.upper() >= 0.0 );
+    
+    // Underflow to a subnormal
+    const i_t w = i_t( 1e-160 ) * i_t( 1e-160 );
+    assert( w.lower() <= 1e-320 && w.upper() >= 1e-320 );
+    
+    // A zero factor is still exact
+    assert( i_t( 0.0 ) * i_t( 1e-200 ) == i_t( 0.0 ) );
+    
+    // A quotient that underflows
+    const i_t q = i_t( 1e-200 ) / i_t( 1e200 );
+    assert( q.lower() <= 0.0 && q.upper() > 0.0 );
+}
+
+#if defined(__SIZEOF_FLOAT128__)
+void test_containment()
+{
+    typedef __float128 quad;
+    
+    std::mt19937_64 rng( 7 );
+    std::uniform_real_distribution<double> mantissa( 1.0, 2.0 );
+    std::uniform_int_distribution<int> exponent( -40, 40 );
+    
+    auto random = [&] {
+        const double x = std::ldexp( mantissa( rng ), exponent( rng ) );
+        return rng() % 2 ? x : -x;
+    };
+    
+    for ( int i = 0; i < 100000; ++i )
+    {
+        const double a = random();
+        const double b = random();
+        
+        // Sums and products of two doubles are exact in quad precision
+        const i_t s = i_t( a ) + i_t( b );
+        assert( quad( s.lower() ) <= quad( a ) + quad( b ) && quad( a ) + quad( b ) <= quad( s.upper() ) );
+        
+        const i_t p = i_t( a ) * i_t( b );
+        assert( quad( p.lower() ) <= quad( a ) * quad( b ) && quad( a ) * quad( b ) <= quad( p.upper() ) );
+        
+        // lower <= a / b <= upper, multiplied by b
+        const i_t q = i_t( a ) / i_t( b );
+        const quad lo = quad( q.lower() ) * quad( b );
+        const quad hi = quad( q.upper() ) * quad( b );
+        assert( std::min( lo, hi ) <= quad( a ) && quad( a ) <= std::max( lo, hi ) );
+        assert( q.upper() <= engunits::detail::next_up( q.lower() ) );
+        
+        const i_t r = sqrt( i_t( std::fabs( a ) ) );
+        assert( quad( r.lower() ) * quad( r.lower() ) <= quad( std::fabs( a ) ) );
+        assert( quad( std::fabs( a ) ) <= quad( r.upper() ) * quad( r.upper() ) );
+    }
+}
+#else
+void test_containment() {}
+#endif
+
+void test_intervals()
+{
+    const i_t x( -2.0, 1.0 );
+    const i_t y( 3.0, 4.0 );
+    
+    assert( x + y == i_t( 1.0, 5.0 ) );
+    assert( x - y == i_t( -6.0, -2.0 ) );
+    assert( x * y == i_t( -8.0, 4.0 ) );
+    assert( x * x == i_t( -2.0, 4.0 ) );
+    assert( x * -y == i_t( -4.0, 8.0 ) );
+    assert( x / y == i_t( -2.0 / 3.0, 1.0 / 3.0 ) || ( x / y ).contains( -2.0 / 3.0 ) );
+    assert( y / x == i_t::entire() );
+    
+    assert( pow( x, 2 ) == i_t( 0.0, 4.0 ) );
+    assert( pow( x, 3 ) == i_t( -8.0, 1.0 ) );
+    assert( abs( x ) == i_t( 0.0, 2.0 ) );
+    assert( fmax( x, i_t( 0.0 ) ) == i_t( 0.0, 1.0 ) );
+    assert( fdim( y, x ) == i_t( 2.0, 6.0 ) );
+    
+    // Certain comparisons
+    assert( x < y && !( x < i_t( 0.5 ) ) && !( i_t( 0.5 ) < x ) );
+    
+    std::ostringstream os;
+    os << y;
+    assert( os.str() == "[3, 4]" );
+}
+
+void test_functions()
+{
+    const i_t half_turn( 0.0, pi );
+    
+    assert( sin( half_turn ).upper() == 1.0 && sin( half_turn ).lower() <= 0.0 );
+    assert( sin( i_t( 1.0, 2.0 ) ).upper() == 1.0 );
+    assert( sin( i_t( 0.1, 0.2 ) ).contains( std::sin( 0.15 ) ) && sin( i_t( 0.1, 0.2 ) ).upper() < 0.2 );
+    assert( cos( i_t( 3.0, 3.5 ) ).lower() == -1.0 );
+    assert( cos( i_t( -10.0, 10.0 ) ) == i_t( -1.0, 1.0 ) );
+    assert( tan( i_t( 1.5, 1.6 ) ) == i_t::entire() );
+    assert( tan( i_t( 0.0, 1.0 ) ).contains( std::tan( 1.0 ) ) );
+    
+    assert( exp( i_t( 0.0, 1.0 ) ).contains( 1.0 ) && exp( i_t( 0.0, 1.0 ) ).contains( std::exp( 1.0 ) ) );
+    assert( log( i_t( 1.0, 2.0 ) ).contains( 0.0 ) );
+    assert( cbrt( i_t( -8.0, 27.0 ) ).contains( -2.0 ) && cbrt( i_t( -8.0, 27.0 ) ).contains( 3.0 ) );
+    assert( pow( i_t( 4.0, 9.0 ), 0.5 ).contains( 2.0 ) && pow( i_t( 4.0, 9.0 ), 0.5 ).contains( 3.0 ) );
+    
+    // The box crosses the negative x axis
+    const i_t a = atan2( i_t( -1.0, 1.0 ), i_t( -2.0, -1.0 ) );
+    assert( a.lower() <= -pi && a.upper() >= pi );
+    
+    const i_t b = atan2( i_t( 1.0, 2.0 ), i_t( 1.0, 2.0 ) );
+    assert( b.contains( std::atan2( 1.0, 2.0 ) ) && b.contains( std::atan2( 2.0, 1.0 ) ) && b.upper() < 1.2 );
+}
+
+void test_quantity()
+{
+    typedef quantity< i_t, si::meter > length_t;
+    
+    const length_t a( i_t( 2.99, 3.01 ) );
+    const length_t b( i_t( 3.99, 4.01 ) );
+    
+    // Conversion factors are long double, and widen by an ulp at most
+    const quantity< i_t, si::millimeter > mm( length_t( i_t( 1.5 ) ) );
+    assert( mm.value().contains( 1500.0 ) && mm.value().upper() <= engunits::detail::next_up( 1500.0 ) );
+    
+    const quantity< i_t, engunits::radian > right( quantity< i_t, engunits::degree >( i_t( 90.0 ) ) );
+    assert( right.value().contains( pi / 2 ) && right.value().width() > 0.0 );
+    
+    // Every function of quantity.hpp
+    const auto c = hypot( a, b );
+    assert( c.value().lower() >= 4.985 && c.value().upper() <= 5.015 );
+    assert( sqrt( a * a + b * b ).value().contains( 5.0 ) );
+    assert( engunits::pow<2>( a ).value().contains( 9.0 ) );
+    assert( cbrt( a * a * a ).value().contains( 3.0 ) );
+    assert( fma( a, b, a * b ).value().contains( 24.0 ) );
+    assert( fmin( a, b ).value() == a.value() );
+    assert( abs( -a ).value() == a.value() );
+    assert( fdim( b, a ).value().contains( 1.0 ) );
+    assert( atan2( a, a ).contains( pi / 4 ) );
+    assert( a < b );
+    
+    // angle.hpp
+    assert( sin( quantity< i_t, engunits::degree >( i_t( 30.0 ) ) ).contains( 0.5 ) );
+    assert( cos( quantity< i_t, engunits::radian >( i_t( 0.0 ) ) ).contains( 1.0 ) );
+    assert( tan( quantity< i_t, engunits::degree >( i_t( 45.0 ) ) ).contains( 1.0 ) );
+    
+    std::ostringstream os;
+    os << a;
+    assert( os.str() == "[2.99, 3.01]m" );
+}
+
+int main()
+{
+    test_rounding();
+    test_containment();
+    test_intervals();
+    test_functions();
+    test_quantity();
+}
@@ -0,0 +1,201 @@
+/*
+ * Boost Software License - Version 1.0 - August 17th, 2003
+ *
+ * Permission is hereby granted, free of charge, to any person or organization
+ * obtaining a copy of the software and accompanying documentation covered by
+ * this license (the "Software") to use, reproduce, display, distribute,
+ * execute, and transmit the Software, and to prepare derivative works of the
+ * Software, and to permit third-parties to whom the Software is furnished to
+ * do so, all subject to the following:
+ *
+ * The copyright notices in the Software and this entire statement, including
+ * the above license grant, this restriction and the following disclaimer,
+ * must be included in all copies of the Software, in whole or in part, and
+ * all derivative works of the Software, unless such copies or derivative
+ * works are solely in the form of machine-executable object code generated by
+ * a source language processor.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+ * SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+ * FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#include <cassert>
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include <sstream>
+#include <type_traits>
+
+#include <engineering_units/quantity.hpp>
+#include <engineering_units/angle.hpp>
+#include <engineering_units/io.hpp>
+#include <engineering_units/numeric/measurement.hpp>
+
+#include <engineering_units/si/energy.hpp>
+#include <engineering_units/si/length.hpp>
+#include <engineering_units/si/mass.hpp>
+#include <engineering_units/si/pressure.hpp>
+#include <engineering_units/si/temperature.hpp>
+
+namespace si = engunits::si;
+
+using engunits::quantity;
+using engunits::measurement;
+using engunits::sampled;
+
+typedef measurement<double> m_t;
+
+bool close( double a, double b, double tol = 1e-12 )
+{
+    return std::abs( a - b ) <= tol * std::max( 1.0, std::abs( b ) );
+}
+
+bool close( const m_t & a, double value, double stddev, double tol = 1e-12 )
+{
+    return close( a.value(), value, tol ) && close( a.stddev(), stddev, tol );
+}
+
+void test_arithmetic()
+{
+    const m_t a( 10.0, 0.3 );
+    const m_t b( 5.0, 0.4 );
+    
+    assert( close( a + b, 15.0, 0.5 ) );
+    assert( close( a - b, 5.0, 0.5 ) );
+    assert( close( -a, -10.0, 0.3 ) );
+    
+    // Relative uncertainties add in quadrature
+    assert( close( m_t( 2.0, 0.1 ) * m_t( 3.0, 0.2 ), 6.0, 0.5 ) );
+    assert( close( m_t( 6.0, 0.3 ) / m_t( 3.0, 0.4 ), 2.0, std::hypot( 0.1, 2.0 * 0.4 / 3.0 ) ) );
+    
+    // Exact scalars
+    assert( close( 2.0 * a, 20.0, 0.6 ) );
+    assert( close( a / 4.0, 2.5, 0.075 ) );
+    
+    m_t c = a;
+    c += b;
+    c *= 2.0;
+    assert( close( c, 30.0, 1.0 ) );
+    
+    assert( a == m_t( 10.0, 0.3 ) && a != m_t( 10.0, 0.2 ) );
+    assert( b < a && a > b );
+    
+    std::ostringstream os;
+    os << a;
+    assert( os.str() == "(10 +/- 0.3)" );
+}
+
+void test_functions()
+{
+    const m_t x( 4.0, 0.2 );
+    
+    assert( close( sqrt( x ), 2.0, 0.05 ) );
+    assert( close( pow( x, 3 ), 64.0, 3.0 * 16.0 * 0.2 ) );
+    assert( close( exp( m_t( 0.0, 0.1 ) ), 1.0, 0.1 ) );
+    assert( close( log( x ), std::log( 4.0 ), 0.05 ) );
+    assert( close( cbrt( m_t( 8.0, 1.2 ) ), 2.0, 0.1 ) );
+    assert( close( hypot( m_t( 3.0, 0.5 ), m_t( 4.0, 0.0 ) ), 5.0, 0.3 ) );
+    assert( close( sin( m_t( 0.0, 0.01 ) ), 0.0, 0.01 ) );
+    assert( close( cos( m_t( 0.0, 0.01 ) ), 1.0, 0.0 ) );
+    assert( close( fma( m_t( 2.0, 0.1 ), m_t( 3.0, 0.0 ), m_t( 1.0, 0.4 ) ), 7.0, 0.5 ) );
+    assert( close( atan2( m_t( 1.0, 0.1 ), m_t( 1.0, 0.0 ) ), std::atan( 1.0 ), 0.05 ) );
+    assert( fmax( x, m_t( 3.0 ) ) == x && fmin( x, m_t( 3.0 ) ) == m_t( 3.0 ) );
+}
+
+void test_quantity()
+{
+    typedef quantity< m_t, si::meter > length_t;
+    
+    const length_t a( m_t( 3.0, 0.03 ) );
+    const length_t b( m_t( 4.0, 0.04 ) );
+    
+    // Unit conversions scale the uncertainty
+    const quantity< m_t, si::millimeter > a_mm( a );
+    assert( close( a_mm.value(), 3000.0, 30.0 ) );
+    
+    const quantity< m_t, si::pascal > p( quantity< m_t, si::kilopascal >( m_t( 1.5, 0.01 ) ) );
+    assert( close( p.value(), 1500.0, 10.0 ) );
+    
+    // Every function of quantity.hpp
+    const auto area = a * b;
+    static_assert( std::is_same< std::decay_t<decltype(area)>, quantity< m_t, si::meter_<2> > >::value, "" );
+    
+    assert( close( sqrt( area ).value().value(), std::sqrt( 12.0 ) ) );
+    assert( close( hypot( a, b ).value(), 5.0, std::hypot( 3.0 * 0.03, 4.0 * 0.04 ) / 5.0 ) );
+    assert( close( engunits::pow<2>( a ).value(), 9.0, 0.18 ) );
+    assert( close( abs( -a ).value(), 3.0, 0.03 ) );
+    assert( close( fdim( b, a ).value(), 1.0, 0.05 ) );
+    assert( close( fma( a, b, area ).value().value(), 24.0 ) );
+    assert( close( atan2( a, a ).value(), std::atan( 1.0 ), 0.01 * std::sqrt( 0.5 ) ) );
+    
+    // angle.hpp
+    const quantity< m_t, engunits::radian > theta( m_t( 0.0, 0.02 ) );
+    assert( close( sin( theta ), 0.0, 0.02 ) );
+    
+    std::ostringstream os;
+    os << a;
+    assert( os.str() == "(3 +/- 0.03)m" );
+}
+
+// Density of dry air, rho = p / ( R T )
+template<class P, class T>
+auto density( const P & p, const T & t )
+{
+    constexpr auto R = 287.058 * si::joule() * si::kilogram_<-1>() * si::kelvin_<-1>();
+    
+    typedef engunits::detail::value_type_t<P> value_type;
+    return quantity< value_type, si::kilogram, si::meter_<-3> >( p / ( t * R ) );
+}
+
+void test_monte_carlo()
+{
+    std::mt19937_64 rng( 42 );
+    
+    typedef sampled<double, 4> s4;
+    const s4 s( 2.0 );
+    assert( s.mean() == 2.0 && s.stddev() == 0.0 );
+    assert( ( s * s + 1.0 ) == s4( 5.0 ) );
+    assert( pow( s, 3 ) == s4( 8.0 ) );
+    assert( reinterpret_cast<std::uintptr_t>( s.data() ) % 64 == 0 );
+    
+    // Correlations: x - x is exact with samples, not with linear propagation
+    const auto x = engunits::draw<256>( m_t( 1.0, 0.1 ), rng );
+    assert( summarize( x - x ) == m_t( 0.0, 0.0 ) );
+    assert( ( m_t( 1.0, 0.1 ) - m_t( 1.0, 0.1 ) ).stddev() > 0.1 );
+    
+    // The two modes agree on a nearly linear formula
+    typedef quantity< m_t, si::hectopascal > pressure_t;
+    typedef quantity< m_t, si::kelvin > temperature_t;
+    
+    const pressure_t p( m_t( 1013.25, 2.0 ) );
+    const temperature_t t( m_t( 288.15, 1.5 ) );
+    
+    const auto linear = density( p, t ).value();
+    
+    const auto mc = summarize( density( engunits::draw<8192>( p, rng ), engunits::draw<8192>( t, rng ) ) ).value();
+    
+    assert( close( linear.value(), 1.225, 1e-3 ) );
+    assert( close( mc.value(), linear.value(), 1e-3 ) );
+    assert( close( mc.stddev(), linear.stddev(), 0.05 ) );
+    
+    // Standard normal samples, scaled for each input
+    const auto z = engunits::draw<8192>( m_t( 0.0, 1.0 ), rng );
+    const auto w = engunits::draw<8192>( m_t( 0.0, 1.0 ), rng );
+    const auto shared = summarize( density( engunits::draw( p, z ), engunits::draw( t, w ) ) ).value();
+    
+    assert( close( shared.stddev(), linear.stddev(), 0.05 ) );
+    assert( close( engunits::draw( m_t( 3.0, 2.0 ), z )[7], 3.0 + 2.0 * z[7] ) );
+}
+
+int main()
+{
+    test_arithmetic();
+    test_functions();
+    test_quantity();
+    test_monte_carlo();
+}
@@ -0,0 +1,187 @@
+/*
+ * Boost Software License - Version 1.0 - August 17th, 2003
+ *
+ * Permission is hereby granted, free of charge, to any person or organization
+ * obtaining a copy of the software and accompanying documentation covered by
+ * this license (the "Software") to use, reproduce, display, distribute,
+ * execute, and transmit the Software, and to prepare derivative works of the
+ * Software, and to permit third-parties to whom the Software is furnished to
+ * do so, all subject to the following:
+ *
+ * The copyright notices in the Software and this entire statement, including
+ * the above license grant, this restriction and the following disclaimer,
+ * must be included in all copies of the Software, in whole or in part, and
+ * all derivative works of the Software, unless such copies or derivative
+ * works are solely in the form of machine-executable object code generated by
+ * a source language processor.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+ * SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+ * FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#include <cassert>
+#include <cmath>
+#include <stdexcept>
+#include <tuple>
+
+#include <engineering_units/quantity.hpp>
+#include <engineering_units/numeric/ode.hpp>
+
+#include <engineering_units/time.hpp>
+#include <engineering_units/si/length.hpp>
+
+namespace si = engunits::si;
+using namespace si::literals;
+using namespace engunits::literals;
+
+using engunits::quantity;
+using engunits::second;
+using engunits::second_;
+
+using time_type = quantity<double, second>;
+using position_type = quantity<double, si::meter>;
+using velocity_type = quantity<double, si::meter, second_<-1> >;
+
+// Harmonic oscillator with unit angular frequency
+struct oscillator
+{
+    template<class State, class Derivative>
+    void operator()( const State & x, Derivative & dxdt, time_type ) const
+    {
+        std::get<0>(dxdt) = std::get<1>(x);
+        std::get<1>(dxdt) = -std::get<0>(x) * second_<-2>();
+    }
+};
+
+void test_runge_kutta4()
+{
+    engunits::runge_kutta4< time_type, position_type, velocity_type > rk;
+    
+    static_assert( std::is_same<
+            std::tuple_element_t<0, decltype(rk)::derivative_type>,
+            velocity_type
+        >::value, "d(meter)/d(second) is meter/second" );
+    
+    auto x = std::make_tuple( 1.0_m, velocity_type( 0.0 ) );
+    auto t = 0.0_s;
+    
+    for ( int i = 0; i < 1000; ++i )
+        rk.do_step( oscillator{}, x, t, 0.001_s );
+    
+    assert( std::fabs( t.value() - 1.0 ) < 1e-9 );
+    assert( std::fabs( std::get<0>(x).value() - std::cos(1.0) ) < 1e-10 );
+    assert( std::fabs( std::get<1>(x).value() + std::sin(1.0) ) < 1e-10 );
+}
+
+void test_runge_kutta45()
+{
+    using stepper = engunits::runge_kutta45< time_type, position_type, velocity_type >;
+    
+    stepper rk( stepper::tolerance_type( 1e-10_m, velocity_type( 1e-10 ) ), 1e-10 );
+    
+    auto x = std::make_tuple( 1.0_m, velocity_type( 0.0 ) );
+    auto dt = 0.1_s;
+    
+    const auto steps = rk.integrate( oscillator{}, x, 0.0_s, 3.0_s, dt );
+    
+    assert( steps > 0 );
+    assert( std::fabs( std::get<0>(x).value() - std::cos(3.0) ) < 1e-8 );
+    assert( std::fabs( std::get<1>(x).value() + std::sin(3.0) ) < 1e-8 );
+    
+    // A short final step does not shrink the step of the next call
+    const auto adaptive = dt;
+    rk.integrate( oscillator{}, x, 3.0_s, 3.000001_s, dt );
+    assert( dt >= adaptive );
+}
+
+void test_velocity_verlet()
+{
+    engunits::velocity_verlet< time_type, position_type > vv;
+    
+    auto q = std::make_tuple( 1.0_m );
+    auto v = std::make_tuple( velocity_type( 0.0 ) );
+    auto t = 0.0_s;
+    
+    const auto accel = []( auto const & q, auto & a, time_type ) {
+        std::get<0>(a) = -std::get<0>(q) * second_<-2>();
+    };
+    
+    for ( int i = 0; i < 10000; ++i )
+        vv.do_step( accel, q, v, t, 0.001_s );
+    
+    // Symplectic: the energy does not drift
+    const auto x = std::get<0>(q);
+    const auto u = std::get<0>(v) * 1.0_s;
+    
+    assert( std::fabs( (x * x + u * u - 1.0_m * 1.0_m).value() ) < 1e-6 );
+    assert( std::fabs( x.value() - std::cos(10.0) ) < 1e-5 );
+}
+
+void test_batch()
+{
+    const std::size_t n = 1000;
+    
+    engunits::batch_runge_kutta4< time_type, position_type, velocity_type > rk( n );
+    
+    decltype(rk)::state_type x;
+    std::get<0>(x).resize( n );
+    std::get<1>(x).resize( n, velocity_type( 0.0 ) );
+    
+    for ( std::size_t i = 0; i < n; ++i )
+        std::get<0>(x)[i] = position_type( double(i) );
+    
+    const auto system = []( auto const & x, auto & dxdt, time_type ) {
+        const auto & p = std::get<0>(x);
+        const auto & v = std::get<1>(x);
+        
+        for ( std::size_t i = 0; i < p.size(); ++i )
+        {
+            std::get<0>(dxdt)[i] = v[i];
+            std::get<1>(dxdt)[i] = -p[i] * second_<-2>();
+        }
+    };
+    
+    auto t = 0.0_s;
+    
+    for ( int i = 0; i < 1000; ++i )
+        rk.do_step( system, x, t, 0.001_s );
+    
+    for ( std::size_t i = 0; i < n; ++i )
+        assert( std::fabs( std::get<0>(x)[i].value() - double(i) * std::cos(1.0) ) < 1e-9 * (1.0 + i) );
+
+    engunits::batch_runge_kutta45< time_type, position_type, velocity_type > 
+        rk45( std::make_tuple( 1e-9_m, velocity_type( 1e-9 ) ), 1e-9, n );
+    
+    auto dt = 0.1_s;
+    rk45.integrate( system, x, 1.0_s, 2.0_s, dt );
+    
+    for ( std::size_t i = 0; i < n; ++i )
+        assert( std::fabs( std::get<0>(x)[i].value() - double(i) * std::cos(2.0) ) < 1e-6 * (1.0 + i) );
+    
+    // The state must have the size of the batch
+    std::get<1>(x).resize( n + 1 );
+    
+    bool thrown = false;
+    try
+    {
+        rk45.integrate( system, x, 2.0_s, 3.0_s, dt );
+    }
+    catch ( const std::invalid_argument & )
+    {
+        thrown = true;
+    }
+    assert( thrown );
+}
+
+int main()
+{
+    test_runge_kutta4();
+    test_runge_kutta45();
+    test_velocity_verlet();
+    test_batch();
+}
@@ -0,0 +1,145 @@
+/*
+ * Boost Software License - Version 1.0 - August 17th, 2003
+ *
+ * Permission is hereby granted, free of charge, to any person or organization
+ * obtaining a copy of the software and accompanying documentation covered by
+ * this license (the "Software") to use, reproduce, display, distribute,
+ * execute, and transmit the Software, and to prepare derivative works of the
+ * Software, and to permit third-parties to whom the Software is furnished to
+ * do so, all subject to the following:
+ *
+ * The copyright notices in the Software and this entire statement, including
+ * the above license grant, this restriction and the following disclaimer,
+ * must be included in all copies of the Software, in whole or in part, and
+ * all derivative works of the Software, unless such copies or derivative
+ * works are solely in the form of machine-executable object code generated by
+ * a source language processor.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+ * SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+ * FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#include <cassert>
+#include <cmath>
+#include <vector>
+
+#include <engineering_units/quantity.hpp>
+#include <engineering_units/numeric/running_stats.hpp>
+
+#include <engineering_units/si/temperature.hpp>
+
+namespace si = engunits::si;
+using namespace si::literals;
+
+using engunits::quantity;
+
+using kelvin_t = quantity<double, si::kelvin>;
+
+bool close( double x, double y )
+{
+    return std::fabs( x - y ) < 1e-9 * ( 1.0 + std::fabs(y) );
+}
+
+void test_running_stats()
+{
+    engunits::running_stats< kelvin_t > stats( 0.5 );
+    
+    const std::vector< kelvin_t > samples { 2.0_K, 4.0_K, 4.0_K, 4.0_K, 5.0_K, 5.0_K, 7.0_K, 9.0_K };
+    
+    stats.push( samples.begin(), samples.end() );
+    
+    static_assert( decltype(stats)::variance_type::unit() == si::kelvin_<2>(),
+                   "variance of K is K^2" );
+    
+    assert( stats.count() == 8 );
+    assert( stats.mean() == 5.0_K );
+    assert( stats.min() == 2.0_K );
+    assert( stats.max() == 9.0_K );
+    assert( close( stats.variance().value(), 32.0 / 7.0 ) );
+    assert( close( stats.stddev().value(), std::sqrt( 32.0 / 7.0 ) ) );
+    
+    // Bias corrected: constant input gives a constant average
+    engunits::running_stats< kelvin_t > constant( 0.01 );
+    constant.push( 300.0_K );
+    constant.push( 300.0_K );
+    assert( close( constant.ewma().value(), 300.0 ) );
+}
+
+void test_merge()
+{
+    std::vector< kelvin_t > samples;
+    
+    for ( int i = 0; i < 100; ++i )
+        samples.emplace_back( 273.0 + std::sin( i * 0.1 ) );
+    
+    engunits::running_stats< kelvin_t > all( 0.2 ), head( 0.2 ), tail( 0.2 );
+    
+    all.push( samples.begin(), samples.end() );
+    head.push( samples.begin(), samples.begin() + 37 );
+    tail.push( samples.begin() + 37, samples.end() );
+    
+    head.merge( tail );
+    
+    assert( head.count() == all.count() );
+    assert( close( head.mean().value(), all.mean().value() ) );
+    assert( close( head.variance().value(), all.variance().value() ) );
+    assert( close( head.ewma().value(), all.ewma().value() ) );
+    assert( head.min() == all.min() );
+    assert( head.max() == all.max() );
+}
+
+void test_batch()
+{
+    const std::size_t channels = 16;
+    const std::size_t frames = 50;
+    
+    std::vector< kelvin_t > data;
+    
+    for ( std::size_t f = 0; f < frames; ++f )
+        for ( std::size_t c = 0; c < channels; ++c )
+            data.emplace_back( double(c) + std::cos( double(f * (c + 1)) ) );
+    
+    engunits::batch_running_stats< kelvin_t > batch( channels, 0.3 );
+    
+    // Two pushes, of a different number of frames
+    batch.push( data.begin(), data.begin() + 20 * channels );
+    batch.push( data.begin() + 20 * channels, data.end() );
+    
+    assert( batch.count() == frames );
+    
+    for ( std::size_t c = 0; c < channels; ++c )
+    {
+        engunits::running_stats< kelvin_t > ref( 0.3 );
+        
+        for ( std::size_t f = 0; f < frames; ++f )
+            ref.push( data[f * channels + c] );
+        
+        const auto s = batch.channel( c );
+        
+        assert( close( s.mean().value(), ref.mean().value() ) );
+        assert( close( s.variance().value(), ref.variance().value() ) );
+        assert( close( s.ewma().value(), ref.ewma().value() ) );
+        assert( s.min() == ref.min() );
+        assert( s.max() == ref.max() );
+    }
+    
+    engunits::batch_running_stats< kelvin_t > other( channels, 0.3 );
+    other.push( data.begin(), data.end() );
+    
+    batch.merge( other );
+    
+    assert( batch.count() == 2 * frames );
+    assert( close( batch.channel( 3 ).mean().value(), other.channel( 3 ).mean().value() ) );
+}
+
+int main()
+{
+    test_running_stats();
+    test_merge();
+    test_batch();
+}
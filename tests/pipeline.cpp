@@ -0,0 +1,293 @@
+/*
+ * Boost Software License - Version 1.0 - August 17th, 2003
+ *
+ * Permission is hereby granted, free of charge, to any person or organization
+ * obtaining a copy of the software and accompanying documentation covered by
+ * this license (the "Software") to use, reproduce, display, distribute,
+ * execute, and transmit the Software, and to prepare derivative works of the
+ * Software, and to permit third-parties to whom the Software is furnished to
+ * do so, all subject to the following:
+ *
+ * The copyright notices in the Software and this entire statement, including
+ * the above license grant, this restriction and the following disclaimer,
+ * must be included in all copies of the Software, in whole or in part, and
+ * all derivative works of the Software, unless such copies or derivative
+ * works are solely in the form of machine-executable object code generated by
+ * a source language processor.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+ * SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+ * FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#include <engineering_units/quantity.hpp>
+#include <engineering_units/pipeline.hpp>
+
+#include <engineering_units/si/length.hpp>
+#include <engineering_units/si/pressure.hpp>
+
+using engunits::quantity;
+using engunits::batch;
+using engunits::batch_pool;
+using engunits::channel;
+using engunits::generator;
+using engunits::make_pipeline;
+using engunits::pipeline;
+using engunits::pipeline_options;
+using engunits::thread_pool;
+
+using kilopascal_t = quantity<double, engunits::si::kilopascal>;
+using pascal_t = quantity<double, engunits::si::pascal>;
+using meter_t = quantity<double, engunits::si::meter>;
+
+generator<int> iota( int n )
+{
+    for ( int i = 0; i < n; ++i )
+        co_yield i;
+}
+
+generator<int> failing()
+{
+    co_yield 1;
+    throw std::runtime_error( "failing" );
+}
+
+void test_generator()
+{
+    int sum = 0;
+    
+    for ( int i : iota( 5 ) )
+        sum += i;
+    
+    assert( sum == 10 );
+    
+    int seen = 0;
+    
+    try
+    {
+        for ( int i : failing() )
+            seen += i;
+        
+        assert( false );
+    }
+    catch ( std::runtime_error & )
+    {
+        assert( seen == 1 );
+    }
+}
+
+void test_batch()
+{
+    batch_pool<pascal_t> pool( 8 );
+    
+    {
+        batch<pascal_t> a = pool.acquire();
+        assert( a.empty() && a.capacity() == 8 );
+        
+        a.push_back( pascal_t( 1.0 ) );
+        a.resize( 3 );
+        assert( a.size() == 3 && a[0] == pascal_t( 1.0 ) );
+        
+        batch<pascal_t> b = pool.acquire();
+        assert( pool.allocated() == 2 );
+    }
+    
+    // Both buffers are back in the pool
+    for ( int i = 0; i < 10; ++i )
+    {
+        batch<pascal_t> a = pool.acquire();
+        batch<pascal_t> b = pool.acquire();
+        assert( a.empty() );
+    }
+    
+    assert( pool.allocated() == 2 );
+}
+
+void test_channel()
+{
+    channel<int> ch( 2 );
+    
+    std::thread producer( [&ch] {
+        for ( int i = 1; i <= 100; ++i )
+            ch.push( int( i ) );
+        ch.close();
+    } );
+    
+    int sum = 0;
+    
+    for ( int i : ch.items() )
+        sum += i;
+    
+    producer.join();
+    
+    assert( sum == 5050 );
+    assert( !ch.push( 1 ) );
+}
+
+// Readings in kPa, 0.5, 1.0, ... 
+auto readings( int batches, std::size_t * allocated = nullptr )
+{
+    return [=]( batch_pool<kilopascal_t> & pool ) -> generator< batch<kilopascal_t> >
+    {
+        int n = 0;
+        
+        for ( int i = 0; i < batches; ++i )
+        {
+            batch<kilopascal_t> b = pool.acquire();
+            
+            while ( !b.full() )
+                b.push_back( kilopascal_t( 0.5 * ++n ) );
+            
+            co_yield std::move( b );
+        }
+        
+        if ( allocated )
+            *allocated = pool.allocated();
+    };
+}
+
+void test_pipeline()
+{
+    const pipeline_options options { 16, 2 };
+    
+    // Stages in Pa, the source in kPa
+    auto above = []( generator< batch<pascal_t> > in, batch_pool<pascal_t> & pool ) -> generator< batch<pascal_t> >
+    {
+        for ( batch<pascal_t> & b : in )
+        {
+            batch<pascal_t> out = pool.acquire();
+            
+            for ( pascal_t p : b )
+                if ( p > pascal_t( 1000.0 ) )
+                    out.push_back( p );
+            
+            co_yield std::move( out );
+        }
+    };
+    
+    auto sum = []( generator< batch<pascal_t> > in )
+    {
+        pascal_t s( 0.0 );
+        
+        for ( batch<pascal_t> & b : in )
+            for ( pascal_t p : b )
+                s += p;
+        
+        return s;
+    };
+    
+    static_assert( std::is_same< decltype( make_pipeline( readings( 1 ) ) ), pipeline<kilopascal_t> >::value, "" );
+    static_assert( std::is_same< decltype( make_pipeline( readings( 1 ) ).then( above ) ), pipeline<pascal_t> >::value, "" );
+    
+    // Source, conversion, filter
+    thread_pool threads( 3 );
+    
+    std::size_t allocated = 0;
+    const int batches = 1000;
+    const pascal_t total = make_pipeline( readings( batches, &allocated ), options ).then( above ).run( sum, threads );
+    
+    // 0.5 kPa steps, everything above 1 kPa
+    const double n = batches * 16.0;
+    const double expected = 500.0 * ( n * ( n + 1 ) / 2 - 3 );
+    assert( std::abs( total.value() - expected ) < 1e-9 * expected );
+    
+    // The source recycles a handful of batches
+    assert( allocated > 0 && allocated <= 8 );
+    
+    // The pool is reusable
+    const pascal_t again = make_pipeline( readings( 2 ), options ).run( sum, threads );
+    assert( again == pascal_t( 500.0 * 32 * 33 / 2 ) );
+    
+    // Explicit conversion, and no stage at all but the source
+    int seen = 0;
+    make_pipeline( readings( 3 ), options ).convert<pascal_t>().run( [&seen]( generator< batch<pascal_t> > in )
+    {
+        for ( batch<pascal_t> & b : in )
+            seen += int( b.size() );
+    }, threads );
+    
+    assert( seen == 48 );
+    
+    // Different dimensions do not connect
+    static_assert( !std::is_constructible< pascal_t, const meter_t & >::value, "" );
+}
+
+void test_early_exit()
+{
+    thread_pool threads( 2 );
+    
+    // The sink stops after the first batch, the endless source must stop too
+    auto endless = []( batch_pool<pascal_t> & pool ) -> generator< batch<pascal_t> >
+    {
+        for (;;)
+        {
+            batch<pascal_t> b = pool.acquire();
+            b.resize( b.capacity() );
+            co_yield std::move( b );
+        }
+    };
+    
+    const std::size_t first = make_pipeline( endless, pipeline_options { 4, 1 } ).run( []( generator< batch<pascal_t> > in )
+    {
+        for ( batch<pascal_t> & b : in )
+            return b.size();
+        
+        return std::size_t( 0 );
+    }, threads );
+    
+    assert( first == 4 );
+    
+    // A stage that throws
+    auto broken = []( generator< batch<pascal_t> > in, batch_pool<pascal_t> & ) -> generator< batch<pascal_t> >
+    {
+        for ( batch<pascal_t> & b : in )
+            if ( !b.empty() )
+                throw std::runtime_error( "broken" );
+        
+        co_return;
+    };
+    
+    try
+    {
+        make_pipeline( endless ).then( broken ).run( []( generator< batch<pascal_t> > in ) { for ( auto & b : in ) (void)b; }, threads );
+        assert( false );
+    }
+    catch ( std::runtime_error & e )
+    {
+        assert( std::string( e.what() ) == "broken" );
+    }
+    
+    // Not enough threads for the stages
+    thread_pool one( 1 );
+    
+    try
+    {
+        make_pipeline( endless ).then( broken ).run( []( generator< batch<pascal_t> > ) {}, one );
+        assert( false );
+    }
+    catch ( std::invalid_argument & )
+    {
+    }
+}
+
+int main()
+{
+    test_generator();
+    test_batch();
+    test_channel();
+    test_pipeline();
+    test_early_exit();
+}
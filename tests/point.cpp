@@ -0,0 +1,179 @@
+/*
+ * Boost Software License - Version 1.0 - August 17th, 2003
+ *
+ * Permission is hereby granted, free of charge, to any person or organization
+ * obtaining a copy of the software and accompanying documentation covered by
+ * this license (the "Software") to use, reproduce, display, distribute,
+ * execute, and transmit the Software, and to prepare derivative works of the
+ * Software, and to permit third-parties to whom the Software is furnished to
+ * do so, all subject to the following:
+ *
+ * The copyright notices in the Software and this entire statement, including
+ * the above license grant, this restriction and the following disclaimer,
+ * must be included in all copies of the Software, in whole or in part, and
+ * all derivative works of the Software, unless such copies or derivative
+ * works are solely in the form of machine-executable object code generated by
+ * a source language processor.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+ * SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+ * FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#include <cassert>
+#include <cmath>
+#include <type_traits>
+#include <vector>
+
+#include <engineering_units/quantity.hpp>
+#include <engineering_units/point.hpp>
+
+#include <engineering_units/si/temperature.hpp>
+#include <engineering_units/imperial/temperature.hpp>
+#include <engineering_units/detail/void_t.hpp>
+
+namespace si = engunits::si;
+namespace imperial = engunits::imperial;
+using namespace si::literals;
+
+using engunits::quantity;
+
+using kelvin_t = si::kelvin_point<double>;
+using celsius_t = si::celsius_point<double>;
+using fahrenheit_t = imperial::fahrenheit_point<double>;
+
+bool close( double x, double y )
+{
+    return std::fabs( x - y ) < 1e-9 * ( 1.0 + std::fabs(y) );
+}
+
+template<class L, class R, class = void>
+struct can_add : std::false_type {};
+
+template<class L, class R>
+struct can_add< L, R, engunits::detail::void_t< decltype( std::declval<L>() + std::declval<R>() ) > > : std::true_type {};
+
+template<class L, class R, class = void>
+struct can_subtract : std::false_type {};
+
+template<class L, class R>
+struct can_subtract< L, R, engunits::detail::void_t< decltype( std::declval<L>() - std::declval<R>() ) > > : std::true_type {};
+
+void test_conversion()
+{
+    constexpr celsius_t boiling( 100.0 );
+    constexpr kelvin_t k( boiling );
+    
+    static_assert( k.value() > 373.1499 && k.value() < 373.1501, "100 C is 373.15 K" );
+    
+    const fahrenheit_t f( boiling );
+    assert( close( f.value(), 212.0 ) );
+    
+    assert( close( celsius_t( fahrenheit_t( 32.0 ) ).value(), 0.0 ) );
+    assert( close( celsius_t( fahrenheit_t( -40.0 ) ).value(), -40.0 ) );
+    assert( close( kelvin_t( fahrenheit_t( 0.0 ) ).value(), 255.3722222222222 ) );
+    assert( close( fahrenheit_t( kelvin_t( 0.0 ) ).value(), -459.67 ) );
+    
+    // Value type conversion on the same scale
+    const si::celsius_point<float> cf( boiling );
+    assert( cf.value() == 100.0f );
+}
+
+void test_arithmetic()
+{
+    const celsius_t morning( 12.5 ), noon( 21.0 );
+    
+    const auto rise = noon - morning;
+    
+    static_assert( std::is_same< decltype(rise), const quantity<double, si::kelvin> >::value, 
+                   "point - point is a difference" );
+    assert( rise == 8.5_K );
+    
+    assert( morning + rise == noon );
+    assert( rise + morning == noon );
+    assert( noon - rise == morning );
+    assert( morning < noon && noon > morning && morning <= morning && noon >= morning );
+    assert( morning != noon );
+    
+    celsius_t t = morning;
+    t += 1.5_K;
+    t -= 0.5_K;
+    assert( t.value() == 13.5 );
+    assert( t.from_origin() == 13.5_K );
+    
+    // A difference on the Fahrenheit scale is in rankine
+    const auto df = fahrenheit_t( 50.0 ) - fahrenheit_t( 32.0 );
+    assert( close( quantity<double, si::kelvin>( df ).value(), 10.0 ) );
+    
+    static_assert( !can_add< celsius_t, celsius_t >::value, "points can not be added" );
+    static_assert( !can_subtract< celsius_t, kelvin_t >::value, "points of different scales" );
+    static_assert( can_subtract< celsius_t, quantity<double, si::kelvin> >::value, "" );
+    static_assert( !can_add< celsius_t, quantity<double, si::celsius> >::value, 
+                   "the celsius unit is not a difference" );
+    
+    // The old helper agrees with the point types
+    assert( close( ( 300.0_K + si::abs_zero ).value(), celsius_t( kelvin_t( 300.0 ) ).value() ) );
+}
+
+void test_convert()
+{
+    std::vector<celsius_t> c;
+    
+    for ( int i = 0; i < 1000; ++i )
+        c.emplace_back( -50.0 + i * 0.15 );
+    
+    std::vector<fahrenheit_t> f( c.size() );
+    std::vector<kelvin_t> k( c.size() );
+    
+    auto end = engunits::convert( c.data(), c.data() + c.size(), f.data() );
+    assert( end == f.data() + f.size() );
+    
+    engunits::convert( c.data(), c.data() + c.size(), k.data() );
+    
+    for ( std::size_t i = 0; i < c.size(); ++i )
+    {
+        assert( close( f[i].value(), fahrenheit_t( c[i] ).value() ) );
+        assert( close( k[i].value(), c[i].value() + 273.15 ) );
+    }
+    
+    // In place, on the same value type
+    std::vector<kelvin_t> back( k );
+    engunits::convert( back.data(), back.data() + back.size(), back.data() );
+    
+    assert( close( back[10].value(), k[10].value() ) );
+}
+
+void test_integral()
+{
+    // Neither factor is truncated, and the result is rounded once
+    assert( imperial::fahrenheit_point<int>( si::celsius_point<int>( 100 ) ).value() == 212 );
+    assert( imperial::fahrenheit_point<int>( si::celsius_point<int>( -40 ) ).value() == -40 );
+    assert( si::celsius_point<int>( imperial::fahrenheit_point<int>( 0 ) ).value() == -18 );
+    assert( si::kelvin_point<long>( si::celsius_point<int>( 20 ) ).value() == 293 );
+    
+    std::vector< si::celsius_point<int> > c;
+    
+    for ( int i = -100; i < 100; ++i )
+        c.emplace_back( i );
+    
+    std::vector< imperial::fahrenheit_point<long> > f( c.size() );
+    engunits::convert( c.data(), c.data() + c.size(), f.data() );
+    
+    for ( std::size_t i = 0; i < c.size(); ++i )
+        assert( f[i].value() == imperial::fahrenheit_point<long>( c[i] ).value() );
+    
+    assert( f[0].value() == -148 );
+    assert( f[199].value() == 210 );
+}
+
+int main()
+{
+    test_conversion();
+    test_arithmetic();
+    test_convert();
+    test_integral();
+}
@@ -0,0 +1,68 @@
+/*
+ * Boost Software License - Version 1.0 - August 17th, 2003
+ *
+ * Permission is hereby granted, free of charge, to any person or organization
+ * obtaining a copy of the software and accompanying documentation covered by
+ * this license (the "Software") to use, reproduce, display, distribute,
+ * execute, and transmit the Software, and to prepare derivative works of the
+ * Software, and to permit third-parties to whom the Software is furnished to
+ * do so, all subject to the following:
+ *
+ * The copyright notices in the Software and this entire statement, including
+ * the above license grant, this restriction and the following disclaimer,
+ * must be included in all copies of the Software, in whole or in part, and
+ * all derivative works of the Software, unless such copies or derivative
+ * works are solely in the form of machine-executable object code generated by
+ * a source language processor.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+ * SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+ * FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#include <engineering_units/precompiled.hpp>
+
+#include <cassert>
+#include <cmath>
+
+using namespace engunits;
+
+// Not constant, so that the conversions below call the constructors 
+// instantiated in the precompiled library instead of being folded
+volatile double input = 2.0;
+
+template<class T>
+bool close( T a, T b )
+{
+    return std::abs( a - b ) <= T( 1e-5 ) * std::abs( b );
+}
+
+void test_conversions()
+{
+    const quantity<double, imperial::foot> ft( input );
+    const quantity<double, si::meter> m( ft );
+    assert( close( m.value(), 0.6096 ) );
+    assert( close( quantity<double, imperial::foot>( m ).value(), 2.0 ) );
+    
+    const quantity<float, imperial::pound> lb( static_cast<float>( input ) );
+    assert( close( quantity<float, si::kilogram>( lb ).value(), 0.90718474f ) );
+    
+    const quantity<double, si::kilopascal> p( input );
+    assert( close( quantity<double, si::pascal>( p ).value(), 2000.0 ) );
+    
+    const quantity<double, hour> h( input );
+    assert( close( quantity<double, second>( h ).value(), 7200.0 ) );
+    
+    const quantity<double, imperial::knot> kn( input );
+    const quantity<double, detail::precompiled::meter_per_second> v( kn );
+    assert( close( v.value(), 1.0288888888888889 ) );
+}
+
+int main()
+{
+    test_conversions();
+}
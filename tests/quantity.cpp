@@ -25,9 +25,14 @@
  */
 
 #include <cassert>
+#include <cmath>
 #include <iostream>
 #include <limits>
+#include <type_traits>
 
+#ifdef ENGUNITS_TEST_MODULE
+import engunits;
+#else
 #include <engineering_units/quantity.hpp>
 #include <engineering_units/io.hpp>
 
@@ -43,6 +48,7 @@
 #include <engineering_units/imperial/mass.hpp>
 #include <engineering_units/imperial/force.hpp>
 #include <engineering_units/imperial/velocity.hpp>
+#endif
 
 namespace si = engunits::si;
 namespace imperial = engunits::imperial;
@@ -139,8 +145,55 @@ void test_functions()
     assert( fabs(tan(45.0_deg) - 1.0 ) < 1e-10 );
 }
 
+void test_copy()
+{
+    using meter_t = engunits::quantity<double, si::meter>;
+    
+    static_assert( std::is_trivially_copyable< meter_t >::value, "" );
+    static_assert( sizeof( meter_t ) == sizeof( double ), "" );
+    
+    meter_t x( 1.0 );
+    meter_t y( 2.0 );
+    
+    x = y;
+    assert( x == 2.0_m );
+    
+    x = meter_t( 3.0 );
+    assert( x == 3.0_m );
+}
+
+void test_construct()
+{
+    quantity<float, si::meter> f( 1.5f );
+    
+    // same unit, different value type
+    quantity<double, si::meter> x( f );
+    quantity<double, si::meter> y = f;
+    quantity<int, si::meter> z( x );
+    assert( x == 1.5_m && y == 1.5_m && z.value() == 1 );
+    
+    // convertible unit
+    quantity<double, si::millimeter> w( x );
+    assert( w == 1500.0_mm );
+    
+    static_assert( std::is_convertible< quantity<float, si::meter>, quantity<double, si::meter> >::value, "" );
+    static_assert( !std::is_convertible< quantity<double, si::meter>, quantity<double, si::millimeter> >::value, "" );
+    static_assert( !std::is_constructible< quantity<double, si::meter>, quantity<double, second> >::value, "" );
+    
+#ifdef ENGUNITS_HAS_CONCEPTS
+    static_assert( engunits::Unit<si::meter> );
+    static_assert( !engunits::Unit<double> );
+    static_assert( engunits::Quantity< quantity<double, si::meter> > );
+    static_assert( !engunits::Quantity< si::meter > );
+    static_assert( engunits::ConvertibleTo< si::meter, imperial::foot > );
+    static_assert( !engunits::ConvertibleTo< si::meter, second > );
+#endif
+}
+
 int main() 
 {
+    test_copy();
+    test_construct();
     test_addition();
     test_mult();
     test_div();
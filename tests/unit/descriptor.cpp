@@ -0,0 +1,108 @@
+/*
+ * Boost Software License - Version 1.0 - August 17th, 2003
+ *
+ * Permission is hereby granted, free of charge, to any person or organization
+ * obtaining a copy of the software and accompanying documentation covered by
+ * this license (the "Software") to use, reproduce, display, distribute,
+ * execute, and transmit the Software, and to prepare derivative works of the
+ * Software, and to permit third-parties to whom the Software is furnished to
+ * do so, all subject to the following:
+ *
+ * The copyright notices in the Software and this entire statement, including
+ * the above license grant, this restriction and the following disclaimer,
+ * must be included in all copies of the Software, in whole or in part, and
+ * all derivative works of the Software, unless such copies or derivative
+ * works are solely in the form of machine-executable object code generated by
+ * a source language processor.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+ * SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+ * FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#include <engineering_units/unit/descriptor.hpp>
+
+#include <cassert>
+#include <cmath>
+
+#include <engineering_units/time.hpp>
+#include <engineering_units/si/length.hpp>
+#include <engineering_units/si/mass.hpp>
+#include <engineering_units/si/force.hpp>
+#include <engineering_units/si/pressure.hpp>
+
+#include <engineering_units/imperial/length.hpp>
+#include <engineering_units/imperial/force.hpp>
+
+namespace si = engunits::si;
+namespace imperial = engunits::imperial;
+
+using engunits::describe_unit;
+using engunits::mixed_unit;
+using engunits::unit_descriptor;
+using engunits::unit_dimension;
+
+using engunits::second_;
+
+bool close( long double x, long double y )
+{
+    return std::fabs( x - y ) < 1e-12L * std::fabs( y );
+}
+
+void test_describe_unit()
+{
+    const unit_descriptor m = describe_unit( si::meter() );
+    
+    assert( m.symbol == "m" );
+    assert( m.scale == 1.0L );
+    assert( m.dimensions.size() == 1 );
+    assert( ( m.dimensions[0] == unit_dimension { "m", 1, 1 } ) );
+    
+    const unit_descriptor ft = describe_unit( imperial::foot_<-1>() );
+    
+    assert( ft.symbol == "ft^-1" );
+    assert( close( ft.scale, 1.0L / 0.3048L ) );
+    assert( ( ft.dimensions[0] == unit_dimension { "m", -1, 1 } ) );
+    
+    // Derived units are flattened, and sorted by root symbol
+    const unit_descriptor pa = describe_unit( si::pascal() );
+    
+    assert( pa.symbol == "Pa" );
+    assert( pa.dimensions.size() == 3 );
+    assert( ( pa.dimensions[0] == unit_dimension { "kg", 1, 1 } ) );
+    assert( ( pa.dimensions[1] == unit_dimension { "m", -1, 1 } ) );
+    assert( ( pa.dimensions[2] == unit_dimension { "s", -2, 1 } ) );
+    
+    // Different bases of the same root are merged
+    const unit_descriptor area = describe_unit( mixed_unit< imperial::foot, si::meter >() );
+    
+    assert( area.dimensions.size() == 1 );
+    assert( ( area.dimensions[0] == unit_dimension { "m", 2, 1 } ) );
+    assert( close( area.scale, 0.3048L ) );
+}
+
+void test_conversion_factor()
+{
+    const unit_descriptor kmh = describe_unit( mixed_unit< si::kilometer, second_<-1> >() );
+    const unit_descriptor ms = describe_unit( mixed_unit< si::meter, second_<-1> >() );
+    const unit_descriptor n = describe_unit( si::newton() );
+    const unit_descriptor lbf = describe_unit( imperial::pound_force() );
+    
+    assert( kmh.same_dimensions( ms ) );
+    assert( !kmh.same_dimensions( n ) );
+    assert( n.same_dimensions( lbf ) );
+    
+    assert( close( conversion_factor( kmh, ms ), 1000.0L ) );
+    assert( close( conversion_factor( lbf, n ), 
+                   engunits::conversion_factor( imperial::pound_force(), si::newton() ) ) );
+}
+
+int main()
+{
+    test_describe_unit();
+    test_conversion_factor();
+}
@@ -0,0 +1,82 @@
+/*
+ * Boost Software License - Version 1.0 - August 17th, 2003
+ *
+ * Permission is hereby granted, free of charge, to any person or organization
+ * obtaining a copy of the software and accompanying documentation covered by
+ * this license (the "Software") to use, reproduce, display, distribute,
+ * execute, and transmit the Software, and to prepare derivative works of the
+ * Software, and to permit third-parties to whom the Software is furnished to
+ * do so, all subject to the following:
+ *
+ * The copyright notices in the Software and this entire statement, including
+ * the above license grant, this restriction and the following disclaimer,
+ * must be included in all copies of the Software, in whole or in part, and
+ * all derivative works of the Software, unless such copies or derivative
+ * works are solely in the form of machine-executable object code generated by
+ * a source language processor.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+ * SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+ * FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#include <engineering_units/unit/dimension_hash.hpp>
+
+#include <engineering_units/time.hpp>
+#include <engineering_units/si/length.hpp>
+#include <engineering_units/si/mass.hpp>
+#include <engineering_units/si/force.hpp>
+#include <engineering_units/si/pressure.hpp>
+
+#include <engineering_units/imperial/length.hpp>
+#include <engineering_units/imperial/force.hpp>
+
+namespace si = engunits::si;
+namespace imperial = engunits::imperial;
+
+using engunits::dimension_hash_v;
+using engunits::unit_root_scale_v;
+using engunits::mixed_unit;
+using engunits::second_;
+using engunits::second;
+
+void test_dimension_hash()
+{
+    // Same dimension, different scale
+    static_assert( dimension_hash_v< imperial::foot > == dimension_hash_v< si::meter >, "" );
+    static_assert( dimension_hash_v< imperial::pound_force > == dimension_hash_v< si::newton >, "" );
+    
+    // Derived units are flattened, order does not matter
+    static_assert( dimension_hash_v< si::newton > == 
+                   dimension_hash_v< mixed_unit< si::kilogram, si::meter, second_<-2> > >, "" );
+    static_assert( dimension_hash_v< mixed_unit< second_<-2>, si::meter, si::kilogram > > == 
+                   dimension_hash_v< mixed_unit< si::kilogram, si::meter, second_<-2> > >, "" );
+    
+    // Bases with the same root are merged
+    static_assert( dimension_hash_v< mixed_unit< imperial::foot, si::meter > > == 
+                   dimension_hash_v< si::meter_<2> >, "" );
+    
+    static_assert( dimension_hash_v< si::meter > != dimension_hash_v< si::meter_<2> >, "" );
+    static_assert( dimension_hash_v< si::meter > != dimension_hash_v< si::meter_<1,2> >, "" );
+    static_assert( dimension_hash_v< si::meter > != dimension_hash_v< second >, "" );
+    static_assert( dimension_hash_v< si::newton > != dimension_hash_v< si::pascal >, "" );
+}
+
+void test_unit_root_scale()
+{
+    static_assert( unit_root_scale_v< si::meter > == 1.0L, "" );
+    static_assert( unit_root_scale_v< si::kilometer > == 1000.0L, "" );
+    static_assert( unit_root_scale_v< imperial::foot > == 0.3048L, "" );
+    static_assert( unit_root_scale_v< si::hectopascal > == 
+                   engunits::conversion_factor( si::hectopascal(), si::pascal() ), "" );
+}
+
+int main()
+{
+    test_dimension_hash();
+    test_unit_root_scale();
+}
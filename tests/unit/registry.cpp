@@ -0,0 +1,121 @@
+/*
+ * Boost Software License - Version 1.0 - August 17th, 2003
+ *
+ * Permission is hereby granted, free of charge, to any person or organization
+ * obtaining a copy of the software and accompanying documentation covered by
+ * this license (the "Software") to use, reproduce, display, distribute,
+ * execute, and transmit the Software, and to prepare derivative works of the
+ * Software, and to permit third-parties to whom the Software is furnished to
+ * do so, all subject to the following:
+ *
+ * The copyright notices in the Software and this entire statement, including
+ * the above license grant, this restriction and the following disclaimer,
+ * must be included in all copies of the Software, in whole or in part, and
+ * all derivative works of the Software, unless such copies or derivative
+ * works are solely in the form of machine-executable object code generated by
+ * a source language processor.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+ * SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+ * FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#include <engineering_units/unit/registry.hpp>
+#include <engineering_units/predefined_units.hpp>
+
+#include <cassert>
+#include <cmath>
+#include <stdexcept>
+
+namespace si = engunits::si;
+namespace imperial = engunits::imperial;
+
+using engunits::unit_descriptor;
+using engunits::unit_dimension;
+using engunits::unit_registry;
+
+bool close( long double x, long double y )
+{
+    return std::fabs( x - y ) < 1e-12L * std::fabs( y );
+}
+
+void test_add()
+{
+    unit_registry r;
+    
+    r.add( si::meter(), imperial::foot() );
+    
+    assert( r.size() == 2 );
+    assert( r.find( "ft" ) != nullptr );
+    assert( r.find( "in" ) == nullptr );
+    
+    // The first one wins
+    assert( !r.add( engunits::describe_unit( si::celsius() ) ) || 
+            !r.add( engunits::describe_unit( si::coulomb() ) ) );
+    assert( r.find( "C" )->dimensions[0].symbol == "C" );
+}
+
+void test_parse()
+{
+    const unit_registry & r = engunits::predefined_units();
+    
+    const unit_descriptor hpa = r.parse( "hPa" );
+    
+    assert( hpa.same_dimensions( engunits::describe_unit( si::pascal() ) ) );
+    assert( close( hpa.scale, 100.0L ) );
+    
+    const unit_descriptor accel = r.parse( "ft/s^2" );
+    
+    assert( accel.symbol == "ft/s^2" );
+    assert( accel.dimensions.size() == 2 );
+    assert( ( accel.dimensions[0] == unit_dimension { "m", 1, 1 } ) );
+    assert( ( accel.dimensions[1] == unit_dimension { "s", -2, 1 } ) );
+    assert( close( accel.scale, 0.3048L ) );
+    
+    // Same form as unit_traits::symbol
+    const unit_descriptor speed = r.parse( "km h^-1" );
+    
+    assert( close( speed.scale, 1000.0L / 3600.0L ) );
+    assert( speed.same_dimensions( r.parse( "m * s^-1" ) ) );
+    
+    const unit_descriptor root = r.parse( "m^(1/2)" );
+    
+    assert( ( root.dimensions[0] == unit_dimension { "m", 1, 2 } ) );
+    
+    assert( r.parse( "" ).dimensions.empty() );
+    assert( r.parse( "m/m" ).dimensions.empty() );
+}
+
+void test_errors()
+{
+    const unit_registry & r = engunits::predefined_units();
+    
+    const char * bad[] = { "furlong", "m^", "m^(1/", "m/", "m^x" };
+    
+    for ( const char * s : bad )
+    {
+        bool thrown = false;
+        
+        try
+        {
+            r.parse( s );
+        }
+        catch ( const std::invalid_argument & )
+        {
+            thrown = true;
+        }
+        
+        assert( thrown );
+    }
+}
+
+int main()
+{
+    test_add();
+    test_parse();
+    test_errors();
+}
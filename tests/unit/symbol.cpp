@@ -24,13 +24,18 @@
  * DEALINGS IN THE SOFTWARE.
  */
 
+#include <cassert>
+#include <cstring>
 #include <iostream>
+#include <sstream>
 
 #include <engineering_units/time.hpp>
 #include <engineering_units/si/length.hpp>
 #include <engineering_units/si/mass.hpp>
 #include <engineering_units/si/force.hpp>
 
+#include <engineering_units/io.hpp>
+#include <engineering_units/unit/symbol.hpp>
 #include <engineering_units/unit/traits.hpp>
 
 template<class U>
@@ -51,7 +56,47 @@ void test_symbol()
     static_assert( get_symbol( si::meter_<-2,3>() ) == "m^(-2/3)", "");
 }
 
+void test_unit_symbol_v()
+{
+    namespace si = engunits::si;
+    using engunits::unit_symbol_v;
+    using engunits::mixed_unit;
+    
+    static_assert( unit_symbol_v< si::meter_<2> > == "m^2", "");
+    static_assert( unit_symbol_v< si::newton > == "N", "");
+    static_assert( unit_symbol_v< mixed_unit< si::meter, engunits::second_<-1> > > == "m s^-1", "");
+    
+    // Always the same object
+    assert( &unit_symbol_v< si::newton > == &unit_symbol_v< si::newton > );
+    assert( unit_symbol_v< si::newton >.c_str() == unit_symbol_v< si::newton >.c_str() );
+    
+    using engunits::operator<<;
+    
+    std::ostringstream ss;
+    ss << engunits::quantity<double, si::meter_<2> >( 3.0 ) << ' ' << si::newton();
+    
+    assert( ss.str() == "3m^2 N" );
+}
+
+#ifdef ENGUNITS_HAS_STRING_VIEW
+void test_unit_symbol_view_v()
+{
+    namespace si = engunits::si;
+    using engunits::unit_symbol_view_v;
+    
+    static_assert( unit_symbol_view_v< si::meter_<-3> > == "m^-3", "");
+    static_assert( unit_symbol_view_v< si::meter_<2,3> >.size() == 7, "");
+    
+    assert( unit_symbol_view_v< si::newton >.data() == engunits::unit_symbol_v< si::newton >.c_str() );
+}
+#endif
+
 int main()
 {
     test_symbol();
+    test_unit_symbol_v();
+    
+#ifdef ENGUNITS_HAS_STRING_VIEW
+    test_unit_symbol_view_v();
+#endif
 }